@@ -3,9 +3,12 @@
 #include <vespa/eval/eval/llvm/compile_cache.h>
 #include <vespa/eval/eval/key_gen.h>
 #include <vespa/eval/eval/test/eval_spec.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <set>
 
 using namespace vespalib::eval;
+using vespalib::make_string;
 
 //-----------------------------------------------------------------------------
 
@@ -144,6 +147,134 @@ TEST("require that cache usage works") {
     TEST_DO(verify_cache(0, 0));
 }
 
+struct PersistentDir {
+    vespalib::string dir;
+    PersistentDir() : dir("compile_cache_dir") {
+        vespalib::rmdir(dir, true);
+        vespalib::mkdir(dir);
+        CompileCache::set_persistent_dir(dir);
+    }
+    ~PersistentDir() {
+        CompileCache::set_persistent_dir("");
+        vespalib::rmdir(dir, true);
+    }
+    size_t num_files() const { return vespalib::listDirectory(dir).size(); }
+    void damage_single_file(bool truncate) const {
+        auto files = vespalib::listDirectory(dir);
+        ASSERT_EQUAL(1u, files.size());
+        vespalib::File file(dir + "/" + files[0]);
+        file.open(0);
+        ASSERT_GREATER(file.getFileSize(), 64);
+        if (truncate) {
+            file.resize(file.getFileSize() / 2);
+        } else {
+            file.write("garbage", 7, file.getFileSize() - 7);
+        }
+        file.close();
+    }
+};
+
+TEST_F("require that compiled code can be loaded from persistent directory", PersistentDir()) {
+    size_t disk_hits = CompileCache::num_disk_hits();
+    CompileCache::Token::UP token_a = CompileCache::compile(Function::parse("x+y"), PassParams::SEPARATE);
+    EXPECT_EQUAL(5.0, token_a->get().get_function<2>()(2.0, 3.0));
+    EXPECT_FALSE(token_a->get().loaded_from_disk());
+    EXPECT_EQUAL(disk_hits, CompileCache::num_disk_hits());
+    EXPECT_EQUAL(1u, f1.num_files());
+    token_a.reset();
+    TEST_DO(verify_cache(0, 0));
+    CompileCache::Token::UP token_b = CompileCache::compile(Function::parse("a+b"), PassParams::SEPARATE);
+    EXPECT_EQUAL(7.0, token_b->get().get_function<2>()(3.0, 4.0));
+    EXPECT_TRUE(token_b->get().loaded_from_disk());
+    EXPECT_EQUAL(disk_hits + 1, CompileCache::num_disk_hits());
+    CompileCache::Token::UP token_c = CompileCache::compile(Function::parse("x+y"), PassParams::ARRAY);
+    EXPECT_FALSE(token_c->get().loaded_from_disk());
+    EXPECT_EQUAL(disk_hits + 1, CompileCache::num_disk_hits());
+    EXPECT_EQUAL(2u, f1.num_files());
+}
+
+void verify_recompiled_after_damage(const PersistentDir &dir, bool truncate) {
+    size_t disk_hits = CompileCache::num_disk_hits();
+    {
+        CompileCache::Token::UP token = CompileCache::compile(Function::parse("x+y"), PassParams::SEPARATE);
+        EXPECT_FALSE(token->get().loaded_from_disk());
+    }
+    TEST_DO(dir.damage_single_file(truncate));
+    {
+        CompileCache::Token::UP token = CompileCache::compile(Function::parse("a+b"), PassParams::SEPARATE);
+        EXPECT_EQUAL(7.0, token->get().get_function<2>()(3.0, 4.0));
+        EXPECT_FALSE(token->get().loaded_from_disk());
+        EXPECT_EQUAL(disk_hits, CompileCache::num_disk_hits());
+        EXPECT_EQUAL(1u, dir.num_files());
+    }
+    CompileCache::Token::UP token = CompileCache::compile(Function::parse("x+y"), PassParams::SEPARATE);
+    EXPECT_EQUAL(5.0, token->get().get_function<2>()(2.0, 3.0));
+    EXPECT_TRUE(token->get().loaded_from_disk());
+    EXPECT_EQUAL(disk_hits + 1, CompileCache::num_disk_hits());
+}
+
+TEST_F("require that corrupted code in persistent directory is compiled again", PersistentDir()) {
+    TEST_DO(verify_recompiled_after_damage(f1, false));
+}
+
+TEST_F("require that truncated code in persistent directory is compiled again", PersistentDir()) {
+    TEST_DO(verify_recompiled_after_damage(f1, true));
+}
+
+TEST_F("require that code referring to native state is persisted", PersistentDir()) {
+    // large set membership checks use a native hash set plugin
+    const char *expr = "if(x in [1,2,3,4,5,6,7,8,9,10],1,0)";
+    {
+        CompileCache::Token::UP token = CompileCache::compile(Function::parse(expr), PassParams::SEPARATE);
+        EXPECT_FALSE(token->get().loaded_from_disk());
+        EXPECT_EQUAL(1.0, token->get().get_function<1>()(2.0));
+    }
+    EXPECT_EQUAL(1u, f1.num_files());
+    CompileCache::Token::UP token = CompileCache::compile(Function::parse(expr), PassParams::SEPARATE);
+    EXPECT_TRUE(token->get().loaded_from_disk());
+    EXPECT_EQUAL(1.0, token->get().get_function<1>()(2.0));
+    EXPECT_EQUAL(0.0, token->get().get_function<1>()(11.0));
+}
+
+vespalib::string make_tree(size_t depth, size_t &node) {
+    if (depth == 0) {
+        return make_string("%g", double(node++ % 97) / 10.0);
+    }
+    vespalib::string cond = make_string("p%zu<%g", node % 10, double(node % 7) / 7.0);
+    ++node;
+    vespalib::string lhs = make_tree(depth - 1, node);
+    vespalib::string rhs = make_tree(depth - 1, node);
+    return make_string("if(%s,%s,%s)", cond.c_str(), lhs.c_str(), rhs.c_str());
+}
+
+vespalib::string make_forest(size_t num_trees) {
+    size_t node = 0;
+    vespalib::string forest;
+    for (size_t i = 0; i < num_trees; ++i) {
+        forest.append((i > 0) ? "+" : "").append(make_tree(5, node));
+    }
+    return forest;
+}
+
+TEST_F("require that code evaluating optimized forests is persisted", PersistentDir()) {
+    // large enough to be evaluated by a natively prepared forest
+    Function function = Function::parse(make_forest(600));
+    std::vector<double> params({0.1, 0.9, 0.2, 0.8, 0.3, 0.7, 0.4, 0.6, 0.5, 0.0});
+    ASSERT_EQUAL(params.size(), function.num_params());
+    double expect;
+    {
+        CompileCache::Token::UP token = CompileCache::compile(function, PassParams::ARRAY);
+        EXPECT_EQUAL(1u, token->get().get_forests().size());
+        EXPECT_FALSE(token->get().loaded_from_disk());
+        expect = token->get().get_function()(&params[0]);
+    }
+    EXPECT_EQUAL(1u, f1.num_files());
+    CompileCache::Token::UP token = CompileCache::compile(function, PassParams::ARRAY);
+    EXPECT_EQUAL(1u, token->get().get_forests().size());
+    EXPECT_TRUE(token->get().loaded_from_disk());
+    EXPECT_EQUAL(expect, token->get().get_function()(&params[0]));
+}
+
 //-----------------------------------------------------------------------------
 
 TEST_MAIN() { TEST_RUN_ALL(); }
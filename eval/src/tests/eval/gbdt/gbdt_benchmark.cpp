@@ -2,11 +2,15 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/eval/gbdt.h>
 #include <vespa/eval/eval/vm_forest.h>
+#include <vespa/eval/eval/quick_scorer_forest.h>
 #include <vespa/eval/eval/llvm/deinline_forest.h>
 #include <vespa/eval/eval/llvm/compiled_function.h>
+#include <vespa/eval/eval/llvm/compile_cache.h>
 #include <vespa/eval/eval/function.h>
+#include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <chrono>
 #include "model.cpp"
 
 using namespace vespalib::eval;
@@ -76,6 +80,22 @@ struct DeinlineForestStrategy : CompileStrategy {
 };
 DeinlineForestStrategy deinline_forest;
 
+struct QuickScorerForestStrategy : CompileStrategy {
+    const char *name() const override {
+        return "quick-scorer";
+    }
+    const char *code_name() const override {
+        return "QuickScorerForest::optimize_chain";
+    }
+    CompiledFunction compile(const Function &function) const override {
+        return CompiledFunction(function, PassParams::ARRAY, QuickScorerForest::optimize_chain);
+    }
+    CompiledFunction compile_lazy(const Function &function) const override {
+        return CompiledFunction(function, PassParams::LAZY, QuickScorerForest::optimize_chain);
+    }
+};
+QuickScorerForestStrategy quick_scorer_forest;
+
 //-----------------------------------------------------------------------------
 
 struct Option {
@@ -88,7 +108,7 @@ struct Option {
     const char *code_name() const { return strategy.code_name(); }
 };
 
-std::vector<Option> all_options({{0, none},{1, vm_forest}});
+std::vector<Option> all_options({{0, none},{1, vm_forest},{2, quick_scorer_forest}});
 
 //-----------------------------------------------------------------------------
 
@@ -260,6 +280,42 @@ void dump_plan(const ForestParams &params, const Plan &plan) {
 
 //-----------------------------------------------------------------------------
 
+double estimate_compile_cost_ms(const Option &option, const Function &function, bool &loaded_from_disk) {
+    auto before = std::chrono::steady_clock::now();
+    CompiledFunction compiled_function = option.compile(function);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - before;
+    loaded_from_disk = compiled_function.loaded_from_disk();
+    return elapsed.count();
+}
+
+TEST("estimate startup cost with persisted compiled code") {
+    vespalib::string dir("gbdt_benchmark_compile_cache");
+    vespalib::rmdir(dir, true);
+    vespalib::mkdir(dir);
+    CompileCache::set_persistent_dir(dir);
+    for (size_t tree_size: std::vector<size_t>({8, 32})) {
+        for (size_t num_trees: std::vector<size_t>({100, 500})) {
+            Function forest = make_forest(ForestParams(1234u, 90, tree_size), num_trees);
+            for (const Option &option: all_options) {
+                // code calling into prepared forests is the same for all
+                // forests, so it may already have been persisted
+                bool first_loaded;
+                bool second_loaded;
+                double first_ms = estimate_compile_cost_ms(option, forest, first_loaded);
+                double second_ms = estimate_compile_cost_ms(option, forest, second_loaded);
+                EXPECT_TRUE(second_loaded);
+                fprintf(stderr, "  %20s@%4zu trees of size %3zu: %s: %10g ms, load: %10g ms (factor: %g)\n",
+                        option.name(), num_trees, tree_size, first_loaded ? "load" : "generate",
+                        first_ms, second_ms, first_ms / second_ms);
+            }
+        }
+    }
+    CompileCache::set_persistent_dir("");
+    vespalib::rmdir(dir, true);
+}
+
+//-----------------------------------------------------------------------------
+
 TEST("find optimization plans") {
     std::vector<size_t> less_percent_values({90, 100});
     std::vector<size_t> tree_size_values(
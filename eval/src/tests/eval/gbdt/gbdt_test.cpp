@@ -2,11 +2,13 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/eval/gbdt.h>
 #include <vespa/eval/eval/vm_forest.h>
+#include <vespa/eval/eval/quick_scorer_forest.h>
 #include <vespa/eval/eval/function.h>
 #include <vespa/eval/eval/llvm/deinline_forest.h>
 #include <vespa/eval/eval/llvm/compiled_function.h>
 #include <vespa/eval/eval/interpreted_function.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <cmath>
 #include "model.cpp"
 
 using namespace vespalib::eval;
@@ -282,6 +284,51 @@ TEST("require that models with too large sets are rejected by general vm optimiz
     EXPECT_TRUE(!Optimize::apply_chain(general_vm_chain, stats, trees).valid());
 }
 
+TEST("require that quick scorer tree optimizer works") {
+    Function function = Function::parse("if((a<1),1.0,if((b<1),if((c<1),2.0,3.0),4.0))+"
+                                        "if((d<1),10.0,if((e<1),if((f<1),20.0,30.0),40.0))+"
+                                        "if((a<2),if((a<0.5),100.0,200.0),300.0)");
+    CompiledFunction compiled_function(function, PassParams::ARRAY, QuickScorerForest::optimize_chain);
+    ASSERT_EQUAL(1u, compiled_function.get_forests().size());
+    EXPECT_TRUE(dynamic_cast<QuickScorerForest*>(compiled_function.get_forests()[0].get()) != nullptr);
+    auto f = compiled_function.get_function();
+    EXPECT_EQUAL(111.0, f(&std::vector<double>({0.0, 0.0, 0.0, 0.5, 0.0, 0.0})[0]));
+    EXPECT_EQUAL(222.0, f(&std::vector<double>({1.5, 0.5, 0.5, 1.5, 0.5, 0.5})[0]));
+    EXPECT_EQUAL(333.0, f(&std::vector<double>({2.5, 0.5, 1.5, 1.5, 0.5, 1.5})[0]));
+    EXPECT_EQUAL(344.0, f(&std::vector<double>({2.0, 1.5, 0.0, 1.5, 1.5, 0.0})[0]));
+    EXPECT_EQUAL(344.0, f(&std::vector<double>({std::nan(""), std::nan(""), 0.0, std::nan(""), std::nan(""), 0.0})[0]));
+}
+
+TEST("require that models with in checks or large trees are rejected by quick scorer optimizer") {
+    Function function = Function::parse(Model().less_percent(100).make_forest(300, 30));
+    auto trees = extract_trees(function.root());
+    ForestStats stats(trees);
+    EXPECT_TRUE(Optimize::apply_chain(QuickScorerForest::optimize_chain, stats, trees).valid());
+    stats.total_in_checks = 1;
+    EXPECT_TRUE(!Optimize::apply_chain(QuickScorerForest::optimize_chain, stats, trees).valid());
+    Function large_function = Function::parse(Model().less_percent(100).make_forest(10, 65));
+    auto large_trees = extract_trees(large_function.root());
+    ForestStats large_stats(large_trees);
+    EXPECT_TRUE(!Optimize::apply_chain(QuickScorerForest::optimize_chain, large_stats, large_trees).valid());
+}
+
+TEST("require that quick scorer forest evaluates like unoptimized forest for varying inputs") {
+    for (size_t tree_size: std::vector<size_t>({2, 20, 64})) {
+        Function function = Function::parse(Model().less_percent(100).make_forest(40, tree_size));
+        CompiledFunction none(function, PassParams::ARRAY, Optimize::none);
+        CompiledFunction quick_scorer(function, PassParams::ARRAY, QuickScorerForest::optimize_chain);
+        ASSERT_EQUAL(1u, quick_scorer.get_forests().size());
+        EXPECT_TRUE(dynamic_cast<QuickScorerForest*>(quick_scorer.get_forests()[0].get()) != nullptr);
+        for (double value = -0.05; value <= 1.05; value += 0.05) {
+            std::vector<double> inputs;
+            for (size_t i = 0; i < function.num_params(); ++i) {
+                inputs.push_back((i % 2 == 0) ? value : (1.0 - value));
+            }
+            EXPECT_APPROX(none.get_function()(&inputs[0]), quick_scorer.get_function()(&inputs[0]), 1e-6);
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 double eval_compiled(const CompiledFunction &cfun, std::vector<double> &params) {
@@ -302,6 +302,34 @@ TEST("require that malformed value type spec is parsed as error") {
     EXPECT_TRUE(ValueType::from_spec("tensor(x{},x[])").is_error());
 }
 
+TEST("require that tensor cell type can be specified") {
+    using CellType = ValueType::CellType;
+    EXPECT_TRUE(ValueType::from_spec("tensor(x[10])").cell_type() == CellType::DOUBLE);
+    EXPECT_TRUE(ValueType::from_spec("tensor<double>(x[10])").cell_type() == CellType::DOUBLE);
+    EXPECT_TRUE(ValueType::from_spec("tensor<float>(x[10])").cell_type() == CellType::FLOAT);
+    EXPECT_TRUE(ValueType::from_spec(" tensor < int8 > ( x [ 10 ] ) ").cell_type() == CellType::INT8);
+    EXPECT_EQUAL(ValueType::tensor_type({{"x", 10}}, CellType::FLOAT), ValueType::from_spec("tensor<float>(x[10])"));
+    EXPECT_NOT_EQUAL(ValueType::tensor_type({{"x", 10}}), ValueType::from_spec("tensor<float>(x[10])"));
+    EXPECT_EQUAL("tensor(x[10])", ValueType::from_spec("tensor<double>(x[10])").to_spec());
+    EXPECT_EQUAL("tensor<float>(x[10])", ValueType::from_spec("tensor<float>(x[10])").to_spec());
+    EXPECT_EQUAL("tensor<int8>(x[10])", ValueType::from_spec("tensor<int8>(x[10])").to_spec());
+    EXPECT_TRUE(ValueType::from_spec("tensor<half>(x[10])").is_error());
+    EXPECT_TRUE(ValueType::from_spec("tensor<float(x[10])").is_error());
+    EXPECT_TRUE(ValueType::from_spec("tensor<>(x[10])").is_error());
+    EXPECT_EQUAL(8u, ValueType::cell_size(CellType::DOUBLE));
+    EXPECT_EQUAL(4u, ValueType::cell_size(CellType::FLOAT));
+    EXPECT_EQUAL(1u, ValueType::cell_size(CellType::INT8));
+}
+
+TEST("require that operations on tensors with lower precision cells give double cells") {
+    ValueType f = ValueType::from_spec("tensor<float>(x[10],y[5])");
+    EXPECT_EQUAL("tensor(x[10])", f.reduce({"y"}).to_spec());
+    EXPECT_EQUAL("tensor(x[10],y[5])", ValueType::join(f, ValueType::double_type()).to_spec());
+    EXPECT_EQUAL("tensor(x[10],y[5])", ValueType::join(ValueType::double_type(), f).to_spec());
+    EXPECT_EQUAL("tensor(x[10],y[5])", ValueType::join(f, f).to_spec());
+    EXPECT_EQUAL("tensor(x[10],z[5])", f.rename({"y"}, {"z"}).to_spec());
+}
+
 struct ParseResult {
     vespalib::string spec;
     const char *pos;
@@ -178,4 +178,109 @@ TEST("require that dot product with un-equal sizes is correct")
     TEST_DO(assertDotProduct(1024, 1024 + 3));
 }
 
+template <typename CT>
+std::vector<CT>
+makeCells(size_t numCells, int cellBias)
+{
+    std::vector<CT> cells;
+    for (size_t i = 0; i < numCells; ++i) {
+        cells.push_back((int(i % 11) - 5) + cellBias);
+    }
+    return cells;
+}
+
+template <typename CT>
+ValueType::CellType cellType();
+template <> ValueType::CellType cellType<double>() { return ValueType::CellType::DOUBLE; }
+template <> ValueType::CellType cellType<float>() { return ValueType::CellType::FLOAT; }
+template <> ValueType::CellType cellType<int8_t>() { return ValueType::CellType::INT8; }
+
+template <typename LCT, typename RCT>
+class TypedFunctionInput : public TensorFunction::Input
+{
+private:
+    ValueType _lhsType;
+    ValueType _rhsType;
+    std::vector<LCT> _lhsCells;
+    std::vector<RCT> _rhsCells;
+    TensorValue _lhsValue;
+    TensorValue _rhsValue;
+
+public:
+    TypedFunctionInput(size_t numCells)
+        : _lhsType(ValueType::tensor_type({{"x", numCells}}, cellType<LCT>())),
+          _rhsType(ValueType::tensor_type({{"x", numCells}}, cellType<RCT>())),
+          _lhsCells(makeCells<LCT>(numCells, 1)),
+          _rhsCells(makeCells<RCT>(numCells, -2)),
+          _lhsValue(std::make_unique<DenseTensorView>(_lhsType, TypedCells(ConstArrayRef<LCT>(_lhsCells)))),
+          _rhsValue(std::make_unique<DenseTensorView>(_rhsType, TypedCells(ConstArrayRef<RCT>(_rhsCells))))
+    {}
+    virtual const Value &get_tensor(size_t id) const override {
+        if (id == 0) {
+            return _lhsValue;
+        } else {
+            return _rhsValue;
+        }
+    }
+    virtual const UnaryOperation &get_map_operation(size_t) const override {
+        abort();
+    }
+    double expectedDotProduct() const {
+        double result = 0;
+        for (size_t i = 0; i < _lhsCells.size(); ++i) {
+            result += (double(_lhsCells[i]) * double(_rhsCells[i]));
+        }
+        return result;
+    }
+};
+
+template <typename LCT, typename RCT>
+void
+assertTypedDotProduct(size_t numCells)
+{
+    DenseDotProductFunction function(0, 1);
+    TypedFunctionInput<LCT, RCT> input(numCells);
+    Stash stash;
+    const Value &result = function.eval(input, stash);
+    ASSERT_TRUE(result.is_double());
+    EXPECT_EQUAL(input.expectedDotProduct(), result.as_double());
+}
+
+TEST("require that dot product of float and int8 cells is correct")
+{
+    for (size_t numCells : {0, 3, 8, 67, 512, 1027}) {
+        vespalib::string state = make_string("numCells=%zu", numCells);
+        TEST_STATE(state.c_str());
+        TEST_DO((assertTypedDotProduct<float, float>(numCells)));
+        TEST_DO((assertTypedDotProduct<int8_t, int8_t>(numCells)));
+        TEST_DO((assertTypedDotProduct<double, float>(numCells)));
+        TEST_DO((assertTypedDotProduct<float, double>(numCells)));
+        TEST_DO((assertTypedDotProduct<int8_t, double>(numCells)));
+        TEST_DO((assertTypedDotProduct<float, int8_t>(numCells)));
+    }
+}
+
+TEST("require that view with lower precision cells decodes cells as double")
+{
+    ValueType type = ValueType::from_spec("tensor<float>(x[3])");
+    std::vector<float> cells({1.5, 2.0, -3.25});
+    DenseTensorView view(type, TypedCells(ConstArrayRef<float>(cells)));
+    EXPECT_TRUE(view.typedCells().type == ValueType::CellType::FLOAT);
+    EXPECT_EQUAL(0.25, view.sum());
+    EXPECT_FALSE(view.hasDoubleCells());
+    DenseTensorView::Cells buffer;
+    DenseTensorView::CellsRef decoded = view.decodeCells(buffer);
+    ASSERT_EQUAL(3u, decoded.size());
+    EXPECT_EQUAL(1.5, decoded[0]);
+    EXPECT_EQUAL(2.0, decoded[1]);
+    EXPECT_EQUAL(-3.25, decoded[2]);
+    Stash stash;
+    DenseTensorView::CellsRef stashed = view.decodeCells(stash);
+    ASSERT_EQUAL(3u, stashed.size());
+    EXPECT_EQUAL(-3.25, stashed[2]);
+    DenseTensorView copy(view);
+    EXPECT_TRUE(view == copy);
+    EXPECT_TRUE(copy.typedCells().data == view.typedCells().data);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,127 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_matmul_function.h>
+#include <vespa/eval/tensor/dense/dense_tensor_function_compiler.h>
+#include <vespa/eval/tensor/dense/dense_xw_product_function.h>
+#include <vespa/vespalib/util/stash.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::operation;
+using namespace vespalib::eval::tensor_function;
+using namespace vespalib::tensor;
+
+const TensorEngine &engine = DefaultTensorEngine::ref();
+
+template <typename T>
+const T *as(const TensorFunction &function) { return dynamic_cast<const T *>(&function); }
+
+TensorSpec
+makeSpec(const vespalib::string &type, int cellBias)
+{
+    TensorSpec spec(type);
+    ValueType valueType = ValueType::from_spec(type);
+    const auto &dims = valueType.dimensions();
+    size_t numCells = 1;
+    for (const auto &dim : dims) {
+        numCells *= dim.size;
+    }
+    for (size_t i = 0; i < numCells; ++i) {
+        TensorSpec::Address address;
+        size_t rest = i;
+        for (size_t d = dims.size(); d-- > 0; ) {
+            address.emplace(dims[d].name, TensorSpec::Label(rest % dims[d].size));
+            rest /= dims[d].size;
+        }
+        spec.add(address, (int(i % 7) - 3) + cellBias);
+    }
+    return spec;
+}
+
+class FunctionInput : public TensorFunction::Input
+{
+private:
+    TensorValue _lhsValue;
+    TensorValue _rhsValue;
+    Neg _neg;
+
+public:
+    FunctionInput(const vespalib::string &lhsType, const vespalib::string &rhsType)
+        : _lhsValue(engine.create(makeSpec(lhsType, 1))),
+          _rhsValue(engine.create(makeSpec(rhsType, -2))),
+          _neg()
+    {}
+    const Value &get_tensor(size_t id) const override {
+        return (id == 0) ? _lhsValue : _rhsValue;
+    }
+    const UnaryOperation &get_map_operation(size_t) const override {
+        return _neg;
+    }
+};
+
+Node_UP
+makeProduct(const vespalib::string &lhsType, const vespalib::string &rhsType,
+            const vespalib::string &dimension, bool withMap)
+{
+    Node_UP expr = reduce(apply(Mul(),
+                                inject(ValueType::from_spec(lhsType), 0),
+                                inject(ValueType::from_spec(rhsType), 1)),
+                          Add(), {dimension});
+    if (withMap) {
+        expr = map(0, std::move(expr));
+    }
+    return expr;
+}
+
+template <typename FunctionType>
+void
+assertProduct(const vespalib::string &lhsType, const vespalib::string &rhsType,
+              const vespalib::string &dimension, bool withMap)
+{
+    FunctionInput input(lhsType, rhsType);
+    Node_UP expected = makeProduct(lhsType, rhsType, dimension, withMap);
+    TensorFunction::UP compiled = DenseTensorFunctionCompiler::compile(makeProduct(lhsType, rhsType, dimension, withMap));
+    ASSERT_TRUE(as<FunctionType>(*compiled));
+    Stash stash;
+    const Value &expectedResult = expected->eval(input, stash);
+    const Value &actualResult = compiled->eval(input, stash);
+    ASSERT_TRUE(actualResult.is_tensor());
+    EXPECT_EQUAL(engine.to_spec(*expectedResult.as_tensor()), engine.to_spec(*actualResult.as_tensor()));
+}
+
+TEST("require that vector-matrix product is correct")
+{
+    for (bool withMap : {false, true}) {
+        TEST_DO(assertProduct<DenseXWProductFunction>("tensor(x[3])", "tensor(x[3],y[5])", "x", withMap));
+        TEST_DO(assertProduct<DenseXWProductFunction>("tensor(y[5])", "tensor(x[3],y[5])", "y", withMap));
+        TEST_DO(assertProduct<DenseXWProductFunction>("tensor(x[3],y[5])", "tensor(x[3])", "x", withMap));
+        TEST_DO(assertProduct<DenseXWProductFunction>("tensor(x[3],y[5])", "tensor(y[5])", "y", withMap));
+        TEST_DO(assertProduct<DenseXWProductFunction>("tensor(x[67])", "tensor(x[67],y[9])", "x", withMap));
+        TEST_DO(assertProduct<DenseXWProductFunction>("tensor(y[67])", "tensor(x[9],y[67])", "y", withMap));
+    }
+}
+
+TEST("require that vector-matrix product with un-equal sizes is correct")
+{
+    TEST_DO(assertProduct<DenseXWProductFunction>("tensor(x[2])", "tensor(x[3],y[5])", "x", false));
+    TEST_DO(assertProduct<DenseXWProductFunction>("tensor(y[7])", "tensor(x[3],y[5])", "y", false));
+}
+
+TEST("require that matrix multiplication is correct for all cell layouts")
+{
+    for (bool withMap : {false, true}) {
+        TEST_DO(assertProduct<DenseMatMulFunction>("tensor(x[3],y[4])", "tensor(y[4],z[5])", "y", withMap));
+        TEST_DO(assertProduct<DenseMatMulFunction>("tensor(y[4],z[5])", "tensor(x[3],y[4])", "y", withMap));
+        TEST_DO(assertProduct<DenseMatMulFunction>("tensor(a[3],y[4])", "tensor(b[5],y[4])", "y", withMap));
+        TEST_DO(assertProduct<DenseMatMulFunction>("tensor(a[3],y[4])", "tensor(y[4],z[5])", "y", withMap));
+        TEST_DO(assertProduct<DenseMatMulFunction>("tensor(x[3],z[4])", "tensor(x[3],y[5])", "x", withMap));
+        TEST_DO(assertProduct<DenseMatMulFunction>("tensor(x[3],y[4])", "tensor(x[3],z[5])", "x", withMap));
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,7 +2,9 @@
 
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/tensor/dense/dense_dot_product_function.h>
+#include <vespa/eval/tensor/dense/dense_matmul_function.h>
 #include <vespa/eval/tensor/dense/dense_tensor_function_compiler.h>
+#include <vespa/eval/tensor/dense/dense_xw_product_function.h>
 
 using namespace vespalib::eval;
 using namespace vespalib::eval::operation;
@@ -62,4 +64,93 @@ TEST("require that dot product with incompatible dimensions is NOT compiled")
     TEST_DO(assertNotCompiledDotProduct("tensor(x[5],y[7])", "tensor(x[5],y[7])"));
 }
 
+TensorFunction::UP
+compileProduct(const vespalib::string &lhsType,
+               const vespalib::string &rhsType,
+               const vespalib::string &dimension,
+               size_t mapOperationId = DenseXWProductFunction::NO_MAP_OPERATION)
+{
+    Node_UP node = reduce(apply(Mul(),
+                                inject(ValueType::from_spec(lhsType), 1),
+                                inject(ValueType::from_spec(rhsType), 3)),
+                          Add(), {dimension});
+    if (mapOperationId != DenseXWProductFunction::NO_MAP_OPERATION) {
+        node = map(mapOperationId, std::move(node));
+    }
+    return DenseTensorFunctionCompiler::compile(std::move(node));
+}
+
+void
+assertCompiledXWProduct(const vespalib::string &lhsType,
+                        const vespalib::string &rhsType,
+                        const vespalib::string &dimension,
+                        size_t vectorTensorId,
+                        size_t matrixTensorId,
+                        size_t mapOperationId = DenseXWProductFunction::NO_MAP_OPERATION)
+{
+    TensorFunction::UP func = compileProduct(lhsType, rhsType, dimension, mapOperationId);
+    const DenseXWProductFunction *product = as<DenseXWProductFunction>(*func);
+    ASSERT_TRUE(product);
+    EXPECT_EQUAL(vectorTensorId, product->vectorTensorId());
+    EXPECT_EQUAL(matrixTensorId, product->matrixTensorId());
+    EXPECT_EQUAL(dimension, product->commonDimension());
+    EXPECT_EQUAL(mapOperationId, product->mapOperationId());
+}
+
+void
+assertCompiledMatMul(const vespalib::string &lhsType,
+                     const vespalib::string &rhsType,
+                     const vespalib::string &dimension,
+                     size_t mapOperationId = DenseMatMulFunction::NO_MAP_OPERATION)
+{
+    TensorFunction::UP func = compileProduct(lhsType, rhsType, dimension, mapOperationId);
+    const DenseMatMulFunction *matMul = as<DenseMatMulFunction>(*func);
+    ASSERT_TRUE(matMul);
+    EXPECT_EQUAL(1u, matMul->lhsTensorId());
+    EXPECT_EQUAL(3u, matMul->rhsTensorId());
+    EXPECT_EQUAL(dimension, matMul->commonDimension());
+    EXPECT_EQUAL(mapOperationId, matMul->mapOperationId());
+}
+
+void
+assertNotCompiledProduct(const vespalib::string &lhsType,
+                         const vespalib::string &rhsType,
+                         const vespalib::string &dimension)
+{
+    TensorFunction::UP func = compileProduct(lhsType, rhsType, dimension);
+    EXPECT_TRUE(as<Reduce>(*func));
+    EXPECT_FALSE(as<DenseXWProductFunction>(*func));
+    EXPECT_FALSE(as<DenseMatMulFunction>(*func));
+}
+
+TEST("require that vector-matrix product is compiled")
+{
+    TEST_DO(assertCompiledXWProduct("tensor(x[3])", "tensor(x[3],y[5])", "x", 1, 3));
+    TEST_DO(assertCompiledXWProduct("tensor(x[3],y[5])", "tensor(x[3])", "x", 3, 1));
+    TEST_DO(assertCompiledXWProduct("tensor(y[5])", "tensor(x[3],y[5])", "y", 1, 3));
+    TEST_DO(assertCompiledXWProduct("tensor(x[])", "tensor(x[3],y[5])", "x", 1, 3));
+}
+
+TEST("require that matrix multiplication is compiled")
+{
+    TEST_DO(assertCompiledMatMul("tensor(x[3],y[4])", "tensor(y[4],z[5])", "y"));
+    TEST_DO(assertCompiledMatMul("tensor(a[3],y[4])", "tensor(b[5],y[4])", "y"));
+    TEST_DO(assertCompiledMatMul("tensor(x[3],y[4])", "tensor(x[3],z[5])", "x"));
+}
+
+TEST("require that map over product is fused into the compiled function")
+{
+    TEST_DO(assertCompiledXWProduct("tensor(x[3])", "tensor(x[3],y[5])", "x", 1, 3, 7));
+    TEST_DO(assertCompiledMatMul("tensor(x[3],y[4])", "tensor(y[4],z[5])", "y", 7));
+}
+
+TEST("require that products not matching a dense kernel are NOT compiled")
+{
+    TEST_DO(assertNotCompiledProduct("tensor(x[3])", "tensor(y[3],z[5])", "y"));
+    TEST_DO(assertNotCompiledProduct("tensor(x[3])", "tensor(x[3],y[5])", "y"));
+    TEST_DO(assertNotCompiledProduct("tensor(x[3],y[4])", "tensor(x[3],y[4])", "y"));
+    TEST_DO(assertNotCompiledProduct("tensor(x{})", "tensor(x{},y{})", "x"));
+    TEST_DO(assertNotCompiledProduct("tensor(x[3],y[4],z[5])", "tensor(y[4])", "y"));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -22,6 +22,8 @@ const vespalib::string dot_product_match_expr    = "sum(query*document)";
 const vespalib::string dot_product_multiply_expr = "sum(query*document)";
 const vespalib::string model_match_expr          = "sum((query*document)*model)";
 const vespalib::string matrix_product_expr       = "sum(sum((query+document)*model,x))";
+const vespalib::string xw_product_expr           = "sum(sum(query*model,x))";
+const vespalib::string matrix_multiply_expr      = "sum(sum(lhs*rhs,y))";
 
 //-----------------------------------------------------------------------------
 
@@ -145,6 +147,34 @@ TEST("SMOKETEST - require that matrix product benchmark expression produces expe
     EXPECT_EQUAL(calculate_expression(matrix_product_expr, params), 17.0);
 }
 
+TEST("SMOKETEST - require that dense xw product benchmark expression produces expected result") {
+    Params params;
+    params.add("query",    make_tensor(TensorSpec("tensor(x[2])")
+                                       .add({{"x",0}}, 1.0)
+                                       .add({{"x",1}}, 2.0)));
+    params.add("model",    make_tensor(TensorSpec("tensor(x[2],y[2])")
+                                       .add({{"x",0},{"y",0}}, 1.0)
+                                       .add({{"x",0},{"y",1}}, 2.0)
+                                       .add({{"x",1},{"y",0}}, 3.0)
+                                       .add({{"x",1},{"y",1}}, 4.0)));
+    EXPECT_EQUAL(calculate_expression(xw_product_expr, params), 17.0);
+}
+
+TEST("SMOKETEST - require that dense matrix multiply benchmark expression produces expected result") {
+    Params params;
+    params.add("lhs",      make_tensor(TensorSpec("tensor(x[2],y[2])")
+                                       .add({{"x",0},{"y",0}}, 1.0)
+                                       .add({{"x",0},{"y",1}}, 2.0)
+                                       .add({{"x",1},{"y",0}}, 3.0)
+                                       .add({{"x",1},{"y",1}}, 4.0)));
+    params.add("rhs",      make_tensor(TensorSpec("tensor(y[2],z[2])")
+                                       .add({{"y",0},{"z",0}}, 1.0)
+                                       .add({{"y",0},{"z",1}}, 0.0)
+                                       .add({{"y",1},{"z",0}}, 0.0)
+                                       .add({{"y",1},{"z",1}}, 2.0)));
+    EXPECT_EQUAL(calculate_expression(matrix_multiply_expr, params), 16.0);
+}
+
 //-----------------------------------------------------------------------------
 
 struct DummyBuilder : TensorBuilder {
@@ -373,6 +403,30 @@ TEST("benchmark matrix product") {
     }
 }
 
+TEST("benchmark xw product") {
+    for (size_t vector_size: {10, 25, 50, 100, 250}) {
+        for (auto type: {DENSE}) {
+            Params params;
+            params.add("query",    make_tensor(type, {DimensionSpec("x", vector_size)}));
+            params.add("model",    make_tensor(type, {DimensionSpec("x", vector_size), DimensionSpec("y", vector_size)}));
+            double time_us = benchmark_expression_us(xw_product_expr, params);
+            fprintf(stderr, "-- xw product (%s) %zu vs %zux%zu: %g us\n", name(type), vector_size, vector_size, vector_size, time_us);
+        }
+    }
+}
+
+TEST("benchmark matrix multiply") {
+    for (size_t matrix_size: {10, 25, 50, 100}) {
+        for (auto type: {DENSE}) {
+            Params params;
+            params.add("lhs",      make_tensor(type, {DimensionSpec("x", matrix_size), DimensionSpec("y", matrix_size)}));
+            params.add("rhs",      make_tensor(type, {DimensionSpec("y", matrix_size), DimensionSpec("z", matrix_size)}));
+            double time_us = benchmark_expression_us(matrix_multiply_expr, params);
+            fprintf(stderr, "-- matrix multiply (%s) %zux%zu vs %zux%zu: %g us\n", name(type), matrix_size, matrix_size, matrix_size, matrix_size, time_us);
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,6 +2,7 @@
 
 #include "gbdt.h"
 #include "vm_forest.h"
+#include "quick_scorer_forest.h"
 #include "node_traverser.h"
 #include <vespa/eval/eval/basic_nodes.h>
 #include <vespa/eval/eval/call_nodes.h>
@@ -143,6 +144,10 @@ Optimize::select_best(const ForestStats &stats,
 {
     double path_len = stats.total_average_path_length;
     if ((stats.tree_sizes.back().size > 12) && (path_len > 2500.0)) {
+        Result result = apply_chain(QuickScorerForest::optimize_chain, stats, trees);
+        if (result.valid()) {
+            return result;
+        }
         return apply_chain(VMForest::optimize_chain, stats, trees);
     }
     return Optimize::Result();
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "compile_cache.h"
+#include "disk_object_cache.h"
 #include <vespa/eval/eval/key_gen.h>
 #include <thread>
 
@@ -9,6 +10,7 @@ namespace eval {
 
 std::mutex CompileCache::_lock;
 CompileCache::Map CompileCache::_cached;
+size_t CompileCache::_disk_hits = 0;
 
 void
 CompileCache::release(Map::iterator entry)
@@ -47,6 +49,19 @@ CompileCache::count_refs()
     return refs;
 }
 
+size_t
+CompileCache::num_disk_hits()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _disk_hits;
+}
+
+void
+CompileCache::set_persistent_dir(const vespalib::string &dir)
+{
+    DiskObjectCache::set_dir(dir);
+}
+
 void
 CompileCache::do_compile(CompileContext &ctx) {
     vespalib::string key = gen_key(ctx.function, ctx.pass_params);
@@ -57,6 +72,9 @@ CompileCache::do_compile(CompileContext &ctx) {
     } else {
         auto res = _cached.emplace(std::move(key), Value(CompiledFunction(ctx.function, ctx.pass_params)));
         assert(res.second);
+        if (res.first->second.cf.loaded_from_disk()) {
+            ++_disk_hits;
+        }
         ctx.token.reset(new Token(res.first));
     }
 }
@@ -15,6 +15,10 @@ namespace eval {
  * to query the cache. The cache itself will not keep anything alive,
  * but will let you find compiled functions that are currently in use
  * by others.
+ *
+ * When a persistent directory is set, generated machine code is also
+ * stored on disk and loaded from there by later compilations of the
+ * same code, also across process restarts (see DiskObjectCache).
  **/
 class CompileCache
 {
@@ -28,6 +32,7 @@ private:
     typedef std::map<Key,Value> Map;
     static std::mutex _lock;
     static Map _cached;
+    static size_t _disk_hits;
 
     static void release(Map::iterator entry);
 
@@ -47,6 +52,8 @@ public:
     static Token::UP compile(const Function &function, PassParams pass_params);
     static size_t num_cached();
     static size_t count_refs();
+    static size_t num_disk_hits();
+    static void set_persistent_dir(const vespalib::string &dir);
 
 private:
     struct CompileContext {
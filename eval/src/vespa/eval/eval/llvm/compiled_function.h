@@ -44,6 +44,7 @@ public:
     CompiledFunction(CompiledFunction &&rhs);
     size_t num_params() const { return _num_params; }
     PassParams pass_params() const { return _pass_params; }
+    bool loaded_from_disk() const { return _llvm_wrapper.loaded_from_disk(); }
     template <size_t NUM_PARAMS>
     typename expand<NUM_PARAMS>::type get_function() const {
         assert(_pass_params == PassParams::SEPARATE);
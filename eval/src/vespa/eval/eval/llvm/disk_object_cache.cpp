@@ -0,0 +1,245 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "disk_object_cache.h"
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/sha1.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/xxhash/xxhash.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.eval.llvm.disk_object_cache");
+
+namespace vespalib {
+namespace eval {
+
+void
+DiskObjectCache::Header::init(const char *obj, size_t obj_size)
+{
+    memset(this, 0, sizeof(Header));
+    memcpy(magic, MAGIC, sizeof(magic));
+    strncpy(llvm_version, LLVM_VERSION_STRING, sizeof(llvm_version) - 1);
+    length = obj_size;
+    checksum = XXH64(obj, obj_size, 0);
+}
+
+bool
+DiskObjectCache::Header::is_valid_for(const char *obj, size_t obj_size) const
+{
+    Header expect;
+    expect.init(obj, obj_size);
+    return ((memcmp(magic, expect.magic, sizeof(magic)) == 0) &&
+            (memcmp(llvm_version, expect.llvm_version, sizeof(llvm_version)) == 0) &&
+            (length == expect.length) && (checksum == expect.checksum));
+}
+
+std::mutex DiskObjectCache::_lock;
+vespalib::string DiskObjectCache::_dir;
+size_t DiskObjectCache::_num_hits = 0;
+size_t DiskObjectCache::_num_stored = 0;
+
+namespace {
+
+vespalib::string host_cpu_key() {
+    vespalib::string key;
+    key.append("triple:").append(llvm::sys::getProcessTriple()).append("\n");
+    key.append("cpu:").append(llvm::sys::getHostCPUName().str()).append("\n");
+    llvm::StringMap<bool> features;
+    std::map<std::string, bool> sorted_features;
+    if (llvm::sys::getHostCPUFeatures(features)) {
+        for (const auto &feature: features) {
+            sorted_features[feature.getKey().str()] = feature.getValue();
+        }
+    }
+    key.append("features:");
+    for (const auto &feature: sorted_features) {
+        key.append(feature.second ? "+" : "-").append(feature.first).append(",");
+    }
+    key.append("\n");
+    return key;
+}
+
+bool write_all(int fd, const void *buf, size_t len) {
+    const char *pos = static_cast<const char *>(buf);
+    while (len > 0) {
+        ssize_t written = ::write(fd, pos, len);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        pos += written;
+        len -= written;
+    }
+    return true;
+}
+
+bool sync_dir(const vespalib::string &dir) {
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = (fsync(fd) == 0);
+    return (close(fd) == 0) && ok;
+}
+
+vespalib::string to_hex(const char *data, size_t size) {
+    vespalib::string hex;
+    for (size_t i = 0; i < size; ++i) {
+        hex.append(make_string("%02x", (unsigned char)data[i]));
+    }
+    return hex;
+}
+
+} // namespace vespalib::eval::<unnamed>
+
+void
+DiskObjectCache::set_dir(const vespalib::string &dir)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _dir = dir;
+}
+
+vespalib::string
+DiskObjectCache::get_dir()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _dir;
+}
+
+size_t
+DiskObjectCache::num_hits()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _num_hits;
+}
+
+size_t
+DiskObjectCache::num_stored()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _num_stored;
+}
+
+vespalib::string
+DiskObjectCache::make_key(const llvm::Module &module)
+{
+    static const vespalib::string cpu_key = host_cpu_key();
+    std::string ir;
+    llvm::raw_string_ostream ir_stream(ir);
+    module.print(ir_stream, nullptr);
+    ir_stream.flush();
+    vespalib::string key;
+    key.append("llvm:").append(LLVM_VERSION_STRING).append("\n");
+    key.append(cpu_key);
+    key.append(ir);
+    char digest[20];
+    Sha1::hash(key.data(), key.size(), digest, sizeof(digest));
+    return to_hex(digest, sizeof(digest));
+}
+
+DiskObjectCache::DiskObjectCache(const llvm::Module &module)
+    : _file_name(),
+      _hit(false)
+{
+    vespalib::string dir = get_dir();
+    if (!dir.empty()) {
+        _file_name = dir + "/" + make_key(module) + ".o";
+    }
+}
+
+DiskObjectCache::~DiskObjectCache() = default;
+
+void
+DiskObjectCache::notifyObjectCompiled(const llvm::Module *, llvm::MemoryBufferRef obj)
+{
+    if (_file_name.empty()) {
+        return;
+    }
+    Header header;
+    header.init(obj.getBufferStart(), obj.getBufferSize());
+    vespalib::string tmp_name = _file_name + ".XXXXXX";
+    int fd = mkstemp(&tmp_name[0]);
+    if (fd < 0) {
+        LOG(warning, "Could not create temporary file for '%s': %s", _file_name.c_str(), getLastErrorString().c_str());
+        return;
+    }
+    bool ok = (write_all(fd, &header, sizeof(header)) &&
+               write_all(fd, obj.getBufferStart(), obj.getBufferSize()) &&
+               (fsync(fd) == 0));
+    ok = (close(fd) == 0) && ok;
+    // the file contents must be durable before the file becomes visible
+    // under its final name, and the rename itself must be durable too
+    ok = ok && (::rename(tmp_name.c_str(), _file_name.c_str()) == 0) && sync_dir(dirname(_file_name));
+    if (!ok) {
+        LOG(warning, "Could not store compiled code in '%s': %s", _file_name.c_str(), getLastErrorString().c_str());
+        ::unlink(tmp_name.c_str());
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    ++_num_stored;
+}
+
+std::unique_ptr<llvm::MemoryBuffer>
+DiskObjectCache::getObject(const llvm::Module *)
+{
+    if (_file_name.empty()) {
+        return std::unique_ptr<llvm::MemoryBuffer>();
+    }
+    int fd = ::open(_file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (errno != ENOENT) {
+            LOG(warning, "Could not open compiled code in '%s': %s", _file_name.c_str(), getLastErrorString().c_str());
+        }
+        return std::unique_ptr<llvm::MemoryBuffer>();
+    }
+    Header header;
+    struct stat st;
+    bool complete = ((::pread(fd, &header, sizeof(Header), 0) == ssize_t(sizeof(Header))) &&
+                     (fstat(fd, &st) == 0) &&
+                     (uint64_t(st.st_size) == (sizeof(Header) + header.length)));
+    std::unique_ptr<llvm::MemoryBuffer> obj;
+    if (complete) {
+        // skip the header; LLVM maps the object code from the file unless it is small
+        static_assert((sizeof(Header) % 8) == 0, "object code must be aligned after the header");
+        auto buffer = llvm::MemoryBuffer::getOpenFileSlice(fd, _file_name, header.length, sizeof(Header));
+        if (!buffer) {
+            LOG(warning, "Could not load compiled code from '%s': %s",
+                _file_name.c_str(), buffer.getError().message().c_str());
+            close(fd);
+            return std::unique_ptr<llvm::MemoryBuffer>();
+        }
+        obj = std::move(buffer.get());
+    }
+    close(fd);
+    if (!obj || !header.is_valid_for(obj->getBufferStart(), obj->getBufferSize())) {
+        // truncated, corrupted or written by another LLVM version; remove
+        // it to have the code generated and stored again
+        LOG(warning, "Removing invalid compiled code in '%s'", _file_name.c_str());
+        ::unlink(_file_name.c_str());
+        return std::unique_ptr<llvm::MemoryBuffer>();
+    }
+    _hit = true;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        ++_num_hits;
+    }
+    return obj;
+}
+
+} // namespace vespalib::eval
+} // namespace vespalib
@@ -0,0 +1,66 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <mutex>
+
+namespace vespalib {
+namespace eval {
+
+/**
+ * Persistent cache of machine code generated by LLVM. Object files
+ * are stored in a common directory, named by a hash of the module IR
+ * combined with the LLVM version and the host CPU and its features.
+ * Each file starts with a header holding the LLVM version and the
+ * length and checksum of the object code. Files are written to a
+ * unique temporary file and synced before being renamed into place.
+ * Object files found in the cache are validated against their header
+ * and the object code is mapped from the file (unless it is small)
+ * and handed to the JIT instead of generating code again; invalid
+ * files are removed, letting the code be generated and stored again.
+ * The cache is disabled until a directory has been set. Modules must
+ * refer to native state (prepared GBDT forests, set membership
+ * plugins) by symbol name rather than by address, since addresses
+ * are only valid in the current process.
+ **/
+class DiskObjectCache : public llvm::ObjectCache
+{
+private:
+    struct Header {
+        static constexpr const char *MAGIC = "VEVALOBJ";
+        char     magic[8];
+        char     llvm_version[32];
+        uint64_t length;
+        uint64_t checksum;
+        void init(const char *obj, size_t obj_size);
+        bool is_valid_for(const char *obj, size_t obj_size) const;
+    };
+
+    static std::mutex       _lock;
+    static vespalib::string _dir;
+    static size_t           _num_hits;
+    static size_t           _num_stored;
+
+    vespalib::string _file_name;
+    bool             _hit;
+
+public:
+    static void set_dir(const vespalib::string &dir);
+    static vespalib::string get_dir();
+    static bool is_enabled() { return !get_dir().empty(); }
+    static size_t num_hits();
+    static size_t num_stored();
+    static vespalib::string make_key(const llvm::Module &module);
+
+    explicit DiskObjectCache(const llvm::Module &module);
+    ~DiskObjectCache();
+    const vespalib::string &file_name() const { return _file_name; }
+    bool hit() const { return _hit; }
+    void notifyObjectCompiled(const llvm::Module *module, llvm::MemoryBufferRef obj) override;
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *module) override;
+};
+
+} // namespace vespalib::eval
+} // namespace vespalib
@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include "llvm_wrapper.h"
+#include "disk_object_cache.h"
 #include <vespa/eval/eval/node_visitor.h>
 #include <vespa/eval/eval/node_traverser.h>
 #include <llvm/IR/Verifier.h>
@@ -83,6 +84,7 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
     const gbdt::Optimize::Chain &forest_optimizers;
     std::vector<gbdt::Forest::UP> &forests;
     std::vector<PluginState::UP> &plugin_state;
+    NativeSymbols &native_symbols;
 
     llvm::PointerType *make_eval_forest_funptr_t() {
         std::vector<llvm::Type*> param_types;
@@ -126,7 +128,8 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
                     PassParams pass_params_in,
                     const gbdt::Optimize::Chain &forest_optimizers_in,
                     std::vector<gbdt::Forest::UP> &forests_out,
-                    std::vector<PluginState::UP> &plugin_state_out)
+                    std::vector<PluginState::UP> &plugin_state_out,
+                    NativeSymbols &native_symbols_out)
         : context(context_in),
           module(module_in),
           builder(context),
@@ -140,7 +143,8 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
           forest_end(nullptr),
           forest_optimizers(forest_optimizers_in),
           forests(forests_out),
-          plugin_state(plugin_state_out)
+          plugin_state(plugin_state_out),
+          native_symbols(native_symbols_out)
     {
         std::vector<llvm::Type*> param_types;
         if (pass_params == PassParams::SEPARATE) {
@@ -216,6 +220,29 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
 
     //-------------------------------------------------------------------------
 
+    // Native functions and state are referred to by external symbols
+    // that are bound to their addresses when the module is compiled.
+    // This keeps process local addresses out of the generated code.
+
+    llvm::Function *inject_function(const vespalib::string &name, llvm::PointerType *funptr_t, void *address) {
+        llvm::Function *fun = module.getFunction(name.c_str());
+        if (fun == nullptr) {
+            llvm::FunctionType *function_type = llvm::cast<llvm::FunctionType>(funptr_t->getElementType());
+            fun = llvm::Function::Create(function_type, llvm::Function::ExternalLinkage, name.c_str(), &module);
+            native_symbols.emplace_back(fun, address);
+        }
+        return fun;
+    }
+
+    llvm::Value *inject_ctx(const vespalib::string &name, const void *address) {
+        llvm::GlobalVariable *ctx = new llvm::GlobalVariable(module, builder.getInt8Ty(), true,
+                                                             llvm::GlobalValue::ExternalLinkage, nullptr, name.c_str());
+        native_symbols.emplace_back(ctx, const_cast<void *>(address));
+        return builder.CreateBitCast(ctx, builder.getVoidTy()->getPointerTo(), "inject_ctx");
+    }
+
+    //-------------------------------------------------------------------------
+
     bool try_optimize_forest(const Node &item) {
         auto trees = gbdt::extract_trees(item);
         gbdt::ForestStats stats(trees);
@@ -223,18 +250,19 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
         if (!optimize_result.valid()) {
             return false;
         }
+        size_t forest_id = forests.size();
         forests.push_back(std::move(optimize_result.forest));
         void *eval_ptr = (void *) optimize_result.eval;
         gbdt::Forest *forest = forests.back().get();
-        llvm::PointerType *eval_funptr_t = make_eval_forest_funptr_t();
-        llvm::Value *eval_fun = builder.CreateIntToPtr(builder.getInt64((uint64_t)eval_ptr), eval_funptr_t, "inject_eval");
-        llvm::Value *ctx = builder.CreateIntToPtr(builder.getInt64((uint64_t)forest), builder.getVoidTy()->getPointerTo(), "inject_ctx");
+        llvm::Function *eval_fun = inject_function(vespalib::make_string("vespalib_eval_forest_eval_%zu", forest_id),
+                                                   make_eval_forest_funptr_t(), eval_ptr);
+        llvm::Value *ctx = inject_ctx(vespalib::make_string("vespalib_eval_forest_%zu", forest_id), forest);
         if (pass_params == PassParams::ARRAY) {
-	    push(builder.CreateCall(eval_fun, {ctx, params[0]}, "call_eval"));
+            push(builder.CreateCall(eval_fun, {ctx, params[0]}, "call_eval"));
         } else {
             assert(pass_params == PassParams::LAZY);
-            llvm::PointerType *proxy_funptr_t = make_eval_forest_proxy_funptr_t();
-            llvm::Value *proxy_fun = builder.CreateIntToPtr(builder.getInt64((uint64_t)vespalib_eval_forest_proxy), proxy_funptr_t, "inject_eval_proxy");
+            llvm::Function *proxy_fun = inject_function("vespalib_eval_forest_proxy", make_eval_forest_proxy_funptr_t(),
+                                                        (void *) vespalib_eval_forest_proxy);
             push(builder.CreateCall(proxy_fun, {eval_fun, ctx, params[0], params[1], builder.getInt64(stats.num_params)}));
         }
         return true;
@@ -506,12 +534,13 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
         if (array) {
             if (array->is_const() && array->size() > 8) {
                 // build call to hash lookup
+                size_t state_id = plugin_state.size();
                 plugin_state.emplace_back(new SetMemberHash(*array));
                 void *call_ptr = (void *) SetMemberHash::check_membership;
                 PluginState *state = plugin_state.back().get();
-                llvm::PointerType *funptr_t = make_check_membership_funptr_t();
-                llvm::Value *call_fun = builder.CreateIntToPtr(builder.getInt64((uint64_t)call_ptr), funptr_t, "inject_call_addr");
-                llvm::Value *ctx = builder.CreateIntToPtr(builder.getInt64((uint64_t)state), builder.getVoidTy()->getPointerTo(), "inject_ctx");
+                llvm::Function *call_fun = inject_function("vespalib_eval_check_membership",
+                                                           make_check_membership_funptr_t(), call_ptr);
+                llvm::Value *ctx = inject_ctx(vespalib::make_string("vespalib_eval_plugin_state_%zu", state_id), state);
                 push(builder.CreateCall(call_fun, {ctx, lhs}, "call_check_membership"));
             } else {
                 // build explicit code to check all set members
@@ -649,7 +678,9 @@ LLVMWrapper::LLVMWrapper()
       _engine(),
       _functions(),
       _forests(),
-      _plugin_state()
+      _plugin_state(),
+      _native_symbols(),
+      _loaded_from_disk(false)
 {
     std::lock_guard<std::recursive_mutex> guard(_global_llvm_lock);
     _context = std::make_unique<llvm::LLVMContext>();
@@ -666,7 +697,7 @@ LLVMWrapper::make_function(size_t num_params, PassParams pass_params, const Node
     FunctionBuilder builder(*_context, *_module,
                             vespalib::make_string("f%zu", function_id),
                             num_params, pass_params,
-                            forest_optimizers, _forests, _plugin_state);
+                            forest_optimizers, _forests, _plugin_state, _native_symbols);
     builder.build_root(root);
     _functions.push_back(builder.build());
     return function_id;
@@ -680,7 +711,7 @@ LLVMWrapper::make_forest_fragment(size_t num_params, const std::vector<const Nod
     FunctionBuilder builder(*_context, *_module,
                             vespalib::make_string("f%zu", function_id),
                             num_params, PassParams::ARRAY,
-                            gbdt::Optimize::none, _forests, _plugin_state);
+                            gbdt::Optimize::none, _forests, _plugin_state, _native_symbols);
     builder.build_forest_fragment(fragment);
     _functions.push_back(builder.build());
     return function_id;
@@ -693,9 +724,25 @@ LLVMWrapper::compile(bool dump_module)
     if (dump_module) {
         _module->dump();
     }
+    // native state is only referred to by symbol name, so the
+    // generated code is the same in all processes and can be persisted
+    std::unique_ptr<DiskObjectCache> object_cache;
+    if (DiskObjectCache::is_enabled()) {
+        object_cache = std::make_unique<DiskObjectCache>(*_module);
+    }
     _engine.reset(llvm::EngineBuilder(std::move(_module)).setOptLevel(llvm::CodeGenOpt::Aggressive).create());
     assert(_engine && "llvm jit not available for your platform");
+    for (const auto &symbol: _native_symbols) {
+        _engine->addGlobalMapping(symbol.first, symbol.second);
+    }
+    if (object_cache) {
+        _engine->setObjectCache(object_cache.get());
+    }
     _engine->finalizeObject();
+    if (object_cache) {
+        _engine->setObjectCache(nullptr);
+        _loaded_from_disk = object_cache->hit();
+    }
 }
 
 void *
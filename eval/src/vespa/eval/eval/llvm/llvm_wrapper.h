@@ -35,6 +35,12 @@ struct PluginState {
     virtual ~PluginState() {}
 };
 
+/**
+ * Native functions and state referred to by generated code, bound by
+ * symbol when the code is compiled.
+ **/
+using NativeSymbols = std::vector<std::pair<const llvm::GlobalValue *, void *>>;
+
 /**
  * Stuff related to LLVM code generation is wrapped in this
  * class. This is mostly used by the CompiledFunction class.
@@ -48,6 +54,8 @@ private:
     std::vector<llvm::Function*>           _functions;
     std::vector<gbdt::Forest::UP>          _forests;
     std::vector<PluginState::UP>           _plugin_state;
+    NativeSymbols                          _native_symbols;
+    bool                                   _loaded_from_disk;
 
     static std::recursive_mutex _global_llvm_lock;
 
@@ -60,6 +68,7 @@ public:
     size_t make_forest_fragment(size_t num_params, const std::vector<const nodes::Node *> &fragment);
     const std::vector<gbdt::Forest::UP> &get_forests() const { return _forests; }
     void compile(bool dump_module = false);
+    bool loaded_from_disk() const { return _loaded_from_disk; }
     void *get_function_address(size_t function_id);
     ~LLVMWrapper();
 };
@@ -0,0 +1,152 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quick_scorer_forest.h"
+#include <vespa/eval/eval/basic_nodes.h>
+#include <vespa/eval/eval/call_nodes.h>
+#include <vespa/eval/eval/operator_nodes.h>
+#include <algorithm>
+#include <cassert>
+
+namespace vespalib {
+namespace eval {
+namespace gbdt {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+
+constexpr size_t MAX_LEAVES = 64;
+constexpr size_t STACK_TREES = 1024;
+
+struct Check {
+    uint32_t feature;
+    double   threshold;
+    uint32_t tree_id;
+    uint64_t mask;
+    bool operator<(const Check &rhs) const {
+        if (feature != rhs.feature) {
+            return (feature < rhs.feature);
+        }
+        return (threshold < rhs.threshold);
+    }
+};
+
+uint64_t leaf_mask(size_t first_leaf, size_t num_leaves) {
+    assert(num_leaves < MAX_LEAVES);
+    return (((uint64_t(1) << num_leaves) - 1) << first_leaf);
+}
+
+// returns the number of leaves in the given (sub-)tree
+size_t encode_node(const nodes::Node &node, uint32_t tree_id, size_t first_leaf,
+                   std::vector<Check> &checks, std::vector<double> &leaves)
+{
+    auto if_node = nodes::as<nodes::If>(node);
+    if (if_node) {
+        auto less = nodes::as<nodes::Less>(if_node->cond());
+        assert(less);
+        auto symbol = nodes::as<nodes::Symbol>(less->lhs());
+        assert(symbol && (symbol->id() >= 0));
+        assert(less->rhs().is_const());
+        size_t check_idx = checks.size();
+        checks.push_back(Check{uint32_t(symbol->id()), less->rhs().get_const_value(), tree_id, 0});
+        size_t true_leaves = encode_node(if_node->true_expr(), tree_id, first_leaf, checks, leaves);
+        size_t false_leaves = encode_node(if_node->false_expr(), tree_id, first_leaf + true_leaves, checks, leaves);
+        checks[check_idx].mask = ~leaf_mask(first_leaf, true_leaves);
+        return (true_leaves + false_leaves);
+    } else {
+        assert(node.is_const());
+        leaves.push_back(node.get_const_value());
+        return 1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+} // namespace vespalib::eval::gbdt::<unnamed>
+
+//-----------------------------------------------------------------------------
+
+QuickScorerForest::QuickScorerForest(const ForestStats &stats, const std::vector<const nodes::Node *> &trees)
+    : _feature_offsets(),
+      _thresholds(),
+      _tree_ids(),
+      _masks(),
+      _leaf_offsets(),
+      _leaves()
+{
+    std::vector<Check> checks;
+    checks.reserve(stats.total_less_checks);
+    _leaves.reserve(stats.total_size);
+    for (const nodes::Node *tree: trees) {
+        _leaf_offsets.push_back(_leaves.size());
+        encode_node(*tree, _leaf_offsets.size() - 1, 0, checks, _leaves);
+    }
+    std::stable_sort(checks.begin(), checks.end());
+    _thresholds.reserve(checks.size());
+    _tree_ids.reserve(checks.size());
+    _masks.reserve(checks.size());
+    _feature_offsets.assign(stats.num_params + 1, 0);
+    for (const Check &check: checks) {
+        ++_feature_offsets[check.feature + 1];
+        _thresholds.push_back(check.threshold);
+        _tree_ids.push_back(check.tree_id);
+        _masks.push_back(check.mask);
+    }
+    for (size_t i = 1; i < _feature_offsets.size(); ++i) {
+        _feature_offsets[i] += _feature_offsets[i - 1];
+    }
+}
+
+Optimize::Result
+QuickScorerForest::optimize(const ForestStats &stats,
+                            const std::vector<const nodes::Node *> &trees)
+{
+    if ((stats.total_in_checks > 0) || (stats.tree_sizes.back().size > MAX_LEAVES)) {
+        return Optimize::Result();
+    }
+    return Optimize::Result(Forest::UP(new QuickScorerForest(stats, trees)), eval);
+}
+
+double
+QuickScorerForest::eval_using(const double *input, uint64_t *bits) const
+{
+    size_t num_features = _feature_offsets.size() - 1;
+    std::fill(bits, bits + num_trees(), ~uint64_t(0));
+    const double *thresholds = _thresholds.data();
+    const uint32_t *tree_ids = _tree_ids.data();
+    const uint64_t *masks = _masks.data();
+    for (size_t feature = 0; feature < num_features; ++feature) {
+        double value = input[feature];
+        size_t end = _feature_offsets[feature + 1];
+        // checks are sorted by threshold, so the false ones form a
+        // prefix (NaN values make all checks false)
+        for (size_t i = _feature_offsets[feature]; (i < end) && !(value < thresholds[i]); ++i) {
+            bits[tree_ids[i]] &= masks[i];
+        }
+    }
+    double sum = 0.0;
+    for (size_t tree = 0; tree < num_trees(); ++tree) {
+        sum += _leaves[_leaf_offsets[tree] + __builtin_ctzll(bits[tree])];
+    }
+    return sum;
+}
+
+double
+QuickScorerForest::eval(const Forest *forest, const double *input)
+{
+    const QuickScorerForest &self = *((const QuickScorerForest *)forest);
+    if (self.num_trees() <= STACK_TREES) {
+        uint64_t bits[STACK_TREES];
+        return self.eval_using(input, bits);
+    }
+    std::vector<uint64_t> bits(self.num_trees());
+    return self.eval_using(input, &bits[0]);
+}
+
+Optimize::Chain QuickScorerForest::optimize_chain({optimize});
+
+//-----------------------------------------------------------------------------
+
+} // namespace vespalib::eval::gbdt
+} // namespace vespalib::eval
+} // namespace vespalib
@@ -0,0 +1,45 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "gbdt.h"
+#include <cstdint>
+
+namespace vespalib {
+namespace eval {
+namespace gbdt {
+
+/**
+ * GBDT forest optimizer using the QuickScorer evaluation strategy.
+ * Each tree has a bit vector with one bit per leaf. The checks of
+ * all trees are grouped by feature and sorted by threshold, so that
+ * for each feature the checks that evaluate to false form a prefix
+ * that can be scanned without branching on tree structure. Each false
+ * check clears the bits of the leaves in its true sub-tree, and the
+ * exit leaf of a tree is its lowest bit still set. Only forests with
+ * less checks and at most 64 leaves per tree are supported.
+ **/
+class QuickScorerForest : public Forest
+{
+private:
+    std::vector<uint32_t> _feature_offsets; // per feature: first check
+    std::vector<double>   _thresholds;      // per check: sorted per feature
+    std::vector<uint32_t> _tree_ids;        // per check: owning tree
+    std::vector<uint64_t> _masks;           // per check: leaves kept if false
+    std::vector<uint32_t> _leaf_offsets;    // per tree: first leaf value
+    std::vector<double>   _leaves;          // leaf values for all trees
+
+    double eval_using(const double *input, uint64_t *bits) const;
+
+public:
+    QuickScorerForest(const ForestStats &stats, const std::vector<const nodes::Node *> &trees);
+    size_t num_trees() const { return _leaf_offsets.size(); }
+    static Optimize::Result optimize(const ForestStats &stats,
+                                     const std::vector<const nodes::Node *> &trees);
+    static double eval(const Forest *forest, const double *input);
+    static Optimize::Chain optimize_chain;
+};
+
+} // namespace vespalib::eval::gbdt
+} // namespace vespalib::eval
+} // namespace vespalib
@@ -99,6 +99,14 @@ struct Renamer {
     bool matched_all() const { return (match_cnt == from.size()); }
 };
 
+// Result of an operation on tensors, which is calculated in double precision
+ValueType with_double_cells(const ValueType &type) {
+    if (type.is_tensor() && (type.cell_type() != ValueType::CellType::DOUBLE)) {
+        return ValueType::tensor_type(type.dimensions());
+    }
+    return type;
+}
+
 } // namespace vespalib::tensor::<unnamed>
 
 constexpr size_t ValueType::Dimension::npos;
@@ -199,13 +207,26 @@ ValueType::rename(const std::vector<vespalib::string> &from,
 }
 
 ValueType
-ValueType::tensor_type(std::vector<Dimension> dimensions_in)
+ValueType::tensor_type(std::vector<Dimension> dimensions_in, CellType cell_type_in)
 {
     sort_dimensions(dimensions_in);
     if (has_duplicates(dimensions_in)) {
         return error_type();
     }
-    return ValueType(Type::TENSOR, std::move(dimensions_in));
+    return ValueType(Type::TENSOR, cell_type_in, std::move(dimensions_in));
+}
+
+size_t
+ValueType::cell_size(CellType cell_type_in)
+{
+    switch (cell_type_in) {
+    case CellType::FLOAT:
+        return sizeof(float);
+    case CellType::INT8:
+        return sizeof(int8_t);
+    default:
+        return sizeof(double);
+    }
 }
 
 ValueType
@@ -226,9 +247,9 @@ ValueType::join(const ValueType &lhs, const ValueType &rhs)
     if (lhs.is_error() || rhs.is_error()) {
         return error_type();
     } else if (lhs.is_double()) {
-        return rhs;
+        return with_double_cells(rhs);
     } else if (rhs.is_double()) {
-        return lhs;
+        return with_double_cells(lhs);
     } else if (lhs.unknown_dimensions() || rhs.unknown_dimensions()) {
         return any_type();
     }
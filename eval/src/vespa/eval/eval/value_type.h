@@ -18,6 +18,13 @@ class ValueType
 {
 public:
     enum class Type { ANY, ERROR, DOUBLE, TENSOR };
+    /**
+     * How the cells of a tensor are stored. Lower precision cell
+     * types trade precision for memory footprint; operations on
+     * tensors are still calculated (and produce cells) in double
+     * precision.
+     **/
+    enum class CellType : char { DOUBLE, FLOAT, INT8 };
     struct Dimension {
         static constexpr size_t npos = -1;
         vespalib::string name;
@@ -37,16 +44,18 @@ public:
 
 private:
     Type _type;
+    CellType _cell_type;
     std::vector<Dimension> _dimensions;
 
     explicit ValueType(Type type_in)
-        : _type(type_in), _dimensions() {}
-    ValueType(Type type_in, std::vector<Dimension> &&dimensions_in)
-        : _type(type_in), _dimensions(std::move(dimensions_in)) {}
+        : _type(type_in), _cell_type(CellType::DOUBLE), _dimensions() {}
+    ValueType(Type type_in, CellType cell_type_in, std::vector<Dimension> &&dimensions_in)
+        : _type(type_in), _cell_type(cell_type_in), _dimensions(std::move(dimensions_in)) {}
 
 public:
     ~ValueType();
     Type type() const { return _type; }
+    CellType cell_type() const { return _cell_type; }
     bool is_any() const { return (_type == Type::ANY); }
     bool is_error() const { return (_type == Type::ERROR); }
     bool is_double() const { return (_type == Type::DOUBLE); }
@@ -67,7 +76,8 @@ public:
         return (is_any() || (is_tensor() && (dimensions().empty())));
     }
     bool operator==(const ValueType &rhs) const {
-        return ((_type == rhs._type) && (_dimensions == rhs._dimensions));
+        return ((_type == rhs._type) && (_cell_type == rhs._cell_type) &&
+                (_dimensions == rhs._dimensions));
     }
     bool operator!=(const ValueType &rhs) const { return !(*this == rhs); }
 
@@ -78,7 +88,9 @@ public:
     static ValueType any_type() { return ValueType(Type::ANY); }
     static ValueType error_type() { return ValueType(Type::ERROR); };
     static ValueType double_type() { return ValueType(Type::DOUBLE); }
-    static ValueType tensor_type(std::vector<Dimension> dimensions_in);
+    static ValueType tensor_type(std::vector<Dimension> dimensions_in,
+                                 CellType cell_type_in = CellType::DOUBLE);
+    static size_t cell_size(CellType cell_type_in);
     static ValueType from_spec(const vespalib::string &spec);
     vespalib::string to_spec() const;
     static ValueType join(const ValueType &lhs, const ValueType &rhs);
@@ -112,6 +112,24 @@ ValueType::Dimension parse_dimension(ParseContext &ctx) {
     return dimension;
 }
 
+ValueType::CellType parse_cell_type(ParseContext &ctx) {
+    ValueType::CellType cell_type = ValueType::CellType::DOUBLE;
+    ctx.skip_spaces();
+    if (ctx.get() == '<') {
+        ctx.eat('<');
+        vespalib::string cell_type_name = parse_ident(ctx);
+        if (cell_type_name == "float") {
+            cell_type = ValueType::CellType::FLOAT;
+        } else if (cell_type_name == "int8") {
+            cell_type = ValueType::CellType::INT8;
+        } else if (cell_type_name != "double") {
+            ctx.fail();
+        }
+        ctx.eat('>');
+    }
+    return cell_type;
+}
+
 std::vector<ValueType::Dimension> parse_dimension_list(ParseContext &ctx) {
     std::vector<ValueType::Dimension> list;
     ctx.skip_spaces();
@@ -145,9 +163,10 @@ parse_spec(const char *pos_in, const char *end_in, const char *&pos_out)
     } else if (type_name == "double") {
         return ValueType::double_type();
     } else if (type_name == "tensor") {
+        ValueType::CellType cell_type = parse_cell_type(ctx);
         std::vector<ValueType::Dimension> list = parse_dimension_list(ctx);
         if (!ctx.failed()) {
-            return ValueType::tensor_type(std::move(list));
+            return ValueType::tensor_type(std::move(list), cell_type);
         }
     } else {
         ctx.fail();
@@ -184,6 +203,11 @@ to_spec(const ValueType &type)
         break;
     case ValueType::Type::TENSOR:
         os << "tensor";
+        if (type.cell_type() == ValueType::CellType::FLOAT) {
+            os << "<float>";
+        } else if (type.cell_type() == ValueType::CellType::INT8) {
+            os << "<int8>";
+        }
         if (!type.dimensions().empty()) {
             os << "(";
             for (const auto &d: type.dimensions()) {            
@@ -9,7 +9,7 @@
 namespace vespalib {
 namespace tensor {
 
-using CellsRef = DenseTensorView::CellsRef;
+using CellType = TypedCells::CellType;
 
 DenseDotProductFunction::DenseDotProductFunction(size_t lhsTensorId_, size_t rhsTensorId_)
     : _lhsTensorId(lhsTensorId_),
@@ -20,12 +20,32 @@ DenseDotProductFunction::DenseDotProductFunction(size_t lhsTensorId_, size_t rhs
 
 namespace {
 
-CellsRef
-getCellsRef(const eval::Value &value)
+const TypedCells &
+getTypedCells(const eval::Value &value)
 {
     const Tensor *tensor = static_cast<const Tensor *>(value.as_tensor());
     const DenseTensorView *denseTensor = static_cast<const DenseTensorView *>(tensor);
-    return denseTensor->cellsRef();
+    return denseTensor->typedCells();
+}
+
+ConstArrayRef<float>
+getFloatCells(const TypedCells &cells, size_t numCells, Stash &stash)
+{
+    if (cells.type == CellType::FLOAT) {
+        return ConstArrayRef<float>(static_cast<const float *>(cells.data), numCells);
+    }
+    ArrayRef<float> floatCells = stash.create_array<float>(numCells);
+    convertCells(TypedCells(cells.data, cells.type, numCells), CellType::FLOAT, floatCells.begin());
+    return floatCells;
+}
+
+template <typename CT>
+double
+sameTypeDotProduct(const hwaccelrated::IAccelrated &hwAccelerator,
+                   const TypedCells &lhs, const TypedCells &rhs, size_t numCells)
+{
+    return hwAccelerator.dotProduct(static_cast<const CT *>(lhs.data),
+                                    static_cast<const CT *>(rhs.data), numCells);
 }
 
 }
@@ -33,10 +53,27 @@ getCellsRef(const eval::Value &value)
 const eval::Value &
 DenseDotProductFunction::eval(const Input &input, Stash &stash) const
 {
-    DenseTensorView::CellsRef lhsCells = getCellsRef(input.get_tensor(_lhsTensorId));
-    DenseTensorView::CellsRef rhsCells = getCellsRef(input.get_tensor(_rhsTensorId));
-    size_t numCells = std::min(lhsCells.size(), rhsCells.size());
-    double result = _hwAccelerator->dotProduct(lhsCells.cbegin(), rhsCells.cbegin(), numCells);
+    const TypedCells &lhsCells = getTypedCells(input.get_tensor(_lhsTensorId));
+    const TypedCells &rhsCells = getTypedCells(input.get_tensor(_rhsTensorId));
+    size_t numCells = std::min(lhsCells.size, rhsCells.size);
+    double result = 0.0;
+    if (lhsCells.type == rhsCells.type) {
+        switch (lhsCells.type) {
+        case CellType::FLOAT:
+            result = sameTypeDotProduct<float>(*_hwAccelerator, lhsCells, rhsCells, numCells);
+            break;
+        case CellType::INT8:
+            result = sameTypeDotProduct<int8_t>(*_hwAccelerator, lhsCells, rhsCells, numCells);
+            break;
+        default:
+            result = sameTypeDotProduct<double>(*_hwAccelerator, lhsCells, rhsCells, numCells);
+        }
+    } else {
+        // Mixed cell types are converted to float once, to use the accelerated float dot product
+        ConstArrayRef<float> lhsFloatCells = getFloatCells(lhsCells, numCells, stash);
+        ConstArrayRef<float> rhsFloatCells = getFloatCells(rhsCells, numCells, stash);
+        result = _hwAccelerator->dotProduct(lhsFloatCells.cbegin(), rhsFloatCells.cbegin(), numCells);
+    }
     return stash.create<eval::DoubleValue>(result);
 }
 
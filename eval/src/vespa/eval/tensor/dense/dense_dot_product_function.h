@@ -10,6 +10,8 @@ namespace tensor {
 
 /**
  * Tensor function for a dot product between two 1-dimensional dense tensors.
+ * Cells are multiplied in their stored cell type when both tensors
+ * use the same cell type.
  */
 class DenseDotProductFunction : public eval::TensorFunction
 {
@@ -0,0 +1,138 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_matmul_function.h"
+#include "dense_tensor.h"
+#include "dense_tensor_view.h"
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/vespalib/util/stash.h>
+
+namespace vespalib {
+namespace tensor {
+
+using CellsRef = DenseTensorView::CellsRef;
+using Cells = DenseTensor::Cells;
+
+DenseMatMulFunction::DenseMatMulFunction(const eval::ValueType &resultType,
+                                         size_t lhsTensorId_,
+                                         size_t rhsTensorId_,
+                                         const vespalib::string &commonDimension_,
+                                         size_t mapOperationId_)
+    : _resultType(resultType),
+      _lhsTensorId(lhsTensorId_),
+      _rhsTensorId(rhsTensorId_),
+      _commonDimension(commonDimension_),
+      _mapOperationId(mapOperationId_),
+      _hwAccelerator(hwaccelrated::IAccelrated::getAccelrator())
+{
+}
+
+DenseMatMulFunction::~DenseMatMulFunction() = default;
+
+namespace {
+
+const DenseTensorView &
+getDenseTensor(const eval::Value &value)
+{
+    const Tensor *tensor = static_cast<const Tensor *>(value.as_tensor());
+    return *static_cast<const DenseTensorView *>(tensor);
+}
+
+/*
+ * Describes how the cells of a matrix are laid out with respect to
+ * the common dimension and the other (outer) dimension.
+ */
+struct MatrixLayout {
+    const eval::ValueType::Dimension &outerDim;
+    size_t commonSize;
+    size_t outerStride;
+    size_t commonStride;
+    MatrixLayout(const eval::ValueType &type, const vespalib::string &commonDimension)
+        : outerDim((type.dimensions()[0].name == commonDimension) ? type.dimensions()[1] : type.dimensions()[0]),
+          commonSize((type.dimensions()[0].name == commonDimension) ? type.dimensions()[0].size : type.dimensions()[1].size),
+          outerStride((type.dimensions()[0].name == commonDimension) ? 1 : commonSize),
+          commonStride((type.dimensions()[0].name == commonDimension) ? outerDim.size : 1)
+    {
+    }
+};
+
+}
+
+const eval::Value &
+DenseMatMulFunction::eval(const Input &input, Stash &stash) const
+{
+    const DenseTensorView &lhs = getDenseTensor(input.get_tensor(_lhsTensorId));
+    const DenseTensorView &rhs = getDenseTensor(input.get_tensor(_rhsTensorId));
+    MatrixLayout lhsLayout(lhs.type(), _commonDimension);
+    MatrixLayout rhsLayout(rhs.type(), _commonDimension);
+    CellsRef lhsCells = lhs.decodeCells(stash);
+    CellsRef rhsCells = rhs.decodeCells(stash);
+    size_t lhsSize = lhsLayout.outerDim.size;
+    size_t rhsSize = rhsLayout.outerDim.size;
+    size_t numCommon = std::min(lhsLayout.commonSize, rhsLayout.commonSize);
+    // result dimensions are sorted by name
+    bool lhsIsOuter = (lhsLayout.outerDim.name < rhsLayout.outerDim.name);
+    size_t resultLhsStride = lhsIsOuter ? rhsSize : 1;
+    size_t resultRhsStride = lhsIsOuter ? 1 : lhsSize;
+    Cells cells(lhsSize * rhsSize, 0.0);
+    if ((lhsLayout.commonStride == 1) && (rhsLayout.commonStride == 1)) {
+        // each result cell is the dot product of a lhs row and a rhs row
+        for (size_t i = 0; i < lhsSize; ++i) {
+            for (size_t j = 0; j < rhsSize; ++j) {
+                cells[i * resultLhsStride + j * resultRhsStride] =
+                    _hwAccelerator->dotProduct(lhsCells.cbegin() + i * lhsLayout.outerStride,
+                                               rhsCells.cbegin() + j * rhsLayout.outerStride,
+                                               numCommon);
+            }
+        }
+    } else if ((rhsLayout.outerStride == 1) && (resultRhsStride == 1)) {
+        // accumulate scaled rhs rows into result rows
+        for (size_t i = 0; i < lhsSize; ++i) {
+            double *dst = &cells[i * resultLhsStride];
+            for (size_t k = 0; k < numCommon; ++k) {
+                double factor = lhsCells[i * lhsLayout.outerStride + k * lhsLayout.commonStride];
+                const double *src = rhsCells.cbegin() + k * rhsLayout.commonStride;
+                for (size_t j = 0; j < rhsSize; ++j) {
+                    dst[j] += factor * src[j];
+                }
+            }
+        }
+    } else if ((lhsLayout.outerStride == 1) && (resultLhsStride == 1)) {
+        // accumulate scaled lhs rows into result rows
+        for (size_t j = 0; j < rhsSize; ++j) {
+            double *dst = &cells[j * resultRhsStride];
+            for (size_t k = 0; k < numCommon; ++k) {
+                double factor = rhsCells[j * rhsLayout.outerStride + k * rhsLayout.commonStride];
+                const double *src = lhsCells.cbegin() + k * lhsLayout.commonStride;
+                for (size_t i = 0; i < lhsSize; ++i) {
+                    dst[i] += factor * src[i];
+                }
+            }
+        }
+    } else {
+        for (size_t i = 0; i < lhsSize; ++i) {
+            for (size_t j = 0; j < rhsSize; ++j) {
+                double sum = 0.0;
+                for (size_t k = 0; k < numCommon; ++k) {
+                    sum += lhsCells[i * lhsLayout.outerStride + k * lhsLayout.commonStride] *
+                           rhsCells[j * rhsLayout.outerStride + k * rhsLayout.commonStride];
+                }
+                cells[i * resultLhsStride + j * resultRhsStride] = sum;
+            }
+        }
+    }
+    if (_mapOperationId != NO_MAP_OPERATION) {
+        const eval::UnaryOperation &op = input.get_map_operation(_mapOperationId);
+        for (double &cell : cells) {
+            cell = op.eval(cell);
+        }
+    }
+    eval::ValueType type = _resultType.is_abstract()
+                           ? eval::ValueType::tensor_type({{lhsLayout.outerDim.name, lhsSize},
+                                                           {rhsLayout.outerDim.name, rhsSize}})
+                           : _resultType;
+    return stash.create<eval::TensorValue>(std::make_unique<DenseTensor>(std::move(type), std::move(cells)));
+}
+
+} // namespace tensor
+} // namespace vespalib
@@ -0,0 +1,47 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+
+namespace vespalib {
+namespace tensor {
+
+/**
+ * Tensor function for a product between two 2-dimensional dense
+ * tensors (matrices) summed over their single common dimension,
+ * i.e. a matrix multiplication.
+ *
+ * An optional map operation is applied in place on the cells of the
+ * result before it is returned.
+ */
+class DenseMatMulFunction : public eval::TensorFunction
+{
+public:
+    static constexpr size_t NO_MAP_OPERATION = -1;
+
+private:
+    eval::ValueType _resultType;
+    size_t _lhsTensorId;
+    size_t _rhsTensorId;
+    vespalib::string _commonDimension;
+    size_t _mapOperationId;
+    hwaccelrated::IAccelrated::UP _hwAccelerator;
+
+public:
+    DenseMatMulFunction(const eval::ValueType &resultType,
+                        size_t lhsTensorId_,
+                        size_t rhsTensorId_,
+                        const vespalib::string &commonDimension_,
+                        size_t mapOperationId_ = NO_MAP_OPERATION);
+    ~DenseMatMulFunction();
+    size_t lhsTensorId() const { return _lhsTensorId; }
+    size_t rhsTensorId() const { return _rhsTensorId; }
+    const vespalib::string &commonDimension() const { return _commonDimension; }
+    size_t mapOperationId() const { return _mapOperationId; }
+    const eval::Value &eval(const Input &input, Stash &stash) const override;
+};
+
+} // namespace tensor
+} // namespace vespalib
@@ -16,8 +16,12 @@ apply(const DenseTensorView &lhs, const DenseTensorView &rhs, Function &&func)
 {
     DenseTensorAddressCombiner combiner(lhs.type(), rhs.type());
     DirectDenseTensorBuilder builder(DenseTensorAddressCombiner::combineDimensions(lhs.type(), rhs.type()));
-    for (DenseTensorCellsIterator lhsItr = lhs.cellsIterator(); lhsItr.valid(); lhsItr.next()) {
-        for (DenseTensorCellsIterator rhsItr = rhs.cellsIterator(); rhsItr.valid(); rhsItr.next()) {
+    DenseTensorView::Cells lhsBuffer;
+    DenseTensorView::Cells rhsBuffer;
+    DenseTensorView::CellsRef lhsCells = lhs.decodeCells(lhsBuffer);
+    DenseTensorView::CellsRef rhsCells = rhs.decodeCells(rhsBuffer);
+    for (DenseTensorCellsIterator lhsItr(lhs.type(), lhsCells); lhsItr.valid(); lhsItr.next()) {
+        for (DenseTensorCellsIterator rhsItr(rhs.type(), rhsCells); rhsItr.valid(); rhsItr.next()) {
             bool combineSuccess = combiner.combine(lhsItr, rhsItr);
             if (combineSuccess) {
                 builder.insertCell(combiner.address(), func(lhsItr.cell(), rhsItr.cell()));
@@ -1,7 +1,9 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "dense_dot_product_function.h"
+#include "dense_matmul_function.h"
 #include "dense_tensor_function_compiler.h"
+#include "dense_xw_product_function.h"
 #include <vespa/eval/eval/operation_visitor.h>
 #include <vespa/eval/eval/operation_visitor.h>
 #include <vespa/vespalib/test/insertion_operators.h>
@@ -63,11 +65,95 @@ struct DotProductFunctionCompiler
     }
 };
 
+bool
+hasDimension(const ValueType &type, const vespalib::string &dimension)
+{
+    return (type.dimension_index(dimension) != ValueType::Dimension::npos);
+}
+
+bool
+is2dDenseTensorWith(const ValueType &type, const vespalib::string &dimension)
+{
+    return (type.is_dense() && (type.dimensions().size() == 2) && hasDimension(type, dimension));
+}
+
+bool
+isVectorForMatrix(const ValueType &vectorType, const ValueType &matrixType, const vespalib::string &dimension)
+{
+    return (is1dDenseTensor(vectorType) &&
+            (vectorType.dimensions()[0].name == dimension) &&
+            is2dDenseTensorWith(matrixType, dimension));
+}
+
+bool
+isCompatibleMatricesForMatMul(const ValueType &lhsType, const ValueType &rhsType, const vespalib::string &dimension)
+{
+    if (!is2dDenseTensorWith(lhsType, dimension) || !is2dDenseTensorWith(rhsType, dimension)) {
+        return false;
+    }
+    const auto &lhsOuter = lhsType.dimensions()[(lhsType.dimensions()[0].name == dimension) ? 1 : 0];
+    const auto &rhsOuter = rhsType.dimensions()[(rhsType.dimensions()[0].name == dimension) ? 1 : 0];
+    return (lhsOuter.name != rhsOuter.name);
+}
+
+/*
+ * Compiles products of two tensors summed over one common dimension
+ * (vector-matrix product and matrix multiplication). An enclosing map
+ * is fused into the compiled function and applied in place on its
+ * result.
+ */
+struct ProductFunctionCompiler
+{
+    static TensorFunction::UP compile(const Node &expr, size_t mapOperationId) {
+        const Reduce *reduce = as<Reduce>(expr);
+        if (!reduce || !isType<Add>(*reduce->op) || (reduce->dimensions.size() != 1)) {
+            return TensorFunction::UP();
+        }
+        const Apply *apply = as<Apply>(*reduce->tensor);
+        if (!apply || !isType<Mul>(*apply->op)) {
+            return TensorFunction::UP();
+        }
+        const Inject *lhsTensor = as<Inject>(*apply->lhs_tensor);
+        const Inject *rhsTensor = as<Inject>(*apply->rhs_tensor);
+        if (!lhsTensor || !rhsTensor) {
+            return TensorFunction::UP();
+        }
+        const vespalib::string &dimension = reduce->dimensions[0];
+        const ValueType &lhsType = lhsTensor->result_type;
+        const ValueType &rhsType = rhsTensor->result_type;
+        if (isVectorForMatrix(lhsType, rhsType, dimension)) {
+            return std::make_unique<DenseXWProductFunction>(reduce->result_type, lhsTensor->tensor_id,
+                                                            rhsTensor->tensor_id, dimension, mapOperationId);
+        }
+        if (isVectorForMatrix(rhsType, lhsType, dimension)) {
+            return std::make_unique<DenseXWProductFunction>(reduce->result_type, rhsTensor->tensor_id,
+                                                            lhsTensor->tensor_id, dimension, mapOperationId);
+        }
+        if (isCompatibleMatricesForMatMul(lhsType, rhsType, dimension)) {
+            return std::make_unique<DenseMatMulFunction>(reduce->result_type, lhsTensor->tensor_id,
+                                                         rhsTensor->tensor_id, dimension, mapOperationId);
+        }
+        return TensorFunction::UP();
+    }
+
+    static TensorFunction::UP compile(const Node &expr) {
+        const Map *map = as<Map>(expr);
+        if (map) {
+            return compile(*map->tensor, map->map_operation_id);
+        }
+        return compile(expr, DenseXWProductFunction::NO_MAP_OPERATION);
+    }
+};
+
 }
 
 TensorFunction::UP
 DenseTensorFunctionCompiler::compile(Node_UP expr)
 {
+    TensorFunction::UP product = ProductFunctionCompiler::compile(*expr);
+    if (product) {
+        return product;
+    }
     return DotProductFunctionCompiler::compile(std::move(expr));
 }
 
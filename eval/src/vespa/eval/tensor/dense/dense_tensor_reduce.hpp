@@ -95,7 +95,8 @@ DenseTensor::UP
 reduce(const DenseTensorView &tensor, const vespalib::string &dimensionToRemove, Function &&func)
 {
     DimensionReducer reducer(tensor.type(), dimensionToRemove);
-    return reducer.reduceCells(tensor.cellsRef(), func);
+    DenseTensorView::Cells buffer;
+    return reducer.reduceCells(tensor.decodeCells(buffer), func);
 }
 
 }
@@ -5,6 +5,7 @@
 #include "dense_tensor_reduce.hpp"
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/eval/tensor/tensor_address_builder.h>
 #include <vespa/eval/tensor/tensor_visitor.h>
@@ -50,12 +51,12 @@ void
 checkCellsSize(const DenseTensorView &arg)
 {
     auto cellsSize = calcCellsSize(arg.type());
-    if (arg.cellsRef().size() != cellsSize) {
+    if (arg.typedCells().size != cellsSize) {
         throw IllegalStateException(make_string("wrong cell size, "
                                                 "expected=%zu, "
                                                 "actual=%zu",
                                                 cellsSize,
-                                                arg.cellsRef().size()));
+                                                arg.typedCells().size));
     }
 }
 
@@ -63,7 +64,7 @@ void
 checkDimensions(const DenseTensorView &lhs, const DenseTensorView &rhs,
                 vespalib::stringref operation)
 {
-    if (lhs.type() != rhs.type()) {
+    if (lhs.type().dimensions() != rhs.type().dimensions()) {
         throw IllegalStateException(make_string("mismatching dimensions for "
                                                 "dense tensor %s, "
                                                 "lhs dimensions = '%s', "
@@ -88,14 +89,18 @@ Tensor::UP
 joinDenseTensors(const DenseTensorView &lhs, const DenseTensorView &rhs,
                  Function &&func)
 {
+    DenseTensorView::Cells lhsBuffer;
+    DenseTensorView::Cells rhsBuffer;
+    DenseTensorView::CellsRef lhsCells = lhs.decodeCells(lhsBuffer);
+    DenseTensorView::CellsRef rhsCells = rhs.decodeCells(rhsBuffer);
     DenseTensor::Cells cells;
-    cells.reserve(lhs.cellsRef().size());
-    auto rhsCellItr = rhs.cellsRef().cbegin();
-    for (const auto &lhsCell : lhs.cellsRef()) {
+    cells.reserve(lhsCells.size());
+    auto rhsCellItr = rhsCells.cbegin();
+    for (const auto &lhsCell : lhsCells) {
         cells.push_back(func(lhsCell, *rhsCellItr));
         ++rhsCellItr;
     }
-    assert(rhsCellItr == rhs.cellsRef().cend());
+    assert(rhsCellItr == rhsCells.cend());
     return std::make_unique<DenseTensor>(lhs.type(),
                                          std::move(cells));
 }
@@ -128,20 +133,61 @@ bool sameCells(DenseTensorView::CellsRef lhs, DenseTensorView::CellsRef rhs)
     return true;
 }
 
+template <typename T>
+double
+sumCells(ConstArrayRef<T> cells)
+{
+    double result = 0.0;
+    for (const auto &cell : cells) {
+        result += cell;
+    }
+    return result;
+}
+
 }
 
 
 DenseTensorView::DenseTensorView(const DenseTensor &rhs)
-    : _typeRef(rhs.type()),
-      _cellsRef(rhs.cellsRef())
+    : DenseTensorView(rhs.type(), rhs.cellsRef())
+{
+}
+
+DenseTensorView::DenseTensorView(const DenseTensorView &rhs)
+    : DenseTensorView(rhs._typeRef)
 {
+    initTypedCells(rhs._typedCells);
 }
 
+DenseTensorView::~DenseTensorView() = default;
+
+DenseTensorView::CellsRef
+DenseTensorView::decodeCells(Cells &buffer) const
+{
+    if (hasDoubleCells()) {
+        return _cellsRef;
+    }
+    buffer.resize(_typedCells.size);
+    convertCells(_typedCells, TypedCells::CellType::DOUBLE, buffer.data());
+    return CellsRef(buffer);
+}
+
+DenseTensorView::CellsRef
+DenseTensorView::decodeCells(Stash &stash) const
+{
+    if (hasDoubleCells()) {
+        return _cellsRef;
+    }
+    ArrayRef<double> cells = stash.create_array<double>(_typedCells.size);
+    convertCells(_typedCells, TypedCells::CellType::DOUBLE, cells.begin());
+    return cells;
+}
 
 bool
 DenseTensorView::operator==(const DenseTensorView &rhs) const
 {
-    return (_typeRef == rhs._typeRef) && sameCells(_cellsRef, rhs._cellsRef);
+    Cells lhsBuffer;
+    Cells rhsBuffer;
+    return (_typeRef == rhs._typeRef) && sameCells(decodeCells(lhsBuffer), rhs.decodeCells(rhsBuffer));
 }
 
 const eval::ValueType &
@@ -153,11 +199,14 @@ DenseTensorView::getType() const
 double
 DenseTensorView::sum() const
 {
-    double result = 0.0;
-    for (const auto &cell : _cellsRef) {
-        result += cell;
+    switch (_typedCells.type) {
+    case TypedCells::CellType::FLOAT:
+        return sumCells(_typedCells.typify<float>());
+    case TypedCells::CellType::INT8:
+        return sumCells(_typedCells.typify<int8_t>());
+    default:
+        return sumCells(_cellsRef);
     }
-    return result;
 }
 
 Tensor::UP
@@ -211,9 +260,11 @@ DenseTensorView::match(const Tensor &arg) const
 Tensor::UP
 DenseTensorView::apply(const CellFunction &func) const
 {
-    Cells newCells(_cellsRef.size());
+    Cells buffer;
+    CellsRef cells = decodeCells(buffer);
+    Cells newCells(cells.size());
     auto itr = newCells.begin();
-    for (const auto &cell : _cellsRef) {
+    for (const auto &cell : cells) {
         *itr = func.apply(cell);
         ++itr;
     }
@@ -250,8 +301,9 @@ DenseTensorView::toString() const
 Tensor::UP
 DenseTensorView::clone() const
 {
-    return std::make_unique<DenseTensor>(_typeRef,
-                                         Cells(_cellsRef.cbegin(), _cellsRef.cend()));
+    Cells buffer;
+    CellsRef cells = decodeCells(buffer);
+    return std::make_unique<DenseTensor>(_typeRef, Cells(cells.cbegin(), cells.cend()));
 }
 
 namespace {
@@ -273,7 +325,8 @@ DenseTensorView::toSpec() const
 {
     TensorSpec result(getType().to_spec());
     TensorSpec::Address address;
-    for (CellsIterator itr(_typeRef, _cellsRef); itr.valid(); itr.next()) {
+    Cells buffer;
+    for (CellsIterator itr(_typeRef, decodeCells(buffer)); itr.valid(); itr.next()) {
         buildAddress(itr, address);
         result.add(address, itr.cell());
         address.clear();
@@ -296,7 +349,8 @@ DenseTensorView::print(std::ostream &out) const
     }
     out << " ] { ";
     first = true;
-    for (const auto &cell : cellsRef()) {
+    Cells buffer;
+    for (const auto &cell : decodeCells(buffer)) {
         if (!first) {
             out << ", ";
         }
@@ -309,7 +363,8 @@ DenseTensorView::print(std::ostream &out) const
 void
 DenseTensorView::accept(TensorVisitor &visitor) const
 {
-    CellsIterator iterator(_typeRef, _cellsRef);
+    Cells buffer;
+    CellsIterator iterator(_typeRef, decodeCells(buffer));
     TensorAddressBuilder addressBuilder;
     TensorAddress address;
     vespalib::string label;
@@ -6,8 +6,13 @@
 #include <vespa/eval/tensor/types.h>
 #include <vespa/eval/eval/value_type.h>
 #include "dense_tensor_cells_iterator.h"
+#include "typed_cells.h"
+#include <cassert>
 
 namespace vespalib {
+
+class Stash;
+
 namespace tensor {
 
 class DenseTensor;
@@ -15,6 +20,11 @@ class DenseTensor;
 /**
  * A view to a dense tensor where all dimensions are indexed.
  * Tensor cells are stored in an underlying array according to the order of the dimensions.
+ *
+ * The underlying cells might be stored with lower precision than
+ * double (see typedCells()). Such cells are not converted when the view
+ * is set up. cellsRef() is only available for double cells, consumers
+ * that need doubles use decodeCells() which converts on demand.
  */
 class DenseTensorView : public Tensor
 {
@@ -25,27 +35,53 @@ public:
 
 private:
     const eval::ValueType &_typeRef;
-protected:
+    TypedCells _typedCells;
     CellsRef _cellsRef;
 
+protected:
     void initCellsRef(CellsRef cells_in) {
+        _typedCells = TypedCells(cells_in);
         _cellsRef = cells_in;
     }
+    void initTypedCells(TypedCells cells_in) {
+        _typedCells = cells_in;
+        _cellsRef = hasDoubleCells() ? cells_in.typify<double>() : CellsRef();
+    }
 
 public:
     explicit DenseTensorView(const DenseTensor &rhs);
+    DenseTensorView(const DenseTensorView &rhs);
     DenseTensorView(const eval::ValueType &type_in, CellsRef cells_in)
         : _typeRef(type_in),
+          _typedCells(cells_in),
           _cellsRef(cells_in)
     {}
+    DenseTensorView(const eval::ValueType &type_in, TypedCells cells_in)
+        : DenseTensorView(type_in)
+    {
+        initTypedCells(cells_in);
+    }
     DenseTensorView(const eval::ValueType &type_in)
             : _typeRef(type_in),
+              _typedCells(),
               _cellsRef()
     {}
+    ~DenseTensorView();
     const eval::ValueType &type() const { return _typeRef; }
-    const CellsRef &cellsRef() const { return _cellsRef; }
+    const TypedCells &typedCells() const { return _typedCells; }
+    bool hasDoubleCells() const { return _typedCells.type == TypedCells::CellType::DOUBLE; }
+    const CellsRef &cellsRef() const {
+        assert(hasDoubleCells());
+        return _cellsRef;
+    }
+    /**
+     * The cells as double. Lower precision cells are converted into the
+     * given buffer or stash, double cells are returned as they are.
+     */
+    CellsRef decodeCells(Cells &buffer) const;
+    CellsRef decodeCells(Stash &stash) const;
     bool operator==(const DenseTensorView &rhs) const;
-    CellsIterator cellsIterator() const { return CellsIterator(_typeRef, _cellsRef); }
+    CellsIterator cellsIterator() const { return CellsIterator(_typeRef, cellsRef()); }
 
     virtual const eval::ValueType &getType() const override;
     virtual double sum() const override;
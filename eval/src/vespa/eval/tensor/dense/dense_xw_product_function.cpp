@@ -0,0 +1,87 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_xw_product_function.h"
+#include "dense_tensor.h"
+#include "dense_tensor_view.h"
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/vespalib/util/stash.h>
+
+namespace vespalib {
+namespace tensor {
+
+using CellsRef = DenseTensorView::CellsRef;
+using Cells = DenseTensor::Cells;
+
+DenseXWProductFunction::DenseXWProductFunction(const eval::ValueType &resultType,
+                                               size_t vectorTensorId_,
+                                               size_t matrixTensorId_,
+                                               const vespalib::string &commonDimension_,
+                                               size_t mapOperationId_)
+    : _resultType(resultType),
+      _vectorTensorId(vectorTensorId_),
+      _matrixTensorId(matrixTensorId_),
+      _commonDimension(commonDimension_),
+      _mapOperationId(mapOperationId_),
+      _hwAccelerator(hwaccelrated::IAccelrated::getAccelrator())
+{
+}
+
+DenseXWProductFunction::~DenseXWProductFunction() = default;
+
+namespace {
+
+const DenseTensorView &
+getDenseTensor(const eval::Value &value)
+{
+    const Tensor *tensor = static_cast<const Tensor *>(value.as_tensor());
+    return *static_cast<const DenseTensorView *>(tensor);
+}
+
+}
+
+const eval::Value &
+DenseXWProductFunction::eval(const Input &input, Stash &stash) const
+{
+    const DenseTensorView &vector = getDenseTensor(input.get_tensor(_vectorTensorId));
+    const DenseTensorView &matrix = getDenseTensor(input.get_tensor(_matrixTensorId));
+    const auto &matrixDims = matrix.type().dimensions();
+    bool commonIsInner = (matrixDims[1].name == _commonDimension);
+    const eval::ValueType::Dimension &resultDim = commonIsInner ? matrixDims[0] : matrixDims[1];
+    size_t commonSize = commonIsInner ? matrixDims[1].size : matrixDims[0].size;
+    size_t resultSize = resultDim.size;
+    CellsRef vectorCells = vector.decodeCells(stash);
+    CellsRef matrixCells = matrix.decodeCells(stash);
+    size_t numCommon = std::min(vectorCells.size(), commonSize);
+    Cells cells(resultSize, 0.0);
+    if (commonIsInner) {
+        // each result cell is the dot product of the vector and a matrix row
+        for (size_t j = 0; j < resultSize; ++j) {
+            cells[j] = _hwAccelerator->dotProduct(vectorCells.cbegin(),
+                                                  matrixCells.cbegin() + j * commonSize,
+                                                  numCommon);
+        }
+    } else {
+        // accumulate scaled matrix rows, giving sequential access in both
+        for (size_t i = 0; i < numCommon; ++i) {
+            double factor = vectorCells[i];
+            const double *row = matrixCells.cbegin() + i * resultSize;
+            for (size_t j = 0; j < resultSize; ++j) {
+                cells[j] += factor * row[j];
+            }
+        }
+    }
+    if (_mapOperationId != NO_MAP_OPERATION) {
+        const eval::UnaryOperation &op = input.get_map_operation(_mapOperationId);
+        for (double &cell : cells) {
+            cell = op.eval(cell);
+        }
+    }
+    eval::ValueType type = _resultType.is_abstract()
+                           ? eval::ValueType::tensor_type({{resultDim.name, resultSize}})
+                           : _resultType;
+    return stash.create<eval::TensorValue>(std::make_unique<DenseTensor>(std::move(type), std::move(cells)));
+}
+
+} // namespace tensor
+} // namespace vespalib
@@ -0,0 +1,48 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+
+namespace vespalib {
+namespace tensor {
+
+/**
+ * Tensor function for a product between a 1-dimensional dense tensor
+ * (vector) and a 2-dimensional dense tensor (matrix), summed over
+ * their common dimension. This is the xW part of xW+b in a neural
+ * net layer.
+ *
+ * An optional map operation is applied in place on the cells of the
+ * result before it is returned.
+ */
+class DenseXWProductFunction : public eval::TensorFunction
+{
+public:
+    static constexpr size_t NO_MAP_OPERATION = -1;
+
+private:
+    eval::ValueType _resultType;
+    size_t _vectorTensorId;
+    size_t _matrixTensorId;
+    vespalib::string _commonDimension;
+    size_t _mapOperationId;
+    hwaccelrated::IAccelrated::UP _hwAccelerator;
+
+public:
+    DenseXWProductFunction(const eval::ValueType &resultType,
+                           size_t vectorTensorId_,
+                           size_t matrixTensorId_,
+                           const vespalib::string &commonDimension_,
+                           size_t mapOperationId_ = NO_MAP_OPERATION);
+    ~DenseXWProductFunction();
+    size_t vectorTensorId() const { return _vectorTensorId; }
+    size_t matrixTensorId() const { return _matrixTensorId; }
+    const vespalib::string &commonDimension() const { return _commonDimension; }
+    size_t mapOperationId() const { return _mapOperationId; }
+    const eval::Value &eval(const Input &input, Stash &stash) const override;
+};
+
+} // namespace tensor
+} // namespace vespalib
@@ -0,0 +1,85 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "typed_cells.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace vespalib {
+namespace tensor {
+
+using CellType = eval::ValueType::CellType;
+
+namespace {
+
+template <typename DstT>
+struct CellConverter {
+    template <typename SrcT>
+    static DstT convert(SrcT value) { return value; }
+};
+
+template <>
+struct CellConverter<int8_t> {
+    template <typename SrcT>
+    static int8_t convert(SrcT value) {
+        double rounded = std::nearbyint(value);
+        if (rounded <= std::numeric_limits<int8_t>::min()) {
+            return std::numeric_limits<int8_t>::min();
+        } else if (rounded >= std::numeric_limits<int8_t>::max()) {
+            return std::numeric_limits<int8_t>::max();
+        }
+        return static_cast<int8_t>(rounded);
+    }
+};
+
+template <typename SrcT, typename DstT>
+void
+convertCellsTyped(const TypedCells &cells, void *dst)
+{
+    ConstArrayRef<SrcT> src = cells.typify<SrcT>();
+    DstT *dstCells = static_cast<DstT *>(dst);
+    if (std::is_same<SrcT, DstT>::value) {
+        memcpy(dstCells, src.cbegin(), src.size() * sizeof(DstT));
+    } else {
+        for (size_t i = 0; i < src.size(); ++i) {
+            dstCells[i] = CellConverter<DstT>::convert(src[i]);
+        }
+    }
+}
+
+template <typename SrcT>
+void
+convertCellsFrom(const TypedCells &cells, CellType dstType, void *dst)
+{
+    switch (dstType) {
+    case CellType::FLOAT:
+        convertCellsTyped<SrcT, float>(cells, dst);
+        break;
+    case CellType::INT8:
+        convertCellsTyped<SrcT, int8_t>(cells, dst);
+        break;
+    default:
+        convertCellsTyped<SrcT, double>(cells, dst);
+    }
+}
+
+}
+
+void
+convertCells(const TypedCells &cells, CellType dstType, void *dst)
+{
+    switch (cells.type) {
+    case CellType::FLOAT:
+        convertCellsFrom<float>(cells, dstType, dst);
+        break;
+    case CellType::INT8:
+        convertCellsFrom<int8_t>(cells, dstType, dst);
+        break;
+    default:
+        convertCellsFrom<double>(cells, dstType, dst);
+    }
+}
+
+} // namespace vespalib::tensor
+} // namespace vespalib
@@ -0,0 +1,46 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <cstdint>
+
+namespace vespalib {
+namespace tensor {
+
+/**
+ * Reference to the cells of a dense tensor, stored as the given cell type.
+ */
+struct TypedCells {
+    using CellType = eval::ValueType::CellType;
+
+    const void *data;
+    CellType    type;
+    size_t      size;
+
+    TypedCells() : data(nullptr), type(CellType::DOUBLE), size(0) {}
+    TypedCells(const void *data_in, CellType type_in, size_t size_in)
+        : data(data_in), type(type_in), size(size_in) {}
+    TypedCells(ConstArrayRef<double> cells)
+        : data(cells.cbegin()), type(CellType::DOUBLE), size(cells.size()) {}
+    TypedCells(ConstArrayRef<float> cells)
+        : data(cells.cbegin()), type(CellType::FLOAT), size(cells.size()) {}
+    TypedCells(ConstArrayRef<int8_t> cells)
+        : data(cells.cbegin()), type(CellType::INT8), size(cells.size()) {}
+
+    template <typename T>
+    ConstArrayRef<T> typify() const {
+        return ConstArrayRef<T>(static_cast<const T *>(data), size);
+    }
+};
+
+/**
+ * Convert cells to the given cell type, writing them to dst which
+ * must have room for cells.size cells of that type. Conversion to
+ * int8 rounds to the nearest value and saturates.
+ */
+void convertCells(const TypedCells &cells, eval::ValueType::CellType dstType, void *dst);
+
+} // namespace vespalib::tensor
+} // namespace vespalib
@@ -13,6 +13,9 @@ Config::Config() :
     _enableOnlyBitVector(false),
     _isFilter(false),
     _fastAccess(false),
+    _hashDictionary(false),
+    _hugePages(false),
+    _paged(false),
     _growStrategy(),
     _compactionStrategy(),
     _predicateParams(),
@@ -32,6 +35,9 @@ Config::Config(BasicType bt,
       _enableOnlyBitVector(false),
       _isFilter(false),
       _fastAccess(false),
+      _hashDictionary(false),
+      _hugePages(false),
+      _paged(false),
       _growStrategy(),
       _compactionStrategy(),
       _predicateParams(),
@@ -43,6 +43,27 @@ public:
 
     bool getIsFilter() const { return _isFilter; }
 
+    /**
+     * Check if a hash index over the unique values should be kept in
+     * addition to the ordered dictionary, to speed up exact match
+     * lookups.
+     */
+    bool getHashDictionary() const { return _hashDictionary; }
+
+    /**
+     * Check if large memory allocations for this attribute should be
+     * backed by huge pages.
+     */
+    bool getHugePages() const { return _hugePages; }
+
+    /**
+     * Check if the saved data file of this attribute should be mapped
+     * on load, so values are paged in on demand instead of being read
+     * into memory up front. The file must not be rewritten in place
+     * while the attribute is loaded.
+     */
+    bool getPaged() const { return _paged; }
+
     /**
      * Check if this attribute should be fast accessible at all times.
      * If so, attribute is kept in memory also for non-searchable documents.
@@ -84,6 +105,9 @@ public:
     }
 
     void setFastAccess(bool v) { _fastAccess = v; }
+    void setHashDictionary(bool v) { _hashDictionary = v; }
+    void setHugePages(bool v) { _hugePages = v; }
+    void setPaged(bool v) { _paged = v; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config &setCompactionStrategy(const CompactionStrategy &compactionStrategy) { _compactionStrategy = compactionStrategy; return *this; }
     bool operator!=(const Config &b) const { return !(operator==(b)); }
@@ -99,6 +123,9 @@ public:
                _enableOnlyBitVector == b._enableOnlyBitVector &&
                _isFilter == b._isFilter &&
                _fastAccess == b._fastAccess &&
+               _hashDictionary == b._hashDictionary &&
+               _hugePages == b._hugePages &&
+               _paged == b._paged &&
                _growStrategy == b._growStrategy &&
                _compactionStrategy == b._compactionStrategy &&
                _predicateParams == b._predicateParams &&
@@ -115,6 +142,9 @@ private:
     bool           _enableOnlyBitVector;
     bool           _isFilter;
     bool           _fastAccess;
+    bool           _hashDictionary;
+    bool           _hugePages;
+    bool           _paged;
     GrowStrategy   _growStrategy;
     CompactionStrategy _compactionStrategy;
     PredicateParams    _predicateParams;
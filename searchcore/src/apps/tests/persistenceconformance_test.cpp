@@ -195,6 +195,7 @@ public:
                                const_cast<DocumentDBFactory &>(*this),
                                _summaryExecutor,
                                _summaryExecutor,
+                               _summaryExecutor,
                                _tls,
                                _metricsWireService,
                                _fileHeaderContext,
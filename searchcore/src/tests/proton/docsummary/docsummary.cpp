@@ -211,7 +211,7 @@ public:
         if (! FastOS_File::MakeDirectory((std::string("tmpdb/") + docTypeName).c_str())) { abort(); }
         _ddb.reset(new DocumentDB("tmpdb", _configMgr.getConfig(), "tcp/localhost:9013", _queryLimiter, _clock,
                                   DocTypeName(docTypeName), makeBucketSpace(),
-				  *b->getProtonConfigSP(), *this, _summaryExecutor, _summaryExecutor,
+				  *b->getProtonConfigSP(), *this, _summaryExecutor, _summaryExecutor, _summaryExecutor,
                                   _tls, _dummy, _fileHeaderContext, ConfigStore::UP(new MemoryConfigStore),
                                   std::make_shared<vespalib::ThreadStackExecutor>(16, 128 * 1024), _hwInfo)),
         _ddb->start();
@@ -159,7 +159,7 @@ MyStoreOnlyContext::MyStoreOnlyContext(IThreadingService &writeService, ThreadSt
                                        IBucketDBHandlerInitializer &bucketDBHandlerInitializer)
     : _owner(), _syncProxy(), _getSerialNum(), _fileHeader(),
       _metrics(DOCTYPE_NAME, 1), _configMutex(), _hwInfo(),
-      _ctx(_owner, _syncProxy, _getSerialNum, _fileHeader, writeService, summaryExecutor, bucketDB,
+      _ctx(_owner, _syncProxy, _getSerialNum, _fileHeader, writeService, summaryExecutor, summaryExecutor, bucketDB,
            bucketDBHandlerInitializer, _metrics, _configMutex, _hwInfo)
 {
 }
@@ -101,7 +101,7 @@ Fixture::Fixture()
     mgr.nextGeneration(0);
     _db.reset(new DocumentDB(".", mgr.getConfig(), "tcp/localhost:9014", _queryLimiter, _clock, DocTypeName("typea"),
                              makeBucketSpace(),
-                             *b->getProtonConfigSP(), _myDBOwner, _summaryExecutor, _summaryExecutor, _tls, _dummy,
+                             *b->getProtonConfigSP(), _myDBOwner, _summaryExecutor, _summaryExecutor, _summaryExecutor, _tls, _dummy,
                              _fileHeaderContext, ConfigStore::UP(new MemoryConfigStore),
                              std::make_shared<vespalib::ThreadStackExecutor>(16, 128 * 1024), _hwInfo));
     _db->start();
@@ -21,6 +21,7 @@ LOG_SETUP("feed_and_search_test");
 #include <vespa/searchlib/diskindex/fusion.h>
 #include <vespa/searchlib/common/documentsummary.h>
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 using document::DataType;
 using document::Document;
@@ -179,6 +180,7 @@ void Test::requireThatMemoryIndexCanBeDumpedAndSearched() {
     fusionInputs.push_back(index_dir);
     uint32_t fusionDocIdLimit = 0;
     typedef search::diskindex::Fusion FastS_Fusion;
+    vespalib::ThreadStackExecutor executor(2, 0x10000);
     bool fret1 = DocumentSummary::readDocIdLimit(index_dir, fusionDocIdLimit);
     ASSERT_TRUE(fret1);
     SelectorArray selector(fusionDocIdLimit, 0);
@@ -187,8 +189,10 @@ void Test::requireThatMemoryIndexCanBeDumpedAndSearched() {
                                     fusionInputs,
                                     selector,
                                     false /* dynamicKPosOccFormat */,
+                                    false /* blockPosOccFormat */,
                                      tuneFileIndexing,
-                                     fileHeaderContext);
+                                     fileHeaderContext,
+                                     executor);
     ASSERT_TRUE(fret2);
 
     // Fusion test with all docs removed in output (doesn't affect word list)
@@ -204,8 +208,10 @@ void Test::requireThatMemoryIndexCanBeDumpedAndSearched() {
                                     fusionInputs,
                                     selector2,
                                     false /* dynamicKPosOccFormat */,
+                                    false /* blockPosOccFormat */,
                                      tuneFileIndexing,
-                                     fileHeaderContext);
+                                     fileHeaderContext,
+                                     executor);
     ASSERT_TRUE(fret4);
 
     // Fusion test with all docs removed in input (affects word list)
@@ -221,8 +227,10 @@ void Test::requireThatMemoryIndexCanBeDumpedAndSearched() {
                                     fusionInputs,
                                     selector3,
                                     false /* dynamicKPosOccFormat */,
+                                    false /* blockPosOccFormat */,
                                      tuneFileIndexing,
-                                     fileHeaderContext);
+                                     fileHeaderContext,
+                                     executor);
     ASSERT_TRUE(fret6);
 
     DiskIndex disk_index(index_dir);
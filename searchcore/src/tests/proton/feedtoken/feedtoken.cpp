@@ -8,17 +8,21 @@ using namespace proton;
 class LocalTransport : public feedtoken::ITransport {
 private:
     size_t _receivedCount;
+    ResultUP _result;
 
 public:
     LocalTransport()
-        : _receivedCount(0)
+        : _receivedCount(0),
+          _result()
     { }
 
-    void send(ResultUP, bool) override {
+    void send(ResultUP result, bool) override {
         _receivedCount++;
+        _result = std::move(result);
     }
 
     size_t getReceivedCount() const { return _receivedCount; }
+    const storage::spi::Result &getResult() const { return *_result; }
 };
 
 class Test : public vespalib::TestApp {
@@ -26,6 +30,7 @@ private:
     void testAck();
     void testFail();
     void testHandover();
+    void testCommitFailure();
 
 public:
     int Main() override {
@@ -34,6 +39,7 @@ public:
         testAck();       TEST_FLUSH();
         testFail();      TEST_FLUSH();
         testHandover();  TEST_FLUSH();
+        testCommitFailure(); TEST_FLUSH();
 
         TEST_DONE();
     }
@@ -78,4 +84,19 @@ Test::testHandover()
     EXPECT_EQUAL(1u, transport.getReceivedCount());
 }
 
-
+void
+Test::testCommitFailure()
+{
+    LocalTransport transport;
+    {
+        FeedToken token = feedtoken::make(transport);
+        token->setResult(std::make_unique<storage::spi::RemoveResult>(true), true);
+        std::shared_ptr<search::IDestructorCallback> onDone = token;
+        dynamic_cast<search::transactionlog::CommitFailureListener &>(*onDone).commitFailed("disk full");
+    }
+    EXPECT_EQUAL(1u, transport.getReceivedCount());
+    EXPECT_TRUE(transport.getResult().hasError());
+    EXPECT_EQUAL(storage::spi::Result::TRANSIENT_ERROR, transport.getResult().getErrorCode());
+    EXPECT_EQUAL("disk full", transport.getResult().getErrorMessage());
+    EXPECT_TRUE(dynamic_cast<const storage::spi::RemoveResult *>(&transport.getResult()) != nullptr);
+}
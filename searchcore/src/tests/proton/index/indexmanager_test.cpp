@@ -9,6 +9,8 @@
 #include <vespa/searchcorespi/index/indexflushtarget.h>
 #include <vespa/searchcorespi/index/indexfusiontarget.h>
 #include <vespa/searchcorespi/index/index_manager_stats.h>
+#include <vespa/searchlib/diskindex/blockposocc.h>
+#include <vespa/searchlib/diskindex/fileheader.h>
 #include <vespa/searchlib/index/docbuilder.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/memoryindex/dictionary.h>
@@ -39,6 +41,8 @@ using search::TuneFileAttributes;
 using search::TuneFileIndexManager;
 using search::TuneFileIndexing;
 using search::datastore::EntryRef;
+using search::diskindex::BlockPosOccSeqRead;
+using search::diskindex::FileHeader;
 using search::index::DocBuilder;
 using search::index::DummyFileHeaderContext;
 using search::index::Schema;
@@ -105,6 +109,7 @@ struct Fixture {
     DummyFileHeaderContext _fileHeaderContext;
     ExecutorThreadingService _writeService;
     std::unique_ptr<IndexManager> _index_manager;
+    bool _blockPosOccFormat;
     Schema _schema;
     DocBuilder _builder;
 
@@ -114,6 +119,7 @@ struct Fixture {
           _fileHeaderContext(),
           _writeService(),
           _index_manager(),
+          _blockPosOccFormat(false),
           _schema(getSchema()),
           _builder(_schema)
     {
@@ -176,7 +182,7 @@ Document::UP Fixture::addDocument(uint32_t id) {
 void Fixture::resetIndexManager() {
     _index_manager.reset(0);
     _index_manager.reset(
-            new IndexManager(index_dir, searchcorespi::index::WarmupConfig(), 2, 0, getSchema(), 1,
+            new IndexManager(index_dir, searchcorespi::index::WarmupConfig(), 2, 1, _blockPosOccFormat, 1, 0, getSchema(), 1,
                              _reconfigurer, _writeService, _writeService.getMasterExecutor(),
                              TuneFileIndexManager(), TuneFileAttributes(),
                              _fileHeaderContext));
@@ -663,6 +669,41 @@ TEST_F("requireThatSerialNumberIsReadOnLoad", Fixture) {
     EXPECT_EQUAL(serial, f._index_manager->getFlushedSerialNum());
 }
 
+bool hasBlockPosOccFormat(const string &indexName) {
+    FileHeader fileHeader;
+    string postingName = index_dir + "/" + indexName + "/" + field_name + "/posocc.dat.compressed";
+    if (!fileHeader.taste(postingName, search::TuneFileSeqRead())) {
+        return false;
+    }
+    return (fileHeader.getFormats().size() == 2 &&
+            fileHeader.getFormats()[0] == BlockPosOccSeqRead::getIdentifier() &&
+            fileHeader.getFormats()[1] == BlockPosOccSeqRead::getSubIdentifier());
+}
+
+TEST_F("requireThatPostingListFormatIsSelectedByConfig", Fixture) {
+    f.addDocument(docid);
+    f.flushIndexManager();
+    EXPECT_FALSE(hasBlockPosOccFormat("index.flush.1"));
+
+    f._blockPosOccFormat = true;
+    f.resetIndexManager();
+    f.addDocument(docid + 1);
+    f.flushIndexManager();
+    EXPECT_TRUE(hasBlockPosOccFormat("index.flush.2"));
+
+    FusionSpec fusion_spec;
+    fusion_spec.flush_ids.push_back(1);
+    fusion_spec.flush_ids.push_back(2);
+    f._index_manager->getMaintainer().runFusion(fusion_spec);
+    EXPECT_TRUE(hasBlockPosOccFormat("index.fusion.2"));
+
+    // the format of existing indexes is detected from their file headers
+    f._blockPosOccFormat = false;
+    f.resetIndexManager();
+    IIndexCollection::SP sources = f._index_manager->getMaintainer().getSourceCollection();
+    EXPECT_EQUAL(2u, sources->getSourceCount());
+}
+
 void crippleFusion(uint32_t fusionId) {
     vespalib::asciistream ost;
     ost << index_dir << "/index.flush." << fusionId << "/serial.dat";
@@ -305,4 +305,90 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work-stealing scheduler starts by dividing the docid space equally") {
+    WorkStealingDocidRangeScheduler scheduler(4, 4, 64);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 63u);
+    TEST_DO(verify_range(scheduler.total_span(0), DocidRange(1, 64)));
+    TEST_DO(verify_range(scheduler.total_span(3), DocidRange(1, 64)));
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 5)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(17, 21)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(33, 37)));
+    TEST_DO(verify_range(scheduler.first_range(3), DocidRange(49, 53)));
+    EXPECT_EQUAL(scheduler.total_size(0), 4u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 47u);
+}
+
+TEST("require that the work-stealing scheduler takes larger tasks when there is more work left") {
+    WorkStealingDocidRangeScheduler scheduler(1, 1, 101);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 13)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(13, 24)));
+    EXPECT_EQUAL(scheduler.total_size(0), 23u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 77u);
+}
+
+TEST("require that the work-stealing scheduler steals half the remaining work of the busiest thread") {
+    WorkStealingDocidRangeScheduler scheduler(3, 1, 31);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 2)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(11, 12)));
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_EQUAL(scheduler.next_range(2).size(), 1u);
+    }
+    EXPECT_EQUAL(scheduler.stolen_ranges(2), 0u);
+    // thread 0 has [2,11) left, thread 1 has [12,21) left; thread 0 is picked first
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(7, 8)));
+    EXPECT_EQUAL(scheduler.stolen_ranges(2), 1u);
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(2, 3)));
+    EXPECT_EQUAL(scheduler.stolen_ranges(0), 0u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 16u);
+}
+
+TEST("require that the work-stealing scheduler respects the minimal task size when stealing") {
+    WorkStealingDocidRangeScheduler scheduler(2, 3, 11);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 4)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(6, 9)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(9, 11)));
+    // thread 0 has [4,6) left, which is too small to be split
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.stolen_ranges(1), 0u);
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(4, 6)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+}
+
+TEST("require that the work-stealing scheduler protects against documents underflow") {
+    WorkStealingDocidRangeScheduler scheduler(2, 1, 0);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange()));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 0u);
+    EXPECT_EQUAL(scheduler.total_size(1), 0u);
+}
+
+TEST_MT_FF("require that the work-stealing scheduler assigns each docid exactly once",
+           4, WorkStealingDocidRangeScheduler(num_threads, 1, 10001), std::vector<std::atomic<uint32_t>>(10001))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        for (uint32_t docid = docid_range.begin; docid < docid_range.end; ++docid) {
+            ++f2[docid];
+        }
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        size_t total = 0;
+        for (size_t i = 0; i < num_threads; ++i) {
+            total += f1.total_size(i);
+        }
+        EXPECT_EQUAL(total, 10000u);
+        EXPECT_EQUAL(f1.unassigned_size(), 0u);
+        EXPECT_EQUAL(f2[0].load(), 0u);
+        for (uint32_t docid = 1; docid < 10001; ++docid) {
+            EXPECT_EQUAL(f2[docid].load(), 1u);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -36,6 +36,18 @@ TEST("requireThatDocCountsAddUp") {
     EXPECT_EQUAL(2u, stats.limited_queries());
 }
 
+TEST("requireThatResultCacheCountsAddUp") {
+    MatchingStats stats;
+    EXPECT_EQUAL(0u, stats.resultCacheHits());
+    EXPECT_EQUAL(0u, stats.resultCacheMisses());
+    EXPECT_EQUAL(0u, stats.resultCacheEvictions());
+    EXPECT_EQUAL(&stats.add(MatchingStats().resultCacheHits(5).resultCacheMisses(3).resultCacheEvictions(1)), &stats);
+    EXPECT_EQUAL(&stats.add(MatchingStats().resultCacheHits(2).resultCacheMisses(1).resultCacheEvictions(4)), &stats);
+    EXPECT_EQUAL(7u, stats.resultCacheHits());
+    EXPECT_EQUAL(4u, stats.resultCacheMisses());
+    EXPECT_EQUAL(5u, stats.resultCacheEvictions());
+}
+
 TEST("requireThatAverageTimesAreRecorded") {
     MatchingStats stats;
     EXPECT_APPROX(0.0, stats.matchTimeAvg(), 0.00001);
@@ -88,8 +100,8 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(0u, all1.getNumPartitions());
 
     MatchingStats::Partition subPart;
-    subPart.docsMatched(3).docsRanked(2).docsReRanked(1)
-        .active_time(1.0).wait_time(0.5);
+    subPart.docsMatched(3).docsRanked(2).docsReRanked(1).stolenRanges(4)
+        .active_time(1.0).wait_time(0.5).idle_time(0.25);
     EXPECT_EQUAL(3u, subPart.docsMatched());
     EXPECT_EQUAL(2u, subPart.docsRanked());
     EXPECT_EQUAL(1u, subPart.docsReRanked());
@@ -97,6 +109,9 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(0.5, subPart.wait_time_avg());
     EXPECT_EQUAL(1u, subPart.active_time_count());
     EXPECT_EQUAL(1u, subPart.wait_time_count());
+    EXPECT_EQUAL(4u, subPart.stolenRanges());
+    EXPECT_EQUAL(0.25, subPart.idle_time_avg());
+    EXPECT_EQUAL(1u, subPart.idle_time_count());
 
     all1.merge_partition(subPart, 0);
     EXPECT_EQUAL(3u, all1.docsMatched());
@@ -136,6 +151,9 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(0.5, all1.getPartition(0).wait_time_avg());
     EXPECT_EQUAL(2u, all1.getPartition(0).active_time_count());
     EXPECT_EQUAL(2u, all1.getPartition(0).wait_time_count());
+    EXPECT_EQUAL(8u, all1.getPartition(0).stolenRanges());
+    EXPECT_EQUAL(0.25, all1.getPartition(0).idle_time_avg());
+    EXPECT_EQUAL(2u, all1.getPartition(0).idle_time_count());
     EXPECT_EQUAL(6u, all1.getPartition(1).docsMatched());
     EXPECT_EQUAL(4u, all1.getPartition(1).docsRanked());
     EXPECT_EQUAL(2u, all1.getPartition(1).docsReRanked());
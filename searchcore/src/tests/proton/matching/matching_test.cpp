@@ -297,7 +297,10 @@ struct MyWorld {
     }
 
     SearchReply::UP performSearch(SearchRequest::SP req, size_t threads) {
-        Matcher::SP matcher = createMatcher();
+        return performSearch(createMatcher(), req, threads);
+    }
+
+    SearchReply::UP performSearch(Matcher::SP matcher, SearchRequest::SP req, size_t threads) {
         SearchSession::OwnershipBundle owned_objects;
         owned_objects.search_handler.reset(new MySearchHandler(matcher));
         owned_objects.context.reset(new MatchContext(
@@ -502,6 +505,91 @@ TEST("require that sortspec can be used (multi-threaded)") {
     }
 }
 
+TEST("require that result cache answers repeated queries with other offsets") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.config.add(indexproperties::matching::ResultCacheMaxBytes::NAME, "1000000");
+    world.config.add(indexproperties::matching::ResultCacheMaxHits::NAME, "5");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    request->maxhits = 2;
+    SearchReply::UP reply = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(9u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(0u, world.matchingStats.resultCacheHits());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheMisses());
+    ASSERT_EQUAL(2u, reply->hits.size());
+    EXPECT_EQUAL(9u, reply->totalHitCount);
+    EXPECT_EQUAL(document::DocumentId("doc::900").getGlobalId(),  reply->hits[0].gid);
+    EXPECT_EQUAL(document::DocumentId("doc::800").getGlobalId(),  reply->hits[1].gid);
+
+    request->offset = 2;
+    reply = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(9u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+    EXPECT_EQUAL(2u, world.matchingStats.queries());
+    EXPECT_EQUAL(2u, world.matchingStats.queryLatencyCount());
+    ASSERT_EQUAL(2u, reply->hits.size());
+    EXPECT_EQUAL(2u, reply->offset);
+    EXPECT_EQUAL(9u, reply->totalHitCount);
+    EXPECT_EQUAL(document::DocumentId("doc::700").getGlobalId(),  reply->hits[0].gid);
+    EXPECT_EQUAL(700.0, reply->hits[0].metric);
+    EXPECT_EQUAL(document::DocumentId("doc::600").getGlobalId(),  reply->hits[1].gid);
+
+    request->offset = 4;  // beyond the cached hits
+    reply = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(18u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheMisses());
+    ASSERT_EQUAL(2u, reply->hits.size());
+    EXPECT_EQUAL(document::DocumentId("doc::500").getGlobalId(),  reply->hits[0].gid);
+
+    request->offset = 0;
+    request->propertiesMap.lookupCreate(search::MapNames::RANK).add("foo", "bar");
+    reply = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(27u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(2u, world.matchingStats.resultCacheMisses());
+}
+
+TEST("require that result cache is invalidated when document meta store changes") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.config.add(indexproperties::matching::ResultCacheMaxBytes::NAME, "1000000");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    world.performSearch(matcher, request, 1);
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(9u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+    EXPECT_TRUE(world.metaStore.remove(1));
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(18u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+    EXPECT_EQUAL(2u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheEvictions());
+}
+
+TEST("require that result cache is invalidated when an attribute is committed") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.config.add(indexproperties::matching::ResultCacheMaxBytes::NAME, "1000000");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    world.performSearch(matcher, request, 1);
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(9u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+    // a partial update only touches the attribute, committing it bumps its generation
+    auto &a2 = dynamic_cast<AttributeVector &>(const_cast<IAttributeVector &>(*world.attributeContext.get("a2")));
+    a2.incGeneration();
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(18u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+    EXPECT_EQUAL(2u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheEvictions());
+}
+
 ExpressionNode::UP createAttr() { return std::make_unique<AttributeNode>("a1"); }
 TEST("require that grouping is performed (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
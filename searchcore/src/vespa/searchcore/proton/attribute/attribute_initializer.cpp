@@ -11,6 +11,7 @@
 #include <vespa/searchlib/util/fileutil.h>
 #include <vespa/searchlib/attribute/attribute_header.h>
 #include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/vespalib/util/threadexecutor.h>
 #include <vespa/fastos/file.h>
 
 #include <vespa/log/log.h>
@@ -191,7 +192,14 @@ AttributeInitializer::loadAttribute(const AttributeVectorSP &attr,
     assert(attr->hasLoadData());
     fastos::TimeStamp startTime = fastos::ClockSystem::now();
     EventLogger::loadAttributeStart(_documentSubDbName, attr->getName());
-    if (!attr->load()) {
+    bool loaded;
+    if ((_loadExecutor != nullptr) && (_loadExecutor->getNumThreads() > 1) && attr->getConfig().fastSearch()) {
+        // Sort loaded values and build posting lists using the threads shared by all attribute loads
+        loaded = attr->load(_loadExecutor);
+    } else {
+        loaded = attr->load();
+    }
+    if (!loaded) {
         LOG(warning, "Could not load attribute vector '%s' from disk. "
                 "Returning empty attribute vector",
                 attr->getBaseFileName().c_str());
@@ -238,12 +246,14 @@ AttributeInitializer::AttributeInitializer(const std::shared_ptr<AttributeDirect
                                            const vespalib::string &documentSubDbName,
                                            const AttributeSpec &spec,
                                            uint64_t currentSerialNum,
-                                           const IAttributeFactory &factory)
+                                           const IAttributeFactory &factory,
+                                           vespalib::ThreadExecutor *loadExecutor)
     : _attrDir(attrDir),
       _documentSubDbName(documentSubDbName),
       _spec(spec),
       _currentSerialNum(currentSerialNum),
-      _factory(factory)
+      _factory(factory),
+      _loadExecutor(loadExecutor)
 {
 }
 
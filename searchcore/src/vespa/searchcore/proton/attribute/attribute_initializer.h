@@ -12,6 +12,8 @@ namespace search {
 namespace attribute { class AttributeHeader; }
 }
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace proton {
 
 class AttributeDirectory;
@@ -32,6 +34,7 @@ private:
     const AttributeSpec             _spec;
     const uint64_t                  _currentSerialNum;
     const IAttributeFactory        &_factory;
+    vespalib::ThreadExecutor       *_loadExecutor;
 
     AttributeVectorSP tryLoadAttribute() const;
 
@@ -49,7 +52,8 @@ public:
                          const vespalib::string &documentSubDbName,
                          const AttributeSpec &spec,
                          uint64_t currentSerialNum,
-                         const IAttributeFactory &factory);
+                         const IAttributeFactory &factory,
+                         vespalib::ThreadExecutor *loadExecutor);
     ~AttributeInitializer();
 
     AttributeInitializerResult init() const;
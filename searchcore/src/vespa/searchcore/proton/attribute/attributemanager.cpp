@@ -137,7 +137,8 @@ AttributeManager::internalAddAttribute(const AttributeSpec &spec,
                                        uint64_t serialNum,
                                        const IAttributeFactory &factory)
 {
-    AttributeInitializer initializer(_diskLayout->createAttributeDir(spec.getName()), _documentSubDbName, spec, serialNum, factory);
+    AttributeInitializer initializer(_diskLayout->createAttributeDir(spec.getName()), _documentSubDbName, spec, serialNum, factory,
+                                     _loadExecutor);
     AttributeInitializerResult result = initializer.init();
     if (result) {
         result.getAttribute()->setInterlock(_interlock);
@@ -211,7 +212,7 @@ AttributeManager::addNewAttributes(const Spec &newSpec,
 
         AttributeInitializer::UP initializer =
             std::make_unique<AttributeInitializer>(_diskLayout->createAttributeDir(aspec.getName()), _documentSubDbName,
-                        aspec, newSpec.getCurrentSerialNum(), *_factory);
+                        aspec, newSpec.getCurrentSerialNum(), *_factory, _loadExecutor);
         initializerRegistry.add(std::move(initializer));
 
         // TODO: Might want to use hardlinks to make attribute vector
@@ -257,6 +258,7 @@ AttributeManager::AttributeManager(const vespalib::string &baseDir,
       _interlock(std::make_shared<search::attribute::Interlock>()),
       _attributeFieldWriter(attributeFieldWriter),
       _hwInfo(hwInfo),
+      _loadExecutor(nullptr),
       _importedAttributes()
 {
 }
@@ -269,7 +271,8 @@ AttributeManager::AttributeManager(const vespalib::string &baseDir,
                                    search::ISequencedTaskExecutor &
                                    attributeFieldWriter,
                                    const IAttributeFactory::SP &factory,
-                                   const HwInfo &hwInfo)
+                                   const HwInfo &hwInfo,
+                                   vespalib::ThreadExecutor *loadExecutor)
     : proton::IAttributeManager(),
       _attributes(),
       _flushables(),
@@ -282,6 +285,7 @@ AttributeManager::AttributeManager(const vespalib::string &baseDir,
       _interlock(std::make_shared<search::attribute::Interlock>()),
       _attributeFieldWriter(attributeFieldWriter),
       _hwInfo(hwInfo),
+      _loadExecutor(loadExecutor),
       _importedAttributes()
 {
 }
@@ -301,6 +305,7 @@ AttributeManager::AttributeManager(const AttributeManager &currMgr,
       _interlock(currMgr._interlock),
       _attributeFieldWriter(currMgr._attributeFieldWriter),
       _hwInfo(currMgr._hwInfo),
+      _loadExecutor(currMgr._loadExecutor),
       _importedAttributes()
 {
     Spec::AttributeList toBeAdded;
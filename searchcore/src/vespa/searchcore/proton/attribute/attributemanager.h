@@ -30,6 +30,8 @@ namespace searchcorespi
 class IFlushTarget;
 }
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace proton
 {
 
@@ -92,6 +94,7 @@ private:
     std::shared_ptr<search::attribute::Interlock> _interlock;
     search::ISequencedTaskExecutor &_attributeFieldWriter;
     HwInfo _hwInfo;
+    vespalib::ThreadExecutor *_loadExecutor;
     std::unique_ptr<ImportedAttributesRepo> _importedAttributes;
 
     AttributeVectorSP internalAddAttribute(const AttributeSpec &spec,
@@ -132,7 +135,8 @@ public:
                      fileHeaderContext,
                      search::ISequencedTaskExecutor &attributeFieldWriter,
                      const IAttributeFactory::SP &factory,
-                     const HwInfo &hwInfo);
+                     const HwInfo &hwInfo,
+                     vespalib::ThreadExecutor *loadExecutor);
 
     AttributeManager(const AttributeManager &currMgr,
                      const Spec &newSpec,
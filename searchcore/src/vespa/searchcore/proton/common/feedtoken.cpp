@@ -8,7 +8,9 @@ State::State(ITransport & transport) :
     _transport(transport),
     _result(new storage::spi::Result()),
     _documentWasFound(false),
-    _alreadySent(false)
+    _alreadySent(false),
+    _lock(),
+    _commitError()
 {
 }
 
@@ -22,10 +24,25 @@ State::ack()
 {
     bool alreadySent = _alreadySent.exchange(true);
     if ( !alreadySent ) {
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            if ( ! _commitError.empty()) {
+                // Keep the type of the result, the transport may depend on it.
+                static_cast<storage::spi::Result &>(*_result) =
+                    storage::spi::Result(storage::spi::Result::TRANSIENT_ERROR, _commitError);
+            }
+        }
         _transport.send(std::move(_result), _documentWasFound);
     }
 }
 
+void
+State::commitFailed(const vespalib::string & error)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _commitError = error;
+}
+
 void
 State::fail()
 {
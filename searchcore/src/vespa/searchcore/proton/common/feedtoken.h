@@ -3,8 +3,10 @@
 
 #include <vespa/persistence/spi/persistenceprovider.h>
 #include <vespa/searchlib/common/idestructorcallback.h>
+#include <vespa/searchlib/transactionlog/common.h>
 #include <vespa/vespalib/util/sync.h>
 #include <atomic>
+#include <mutex>
 
 namespace proton {
 
@@ -22,7 +24,9 @@ namespace feedtoken {
         virtual void send(ResultUP result, bool documentWasFound) = 0;
     };
 
-    class State : public search::IDestructorCallback {
+    class State : public search::IDestructorCallback,
+                  public search::transactionlog::CommitFailureListener
+    {
     public:
         State(const State &) = delete;
         State & operator = (const State &) = delete;
@@ -34,12 +38,19 @@ namespace feedtoken {
             _result = std::move(result);
         }
         const storage::spi::Result &getResult() { return *_result; }
+        /**
+         * The operation was not persisted in the transaction log. The
+         * reply carries the error instead of the result of the operation.
+         */
+        void commitFailed(const vespalib::string & error) override;
     private:
         void ack();
         ITransport           &_transport;
         ResultUP              _result;
         bool                  _documentWasFound;
         std::atomic<bool>     _alreadySent;
+        std::mutex            _lock;
+        vespalib::string      _commitError;
     };
 
     inline std::shared_ptr<State>
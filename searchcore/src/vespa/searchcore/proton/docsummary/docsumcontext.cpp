@@ -54,6 +54,23 @@ DocsumContext::initState()
     }
 }
 
+void
+DocsumContext::prefetchDocuments(const IDocsumWriter::ResolveClassInfo & rci)
+{
+    if (rci.mustSkip || rci.allGenerated) {
+        return;
+    }
+    std::vector<uint32_t> docIds;
+    docIds.reserve(_docsumState._docsumcnt);
+    for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
+        uint32_t docId = _docsumState._docsumbuf[i];
+        if (docId != search::endDocId) {
+            docIds.push_back(docId);
+        }
+    }
+    _docsumStore.prefetch(docIds);
+}
+
 DocsumReply::UP
 DocsumContext::createReply()
 {
@@ -63,6 +80,7 @@ DocsumContext::createReply()
     reply->docsums.resize(_docsumState._docsumcnt);
     SymbolTable::UP symbols = std::make_unique<SymbolTable>();
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(), _docsumStore.getSummaryClassId());
+    prefetchDocuments(rci);
     for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
         buf.reset();
         uint32_t docId = _docsumState._docsumbuf[i];
@@ -102,6 +120,7 @@ DocsumContext::createSlimeReply()
     Cursor & array = root.setArray(DOCSUMS);
     const Symbol docsumSym = response->insert(DOCSUM);
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(), _docsumStore.getSummaryClassId());
+    prefetchDocuments(rci);
     for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
         uint32_t docId = _docsumState._docsumbuf[i];
         Cursor & docSumC = array.addObject();
@@ -27,6 +27,7 @@ private:
     matching::SessionManager             & _sessionMgr;
 
     void initState();
+    void prefetchDocuments(const search::docsummary::IDocsumWriter::ResolveClassInfo & rci);
     search::engine::DocsumReply::UP createReply();
     std::unique_ptr<vespalib::Slime> createSlimeReply();
 
@@ -27,6 +27,22 @@ setMemoryUsage(Cursor &object, const search::MemoryUsage &usage)
     memory.setLong("onHoldBytes", usage.allocatedBytesOnHold());
 }
 
+const char *
+compressionName(const DataStoreFileChunkStats &chunk)
+{
+    if (!chunk.compressionKnown()) {
+        return "UNKNOWN";
+    }
+    switch (chunk.compression()) {
+    case DataStoreFileChunkStats::CompressionType::LZ4:
+        return "LZ4";
+    case DataStoreFileChunkStats::CompressionType::ZSTD:
+        return "ZSTD";
+    default:
+        return "NONE";
+    }
+}
+
 }
 
 void
@@ -55,6 +71,8 @@ DocumentStoreExplorer::get_state(const Inserter &inserter, bool full) const
             chunkCursor.setLong("lastFlushedSerialNum", chunk.lastFlushedSerialNum());
             chunkCursor.setLong("lastSerialNum", chunk.lastSerialNum());
             chunkCursor.setLong("docIdLimit", chunk.docIdLimit());
+            chunkCursor.setString("compression", compressionName(chunk));
+            chunkCursor.setDouble("compressionRatio", chunk.compressionRatio());
             chunkCursor.setLong("nameid", chunk.nameId());
             chunkCursor.setString("name", chunk.createName(baseDir));
         }
@@ -175,7 +175,8 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                                              c_str()))),
       _resultPacker(&_resultConfig),
       _fieldCache(fieldCache),
-      _markupFields(markupFields)
+      _markupFields(markupFields),
+      _prefetched()
 {
 }
 
@@ -190,7 +191,14 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
             _resultClass->GetClassName(), getSummaryClassId());
         return DocsumStoreValue();
     }
-    Document::UP document = _docStore.read(docId, _repo);
+    Document::UP document;
+    auto found = _prefetched.find(docId);
+    if (found != _prefetched.end()) {
+        document = std::move(found->second);
+        _prefetched.erase(found);
+    } else {
+        document = _docStore.read(docId, _repo);
+    }
     if (document.get() == NULL) {
         LOG(debug,
             "Did not find summary document for docId %u. "
@@ -215,4 +223,17 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
     return DocsumStoreValue(buf, buflen);
 }
 
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t> &docIds)
+{
+    _prefetched.clear();
+    if (docIds.size() < 2) {
+        return;
+    }
+    search::IDocumentStore::DocumentVector docs = _docStore.read(docIds, _repo);
+    for (size_t i = 0; i < docIds.size(); ++i) {
+        _prefetched[docIds[i]] = std::move(docs[i]);
+    }
+}
+
 } // namespace proton
@@ -12,6 +12,9 @@ IndexManagerInitializer::
 IndexManagerInitializer(const vespalib::string &baseDir,
                         const searchcorespi::index::WarmupConfig & warmupCfg,
                         size_t maxFlushed,
+                        uint32_t fusionThreads,
+                        bool blockPosOccFormat,
+                        uint32_t invertShards,
                         size_t cacheSize,
                         const search::index::Schema &schema,
                         search::SerialNum serialNum,
@@ -25,6 +28,9 @@ IndexManagerInitializer(const vespalib::string &baseDir,
     : _baseDir(baseDir),
       _warmupCfg(warmupCfg),
       _maxFlushed(maxFlushed),
+      _fusionThreads(fusionThreads),
+      _blockPosOccFormat(blockPosOccFormat),
+      _invertShards(invertShards),
       _cacheSize(cacheSize),
       _schema(schema),
       _serialNum(serialNum),
@@ -49,6 +55,9 @@ IndexManagerInitializer::run()
                     (_baseDir,
                      _warmupCfg,
                      _maxFlushed,
+                     _fusionThreads,
+                     _blockPosOccFormat,
+                     _invertShards,
                      _cacheSize,
                      _schema,
                      _serialNum,
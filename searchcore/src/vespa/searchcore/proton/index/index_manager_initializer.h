@@ -18,6 +18,9 @@ class IndexManagerInitializer :  public initializer::InitializerTask
     const vespalib::string                      _baseDir;
     const searchcorespi::index::WarmupConfig    _warmupCfg;
     size_t                                      _maxFlushed;
+    uint32_t                                    _fusionThreads;
+    bool                                        _blockPosOccFormat;
+    uint32_t                                    _invertShards;
     size_t                                      _cacheSize;
     const search::index::Schema                 _schema;
     search::SerialNum                           _serialNum;
@@ -33,6 +36,9 @@ public:
     IndexManagerInitializer(const vespalib::string &baseDir,
                             const searchcorespi::index::WarmupConfig & warmupCfg,
                             size_t maxFlushed,
+                            uint32_t fusionThreads,
+                            bool blockPosOccFormat,
+                            uint32_t invertShards,
                             size_t cacheSize,
                             const search::index::Schema &schema,
                             search::SerialNum serialNum,
@@ -27,10 +27,14 @@ namespace proton {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
+                                                         bool blockPosOccFormat,
+                                                         uint32_t invertShards,
                                                          searchcorespi::index::
                                                          IThreadingService &
                                                          threadingService)
     : _cacheSize(cacheSize),
+      _blockPosOccFormat(blockPosOccFormat),
+      _invertShards(invertShards),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
@@ -45,6 +49,8 @@ IndexManager::MaintainerOperations::createMemoryIndex(const Schema &schema,
     return IMemoryIndex::SP(new MemoryIndexWrapper(schema,
                                                    _fileHeaderContext,
                                                    _tuneFileIndexing,
+                                                   _blockPosOccFormat,
+                                                   _invertShards,
                                                    _threadingService,
                                                    serialNum));
 }
@@ -67,20 +73,25 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
                                               const vespalib::string &outputDir,
                                               const std::vector<vespalib::string> &sources,
                                               const SelectorArray &selectorArray,
-                                              SerialNum serialNum)
+                                              SerialNum serialNum,
+                                              vespalib::ThreadExecutor &executor)
 {
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext,
                                                  serialNum);
     const bool dynamic_k_doc_pos_occ_format = false;
     return Fusion::merge(schema, outputDir, sources, selectorArray,
                          dynamic_k_doc_pos_occ_format,
-                         _tuneFileIndexing, fileHeaderContext);
+                         _blockPosOccFormat,
+                         _tuneFileIndexing, fileHeaderContext, executor);
 }
 
 
 IndexManager::IndexManager(const vespalib::string &baseDir,
                            const WarmupConfig & warmup,
                            const size_t maxFlushed,
+                           const uint32_t fusionThreads,
+                           const bool blockPosOccFormat,
+                           const uint32_t invertShards,
                            const size_t cacheSize,
                            const Schema &schema,
                            SerialNum serialNum,
@@ -91,10 +102,11 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const search::common::FileHeaderContext &fileHeaderContext) :
     _operations(fileHeaderContext, tuneFileIndexManager, cacheSize,
-                threadingService),
+                blockPosOccFormat, invertShards, threadingService),
     _maintainer(IndexMaintainerConfig(baseDir,
                                       warmup,
                                       maxFlushed,
+                                      fusionThreads,
                                       schema,
                                       serialNum,
                                       tuneFileAttributes),
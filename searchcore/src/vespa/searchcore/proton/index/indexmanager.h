@@ -20,6 +20,8 @@ public:
     class MaintainerOperations : public searchcorespi::index::IIndexMaintainerOperations {
     private:
         const size_t _cacheSize;
+        const bool _blockPosOccFormat;
+        const uint32_t _invertShards;
         const search::common::FileHeaderContext &_fileHeaderContext;
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
@@ -29,6 +31,8 @@ public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              size_t cacheSize,
+                             bool blockPosOccFormat,
+                             uint32_t invertShards,
                              searchcorespi::index::IThreadingService &
                              threadingService);
 
@@ -43,7 +47,8 @@ public:
                                const vespalib::string &outputDir,
                                const std::vector<vespalib::string> &sources,
                                const search::diskindex::SelectorArray &docIdSelector,
-                               search::SerialNum lastSerialNum) override;
+                               search::SerialNum lastSerialNum,
+                               vespalib::ThreadExecutor &executor) override;
     };
 
 private:
@@ -56,6 +61,9 @@ public:
     IndexManager(const vespalib::string &baseDir,
                  const searchcorespi::index::WarmupConfig & warmup,
                  size_t maxFlushed,
+                 uint32_t fusionThreads,
+                 bool blockPosOccFormat,
+                 uint32_t invertShards,
                  size_t cacheSize,
                  const Schema &schema,
                  SerialNum serialNum,
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/diskindex/indexbuilder.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/searchcorespi/index/indexsearchablevisitor.h>
+#include <algorithm>
 
 using search::TuneFileIndexing;
 using search::common::FileHeaderContext;
@@ -19,14 +20,18 @@ namespace proton {
 MemoryIndexWrapper::MemoryIndexWrapper(const search::index::Schema &schema,
                                        const search::common::FileHeaderContext &fileHeaderContext,
                                        const TuneFileIndexing &tuneFileIndexing,
+                                       bool blockPosOccFormat,
+                                       uint32_t invertShards,
                                        searchcorespi::index::IThreadingService &
                                        threadingService,
                                        search::SerialNum serialNum)
     : _index(schema, threadingService.indexFieldInverter(),
-             threadingService.indexFieldWriter()),
+             threadingService.indexFieldWriter(),
+             std::max(invertShards, 1u)),
       _serialNum(serialNum),
       _fileHeaderContext(fileHeaderContext),
-      _tuneFileIndexing(tuneFileIndexing)
+      _tuneFileIndexing(tuneFileIndexing),
+      _blockPosOccFormat(blockPosOccFormat)
 {
 }
 
@@ -39,6 +44,7 @@ MemoryIndexWrapper::flushToDisk(const vespalib::string &flushDir,
     _index.freeze(); // TODO(geirst): is this needed anymore?
     IndexBuilder indexBuilder(_index.getSchema());
     indexBuilder.setPrefix(flushDir);
+    indexBuilder.setBlockPosOccFormat(_blockPosOccFormat);
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext,
                                                  serialNum);
     indexBuilder.open(docIdLimit, numWords, _tuneFileIndexing, fileHeaderContext);
@@ -22,11 +22,14 @@ private:
     std::atomic<SerialNum> _serialNum;
     const search::common::FileHeaderContext &_fileHeaderContext;
     const search::TuneFileIndexing _tuneFileIndexing;
+    const bool _blockPosOccFormat;
 
 public:
     MemoryIndexWrapper(const search::index::Schema &schema,
                        const search::common::FileHeaderContext &fileHeaderContext,
                        const search::TuneFileIndexing &tuneFileIndexing,
+                       bool blockPosOccFormat,
+                       uint32_t invertShards,
                        searchcorespi::index::IThreadingService &
                        threadingService,
                        SerialNum serialNum);
@@ -160,4 +160,95 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::take_task(size_t thread_id)
+{
+    Worker &self = _workers[thread_id];
+    uint64_t old_value = self.todo.load(std::memory_order::memory_order_acquire);
+    for (;;) {
+        DocidRange todo = unpack(old_value);
+        if (todo.empty()) {
+            return DocidRange();
+        }
+        size_t task_size = std::min(todo.size(), std::max(size_t(_min_task), todo.size() / 8));
+        DocidRange task(todo.begin, todo.begin + task_size);
+        if (self.todo.compare_exchange_weak(old_value, pack(DocidRange(task.end, todo.end)),
+                                            std::memory_order::memory_order_acq_rel,
+                                            std::memory_order::memory_order_acquire))
+        {
+            self.assigned += task.size();
+            return task;
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    for (;;) {
+        size_t victim = thread_id;
+        size_t victim_size = 0;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            size_t size = load_todo(i).size();
+            if ((i != thread_id) && (size > victim_size)) {
+                victim = i;
+                victim_size = size;
+            }
+        }
+        if ((victim == thread_id) || (victim_size < (2 * size_t(_min_task)))) {
+            return false;
+        }
+        uint64_t old_value = _workers[victim].todo.load(std::memory_order::memory_order_acquire);
+        DocidRange todo = unpack(old_value);
+        if (todo.size() < (2 * size_t(_min_task))) {
+            continue;
+        }
+        uint32_t middle = (todo.end - (todo.size() / 2));
+        if (_workers[victim].todo.compare_exchange_strong(old_value, pack(DocidRange(todo.begin, middle)),
+                                                          std::memory_order::memory_order_acq_rel,
+                                                          std::memory_order::memory_order_acquire))
+        {
+            // our own todo is empty; other threads will not touch it until it is published
+            _workers[thread_id].todo.store(pack(DocidRange(middle, todo.end)),
+                                           std::memory_order::memory_order_release);
+            ++_workers[thread_id].stolen;
+            return true;
+        }
+    }
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit)
+    : _splitter(DocidRange(1, docid_limit), num_threads),
+      _min_task(std::max(1u, min_task)),
+      _workers(num_threads)
+{
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].todo.store(pack(_splitter.get(i)), std::memory_order::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() {}
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    DocidRange task = take_task(thread_id);
+    while (task.empty() && steal(thread_id)) {
+        task = take_task(thread_id);
+    }
+    return task;
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        sum += load_todo(i).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
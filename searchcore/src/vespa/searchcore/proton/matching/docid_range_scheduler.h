@@ -105,6 +105,10 @@ public:
  * will return the remaining work to be done by the thread calling
  * it. The returned range is guaranteed to be a prefix of the range
  * passed as input to the 'share_range' function.
+ *
+ * The 'stolen_ranges' function returns the number of docid ranges
+ * the given worker has stolen from other workers. Schedulers not
+ * using work-stealing will always return 0.
  **/
 struct DocidRangeScheduler {
     typedef std::unique_ptr<DocidRangeScheduler> UP;
@@ -115,6 +119,7 @@ struct DocidRangeScheduler {
     virtual size_t unassigned_size() const = 0;
     virtual IdleObserver make_idle_observer() const = 0;
     virtual DocidRange share_range(size_t thread_id, DocidRange todo) = 0;
+    virtual size_t stolen_ranges(size_t thread_id) const = 0;
     virtual ~DocidRangeScheduler() {}
 };
 
@@ -136,6 +141,7 @@ public:
     size_t unassigned_size() const override { return 0; }
     IdleObserver make_idle_observer() const override { return IdleObserver(); }
     DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t stolen_ranges(size_t) const override { return 0; }
 };
 
 /**
@@ -163,6 +169,7 @@ public:
     size_t unassigned_size() const override { return _unassigned.load(std::memory_order::memory_order_relaxed); }
     IdleObserver make_idle_observer() const override { return IdleObserver(); }
     DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t stolen_ranges(size_t) const override { return 0; }
 };
 
 /**
@@ -203,6 +210,49 @@ public:
     size_t unassigned_size() const override { return 0; }
     IdleObserver make_idle_observer() const override { return IdleObserver(_num_idle); }
     DocidRange share_range(size_t, DocidRange todo) override;
+    size_t stolen_ranges(size_t) const override { return 0; }
+};
+
+/**
+ * A lock-free scheduler using work-stealing. It begins by giving each
+ * thread an equal part of the docid space. Each thread keeps the
+ * unassigned part of its work as a single docid range and takes tasks
+ * from the front of it. A thread running out of work steals the back
+ * half of the unassigned work of the thread with the most work left.
+ * Tasks are never smaller than the minimal task size, and a range is
+ * only stolen from if both halves can be at least this large.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    struct Worker {
+        std::atomic<uint64_t> todo;
+        size_t                assigned;
+        size_t                stolen;
+        Worker() : todo(0), assigned(0), stolen(0) {}
+    };
+    DocidRangeSplitter  _splitter;
+    uint32_t            _min_task;
+    std::vector<Worker> _workers;
+
+    static uint64_t pack(DocidRange range) { return ((uint64_t(range.begin) << 32) | range.end); }
+    static DocidRange unpack(uint64_t value) { return DocidRange(uint32_t(value >> 32), uint32_t(value)); }
+    DocidRange load_todo(size_t thread_id) const {
+        return unpack(_workers[thread_id].todo.load(std::memory_order::memory_order_acquire));
+    }
+    VESPA_DLL_LOCAL DocidRange take_task(size_t thread_id);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler();
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    DocidRange total_span(size_t) const override { return _splitter.full_range(); }
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t stolen_ranges(size_t thread_id) const override { return _workers[thread_id].stolen; }
 };
 
 } // namespace proton::matching
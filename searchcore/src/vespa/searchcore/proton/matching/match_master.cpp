@@ -39,9 +39,12 @@ struct TimedMatchLoopCommunicator : IMatchLoopCommunicator {
 };
 
 DocidRangeScheduler::UP
-createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
+createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, bool useWorkStealing, uint32_t numDocs)
 {
     if (numSearchPartitions == 0) {
+        if (useWorkStealing) {
+            return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, 1, numDocs);
+        }
         return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
     }
     if (numSearchPartitions <= numThreads) {
@@ -58,14 +61,16 @@ MatchMaster::match(const MatchParams &params,
                    const MatchToolsFactory &matchToolsFactory,
                    ResultProcessor &resultProcessor,
                    uint32_t distributionKey,
-                   uint32_t numSearchPartitions)
+                   uint32_t numSearchPartitions,
+                   bool useWorkStealing)
 {
     fastos::StopWatch query_latency_time;
     query_latency_time.start();
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
     MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize);
     TimedMatchLoopCommunicator timedCommunicator(communicator);
-    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions,
+                                                        useWorkStealing, params.numDocs);
 
     std::vector<MatchThread::UP> threadState;
     std::vector<vespalib::Runnable*> targets;
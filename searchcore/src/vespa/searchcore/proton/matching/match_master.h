@@ -29,7 +29,8 @@ public:
                                       const MatchToolsFactory &matchToolsFactory,
                                       ResultProcessor &resultProcessor,
                                       uint32_t distributionKey,
-                                      uint32_t numSearchPartitions);
+                                      uint32_t numSearchPartitions,
+                                      bool useWorkStealing);
 
     static std::shared_ptr<search::FeatureSet>
     getFeatureSet(const MatchToolsFactory &matchToolsFactory,
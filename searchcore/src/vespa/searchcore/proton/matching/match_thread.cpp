@@ -128,6 +128,15 @@ MatchThread::maybe_limit(MatchTools &tools, uint32_t matches, uint32_t docId, ui
     return &tools.search();
 }
 
+DocidRange
+MatchThread::next_range()
+{
+    WaitTimer idle_timer(idle_time_s);
+    DocidRange docid_range = scheduler.next_range(thread_id);
+    idle_timer.done();
+    return docid_range;
+}
+
 bool
 MatchThread::try_share(DocidRange &docid_range, uint32_t next_docid) {
     DocidRange todo(next_docid, docid_range.end);
@@ -175,7 +184,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     Context context(matchParams.rankDropLimit, tools, hits, num_threads);
     for (DocidRange docid_range = scheduler.first_range(thread_id);
          !docid_range.empty() && ! softDoomed;
-         docid_range = scheduler.next_range(thread_id))
+         docid_range = next_range())
     {
         softDoomed = inner_match_loop<Strategy, do_rank, do_limit, do_share_work>(context, tools, docid_range);
     }
@@ -189,6 +198,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     }
     thread_stats.docsMatched(matches);
     thread_stats.softDoomed(softDoomed);
+    thread_stats.stolenRanges(scheduler.stolen_ranges(thread_id));
     if (do_rank) {
         thread_stats.docsRanked(matches);
     }
@@ -362,6 +372,7 @@ MatchThread::MatchThread(size_t thread_id_in,
     total_time_s(0.0),
     match_time_s(0.0),
     wait_time_s(0.0),
+    idle_time_s(0.0),
     match_with_ranking(mtf.has_first_phase_rank() && mp.save_rank_scores())
 {
 }
@@ -391,7 +402,7 @@ MatchThread::run()
     }
     total_time.stop();
     total_time_s = total_time.elapsed().sec();
-    thread_stats.active_time(total_time_s - wait_time_s).wait_time(wait_time_s);
+    thread_stats.active_time(total_time_s - wait_time_s).wait_time(wait_time_s).idle_time(idle_time_s);
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
 }
 
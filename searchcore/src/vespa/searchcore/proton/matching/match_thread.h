@@ -47,6 +47,7 @@ private:
     double                        total_time_s;
     double                        match_time_s;
     double                        wait_time_s;
+    double                        idle_time_s;
     bool                          match_with_ranking;
 
     class Context {
@@ -73,6 +74,7 @@ private:
 
     bool any_idle() const { return (idle_observer.get() > 0); }
     bool try_share(DocidRange &docid_range, uint32_t next_docid) __attribute__((noinline));
+    DocidRange next_range() __attribute__((noinline));
 
     template <typename Strategy, bool do_rank, bool do_limit, bool do_share_work>
     bool inner_match_loop(Context &context, MatchTools &tools, DocidRange docid_range) __attribute__((noinline));
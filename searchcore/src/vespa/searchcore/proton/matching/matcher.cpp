@@ -8,6 +8,7 @@
 #include "matcher.h"
 #include "sessionmanager.h"
 #include <vespa/searchcore/grouping/groupingcontext.h>
+#include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchlib/engine/errorcodes.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/searchrequest.h>
@@ -27,6 +28,7 @@ using search::DocumentMetaData;
 using search::LidUsageStats;
 using search::FeatureSet;
 using search::attribute::IAttributeContext;
+using search::attribute::IAttributeVector;
 using search::fef::MatchDataLayout;
 using search::fef::MatchData;
 using search::queryeval::Blueprint;
@@ -64,6 +66,20 @@ FeatureSet::SP findFeatureSet(const DocsumRequest &req,
     return MatchMaster::getFeatureSet(mtf, docs, summaryFeatures);
 }
 
+// Attributes bump their generation on every commit, so the sum changes with any visible update
+uint64_t sumAttributeGenerations(const IAttributeContext &attrContext) {
+    std::vector<const IAttributeVector *> attributes;
+    attrContext.getAttributeList(attributes);
+    uint64_t sum = 0;
+    for (const IAttributeVector *attribute : attributes) {
+        const auto *vector = dynamic_cast<const search::AttributeVector *>(attribute);
+        if (vector != nullptr) {
+            sum += vector->getCurrentGeneration();
+        }
+    }
+    return sum;
+}
+
 size_t numThreads(size_t hits, size_t minHits) {
     return static_cast<size_t>(std::ceil(double(hits) / double(minHits)));
 }
@@ -138,7 +154,8 @@ Matcher::Matcher(const search::index::Schema &schema,
       _stats(),
       _clock(clock),
       _queryLimiter(queryLimiter),
-      _distributionKey(distributionKey)
+      _distributionKey(distributionKey),
+      _resultCache()
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -147,6 +164,10 @@ Matcher::Matcher(const search::index::Schema &schema,
     if (!_rankSetup->compile()) {
         throw vespalib::IllegalArgumentException("failed to compile rank setup", VESPA_STRLOC);
     }
+    if ((_rankSetup->getResultCacheMaxBytes() > 0) && (_rankSetup->getResultCacheMaxHits() > 0)) {
+        _resultCache = std::make_unique<QueryResultCache>(_rankSetup->getResultCacheMaxBytes(),
+                                                          _rankSetup->getResultCacheMaxHits());
+    }
 }
 
 MatchingStats
@@ -156,6 +177,12 @@ Matcher::getStats()
     MatchingStats stats = std::move(_stats);
     _stats = std::move(MatchingStats());
     _stats.softDoomFactor(stats.softDoomFactor());
+    if (_resultCache) {
+        QueryResultCache::Stats cacheStats = _resultCache->getStats();
+        stats.resultCacheHits(cacheStats.hits)
+            .resultCacheMisses(cacheStats.misses)
+            .resultCacheEvictions(cacheStats.evictions);
+    }
     return stats;
 }
 
@@ -208,6 +235,15 @@ Matcher::computeNumThreadsPerSearch(Blueprint::HitEstimate hits, const Propertie
     return threads;
 }
 
+bool
+Matcher::canUseResultCache(const SearchRequest &request, const GroupingContext &groupingContext,
+                           bool shouldCacheSearchSession) const
+{
+    // Cached search sessions need the match tools used to produce the result
+    return _resultCache && groupingContext.empty() && !shouldCacheSearchSession &&
+        (request.maxhits > 0) && (request.offset + request.maxhits <= _resultCache->getMaxHits());
+}
+
 SearchReply::UP
 Matcher::match(const SearchRequest &request,
                vespalib::ThreadBundle &threadBundle,
@@ -221,6 +257,7 @@ Matcher::match(const SearchRequest &request,
     total_matching_time.start();
     MatchingStats my_stats;
     SearchReply::UP reply = std::make_unique<SearchReply>();
+    bool answeredFromCache = false;
     { // we want to measure full set-up and tear-down time as part of
       // collateral time
         GroupingContext groupingContext(_clock, request.getTimeOfDoom(),
@@ -239,62 +276,94 @@ Matcher::match(const SearchRequest &request,
                 }
             }
         }
-        const Properties *feature_overrides = &request.propertiesMap.featureOverrides();
-        if (shouldCacheSearchSession) {
-            owned_objects.feature_overrides.reset(new Properties(*feature_overrides));
-            feature_overrides = owned_objects.feature_overrides.get();
-        }
-        MatchToolsFactory::UP mtf = create_match_tools_factory(request, searchContext, attrContext,
-                                                               metaStore, *feature_overrides);
-        if (!mtf->valid()) {
-            reply->errorCode = ECODE_QUERY_PARSE_ERROR;
-            reply->errorMessage = "query execution failed (invalid query)";
-            return reply;
+        bool useResultCache = canUseResultCache(request, groupingContext, shouldCacheSearchSession);
+        vespalib::string resultCacheKey;
+        QueryResultCache::Version resultCacheVersion;
+        QueryResultCache::Entry::SP cached;
+        if (useResultCache) {
+            resultCacheKey = QueryResultCache::makeKey(request);
+            resultCacheVersion = QueryResultCache::Version(metaStore.getCurrentGeneration(),
+                                                           sumAttributeGenerations(attrContext),
+                                                           metaStore.getCommittedDocIdLimit(),
+                                                           metaStore.getNumActiveLids());
+            cached = _resultCache->lookup(resultCacheKey, resultCacheVersion);
         }
+        if (cached) {
+            reply = cached->makeReply(request.offset, request.maxhits);
+            answeredFromCache = true;
+        } else {
+            const Properties *feature_overrides = &request.propertiesMap.featureOverrides();
+            if (shouldCacheSearchSession) {
+                owned_objects.feature_overrides.reset(new Properties(*feature_overrides));
+                feature_overrides = owned_objects.feature_overrides.get();
+            }
+            MatchToolsFactory::UP mtf = create_match_tools_factory(request, searchContext, attrContext,
+                                                                   metaStore, *feature_overrides);
+            if (!mtf->valid()) {
+                reply->errorCode = ECODE_QUERY_PARSE_ERROR;
+                reply->errorMessage = "query execution failed (invalid query)";
+                return reply;
+            }
 
-        MatchParams params(searchContext.getDocIdLimit(), _rankSetup->getHeapSize(), _rankSetup->getArraySize(),
-                           _rankSetup->getRankScoreDropLimit(), request.offset, request.maxhits,
-                           !_rankSetup->getSecondPhaseRank().empty(), !willNotNeedRanking(request, groupingContext));
+            // Collect the best hits from offset 0 when the result should be cached
+            uint32_t offset = useResultCache ? 0u : request.offset;
+            uint32_t maxHits = useResultCache ? _resultCache->getMaxHits() : request.maxhits;
+            MatchParams params(searchContext.getDocIdLimit(), _rankSetup->getHeapSize(), _rankSetup->getArraySize(),
+                               _rankSetup->getRankScoreDropLimit(), offset, maxHits,
+                               !_rankSetup->getSecondPhaseRank().empty(), !willNotNeedRanking(request, groupingContext));
 
-        ResultProcessor rp(attrContext, metaStore, sessionMgr, groupingContext, sessionId,
-                           request.sortSpec, params.offset, params.hits);
+            ResultProcessor rp(attrContext, metaStore, sessionMgr, groupingContext, sessionId,
+                               request.sortSpec, params.offset, params.hits);
 
-        const Properties & rankProperties = request.propertiesMap.rankProperties();
-        size_t numThreadsPerSearch = computeNumThreadsPerSearch(mtf->estimate(), rankProperties);
-        LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
-        MatchMaster master;
-        uint32_t numSearchPartitions = NumSearchPartitions::lookup(rankProperties,
-                                                                   _rankSetup->getNumSearchPartitions());
-        ResultProcessor::Result::UP result = master.match(params, limitedThreadBundle, *mtf, rp,
-                                                          _distributionKey, numSearchPartitions);
-        my_stats = MatchMaster::getStats(std::move(master));
-        size_t estimate = std::min(static_cast<size_t>(metaStore.getCommittedDocIdLimit()),
-                                   mtf->match_limiter().getDocIdSpaceEstimate());
-        bool wasLimited = mtf->match_limiter().was_limited();
-        uint32_t estHits = mtf->estimate().estHits;
-        if (shouldCacheSearchSession && ((result->_numFs4Hits != 0) || shouldCacheGroupingSession)) {
-            SearchSession::SP session = std::make_shared<SearchSession>(sessionId, request.getTimeOfDoom(),
-                                                                        std::move(mtf), std::move(owned_objects));
-            session->releaseEnumGuards();
-            sessionMgr.insert(std::move(session));
-        }
-        reply = std::move(result->_reply);
-        SearchReply::Coverage & coverage = reply->coverage;
-        if (wasLimited) {
-            coverage.degradeMatchPhase();
-        }
-        if (my_stats.softDoomed()) {
-            coverage.degradeTimeout();
+            const Properties & rankProperties = request.propertiesMap.rankProperties();
+            size_t numThreadsPerSearch = computeNumThreadsPerSearch(mtf->estimate(), rankProperties);
+            LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
+            MatchMaster master;
+            uint32_t numSearchPartitions = NumSearchPartitions::lookup(rankProperties,
+                                                                       _rankSetup->getNumSearchPartitions());
+            bool useWorkStealing = UseWorkStealing::lookup(rankProperties, _rankSetup->getUseWorkStealing());
+            ResultProcessor::Result::UP result = master.match(params, limitedThreadBundle, *mtf, rp,
+                                                              _distributionKey, numSearchPartitions,
+                                                              useWorkStealing);
+            my_stats = MatchMaster::getStats(std::move(master));
+            size_t estimate = std::min(static_cast<size_t>(metaStore.getCommittedDocIdLimit()),
+                                       mtf->match_limiter().getDocIdSpaceEstimate());
+            bool wasLimited = mtf->match_limiter().was_limited();
+            uint32_t estHits = mtf->estimate().estHits;
+            if (shouldCacheSearchSession && ((result->_numFs4Hits != 0) || shouldCacheGroupingSession)) {
+                SearchSession::SP session = std::make_shared<SearchSession>(sessionId, request.getTimeOfDoom(),
+                                                                            std::move(mtf), std::move(owned_objects));
+                session->releaseEnumGuards();
+                sessionMgr.insert(std::move(session));
+            }
+            reply = std::move(result->_reply);
+            SearchReply::Coverage & coverage = reply->coverage;
+            if (wasLimited) {
+                coverage.degradeMatchPhase();
+            }
+            if (my_stats.softDoomed()) {
+                coverage.degradeTimeout();
+            }
+            coverage.setActive(metaStore.getNumActiveLids());
+            //TODO this should be calculated with ClusterState calculator.
+            coverage.setSoonActive(metaStore.getNumActiveLids());
+            coverage.setCovered(std::min(static_cast<size_t>(metaStore.getNumActiveLids()),
+                                         (estimate * metaStore.getNumActiveLids())/metaStore.getCommittedDocIdLimit()));
+            if (useResultCache) {
+                auto entry = std::make_shared<const QueryResultCache::Entry>(*reply);
+                reply = entry->makeReply(request.offset, request.maxhits);
+                if (!wasLimited && !my_stats.softDoomed()) {
+                    _resultCache->insert(resultCacheKey, resultCacheVersion, std::move(entry));
+                }
+            }
+            LOG(debug, "numThreadsPerSearch = %zu. Configured = %d, estimated hits=%d, totalHits=%ld",
+                numThreadsPerSearch, _rankSetup->getNumThreadsPerSearch(), estHits, reply->totalHitCount);
         }
-        coverage.setActive(metaStore.getNumActiveLids());
-        //TODO this should be calculated with ClusterState calculator.
-        coverage.setSoonActive(metaStore.getNumActiveLids());
-        coverage.setCovered(std::min(static_cast<size_t>(metaStore.getNumActiveLids()),
-                                     (estimate * metaStore.getNumActiveLids())/metaStore.getCommittedDocIdLimit()));
-        LOG(debug, "numThreadsPerSearch = %zu. Configured = %d, estimated hits=%d, totalHits=%ld",
-            numThreadsPerSearch, _rankSetup->getNumThreadsPerSearch(), estHits, reply->totalHitCount);
     }
     total_matching_time.stop();
+    if (answeredFromCache) {
+        my_stats.queries(1).queryLatency(total_matching_time.elapsed().sec());
+    }
     my_stats.queryCollateralTime(total_matching_time.elapsed().sec() - my_stats.queryLatencyAvg());
     {
         fastos::TimeStamp softLimit = uint64_t((1.0 - _rankSetup->getSoftTimeoutTailCost()) * request.getTimeout());
@@ -5,6 +5,7 @@
 #include "i_constant_value_repo.h"
 #include "indexenvironment.h"
 #include "matching_stats.h"
+#include "query_result_cache.h"
 #include "search_session.h"
 #include "viewresolver.h"
 #include <vespa/searchcore/proton/matching/querylimiter.h>
@@ -57,6 +58,7 @@ private:
     const vespalib::Clock        &_clock;
     QueryLimiter                 &_queryLimiter;
     uint32_t                      _distributionKey;
+    QueryResultCache::UP          _resultCache;
 
     search::FeatureSet::SP
     getFeatureSet(const search::engine::DocsumRequest & req,
@@ -72,6 +74,9 @@ private:
 
     size_t computeNumThreadsPerSearch(search::queryeval::Blueprint::HitEstimate hits,
                                       const search::fef::Properties & rankProperties) const;
+    bool canUseResultCache(const search::engine::SearchRequest &request,
+                           const search::grouping::GroupingContext &groupingContext,
+                           bool shouldCacheSearchSession) const;
 public:
     /**
      * Convenience typedefs.
@@ -23,6 +23,9 @@ MatchingStats::MatchingStats()
       _docsReRanked(0),
       _softDoomed(0),
       _softDoomFactor(0.5),
+      _resultCacheHits(0),
+      _resultCacheMisses(0),
+      _resultCacheEvictions(0),
       _queryCollateralTime(),
       _queryLatency(),
       _matchTime(),
@@ -59,6 +62,9 @@ MatchingStats::add(const MatchingStats &rhs)
     _docsRanked += rhs._docsRanked;
     _docsReRanked += rhs._docsReRanked;
     _softDoomed += rhs.softDoomed();
+    _resultCacheHits += rhs._resultCacheHits;
+    _resultCacheMisses += rhs._resultCacheMisses;
+    _resultCacheEvictions += rhs._resultCacheEvictions;
 
     _queryCollateralTime.add(rhs._queryCollateralTime);
     _queryLatency.add(rhs._queryLatency);
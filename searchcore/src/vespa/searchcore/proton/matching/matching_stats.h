@@ -41,16 +41,20 @@ public:
         size_t _docsRanked;
         size_t _docsReRanked;
         size_t _softDoomed;
+        size_t _stolenRanges;
         Avg    _active_time;
         Avg    _wait_time;
+        Avg    _idle_time;
     public:
         Partition()
             : _docsMatched(0),
               _docsRanked(0),
               _docsReRanked(0),
               _softDoomed(0),
+              _stolenRanges(0),
               _active_time(),
-              _wait_time() { }
+              _wait_time(),
+              _idle_time() { }
 
         Partition &docsMatched(size_t value) { _docsMatched = value; return *this; }
         size_t docsMatched() const { return _docsMatched; }
@@ -60,6 +64,8 @@ public:
         size_t docsReRanked() const { return _docsReRanked; }
         Partition &softDoomed(bool v) { _softDoomed += v ? 1 : 0; return *this; }
         size_t softDoomed() const { return _softDoomed; }
+        Partition &stolenRanges(size_t value) { _stolenRanges = value; return *this; }
+        size_t stolenRanges() const { return _stolenRanges; }
 
         Partition &active_time(double time_s) { _active_time.set(time_s); return *this; }
         double active_time_avg() const { return _active_time.avg(); }
@@ -67,15 +73,20 @@ public:
         Partition &wait_time(double time_s) { _wait_time.set(time_s); return *this; }
         double wait_time_avg() const { return _wait_time.avg(); }
         size_t wait_time_count() const { return _wait_time.count(); }
+        Partition &idle_time(double time_s) { _idle_time.set(time_s); return *this; }
+        double idle_time_avg() const { return _idle_time.avg(); }
+        size_t idle_time_count() const { return _idle_time.count(); }
 
         Partition &add(const Partition &rhs) {
             _docsMatched += rhs._docsMatched;
             _docsRanked += rhs._docsRanked;
             _docsReRanked += rhs._docsReRanked;
             _softDoomed += rhs._softDoomed;
+            _stolenRanges += rhs._stolenRanges;
 
             _active_time.add(rhs._active_time);
             _wait_time.add(rhs._wait_time);
+            _idle_time.add(rhs._idle_time);
             return *this;
         }
     };
@@ -88,6 +99,9 @@ private:
     size_t                 _docsReRanked;
     size_t                 _softDoomed;
     double                 _softDoomFactor;
+    size_t                 _resultCacheHits;
+    size_t                 _resultCacheMisses;
+    size_t                 _resultCacheEvictions;
     Avg                    _queryCollateralTime;
     Avg                    _queryLatency;
     Avg                    _matchTime;
@@ -124,6 +138,15 @@ public:
     double softDoomFactor() const { return _softDoomFactor; }
     MatchingStats &updatesoftDoomFactor(double hardLimit, double softLimit, double duration);
 
+    MatchingStats &resultCacheHits(size_t value) { _resultCacheHits = value; return *this; }
+    size_t resultCacheHits() const { return _resultCacheHits; }
+
+    MatchingStats &resultCacheMisses(size_t value) { _resultCacheMisses = value; return *this; }
+    size_t resultCacheMisses() const { return _resultCacheMisses; }
+
+    MatchingStats &resultCacheEvictions(size_t value) { _resultCacheEvictions = value; return *this; }
+    size_t resultCacheEvictions() const { return _resultCacheEvictions; }
+
     MatchingStats &queryCollateralTime(double time_s) { _queryCollateralTime.set(time_s); return *this; }
     double queryCollateralTimeAvg() const { return _queryCollateralTime.avg(); }
     size_t queryCollateralTimeCount() const { return _queryCollateralTime.count(); }
@@ -0,0 +1,202 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_result_cache.h"
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/searchlib/fef/properties.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <cassert>
+
+namespace proton::matching {
+
+using search::engine::SearchRequest;
+using search::fef::IPropertiesVisitor;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace {
+
+void appendField(vespalib::string &key, vespalib::stringref value) {
+    uint32_t len = value.size();
+    key.append(reinterpret_cast<const char *>(&len), sizeof(len));
+    key.append(value.data(), value.size());
+}
+
+struct KeyBuilder : IPropertiesVisitor {
+    vespalib::string &key;
+    KeyBuilder(vespalib::string &key_in) : key(key_in) { }
+    void visitProperty(const Property::Value &name, const Property &values) override {
+        appendField(key, name);
+        uint32_t numValues = values.size();
+        key.append(reinterpret_cast<const char *>(&numValues), sizeof(numValues));
+        for (uint32_t i = 0; i < numValues; ++i) {
+            appendField(key, values.getAt(i));
+        }
+    }
+};
+
+void appendProperties(vespalib::string &key, const Properties &props) {
+    uint32_t numKeys = props.numKeys();
+    key.append(reinterpret_cast<const char *>(&numKeys), sizeof(numKeys));
+    KeyBuilder builder(key);
+    props.visitProperties(builder);
+}
+
+} // namespace proton::matching::<unnamed>
+
+QueryResultCache::Entry::Entry(const SearchReply &reply)
+    : _totalHitCount(reply.totalHitCount),
+      _hits(reply.hits),
+      _sortIndex(reply.sortIndex),
+      _sortData(reply.sortData),
+      _coverage(reply.coverage)
+{
+    assert(reply.offset == 0);
+}
+
+QueryResultCache::Entry::~Entry() { }
+
+size_t
+QueryResultCache::Entry::memoryUsage() const
+{
+    return sizeof(Entry) + _hits.capacity() * sizeof(SearchReply::Hit) +
+        _sortIndex.capacity() * sizeof(uint32_t) + _sortData.capacity();
+}
+
+std::unique_ptr<search::engine::SearchReply>
+QueryResultCache::Entry::makeReply(uint32_t offset, uint32_t maxHits) const
+{
+    auto reply = std::make_unique<SearchReply>();
+    SearchReply &r = *reply;
+    uint32_t hitOffset = std::min(offset, numHits());
+    uint32_t hitcnt = std::min(maxHits, numHits() - hitOffset);
+    r.offset = offset;
+    r.totalHitCount = _totalHitCount;
+    r.coverage = _coverage;
+    r.hits.assign(_hits.begin() + hitOffset, _hits.begin() + hitOffset + hitcnt);
+    if (!_sortIndex.empty() && hitcnt > 0) {
+        uint32_t sortStart = _sortIndex[hitOffset];
+        uint32_t sortEnd = _sortIndex[hitOffset + hitcnt];
+        r.sortIndex.resize(hitcnt + 1);
+        for (uint32_t i = 0; i <= hitcnt; ++i) {
+            r.sortIndex[i] = _sortIndex[hitOffset + i] - sortStart;
+        }
+        r.sortData.assign(_sortData.begin() + sortStart, _sortData.begin() + sortEnd);
+    }
+    return reply;
+}
+
+QueryResultCache::Cache::Cache(size_t maxBytes, size_t &evictions)
+    : Parent(UNLIMITED),
+      _maxBytes(maxBytes),
+      _sizeBytes(0),
+      _evictions(evictions)
+{ }
+
+QueryResultCache::Cache::~Cache() { }
+
+size_t
+QueryResultCache::Cache::calcSize(const vespalib::string &key, const Entry &entry)
+{
+    return sizeof(value_type) + key.size() + entry.memoryUsage();
+}
+
+bool
+QueryResultCache::Cache::removeOldest(const value_type &v)
+{
+    bool remove = (_sizeBytes > _maxBytes);
+    if (remove) {
+        _sizeBytes -= calcSize(v.first, *v.second._value);
+        ++_evictions;
+    }
+    return remove;
+}
+
+QueryResultCache::QueryResultCache(size_t maxBytes, uint32_t maxHits)
+    : _lock(),
+      _stats(),
+      _version(),
+      _cache(maxBytes, _stats.evictions),
+      _maxHits(maxHits)
+{ }
+
+QueryResultCache::~QueryResultCache() { }
+
+vespalib::string
+QueryResultCache::makeKey(const SearchRequest &request)
+{
+    vespalib::string key;
+    appendField(key, request.ranking);
+    appendField(key, request.getStackRef());
+    appendField(key, request.location);
+    appendField(key, request.sortSpec);
+    appendProperties(key, request.propertiesMap.rankProperties());
+    appendProperties(key, request.propertiesMap.featureOverrides());
+    return key;
+}
+
+void
+QueryResultCache::dropAll()
+{
+    _stats.evictions += _cache.size();
+    for (auto it = _cache.begin(); it != _cache.end(); ) {
+        it = _cache.erase(it);
+    }
+    _cache._sizeBytes = 0;
+}
+
+bool
+QueryResultCache::checkVersion(const Version &version)
+{
+    if (version == _version) {
+        return true;
+    }
+    if (version.isOlderThan(_version)) {
+        // Produced from or asking for an older view of the data
+        return false;
+    }
+    dropAll();
+    _version = version;
+    return true;
+}
+
+QueryResultCache::Entry::SP
+QueryResultCache::lookup(const vespalib::string &key, const Version &version)
+{
+    vespalib::LockGuard guard(_lock);
+    if (checkVersion(version) && _cache.hasKey(key)) {
+        ++_stats.hits;
+        return _cache[key];
+    }
+    ++_stats.misses;
+    return Entry::SP();
+}
+
+void
+QueryResultCache::insert(const vespalib::string &key, const Version &version, Entry::SP entry)
+{
+    size_t entrySize = Cache::calcSize(key, *entry);
+    vespalib::LockGuard guard(_lock);
+    if (entrySize > _cache._maxBytes || !checkVersion(version) || _cache.hasKey(key)) {
+        return;
+    }
+    _cache._sizeBytes += entrySize;
+    _cache.insert(key, std::move(entry));
+}
+
+QueryResultCache::Stats
+QueryResultCache::getStats()
+{
+    vespalib::LockGuard guard(_lock);
+    Stats stats = _stats;
+    _stats = Stats();
+    return stats;
+}
+
+size_t
+QueryResultCache::size() const
+{
+    vespalib::LockGuard guard(_lock);
+    return _cache.size();
+}
+
+}
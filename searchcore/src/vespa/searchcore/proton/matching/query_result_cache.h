@@ -0,0 +1,135 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/sync.h>
+#include <memory>
+#include <vector>
+
+namespace search::engine { class SearchRequest; }
+
+namespace proton::matching {
+
+/**
+ * Memory bounded cache of the best hits (after second phase ranking)
+ * for queries. Used to answer repeated queries asking for other
+ * offsets into the same result without matching.
+ *
+ * Entries are only valid for the version of the searchable data
+ * (document meta store generation, committed docid limit, number of
+ * active lids and the sum of the attribute generations) they were
+ * produced with. All entries are dropped when a newer version is
+ * observed. Attributes bump their generation on every commit, so
+ * partial updates of attributes also invalidate the cache.
+ **/
+class QueryResultCache
+{
+public:
+    using SearchReply = search::engine::SearchReply;
+
+    /**
+     * The visible state of the searchable data that cached entries
+     * were produced from.
+     **/
+    struct Version {
+        uint64_t generation;
+        uint64_t attributeGeneration;
+        uint32_t docIdLimit;
+        uint32_t numActiveLids;
+        Version() : generation(0), attributeGeneration(0), docIdLimit(0), numActiveLids(0) { }
+        Version(uint64_t generation_in, uint64_t attributeGeneration_in,
+                uint32_t docIdLimit_in, uint32_t numActiveLids_in)
+            : generation(generation_in), attributeGeneration(attributeGeneration_in),
+              docIdLimit(docIdLimit_in), numActiveLids(numActiveLids_in) { }
+        bool operator==(const Version &rhs) const {
+            return (generation == rhs.generation) && (attributeGeneration == rhs.attributeGeneration) &&
+                (docIdLimit == rhs.docIdLimit) && (numActiveLids == rhs.numActiveLids);
+        }
+        bool isOlderThan(const Version &rhs) const {
+            return (generation < rhs.generation) || (attributeGeneration < rhs.attributeGeneration);
+        }
+        bool operator!=(const Version &rhs) const { return !(*this == rhs); }
+    };
+
+    /**
+     * The best hits for a query, starting at offset 0.
+     **/
+    class Entry {
+    private:
+        uint64_t                      _totalHitCount;
+        std::vector<SearchReply::Hit> _hits;
+        std::vector<uint32_t>         _sortIndex;
+        std::vector<char>             _sortData;
+        SearchReply::Coverage         _coverage;
+    public:
+        using SP = std::shared_ptr<const Entry>;
+        Entry(const SearchReply &reply);
+        ~Entry();
+        uint32_t numHits() const { return _hits.size(); }
+        size_t memoryUsage() const;
+        std::unique_ptr<SearchReply> makeReply(uint32_t offset, uint32_t maxHits) const;
+    };
+
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+        Stats() : hits(0), misses(0), evictions(0) { }
+    };
+
+private:
+    using LruParam = vespalib::LruParam<vespalib::string, Entry::SP>;
+    struct Cache : vespalib::lrucache_map<LruParam> {
+        using Parent = vespalib::lrucache_map<LruParam>;
+        using value_type = LruParam::value_type;
+        size_t  _maxBytes;
+        size_t  _sizeBytes;
+        size_t &_evictions;
+        Cache(size_t maxBytes, size_t &evictions);
+        ~Cache();
+        static size_t calcSize(const vespalib::string &key, const Entry &entry);
+        bool removeOldest(const value_type &v) override;
+    };
+
+    vespalib::Lock _lock;
+    Stats          _stats;
+    Version        _version;
+    Cache          _cache;
+    const uint32_t _maxHits;
+
+    void dropAll();
+    bool checkVersion(const Version &version);
+
+public:
+    using UP = std::unique_ptr<QueryResultCache>;
+
+    QueryResultCache(size_t maxBytes, uint32_t maxHits);
+    ~QueryResultCache();
+
+    /**
+     * Number of best hits stored for each query. Requests asking for
+     * hits beyond this limit cannot be answered by the cache.
+     **/
+    uint32_t getMaxHits() const { return _maxHits; }
+
+    /**
+     * Create the cache key for the given request, based on the
+     * serialized query stack, rank profile, location, sort spec, rank
+     * properties and feature overrides.
+     **/
+    static vespalib::string makeKey(const search::engine::SearchRequest &request);
+
+    Entry::SP lookup(const vespalib::string &key, const Version &version);
+    void insert(const vespalib::string &key, const Version &version, Entry::SP entry);
+
+    /**
+     * Observe and reset hit, miss and eviction counts.
+     **/
+    Stats getStats();
+    size_t size() const;
+};
+
+}
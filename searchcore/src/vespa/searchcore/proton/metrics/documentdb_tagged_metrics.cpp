@@ -77,6 +77,23 @@ DocumentDBTaggedMetrics::AttributeMetrics::ResourceUsageMetrics::ResourceUsageMe
 
 DocumentDBTaggedMetrics::AttributeMetrics::ResourceUsageMetrics::~ResourceUsageMetrics() { }
 
+DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
+    : MetricSet("matching", "", "Matching metrics for this document db", parent),
+      resultCache(this)
+{ }
+
+DocumentDBTaggedMetrics::MatchingMetrics::~MatchingMetrics() { }
+
+DocumentDBTaggedMetrics::MatchingMetrics::ResultCacheMetrics::ResultCacheMetrics(MetricSet *parent)
+    : MetricSet("result_cache", "", "Query result cache metrics for all rank profiles in this document db", parent),
+      hits("hits", "", "Number of queries answered by the query result cache", this),
+      misses("misses", "", "Number of cacheable queries not found in the query result cache", this),
+      evictions("evictions", "", "Number of entries removed from the query result cache, "
+              "either to stay within the memory limit or due to changes in the document meta store", this)
+{ }
+
+DocumentDBTaggedMetrics::MatchingMetrics::ResultCacheMetrics::~ResultCacheMetrics() { }
+
 DocumentDBTaggedMetrics::IndexMetrics::IndexMetrics(MetricSet *parent)
     : MetricSet("index", "", "Index metrics (memory and disk) for this document db", parent),
       diskUsage("disk_usage", "", "Disk space usage in bytes", this),
@@ -88,6 +105,7 @@ DocumentDBTaggedMetrics::IndexMetrics::~IndexMetrics() { }
 DocumentDBTaggedMetrics::DocumentDBTaggedMetrics(const vespalib::string &docTypeName)
     : MetricSet("documentdb", {{"documenttype", docTypeName}}, "Document DB metrics", nullptr),
       job(this),
+      matching(this),
       attribute(this),
       index(this),
       ready("ready", this),
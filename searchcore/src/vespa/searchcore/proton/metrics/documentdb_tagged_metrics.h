@@ -3,6 +3,7 @@
 
 #include "attribute_metrics.h"
 #include "memory_usage_metrics.h"
+#include <vespa/metrics/countmetric.h>
 #include <vespa/metrics/metricset.h>
 #include <vespa/metrics/valuemetric.h>
 
@@ -91,7 +92,26 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
         ~IndexMetrics();
     };
 
+    struct MatchingMetrics : metrics::MetricSet
+    {
+        struct ResultCacheMetrics : metrics::MetricSet
+        {
+            metrics::LongCountMetric hits;
+            metrics::LongCountMetric misses;
+            metrics::LongCountMetric evictions;
+
+            ResultCacheMetrics(metrics::MetricSet *parent);
+            ~ResultCacheMetrics();
+        };
+
+        ResultCacheMetrics resultCache;
+
+        MatchingMetrics(metrics::MetricSet *parent);
+        ~MatchingMetrics();
+    };
+
     JobMetrics job;
+    MatchingMetrics matching;
     AttributeMetrics attribute;
     IndexMetrics index;
     SubDBMetrics ready;
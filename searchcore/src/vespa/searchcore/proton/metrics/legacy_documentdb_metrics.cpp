@@ -80,8 +80,10 @@ LegacyDocumentDBMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::Do
     docsMatched("docsmatched", "", "Number of documents matched", this),
     docsRanked("docsranked", "", "Number of documents ranked (first phase)", this),
     docsReRanked("docsreranked", "", "Number of documents re-ranked (second phase)", this),
+    stolenRanges("stolenranges", "", "Number of docid ranges stolen from other match threads", this),
     active_time("activetime", "", "Time spent doing actual work", this),
-    wait_time("waittime", "", "Time spent waiting for other external threads and resources", this)
+    wait_time("waittime", "", "Time spent waiting for other external threads and resources", this),
+    idle_time("idletime", "", "Time spent waiting for more docid ranges to match", this)
 { }
 
 LegacyDocumentDBMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::~DocIdPartition() {}
@@ -92,8 +94,10 @@ LegacyDocumentDBMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::up
     docsMatched.inc(stats.docsMatched());
     docsRanked.inc(stats.docsRanked());
     docsReRanked.inc(stats.docsReRanked());
+    stolenRanges.inc(stats.stolenRanges());
     active_time.addValueBatch(stats.active_time_avg(), stats.active_time_count());
     wait_time.addValueBatch(stats.wait_time_avg(), stats.wait_time_count());
+    idle_time.addValueBatch(stats.idle_time_avg(), stats.idle_time_count());
 }
 
 void
@@ -55,8 +55,10 @@ struct LegacyDocumentDBMetrics : metrics::MetricSet
                 metrics::LongCountMetric docsMatched;
                 metrics::LongCountMetric docsRanked;
                 metrics::LongCountMetric docsReRanked;
+                metrics::LongCountMetric stolenRanges;
                 metrics::DoubleAverageMetric active_time;
                 metrics::DoubleAverageMetric wait_time;
+                metrics::DoubleAverageMetric idle_time;
 
                 using UP = std::unique_ptr<DocIdPartition>;
                 DocIdPartition(const std::string &name, metrics::MetricSet *parent);
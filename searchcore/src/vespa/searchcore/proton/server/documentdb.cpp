@@ -81,6 +81,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
                        IDocumentDBOwner &owner,
                        vespalib::ThreadExecutor &warmupExecutor,
                        vespalib::ThreadStackExecutorBase &summaryExecutor,
+                       vespalib::ThreadExecutor &attributeLoadExecutor,
                        search::transactionlog::Writer &tlsDirectWriter,
                        MetricsWireService &metricsWireService,
                        const FileHeaderContext &fileHeaderContext,
@@ -127,7 +128,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _writeFilter(),
       _feedHandler(_writeService, tlsSpec, docTypeName, _state, *this, _writeFilter, *this, tlsDirectWriter),
       _subDBs(*this, *this, _feedHandler, _docTypeName, _writeService, warmupExecutor,
-              summaryExecutor, fileHeaderContext, metricsWireService, getMetricsCollection(),
+              summaryExecutor, attributeLoadExecutor, fileHeaderContext, metricsWireService, getMetricsCollection(),
               queryLimiter, clock, _configMutex, _baseDir, protonCfg, hwInfo),
       _maintenanceController(_writeService.master(), summaryExecutor, _docTypeName),
       _visibility(_feedHandler, _writeService, _feedView),
@@ -1137,16 +1138,23 @@ updateAttributeMetrics(DocumentDBMetricsCollection &metrics,
 }
 
 void
-updateMatchingMetrics(LegacyDocumentDBMetrics::MatchingMetrics &metrics,
+updateMatchingMetrics(DocumentDBMetricsCollection &metrics,
                       const IDocumentSubDB &ready)
 {
+    LegacyDocumentDBMetrics::MatchingMetrics &legacyMetrics = metrics.getLegacyMetrics().matching;
     MatchingStats stats;
-    for (const auto &kv : metrics.rank_profiles) {
+    for (const auto &kv : legacyMetrics.rank_profiles) {
         MatchingStats rp_stats = ready.getMatcherStats(kv.first);
         kv.second->update(rp_stats);
         stats.add(rp_stats);
     }
-    metrics.update(stats);
+    legacyMetrics.update(stats);
+
+    DocumentDBTaggedMetrics::MatchingMetrics::ResultCacheMetrics &resultCache =
+        metrics.getTaggedMetrics().matching.resultCache;
+    resultCache.hits.inc(stats.resultCacheHits());
+    resultCache.misses.inc(stats.resultCacheMisses());
+    resultCache.evictions.inc(stats.resultCacheEvictions());
 }
 
 void
@@ -1221,6 +1229,7 @@ updateLidSpaceMetrics(MetricSetType &metrics,
 void
 DocumentDB::updateMetrics(DocumentDBMetricsCollection &metrics)
 {
+    updateMatchingMetrics(metrics, *_subDBs.getReadySubDB());
     updateLegacyMetrics(metrics.getLegacyMetrics());
     updateIndexMetrics(metrics, _subDBs.getReadySubDB()->getSearchableStats());
     updateAttributeMetrics(metrics, _subDBs);
@@ -1230,7 +1239,6 @@ DocumentDB::updateMetrics(DocumentDBMetricsCollection &metrics)
 void
 DocumentDB::updateLegacyMetrics(LegacyDocumentDBMetrics &metrics)
 {
-    updateMatchingMetrics(metrics.matching, *_subDBs.getReadySubDB());
     metrics.executor.update(_writeService.getMasterExecutor().getStats());
     metrics.summaryExecutor.update(_writeService.getSummaryExecutor().getStats());
     metrics.indexExecutor.update(_writeService.getIndexExecutor().getStats());
@@ -243,6 +243,7 @@ public:
                IDocumentDBOwner &owner,
                vespalib::ThreadExecutor &warmupExecutor,
                vespalib::ThreadStackExecutorBase &summaryExecutor,
+               vespalib::ThreadExecutor &attributeLoadExecutor,
                search::transactionlog::Writer &tlsDirectWriter,
                MetricsWireService &metricsWireService,
                const search::common::FileHeaderContext &fileHeaderContext,
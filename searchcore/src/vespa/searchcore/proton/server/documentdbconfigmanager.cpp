@@ -171,7 +171,9 @@ deriveConfig(const ProtonConfig::Summary & summary, const ProtonConfig::Flush::M
             .setMaxDiskBloatFactor(std::min(flush.diskbloatfactor, flush.each.diskbloatfactor))
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
             .compact2ActiveFile(log.compact2activefile).compactCompression(deriveCompression(log.compact.compression))
-            .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread);
+            .setFileConfig(fileConfig).setCompactedFileCompression(deriveCompression(log.compact.chunk.compression))
+            .disableCrcOnRead(chunk.skipcrconread)
+            .setDictionarySize(chunk.dictionarysize);
     return LogDocumentStore::Config(config, logConfig);
 }
 
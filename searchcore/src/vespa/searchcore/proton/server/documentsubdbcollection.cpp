@@ -25,6 +25,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
         searchcorespi::index::IThreadingService &writeService,
         vespalib::ThreadExecutor &warmupExecutor,
         vespalib::ThreadStackExecutorBase &summaryExecutor,
+        vespalib::ThreadExecutor &attributeLoadExecutor,
         const search::common::FileHeaderContext &fileHeaderContext,
         MetricsWireService &metricsWireService,
         DocumentDBMetricsCollection &metrics,
@@ -61,6 +62,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                                        fileHeaderContext,
                                        writeService,
                                        summaryExecutor,
+                                       attributeLoadExecutor,
                                        _bucketDB,
                                        *_bucketDBHandler,
                                        metrics.getLegacyMetrics(),
@@ -83,6 +83,7 @@ public:
             searchcorespi::index::IThreadingService &writeService,
             vespalib::ThreadExecutor &warmupExecutor,
             vespalib::ThreadStackExecutorBase &summaryExecutor,
+            vespalib::ThreadExecutor &attributeLoadExecutor,
             const search::common::FileHeaderContext &fileHeaderContext,
             MetricsWireService &metricsWireService,
             DocumentDBMetricsCollection &metrics,
@@ -72,7 +72,8 @@ FastAccessDocSubDB::createAttributeManagerInitializer(const DocumentDBConfig &co
                                                _fileHeaderContext,
                                                _writeService.attributeFieldWriter(),
                                                attrFactory,
-                                               _hwInfo);
+                                               _hwInfo,
+                                               &_attributeLoadExecutor);
     return std::make_shared<AttributeManagerInitializer>(configSerialNum,
                                                          documentMetaStoreInitTask,
                                                          documentMetaStore,
@@ -22,6 +22,7 @@
 #include <vespa/searchcommon/common/schemaconfigurer.h>
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/datatype/documenttype.h>
+#include <vespa/eval/eval/llvm/compile_cache.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/closuretask.h>
 #include <vespa/vespalib/util/host_name.h>
@@ -193,6 +194,7 @@ Proton::Proton(const config::ConfigUri & configUri,
       _protonConfigFetcher(configUri, _protonConfigurer, subscribeTimeout),
       _warmupExecutor(),
       _summaryExecutor(),
+      _attributeLoadExecutor(),
       _queryLimiter(),
       _clock(0.010),
       _threadPool(128 * 1024),
@@ -279,6 +281,11 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
         break;
     }
     vespalib::mkdir(protonConfig.basedir + "/documents", true);
+    if (protonConfig.rankexpression.compilecache.persistent) {
+        vespalib::string compileCacheDir = protonConfig.basedir + "/compilecache";
+        vespalib::mkdir(compileCacheDir, false);
+        vespalib::eval::CompileCache::set_persistent_dir(compileCacheDir);
+    }
     vespalib::chdir(protonConfig.basedir);
     _tls->start();
     _flushEngine.reset(new FlushEngine(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
@@ -302,6 +309,8 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
 
     const size_t summaryThreads = deriveCompactionCompressionThreads(protonConfig, _hwInfo.cpu());
     _summaryExecutor.reset(new vespalib::BlockingThreadStackExecutor(summaryThreads, 128*1024, summaryThreads*16));
+    // Shared by all attribute loads, bounding the number of threads used to load attributes in parallel
+    _attributeLoadExecutor.reset(new vespalib::ThreadStackExecutor(std::max(1u, _hwInfo.cpu().cores()), 128*1024));
     InitializeThreads initializeThreads;
     if (protonConfig.initialize.threads > 0) {
         initializeThreads = std::make_shared<vespalib::ThreadStackExecutor>(protonConfig.initialize.threads, 128 * 1024);
@@ -450,6 +459,7 @@ Proton::~Proton()
     _tls.reset();
     _warmupExecutor.reset();
     _summaryExecutor.reset();
+    _attributeLoadExecutor.reset();
     _clock.stop();
     LOG(debug, "Explicit destructor done");
 }
@@ -561,6 +571,7 @@ Proton::addDocumentDB(const document::DocumentType &docType,
                                       *this,
                                       *_warmupExecutor,
                                       *_summaryExecutor,
+                                      *_attributeLoadExecutor,
                                       *_tls->getTransLogServer(),
                                       *_metricsEngine,
                                       _fileHeaderContext,
@@ -99,6 +99,9 @@ createIndexManagerInitializer(const DocumentDBConfig &configSnapshot,
         (vespaIndexDir,
          searchcorespi::index::WarmupConfig(indexCfg.warmup.time, indexCfg.warmup.unpack),
          indexCfg.maxflushed,
+         indexCfg.fusion.threads,
+         indexCfg.postinglist.blockformat,
+         indexCfg.invert.shards,
          indexCfg.cache.size,
          *schema,
          configSerialNum,
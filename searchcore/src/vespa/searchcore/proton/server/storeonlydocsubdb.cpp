@@ -85,6 +85,7 @@ StoreOnlyDocSubDB::Context::Context(IDocumentSubDBOwner &owner,
                                     const search::common::FileHeaderContext &fileHeaderContext,
                                     searchcorespi::index::IThreadingService &writeService,
                                     vespalib::ThreadStackExecutorBase &summaryExecutor,
+                                    vespalib::ThreadExecutor &attributeLoadExecutor,
                                     std::shared_ptr<BucketDBOwner> bucketDB,
                                     bucketdb::IBucketDBHandlerInitializer & bucketDBHandlerInitializer,
                                     LegacyDocumentDBMetrics &metrics,
@@ -96,6 +97,7 @@ StoreOnlyDocSubDB::Context::Context(IDocumentSubDBOwner &owner,
       _fileHeaderContext(fileHeaderContext),
       _writeService(writeService),
       _summaryExecutor(summaryExecutor),
+      _attributeLoadExecutor(attributeLoadExecutor),
       _bucketDB(bucketDB),
       _bucketDBHandlerInitializer(bucketDBHandlerInitializer),
       _metrics(metrics),
@@ -122,6 +124,7 @@ StoreOnlyDocSubDB::StoreOnlyDocSubDB(const Config &cfg, const Context &ctx)
       _summaryAdapter(),
       _writeService(ctx._writeService),
       _summaryExecutor(ctx._summaryExecutor),
+      _attributeLoadExecutor(ctx._attributeLoadExecutor),
       _metrics(ctx._metrics),
       _iSearchView(),
       _iFeedView(),
@@ -111,6 +111,7 @@ public:
         const search::common::FileHeaderContext &_fileHeaderContext;
         searchcorespi::index::IThreadingService &_writeService;
         vespalib::ThreadStackExecutorBase &_summaryExecutor;
+        vespalib::ThreadExecutor &_attributeLoadExecutor;
         std::shared_ptr<BucketDBOwner> _bucketDB;
         bucketdb::IBucketDBHandlerInitializer &_bucketDBHandlerInitializer;
         LegacyDocumentDBMetrics &_metrics;
@@ -123,6 +124,7 @@ public:
                 const search::common::FileHeaderContext &fileHeaderContext,
                 searchcorespi::index::IThreadingService &writeService,
                 vespalib::ThreadStackExecutorBase &summaryExecutor,
+                vespalib::ThreadExecutor &attributeLoadExecutor,
                 std::shared_ptr<BucketDBOwner> bucketDB,
                 bucketdb::IBucketDBHandlerInitializer &
                 bucketDBHandlerInitializer,
@@ -154,6 +156,7 @@ private:
 protected:
     searchcorespi::index::IThreadingService &_writeService;
     vespalib::ThreadStackExecutorBase       &_summaryExecutor;
+    vespalib::ThreadExecutor                &_attributeLoadExecutor;
     LegacyDocumentDBMetrics                 &_metrics;
     vespalib::VarHolder<ISearchHandler::SP> _iSearchView;
     vespalib::VarHolder<IFeedView::SP>      _iFeedView;
@@ -8,6 +8,7 @@
 #include <vespa/searchlib/queryeval/isourceselector.h>
 #include <vespa/searchlib/util/dirtraverse.h>
 #include <vespa/vespalib/util/jsonwriter.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchcorespi.index.fusionrunner");
@@ -24,17 +25,20 @@ using search::SerialNum;
 using std::vector;
 using vespalib::string;
 using vespalib::JSONStringer;
+using vespalib::ThreadStackExecutor;
 
 namespace searchcorespi::index {
 
 FusionRunner::FusionRunner(const string &base_dir,
                            const Schema &schema,
                            const TuneFileAttributes &tuneFileAttributes,
-                           const FileHeaderContext &fileHeaderContext)
+                           const FileHeaderContext &fileHeaderContext,
+                           uint32_t fusionThreads)
     : _diskLayout(base_dir),
       _schema(schema),
       _tuneFileAttributes(tuneFileAttributes),
-      _fileHeaderContext(fileHeaderContext)
+      _fileHeaderContext(fileHeaderContext),
+      _fusionThreads(std::max(1u, fusionThreads))
 { }
 
 FusionRunner::~FusionRunner() {
@@ -112,7 +116,11 @@ FusionRunner::fuse(const FusionSpec &fusion_spec,
     SelectorArray selector_array;
     readSelectorArray(selector_name, selector_array, id_map, fusion_spec.last_fusion_id);
 
-    if (!operations.runFusion(_schema, fusion_dir, sources, selector_array, lastSerialNum)) {
+    ThreadStackExecutor executor(_fusionThreads, 128 * 1024);
+    bool fusionOk = operations.runFusion(_schema, fusion_dir, sources, selector_array, lastSerialNum, executor);
+    executor.shutdown();
+    executor.sync();
+    if (!fusionOk) {
         return 0;
     }
 
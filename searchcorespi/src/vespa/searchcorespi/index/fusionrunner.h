@@ -34,16 +34,19 @@ class FusionRunner {
     const search::index::Schema _schema;
     const search::TuneFileAttributes _tuneFileAttributes;
     const search::common::FileHeaderContext &_fileHeaderContext;
+    const uint32_t _fusionThreads;
 
 public:
     /**
      * Create a FusionRunner that operates on indexes stored in the
-     * base dir.
+     * base dir.  Index fields are merged in parallel using the given
+     * number of fusion threads.
      **/
     FusionRunner(const vespalib::string &base_dir,
                  const search::index::Schema &schema,
                  const search::TuneFileAttributes &tuneFileAttributes,
-                 const search::common::FileHeaderContext &fileHeaderContext);
+                 const search::common::FileHeaderContext &fileHeaderContext,
+                 uint32_t fusionThreads);
     ~FusionRunner();
 
     /**
@@ -7,6 +7,8 @@
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/searchlib/diskindex/docidmapper.h>
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace searchcorespi {
 namespace index {
 
@@ -42,12 +44,14 @@ struct IIndexMaintainerOperations {
      * @param sources the directories of the input disk indexes.
      * @param selectorArray the array specifying in which input disk index a document is located.
      * @param lastSerialNum the serial number of the last operation in the last input disk index.
+     * @param executor the executor used to merge index fields in parallel.
      */
     virtual bool runFusion(const search::index::Schema &schema,
                            const vespalib::string &outputDir,
                            const std::vector<vespalib::string> &sources,
                            const search::diskindex::SelectorArray &selectorArray,
-                           search::SerialNum lastSerialNum) = 0;
+                           search::SerialNum lastSerialNum,
+                           vespalib::ThreadExecutor &executor) = 0;
 };
 
 } // namespace index
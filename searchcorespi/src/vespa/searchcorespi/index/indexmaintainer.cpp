@@ -825,6 +825,7 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
       _fusion_spec(),
       _fusion_lock(),
       _maxFlushed(config.getMaxFlushed()),
+      _fusionThreads(config.getFusionThreads()),
       _maxFrozen(10),
       _changeGens(),
       _schemaUpdateLock(),
@@ -982,7 +983,7 @@ IndexMaintainer::runFusion(const FusionSpec &fusion_spec)
     if (FastOS_File::Stat(lastSerialFile.c_str(), &statInfo)) {
         serialNum = IndexReadUtilities::readSerialNum(lastFlushDir);
     }
-    FusionRunner fusion_runner(_base_dir, args._schema, tuneFileAttributes, _ctx.getFileHeaderContext());
+    FusionRunner fusion_runner(_base_dir, args._schema, tuneFileAttributes, _ctx.getFileHeaderContext(), _fusionThreads);
     uint32_t new_fusion_id = fusion_runner.fuse(fusion_spec, serialNum, _operations);
     bool ok = (new_fusion_id != 0);
     if (ok) {
@@ -145,6 +145,7 @@ class IndexMaintainer : public IIndexManager,
     FusionSpec     _fusion_spec;		// Protected by FL
     vespalib::Lock _fusion_lock;	// Fusion spec lock (FL)
     uint32_t       _maxFlushed;
+    uint32_t       _fusionThreads;
     uint32_t       _maxFrozen;
     ChangeGens     _changeGens; // Protected by SL + IUL
     vespalib::Lock _schemaUpdateLock;	// Serialize rewrite of schema
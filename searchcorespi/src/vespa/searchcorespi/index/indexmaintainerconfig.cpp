@@ -10,12 +10,14 @@ namespace searchcorespi::index {
 IndexMaintainerConfig::IndexMaintainerConfig(const vespalib::string &baseDir,
                                              const WarmupConfig & warmup,
                                              size_t maxFlushed,
+                                             uint32_t fusionThreads,
                                              const Schema &schema,
                                              const search::SerialNum serialNum,
                                              const TuneFileAttributes &tuneFileAttributes)
     : _baseDir(baseDir),
       _warmup(warmup),
       _maxFlushed(maxFlushed),
+      _fusionThreads(fusionThreads),
       _schema(schema),
       _serialNum(serialNum),
       _tuneFileAttributes(tuneFileAttributes)
@@ -17,6 +17,7 @@ private:
     const vespalib::string _baseDir;
     const WarmupConfig _warmup;
     const size_t _maxFlushed;
+    const uint32_t _fusionThreads;
     const search::index::Schema _schema;
     const search::SerialNum _serialNum;
     const search::TuneFileAttributes _tuneFileAttributes;
@@ -25,6 +26,7 @@ public:
     IndexMaintainerConfig(const vespalib::string &baseDir,
                           const WarmupConfig & warmup,
                           size_t maxFlushed,
+                          uint32_t fusionThreads,
                           const search::index::Schema &schema,
                           const search::SerialNum serialNum,
                           const search::TuneFileAttributes &tuneFileAttributes);
@@ -59,6 +61,13 @@ public:
     size_t getMaxFlushed() const {
         return _maxFlushed;
     }
+
+    /**
+     * Returns the number of threads used to merge index fields during fusion.
+     */
+    uint32_t getFusionThreads() const {
+        return _fusionThreads;
+    }
 };
 
 }
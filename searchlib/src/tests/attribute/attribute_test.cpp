@@ -245,6 +245,7 @@ private:
     void testReaderDuringLastUpdate();
 
     void testPendingCompaction();
+    void testPagedLoad();
 
 public:
     AttributeTest() { }
@@ -2315,6 +2316,50 @@ AttributeTest::testPendingCompaction()
     populateSimple(iv, 1, 2);  // should not trigger new compaction
 }
 
+void
+AttributeTest::testPagedLoad()
+{
+    constexpr uint32_t numDocs = 5000;
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    {
+        AttributePtr v = createAttribute("paged_int32", cfg);
+        IntegerAttribute &iv = static_cast<IntegerAttribute &>(*v.get());
+        addDocs(v, numDocs);
+        for (uint32_t doc = 0; doc < numDocs; ++doc) {
+            EXPECT_TRUE(iv.update(doc, doc * 3));
+        }
+        commit(v);
+        EXPECT_TRUE(v->save());
+    }
+    cfg.setPaged(true);
+    {
+        AttributePtr v = createAttribute("paged_int32", cfg);
+        EXPECT_TRUE(v->load());
+        EXPECT_EQUAL(numDocs, v->getNumDocs());
+        for (uint32_t doc = 0; doc < numDocs; ++doc) {
+            EXPECT_EQUAL(static_cast<int64_t>(doc * 3), v->getInt(doc));
+        }
+        // Writes to mapped pages are private, growth copies to memory
+        IntegerAttribute &iv = static_cast<IntegerAttribute &>(*v.get());
+        EXPECT_TRUE(iv.update(10, 7));
+        AttributeVector::DocId docId;
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            EXPECT_TRUE(v->addDoc(docId));
+        }
+        EXPECT_TRUE(iv.update(numDocs + 10, 8));
+        commit(v);
+        EXPECT_EQUAL(7, v->getInt(10));
+        EXPECT_EQUAL(33, v->getInt(11));
+        EXPECT_EQUAL(8, v->getInt(numDocs + 10));
+    }
+    {
+        AttributePtr v = createAttribute("paged_int32", cfg);
+        EXPECT_TRUE(v->load());
+        EXPECT_EQUAL(numDocs, v->getNumDocs());
+        EXPECT_EQUAL(30, v->getInt(10));
+    }
+}
+
 void
 deleteDataDirs()
 {
@@ -2361,6 +2406,7 @@ int AttributeTest::Main()
     TEST_DO(requireThatAddressSpaceUsageIsReported());
     testReaderDuringLastUpdate();
     TEST_DO(testPendingCompaction());
+    TEST_DO(testPagedLoad());
 
     deleteDataDirs();
     TEST_DONE();
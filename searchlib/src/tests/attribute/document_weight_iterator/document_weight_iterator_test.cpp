@@ -167,6 +167,26 @@ TEST_F("require that string iterators are created correctly", StringFixture) {
     verify_posting(*f1.api, "foo");
 }
 
+TEST("require that max weight is available per posting list block") {
+    AttributeVector::SP attr = make_attribute(BasicType::INT64, CollectionType::WSET, true);
+    add_docs(attr);
+    IntegerAttribute *int_attr = static_cast<IntegerAttribute *>(attr.get());
+    for (uint32_t docid = 1; docid < 100; ++docid) {
+        set_doc(int_attr, docid, int64_t(111), docid);
+    }
+    const IDocumentWeightAttribute *api = attr->asDocumentWeightAttribute();
+    auto result = api->lookup("111");
+    EXPECT_EQUAL(99, result.max_weight);
+    DocumentWeightIterator itr = api->create(result.posting_idx);
+    ASSERT_TRUE(itr.valid());
+    EXPECT_LESS(itr.getLeafLastKey(), 99u);
+    for (; itr.valid(); ++itr) {
+        // weights increase with docid, so the block max is found at the end of the block
+        EXPECT_LESS_EQUAL(itr.getKey(), itr.getLeafLastKey());
+        EXPECT_EQUAL(int32_t(itr.getLeafLastKey()), itr.getLeafAggregated().getMax());
+    }
+}
+
 class Verifier : public search::test::SearchIteratorVerifier {
 public:
     Verifier();
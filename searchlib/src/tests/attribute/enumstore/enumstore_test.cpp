@@ -4,6 +4,7 @@ LOG_SETUP("enumstore_test");
 #include <vespa/vespalib/testkit/testapp.h>
 //#define LOG_ENUM_STORE
 #include <vespa/searchlib/attribute/enumstore.hpp>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <limits>
 #include <string>
 #include <iostream>
@@ -59,6 +60,10 @@ private:
     template <typename EnumStoreType>
     void testReset(bool hasPostings);
 
+    void testHashIndex();
+    template <typename EnumStoreType>
+    void testHashIndex(bool hasPostings);
+
     void testHoldListAndGeneration();
     void testMemoryUsage();
     void requireThatAddressSpaceUsageIsReported();
@@ -474,6 +479,76 @@ EnumStoreTest::testCompaction(bool hasPostings, bool disableReEnumerate)
     EXPECT_EQUAL(3 * entrySize, idx.offset());
 }
 
+template <typename EnumStoreType>
+void
+EnumStoreTest::testHashIndex(bool hasPostings)
+{
+    EnumStoreType ses(100, hasPostings, true);
+    EXPECT_TRUE(ses.hasHashIndex());
+    EnumIndex idx;
+    std::vector<EnumIndex> indices;
+    std::vector<std::string> unique;
+    unique.push_back("Foo");
+    unique.push_back("bar");
+    unique.push_back("foo");
+    for (uint32_t i = 0; i < 200; ++i) {
+        unique.push_back(vespalib::make_string("enum%03u", i));
+    }
+
+    for (uint32_t i = 0; i < unique.size(); ++i) {
+        ses.addEnum(unique[i].c_str(), idx);
+        ses.incRefCount(idx);
+        indices.push_back(idx);
+        ses.addEnum(unique[i].c_str(), idx);
+        EXPECT_TRUE(idx == indices[i]);
+    }
+    ses.freezeTree();
+    EXPECT_TRUE(!ses.findIndex("FOO", idx));
+    EXPECT_TRUE(!ses.findIndex("baz", idx));
+    for (uint32_t i = 0; i < unique.size(); ++i) {
+        EXPECT_TRUE(ses.findIndex(unique[i].c_str(), idx));
+        EXPECT_TRUE(idx == indices[i]);
+        EnumStoreBase::EnumHandle e = 0;
+        EXPECT_TRUE(ses.findEnum(unique[i].c_str(), e));
+        EXPECT_TRUE(e == indices[i].ref());
+    }
+
+    // drop every other value and verify that only the remaining are found
+    for (uint32_t i = 0; i < unique.size(); i += 2) {
+        ses.decRefCount(indices[i]);
+    }
+    ses.freeUnusedEnums(hasPostings);
+    for (uint32_t i = 0; i < unique.size(); ++i) {
+        EXPECT_EQUAL((i % 2) != 0, ses.findIndex(unique[i].c_str(), idx));
+    }
+
+    // values moved by compaction are found at their new location
+    EXPECT_TRUE(ses.performCompaction(1000));
+    ses.freezeTree();
+    for (uint32_t i = 1; i < unique.size(); i += 2) {
+        EXPECT_TRUE(ses.findIndex(unique[i].c_str(), idx));
+        EXPECT_NOT_EQUAL(indices[i].bufferId(), idx.bufferId());
+        EXPECT_TRUE(strcmp(unique[i].c_str(), ses.getValue(idx)) == 0);
+    }
+    ses.addEnum("foo", idx);
+    EXPECT_TRUE(ses.findIndex("foo", idx));
+}
+
+void
+EnumStoreTest::testHashIndex()
+{
+    testHashIndex<StringEnumStore>(false);
+    testHashIndex<StringEnumStore>(true);
+
+    FloatEnumStore fes(1000, false, true);
+    testFloatEnumStore<FloatEnumStore, float>(fes);
+    EnumIndex zero;
+    EnumIndex idx;
+    fes.addEnum(0.0f, zero);
+    EXPECT_TRUE(fes.findIndex(-0.0f, idx));
+    EXPECT_TRUE(idx == zero);
+}
+
 void
 EnumStoreTest::testReset()
 {
@@ -868,6 +943,7 @@ EnumStoreTest::Main()
     testAddEnum();
     testCompaction();
     testReset();
+    testHashIndex();
     testHoldListAndGeneration();
     testMemoryUsage();
     TEST_DO(requireThatAddressSpaceUsageIsReported());
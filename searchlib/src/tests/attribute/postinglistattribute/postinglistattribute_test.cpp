@@ -15,6 +15,7 @@
 #include <vespa/searchlib/attribute/attributevector.hpp>
 #include <vespa/vespalib/util/compress.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/fastos/file.h>
 #include <iostream>
 #include <vespa/log/log.h>
@@ -169,6 +170,14 @@ private:
     void testStringFold();
     void testDupValuesInIntArray();
     void testDupValuesInStringArray();
+
+    template <typename VectorType>
+    void populateMany(VectorType &v, uint32_t numDocs);
+    template <typename VectorType, typename ValueType>
+    void checkSameSearch(AttributePtr &ptr1, AttributePtr &ptr2, ValueType value);
+    template <typename VectorType>
+    void testParallelLoad(const Config &cfg, const vespalib::string &name, bool enumerated);
+    void testParallelLoad();
 public:
     int Main() override;
 };
@@ -1129,6 +1138,135 @@ PostingListAttributeTest::testDupValuesInStringArray()
 }
 
 
+template <>
+void
+PostingListAttributeTest::populateMany<IntegerAttribute>(IntegerAttribute &v, uint32_t numDocs)
+{
+    for (uint32_t doc = 1; doc < numDocs; ++doc) {
+        // Few common values with long posting lists and many rare values
+        int32_t common = doc % 7;
+        int32_t rare = 1000 + doc / 3;
+        if (v.hasMultiValue()) {
+            v.append(doc, common, 1 + doc % 5);
+            v.append(doc, rare, 2);
+            v.append(doc, common + 1, -1);
+        } else {
+            EXPECT_TRUE(v.update(doc, (doc % 4 == 0) ? rare : common));
+        }
+    }
+    v.commit();
+}
+
+template <>
+void
+PostingListAttributeTest::populateMany<StringAttribute>(StringAttribute &v, uint32_t numDocs)
+{
+    for (uint32_t doc = 1; doc < numDocs; ++doc) {
+        vespalib::asciistream common;
+        vespalib::asciistream rare;
+        common << ((doc % 2 == 0) ? "Common" : "common") << doc % 7;
+        rare << "rare" << doc / 3;
+        if (v.hasMultiValue()) {
+            v.append(doc, common.str(), 1 + doc % 5);
+            v.append(doc, rare.str(), 2);
+        } else {
+            EXPECT_TRUE(v.update(doc, (doc % 4 == 0) ? rare.str() : common.str()));
+        }
+    }
+    v.commit();
+}
+
+template <typename VectorType, typename ValueType>
+void
+PostingListAttributeTest::checkSameSearch(AttributePtr &ptr1, AttributePtr &ptr2, ValueType value)
+{
+    std::stringstream ss1;
+    std::stringstream ss2;
+    TermFieldMatchData md1;
+    TermFieldMatchData md2;
+    SearchContextPtr sc1 = getSearch<VectorType, ValueType>(as<VectorType>(ptr1), value, false);
+    SearchContextPtr sc2 = getSearch<VectorType, ValueType>(as<VectorType>(ptr2), value, false);
+    sc1->fetchPostings(true);
+    sc2->fetchPostings(true);
+    SearchBasePtr sb1 = sc1->createIterator(&md1, true);
+    SearchBasePtr sb2 = sc2->createIterator(&md2, true);
+    toStr(ss1, *sb1, &md1);
+    toStr(ss2, *sb2, &md2);
+    EXPECT_EQUAL(ss1.str(), ss2.str());
+}
+
+template <typename VectorType>
+void
+PostingListAttributeTest::testParallelLoad(const Config &cfg, const vespalib::string &name, bool enumerated)
+{
+    LOG(info, "testParallelLoad: vector '%s', enumerated=%s", name.c_str(), enumerated ? "true" : "false");
+    const uint32_t numDocs = 100000;
+    AttributePtr ptr1 = AttributeFactory::createAttribute(name + "_1", cfg);
+    AttributePtr ptr2 = AttributeFactory::createAttribute(name + "_2", cfg);
+    AttributePtr ptr3 = AttributeFactory::createAttribute(name + "_3", cfg);
+    addDocs(ptr1, numDocs);
+    populateMany(as<VectorType>(ptr1), numDocs);
+    ptr1->enableEnumeratedSave(enumerated);
+    ASSERT_TRUE(ptr1->saveAs(ptr2->getBaseFileName()));
+    ASSERT_TRUE(ptr1->saveAs(ptr3->getBaseFileName()));
+    ASSERT_TRUE(ptr2->load());
+    vespalib::ThreadStackExecutor executor(4, 128 * 1024);
+    ASSERT_TRUE(ptr3->load(&executor));
+    ASSERT_EQUAL(numDocs, ptr3->getNumDocs());
+    typedef typename VectorType::WeightedString WeightedString;
+    std::vector<WeightedString> buf2(16);
+    std::vector<WeightedString> buf3(16);
+    for (uint32_t doc = 0; doc < numDocs; ++doc) {
+        uint32_t cnt2 = ptr2->get(doc, &buf2[0], buf2.size());
+        uint32_t cnt3 = ptr3->get(doc, &buf3[0], buf3.size());
+        ASSERT_EQUAL(cnt2, cnt3);
+        for (uint32_t i = 0; i < cnt2; ++i) {
+            EXPECT_EQUAL(buf2[i].getValue(), buf3[i].getValue());
+            EXPECT_EQUAL(buf2[i].getWeight(), buf3[i].getWeight());
+        }
+    }
+    for (uint32_t doc = 1; doc < numDocs; doc += 997) {
+        std::vector<WeightedString> buf1(16);
+        uint32_t cnt1 = ptr1->get(doc, &buf1[0], buf1.size());
+        for (uint32_t i = 0; i < cnt1; ++i) {
+            TEST_DO((checkSameSearch<VectorType, vespalib::string>(ptr2, ptr3, buf1[i].getValue())));
+        }
+    }
+    ptr1->enableEnumeratedSave(false);
+}
+
+void
+PostingListAttributeTest::testParallelLoad()
+{
+    for (bool enumerated : {false, true}) {
+        {
+            Config cfg(Config(BasicType::INT32, CollectionType::SINGLE));
+            cfg.setFastSearch(true);
+            testParallelLoad<IntegerAttribute>(cfg, "psint32", enumerated);
+        }
+        {
+            Config cfg(Config(BasicType::INT32, CollectionType::WSET));
+            cfg.setFastSearch(true);
+            testParallelLoad<IntegerAttribute>(cfg, "pwsint32", enumerated);
+        }
+        {
+            Config cfg(Config(BasicType::INT32, CollectionType::ARRAY));
+            cfg.setFastSearch(true);
+            testParallelLoad<IntegerAttribute>(cfg, "paint32", enumerated);
+        }
+        {
+            Config cfg(Config(BasicType::STRING, CollectionType::SINGLE));
+            cfg.setFastSearch(true);
+            testParallelLoad<StringAttribute>(cfg, "psstr", enumerated);
+        }
+        {
+            Config cfg(Config(BasicType::STRING, CollectionType::WSET));
+            cfg.setFastSearch(true);
+            testParallelLoad<StringAttribute>(cfg, "pwsstr", enumerated);
+        }
+    }
+}
+
 int
 PostingListAttributeTest::Main()
 {
@@ -1141,6 +1279,7 @@ PostingListAttributeTest::Main()
     testStringFold();
     testDupValuesInIntArray();
     testDupValuesInStringArray();
+    TEST_DO(testParallelLoad());
 
     TEST_DONE();
 }
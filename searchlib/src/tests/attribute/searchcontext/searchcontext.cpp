@@ -73,6 +73,17 @@ public:
 DocSet::DocSet() : std::set<uint32_t>() {}
 DocSet::~DocSet() {}
 
+DocSet
+collectHits(SearchIterator & sb, uint32_t begin, uint32_t end)
+{
+    DocSet hits;
+    sb.initRange(begin, end);
+    for (sb.seek(begin); !sb.isAtEnd(); sb.seek(sb.getDocId() + 1)) {
+        hits.put(sb.getDocId());
+    }
+    return hits;
+}
+
 template <typename V, typename T>
 class PostingList
 {
@@ -181,6 +192,28 @@ private:
                    (dynamic_cast<const queryeval::EmptySearch *>(&base) != NULL);
         }
     };
+    class ScanFilterIteratorTester : public IteratorTester
+    {
+    public:
+        virtual bool matches(const SearchIterator & base) const override {
+            return dynamic_cast<const ScanFilterAttributeIterator *>(&base) != NULL;
+        }
+    };
+    class FilterAttributeIteratorTester : public IteratorTester
+    {
+    public:
+        virtual bool matches(const SearchIterator & base) const override {
+            return (dynamic_cast<const FilterAttributeIterator *>(&base) != NULL) &&
+                   (dynamic_cast<const ScanFilterAttributeIterator *>(&base) == NULL);
+        }
+    };
+    class StrictFilterIteratorTester : public IteratorTester
+    {
+    public:
+        virtual bool matches(const SearchIterator & base) const override {
+            return dynamic_cast<const FilterAttributeIterator *>(&base) != NULL;
+        }
+    };
     class AttributePostingListIteratorTester : public IteratorTester
     {
     public:
@@ -273,6 +306,8 @@ private:
                                                        int64_t maxValue);
     void requireThatOutOfBoundsSearchTermGivesZeroHits();
 
+    void requireThatStrictFilterSearchScansAllDocs();
+
     // init maps with config objects
     void initIntegerConfig();
     void initFloatConfig();
@@ -834,6 +869,18 @@ SearchContextTest::testSearchIterator()
         noHits = getSearch(*ptr.get(), 30);
         testNonStrictSearchIterator(*threeHits, *noHits, tester);
     }
+    {
+        Config cfg(BasicType::INT32, CollectionType::SINGLE);
+        cfg.setIsFilter(true);
+        AttributePtr ptr = AttributeFactory::createAttribute("s-filter-int32", cfg);
+        fillForSearchIteratorTest(dynamic_cast<IntegerAttribute *>(ptr.get()));
+
+        // the term with three hits is scanned, the one without hits is not
+        SearchContextPtr threeHits = getSearch(*ptr.get(), 10);
+        SearchContextPtr noHits = getSearch(*ptr.get(), 30);
+        StrictFilterIteratorTester tester;
+        testStrictSearchIterator(*threeHits, *noHits, tester);
+    }
     {
         Config cfg(BasicType::UINT2, CollectionType::SINGLE);
         AttributePtr ptr = AttributeFactory::createAttribute("s-uint2", cfg);
@@ -1787,6 +1834,53 @@ SearchContextTest::requireThatOutOfBoundsSearchTermGivesZeroHits()
     }
 }
 
+void
+SearchContextTest::requireThatStrictFilterSearchScansAllDocs()
+{
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    cfg.setIsFilter(true);
+    AttributePtr a = AttributeFactory::createAttribute("s-filter-int32-scan", cfg);
+    IntegerAttribute &ia = dynamic_cast<IntegerAttribute &>(*a);
+    addReservedDoc(*a);
+    a->addDocs(199);
+    DocSet expected;
+    for (uint32_t doc = 1; doc < 200; ++doc) {
+        ia.update(doc, doc % 10);
+        if ((doc % 10) >= 3 && (doc % 10) <= 5) {
+            expected.put(doc);
+        }
+    }
+    ia.commit(true);
+    performSearch(ia, "[3;5]", expected, QueryTermSimple::WORD);
+    performSearch(ia, "7", DocSet().put(7).put(17).put(27).put(37).put(47).put(57).put(67).put(77).
+                  put(87).put(97).put(107).put(117).put(127).put(137).put(147).put(157).put(167).
+                  put(177).put(187).put(197), QueryTermSimple::WORD);
+    performSearch(ia, "[10;20]", DocSet(), QueryTermSimple::WORD);
+
+    // only terms with a high estimated hit ratio are scanned
+    TermFieldMatchData dummy;
+    SearchContextPtr few = getSearch(ia, "[3;5]");
+    few->fetchPostings(true);
+    EXPECT_TRUE(FilterAttributeIteratorTester().matches(*few->createIterator(&dummy, true)));
+    SearchContextPtr many = getSearch(ia, "[1;8]");
+    many->fetchPostings(true);
+    EXPECT_TRUE(ScanFilterIteratorTester().matches(*many->createIterator(&dummy, true)));
+
+    // each iterator from the same search context scans only its own range
+    SearchBasePtr first = many->createIterator(&dummy, true);
+    SearchBasePtr second = many->createIterator(&dummy, true);
+    DocSet firstHits;
+    DocSet secondHits;
+    for (uint32_t doc = 1; doc < 200; ++doc) {
+        if ((doc % 10) >= 1 && (doc % 10) <= 8) {
+            ((doc < 100) ? firstHits : secondHits).put(doc);
+        }
+    }
+    EXPECT_TRUE(firstHits == collectHits(*first, 1, 100));
+    EXPECT_TRUE(secondHits == collectHits(*second, 100, 300));
+    EXPECT_TRUE(DocSet().put(151).put(152).put(153).put(154).put(155).put(156).put(157).put(158) ==
+                collectHits(*first, 150, 160));
+}
 
 void
 SearchContextTest::initIntegerConfig()
@@ -1918,6 +2012,7 @@ SearchContextTest::Main()
     TEST_DO(requireThatInvalidSearchTermGivesZeroHits());
     TEST_DO(requireThatFlagAttributeHandlesTheByteRange());
     TEST_DO(requireThatOutOfBoundsSearchTermGivesZeroHits());
+    TEST_DO(requireThatStrictFilterSearchScansAllDocs());
 
     TEST_DONE();
 }
@@ -7,6 +7,7 @@
 #include <vespa/searchlib/attribute/attributeguard.h>
 #include <vespa/eval/tensor/tensor_factory.h>
 #include <vespa/eval/tensor/default_tensor.h>
+#include <vespa/eval/tensor/dense/dense_tensor_view.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/fastos/file.h>
@@ -24,6 +25,7 @@ using vespalib::tensor::TensorCells;
 using vespalib::tensor::DenseTensorCells;
 using vespalib::tensor::TensorDimensions;
 using vespalib::tensor::TensorFactory;
+using vespalib::tensor::DenseTensorView;
 
 namespace vespalib {
 namespace tensor {
@@ -41,6 +43,8 @@ vespalib::string denseSpec("tensor(x[2],y[3])");
 vespalib::string denseAbstractSpec_xy("tensor(x[],y[])");
 vespalib::string denseAbstractSpec_x("tensor(x[2],y[])");
 vespalib::string denseAbstractSpec_y("tensor(x[],y[3])");
+vespalib::string denseFloatSpec("tensor<float>(x[2],y[3])");
+vespalib::string denseInt8Spec("tensor<int8>(x[2],y[3])");
 
 struct Fixture
 {
@@ -241,6 +245,7 @@ struct Fixture
     void testCompaction();
     void testTensorTypeFileHeaderTag();
     void testEmptyTensor();
+    void testLowerPrecisionCells();
 };
 
 
@@ -371,6 +376,28 @@ Fixture::testEmptyTensor()
 }
 
 
+void
+Fixture::testLowerPrecisionCells()
+{
+    setTensor(1, *createDenseTensor({ {{{"x",0},{"y",1}}, 11},
+                                      {{{"x",1},{"y",2}}, -3} }));
+    TEST_DO(save());
+    TEST_DO(load());
+    AttributeGuard guard(_attr);
+    Tensor::UP actTensor = _tensorAttr->getTensor(1);
+    ASSERT_TRUE(static_cast<bool>(actTensor));
+    EXPECT_EQUAL(ValueType::from_spec(_typeSpec), actTensor->getType());
+    const DenseTensorView &view = dynamic_cast<const DenseTensorView &>(*actTensor);
+    EXPECT_TRUE(view.typedCells().type == _cfg.tensorType().cell_type());
+    DenseTensorView::Cells buffer;
+    DenseTensorView::CellsRef cells = view.decodeCells(buffer);
+    ASSERT_EQUAL(6u, cells.size());
+    EXPECT_EQUAL(11.0, cells[1]);
+    EXPECT_EQUAL(-3.0, cells[5]);
+    EXPECT_EQUAL(8.0, actTensor->sum());
+}
+
+
 TEST_F("Test empty sparse tensor attribute", Fixture("tensor()"))
 {
     f.testEmptyAttribute();
@@ -433,4 +460,18 @@ TEST("Test dense tensors with dense tensor attribute with unbound y dim")
     testAll([]() { return std::make_shared<Fixture>(denseAbstractSpec_y, true); });
 }
 
+TEST("Test dense tensors with float cells in dense tensor attribute")
+{
+    Fixture f(denseFloatSpec, true);
+    TEST_DO(f.testLowerPrecisionCells());
+    TEST_DO(f.testTensorTypeFileHeaderTag());
+}
+
+TEST("Test dense tensors with int8 cells in dense tensor attribute")
+{
+    Fixture f(denseInt8Spec, true);
+    TEST_DO(f.testLowerPrecisionCells());
+    TEST_DO(f.testTensorTypeFileHeaderTag());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); vespalib::unlink("test.dat"); }
@@ -185,6 +185,7 @@ private:
     void requireThatTreeRemoveStealWorks();
     void requireThatNodeRemoveWorks();
     void requireThatNodeLowerBoundWorks();
+    void requireThatNodeKeySearchByCountingWorks();
     void requireThatWeCanInsertAndRemoveFromTree();
     void requireThatSortedTreeInsertWorks();
     void requireThatCornerCaseTreeFindWorks();
@@ -669,6 +670,30 @@ Test::requireThatNodeLowerBoundWorks()
     cleanup(g, m, nPair.ref, n);
 }
 
+void
+Test::requireThatNodeKeySearchByCountingWorks()
+{
+    using Less = std::less<uint32_t>;
+    using CountingSearch = BTreeNodeKeySearch<uint32_t, Less>;
+    using BinarySearch = BTreeNodeKeySearch<uint32_t, Less, false>;
+    uint32_t keys[16];
+    for (uint32_t i = 0; i < 16; ++i) {
+        keys[i] = 10 + i * 2;
+    }
+    for (uint32_t eidx = 0; eidx <= 16; ++eidx) {
+        for (uint32_t sidx = 0; sidx <= eidx; ++sidx) {
+            for (uint32_t key = 8; key < 45; ++key) {
+                EXPECT_EQUAL(BinarySearch::lower_bound(keys, sidx, eidx, key, Less()),
+                             CountingSearch::lower_bound(keys, sidx, eidx, key, Less()));
+                EXPECT_EQUAL(BinarySearch::upper_bound(keys, sidx, eidx, key, Less()),
+                             CountingSearch::upper_bound(keys, sidx, eidx, key, Less()));
+            }
+        }
+    }
+    EXPECT_EQUAL(3u, CountingSearch::lower_bound(keys, 0, 16, 16, Less()));
+    EXPECT_EQUAL(4u, CountingSearch::upper_bound(keys, 0, 16, 16, Less()));
+}
+
 void
 generateData(std::vector<LeafPair> & data, size_t numEntries)
 {
@@ -1494,6 +1519,7 @@ Test::Main()
     requireThatTreeRemoveStealWorks();
     requireThatNodeRemoveWorks();
     requireThatNodeLowerBoundWorks();
+    requireThatNodeKeySearchByCountingWorks();
     requireThatWeCanInsertAndRemoveFromTree();
     requireThatSortedTreeInsertWorks();
     requireThatCornerCaseTreeFindWorks();
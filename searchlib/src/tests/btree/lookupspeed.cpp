@@ -0,0 +1,202 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/btree/btreeroot.h>
+#include <vespa/searchlib/btree/btreebuilder.h>
+#include <vespa/searchlib/btree/btreenodeallocator.h>
+#include <vespa/searchlib/btree/btree.h>
+#include <vespa/searchlib/btree/btreestore.h>
+#include <vespa/searchlib/util/rand48.h>
+#include <vespa/searchlib/btree/btreenodeallocator.hpp>
+#include <vespa/searchlib/btree/btreenode.hpp>
+#include <vespa/searchlib/btree/btreenodestore.hpp>
+#include <vespa/searchlib/btree/btreeiterator.hpp>
+#include <vespa/searchlib/btree/btreeroot.hpp>
+#include <vespa/searchlib/btree/btreebuilder.hpp>
+#include <vespa/searchlib/btree/btree.hpp>
+#include <vespa/searchlib/btree/btreestore.hpp>
+
+#include <vespa/fastos/app.h>
+#include <vespa/fastos/timestamp.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("lookupspeed");
+
+namespace search {
+namespace btree {
+
+enum class LookupMethod
+{
+    LOWER_BOUND,
+    SEEK
+};
+
+/*
+ * Comparator with the same ordering as std::less<uint32_t>, used to
+ * force binary search for key position within nodes.
+ */
+struct BinarySearchLess
+{
+    bool operator()(uint32_t lhs, uint32_t rhs) const { return lhs < rhs; }
+};
+
+class LookupSpeed : public FastOS_Application
+{
+    template <typename Traits, typename CompareT, LookupMethod lookupMethod>
+    void
+    workLoop(int loops, bool enableLowerBound, bool enableSeek,
+             int leafSlots, const char *searchName);
+    void usage();
+    int Main() override;
+};
+
+
+namespace {
+
+const char *lookupMethodName(LookupMethod lookupMethod)
+{
+    switch (lookupMethod) {
+    case LookupMethod::LOWER_BOUND:
+        return "lower_bound";
+    default:
+        return "seek";
+    }
+}
+
+}
+
+template <typename Traits, typename CompareT, LookupMethod lookupMethod>
+void
+LookupSpeed::workLoop(int loops, bool enableLowerBound, bool enableSeek,
+                      int leafSlots, const char *searchName)
+{
+    if ((lookupMethod == LookupMethod::LOWER_BOUND && !enableLowerBound) ||
+        (lookupMethod == LookupMethod::SEEK && !enableSeek) ||
+        (leafSlots != 0 &&
+         leafSlots != static_cast<int>(Traits::LEAF_SLOTS)))
+        return;
+    using Tree = BTree<uint32_t, int32_t, btree::NoAggregated, CompareT, Traits>;
+    using Builder = typename Tree::Builder;
+    using ConstIterator = typename Tree::ConstIterator;
+    Tree tree;
+    Builder builder(tree.getAllocator());
+    size_t numEntries = 10000000;
+    size_t numLookups = 10000000;
+    for (size_t i = 0; i < numEntries; ++i) {
+        builder.insert(i * 3, 0);
+    }
+    tree.assign(builder);
+    assert(numEntries == tree.size());
+    assert(tree.isValid());
+    std::vector<uint32_t> keys;
+    keys.reserve(numLookups);
+    Rand48 rnd;
+    rnd.srand48(42);
+    for (size_t i = 0; i < numLookups; ++i) {
+        keys.push_back(rnd.lrand48() % (numEntries * 3));
+    }
+    if (lookupMethod == LookupMethod::SEEK) {
+        std::sort(keys.begin(), keys.end());
+    }
+    for (int l = 0; l < loops; ++l) {
+        fastos::TimeStamp before = fastos::ClockSystem::now();
+        uint64_t sum = 0;
+        ConstIterator itr(BTreeNode::Ref(), tree.getAllocator());
+        itr.begin(tree.getRoot());
+        for (uint32_t key : keys) {
+            if (lookupMethod == LookupMethod::LOWER_BOUND) {
+                itr.lower_bound(tree.getRoot(), key, CompareT());
+            } else if (itr.valid() && itr.getKey() < key) {
+                itr.seek(key, CompareT());
+            }
+            if (itr.valid()) {
+                sum += itr.getKey();
+            }
+        }
+        fastos::TimeStamp after = fastos::ClockSystem::now();
+        double used = after.sec() - before.sec();
+        printf("Elapsed time for %ld lookups is %8.5f, "
+               "method=%s, search=%s, fanout=%u,%u, sum=%" PRIu64 "\n",
+               numLookups,
+               used,
+               lookupMethodName(lookupMethod),
+               searchName,
+               static_cast<int>(Traits::LEAF_SLOTS),
+               static_cast<int>(Traits::INTERNAL_SLOTS),
+               sum);
+        fflush(stdout);
+    }
+}
+
+
+void
+LookupSpeed::usage()
+{
+    printf("lookupspeed "
+           "[-F <leafSlots>] "
+           "[-c <numLoops>] "
+           "[-l] "
+           "[-s]\n");
+}
+
+int
+LookupSpeed::Main()
+{
+    int argi;
+    char c;
+    const char *optArg;
+    argi = 1;
+    int loops = 1;
+    bool lowerBound = false;
+    bool seek = false;
+    int leafSlots = 0;
+    while ((c = GetOpt("F:c:ls", optArg, argi)) != -1) {
+        switch (c) {
+        case 'F':
+            leafSlots = atoi(optArg);
+            break;
+        case 'c':
+            loops = atoi(optArg);
+            break;
+        case 'l':
+            lowerBound = true;
+            break;
+        case 's':
+            seek = true;
+            break;
+        default:
+            usage();
+            return 1;
+        }
+    }
+    if (!lowerBound && !seek) {
+        lowerBound = true;
+        seek = true;
+    }
+
+    using Less = std::less<uint32_t>;
+    using SmallTraits = BTreeTraits<8, 8, 20, true>;
+    using DefTraits = BTreeDefaultTraits;
+    using LargeTraits = BTreeTraits<32, 16, 10, true>;
+    using WideTraits = BTreeTraits<32, 32, 7, true>;
+    using HugeTraits = BTreeTraits<64, 16, 10, true>;
+    workLoop<SmallTraits, Less, LookupMethod::LOWER_BOUND>(loops, lowerBound, seek, leafSlots, "count");
+    workLoop<DefTraits, Less, LookupMethod::LOWER_BOUND>(loops, lowerBound, seek, leafSlots, "count");
+    workLoop<DefTraits, BinarySearchLess, LookupMethod::LOWER_BOUND>(loops, lowerBound, seek, leafSlots, "binary");
+    workLoop<LargeTraits, Less, LookupMethod::LOWER_BOUND>(loops, lowerBound, seek, leafSlots, "count");
+    workLoop<LargeTraits, BinarySearchLess, LookupMethod::LOWER_BOUND>(loops, lowerBound, seek, leafSlots, "binary");
+    workLoop<WideTraits, Less, LookupMethod::LOWER_BOUND>(loops, lowerBound, seek, leafSlots, "count");
+    workLoop<HugeTraits, Less, LookupMethod::LOWER_BOUND>(loops, lowerBound, seek, leafSlots, "count");
+    workLoop<SmallTraits, Less, LookupMethod::SEEK>(loops, lowerBound, seek, leafSlots, "count");
+    workLoop<DefTraits, Less, LookupMethod::SEEK>(loops, lowerBound, seek, leafSlots, "count");
+    workLoop<DefTraits, BinarySearchLess, LookupMethod::SEEK>(loops, lowerBound, seek, leafSlots, "binary");
+    workLoop<LargeTraits, Less, LookupMethod::SEEK>(loops, lowerBound, seek, leafSlots, "count");
+    workLoop<LargeTraits, BinarySearchLess, LookupMethod::SEEK>(loops, lowerBound, seek, leafSlots, "binary");
+    workLoop<WideTraits, Less, LookupMethod::SEEK>(loops, lowerBound, seek, leafSlots, "count");
+    workLoop<HugeTraits, Less, LookupMethod::SEEK>(loops, lowerBound, seek, leafSlots, "count");
+    return 0;
+}
+
+}
+}
+
+FASTOS_MAIN(search::btree::LookupSpeed);
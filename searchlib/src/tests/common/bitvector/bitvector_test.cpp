@@ -179,6 +179,8 @@ testAnd(uint32_t offset)
     fill(*v2, B, offset);
     EXPECT_TRUE(assertBV(fill(A, offset), *v1));
     EXPECT_TRUE(assertBV(fill(B, offset), *v2));
+    EXPECT_EQUAL(2u, v1->andCount(*v2));
+    EXPECT_EQUAL(4u, v1->andCount(*v3));
 
     EXPECT_TRUE(assertBV(fill(A, offset), *v3));
     v3->andWith(*v2);
@@ -289,10 +291,47 @@ TEST("requireThatSequentialOperationsOnPartialWorks")
     AllocatedBitVector full(1000);
     full.setInterval(0, 1000);
     EXPECT_EQUAL(5u, p2.countTrueBits());
+    EXPECT_EQUAL(5u, p2.andCount(full));
     p2.orWith(full);
     EXPECT_EQUAL(202u, p2.countTrueBits());
 }
 
+void
+verifyAndCount(const BitVector & lhs, const BitVector & rhs)
+{
+    BitVector::UP expect((lhs.getStartIndex() == 0)
+                         ? BitVector::create(lhs)
+                         : BitVector::create(lhs, lhs.getStartIndex(), lhs.size()));
+    expect->andWith(rhs);
+    EXPECT_EQUAL(expect->countTrueBits(), lhs.andCount(rhs));
+}
+
+TEST("requireThatAndCountIgnoresBitsOutsideActiveRange")
+{
+    AllocatedBitVector full(1030);
+    full.setInterval(0, 1030);
+    PartialBitVector p(717, 919);
+    p.slowSetBit(718);
+    p.slowSetBit(871);
+    verifyAndCount(p, full);
+    // not leaves the bits before the start and after the guard bit set
+    p.notSelf();
+    verifyAndCount(p, full);
+    EXPECT_EQUAL(200u, p.andCount(full));
+
+    PartialBitVector small(700, 710);
+    small.notSelf();
+    verifyAndCount(small, full);
+    EXPECT_EQUAL(10u, small.andCount(full));
+
+    AllocatedBitVector v(1000);
+    v.slowSetBit(7);
+    v.slowSetBit(999);
+    v.notSelf();
+    verifyAndCount(v, full);
+    EXPECT_EQUAL(998u, v.andCount(full));
+}
+
 TEST("requireThatInitRangeStaysWithinBounds") {
     AllocatedBitVector v1(128);
     search::fef::TermFieldMatchData f;
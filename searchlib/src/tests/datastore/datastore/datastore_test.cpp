@@ -142,6 +142,7 @@ private:
     void requireThatMemoryUsageIsCalculated();
     void requireThatWecanDisableElemHoldList();
     void requireThatBufferGrowthWorks();
+    void requireThatHugePageBytesAreReported();
 public:
     int Main() override;
 };
@@ -508,6 +509,35 @@ Test::requireThatBufferGrowthWorks()
                             { 0, 1 }, 4, 0, 0));
 }
 
+void
+Test::requireThatHugePageBytesAreReported()
+{
+    using Store = DataStoreT<EntryRefT<22>>;
+    // Without explicit huge pages available buffers fall back to ordinary pages
+    bool hugeTlb = (vespalib::alloc::Alloc::allocHugePages((1u << 20) * sizeof(int)).hugePageBytes() != 0);
+    for (bool hugePages : { false, true }) {
+        Store store;
+        BufferType<int> type(1, 1, Store::RefType::offsetSize(), 0);
+        uint32_t typeId = store.addType(&type);
+        if (hugePages) {
+            store.enableHugePages();
+        }
+        store.initActiveBuffers();
+        EXPECT_EQUAL(0u, store.getMemoryUsage().hugePageBytes());
+        store.switchActiveBuffer(typeId, 1u << 20);
+        MemoryUsage usage = store.getMemoryUsage();
+        if (hugePages && hugeTlb) {
+            EXPECT_LESS_EQUAL((1u << 20) * sizeof(int), usage.hugePageBytes());
+            EXPECT_LESS_EQUAL(usage.hugePageBytes(), usage.allocatedBytes());
+        } else {
+            EXPECT_EQUAL(0u, usage.hugePageBytes());
+        }
+        store.transferHoldLists(1);
+        store.trimHoldLists(2);
+        store.dropBuffers();
+    }
+}
+
 int
 Test::Main()
 {
@@ -524,6 +554,7 @@ Test::Main()
     requireThatMemoryUsageIsCalculated();
     requireThatWecanDisableElemHoldList();
     requireThatBufferGrowthWorks();
+    requireThatHugePageBytesAreReported();
 
     TEST_DONE();
 }
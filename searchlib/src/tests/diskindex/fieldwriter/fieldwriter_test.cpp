@@ -143,6 +143,7 @@ public:
     std::unique_ptr<FieldWriter> _fieldWriter;
 private:
     bool _dynamicK;
+    bool _blockFormat;
     uint32_t _numWordIds;
     uint32_t _docIdLimit;
     vespalib::string _namepref;
@@ -153,6 +154,7 @@ public:
 
     WrappedFieldWriter(const vespalib::string &namepref,
                       bool dynamicK,
+                      bool blockFormat,
                       uint32_t numWordIds,
                       uint32_t docIdLimit);
     ~WrappedFieldWriter();
@@ -165,10 +167,12 @@ WrappedFieldWriter::~WrappedFieldWriter() {}
 
 WrappedFieldWriter::WrappedFieldWriter(const vespalib::string &namepref,
                                        bool dynamicK,
+                                       bool blockFormat,
                                        uint32_t numWordIds,
                                        uint32_t docIdLimit)
     : _fieldWriter(),
       _dynamicK(dynamicK),
+      _blockFormat(blockFormat),
       _numWordIds(numWordIds),
       _docIdLimit(docIdLimit),
       _namepref(dirprefix + namepref),
@@ -189,7 +193,7 @@ WrappedFieldWriter::open()
     fileHeaderContext.disableFileName();
     _fieldWriter = std::make_unique<FieldWriter>(_docIdLimit, _numWordIds);
     _fieldWriter->open(_namepref,
-                       minSkipDocs, minChunkDocs, _dynamicK, _schema,
+                       minSkipDocs, minChunkDocs, _dynamicK, _blockFormat, _schema,
                        _indexId,
                        tuneFileWrite, fileHeaderContext);
 }
@@ -276,7 +280,8 @@ void
 writeField(FakeWordSet &wordSet,
            uint32_t docIdLimit,
            const std::string &namepref,
-           bool dynamicK)
+           bool dynamicK,
+           bool blockFormat = false)
 {
     const char *dynamicKStr = dynamicK ? "true" : "false";
 
@@ -292,7 +297,7 @@ writeField(FakeWordSet &wordSet,
     tv.SetNow();
     before = tv.Secs();
     WrappedFieldWriter ostate(namepref,
-                             dynamicK,
+                             dynamicK, blockFormat,
                              wordSet.getNumWords(), docIdLimit);
     FieldWriter::remove(namepref);
     ostate.open();
@@ -378,7 +383,9 @@ void
 randReadField(FakeWordSet &wordSet,
               const std::string &namepref,
               bool dynamicK,
-              bool verbose)
+              bool verbose,
+              bool mmapPrefetch = false,
+              bool blockFormat = false)
 {
     const char *dynamicKStr = dynamicK ? "true" : "false";
 
@@ -389,9 +396,10 @@ randReadField(FakeWordSet &wordSet,
 
     LOG(info,
         "enter randReadField,"
-        " namepref=%s, dynamicK=%s",
+        " namepref=%s, dynamicK=%s, mmapPrefetch=%s",
         namepref.c_str(),
-        dynamicKStr);
+        dynamicKStr,
+        mmapPrefetch ? "true" : "false");
     tv.SetNow();
     before = tv.Secs();
 
@@ -402,7 +410,10 @@ randReadField(FakeWordSet &wordSet,
     dictFile.reset(new PageDict4RandRead);
 
     search::index::PostingListFileRandRead *postingFile = NULL;
-    if (dynamicK)
+    if (blockFormat)
+        postingFile =
+            new search::diskindex::BlockPosOccRandRead;
+    else if (dynamicK)
         postingFile =
             new search::diskindex::ZcPosOccRandRead;
     else
@@ -411,6 +422,10 @@ randReadField(FakeWordSet &wordSet,
 
     TuneFileSeqRead tuneFileRead;
     TuneFileRandRead tuneFileRandRead;
+    if (mmapPrefetch) {
+        tuneFileRandRead.setWantMemoryMap();
+        tuneFileRandRead.setWantPrefetch(true);
+    }
     bool openCntRes = dictFile->open(cname, tuneFileRandRead);
     assert(openCntRes);
     (void) openCntRes;
@@ -498,7 +513,8 @@ fusionField(uint32_t numWordIds,
             const vespalib::string &ipref,
             const vespalib::string &opref,
             bool doRaw,
-            bool dynamicK)
+            bool dynamicK,
+            bool blockFormat = false)
 {
     const char *rawStr = doRaw ? "true" : "false";
     const char *dynamicKStr = dynamicK ? "true" : "false";
@@ -517,7 +533,7 @@ fusionField(uint32_t numWordIds,
     double before;
     double after;
     WrappedFieldWriter ostate(opref,
-                             dynamicK,
+                             dynamicK, blockFormat,
                              numWordIds, docIdLimit);
     WrappedFieldReader istate(ipref, numWordIds, docIdLimit);
 
@@ -634,6 +650,46 @@ testFieldWriterVariants(FakeWordSet &wordSet,
                 true, false);
     randReadField(wordSet, "newchunk4", true, verbose);
     randReadField(wordSet, "newchunk5", false, verbose);
+    randReadField(wordSet, "newchunk4", true, verbose, true);
+    randReadField(wordSet, "newchunk5", false, verbose, true);
+}
+
+
+void
+testFieldWriterBlockVariants(FakeWordSet &wordSet,
+                             uint32_t docIdLimit, bool verbose)
+{
+    enableSkip();
+    writeField(wordSet, docIdLimit, "newskipblk", true, true);
+    readField(wordSet, docIdLimit, "newskipblk", true, verbose);
+    fusionField(wordSet.getNumWords(),
+                docIdLimit,
+                "newskipblk", "newskipblkx",
+                false, true, true);
+    fusionField(wordSet.getNumWords(),
+                docIdLimit,
+                "newskipblk", "newskipblkxx",
+                true, true, true);
+    fusionField(wordSet.getNumWords(),
+                docIdLimit,
+                "newskip4", "newskipblkconv",
+                false, true, true);
+    randReadField(wordSet, "newskipblk", true, verbose, false, true);
+    randReadField(wordSet, "newskipblkconv", true, verbose, false, true);
+    enableSkipChunks();
+    writeField(wordSet, docIdLimit, "newchunkblk", true, true);
+    readField(wordSet, docIdLimit, "newchunkblk", true, verbose);
+    fusionField(wordSet.getNumWords(),
+                docIdLimit,
+                "newchunkblk", "newchunkblkx",
+                false, true, true);
+    fusionField(wordSet.getNumWords(),
+                docIdLimit,
+                "newchunkblk", "newchunk4blk",
+                false, true, false);
+    readField(wordSet, docIdLimit, "newchunk4blk", true, verbose);
+    randReadField(wordSet, "newchunkblk", true, verbose, false, true);
+    randReadField(wordSet, "newchunkblk", true, verbose, true, true);
 }
 
 
@@ -708,6 +764,7 @@ FieldWriterTest::Main()
 
     vespalib::mkdir("index", false);
     testFieldWriterVariants(_wordSet, _numDocs, _verbose);
+    testFieldWriterBlockVariants(_wordSet, _numDocs, _verbose);
 
     _wordSet2.setupParams(false, false);
     _wordSet2.setupWords(_rnd, _numDocs, _commonDocFreq, 3);
@@ -56,8 +56,12 @@ newpfiles3=index/newchunk[46]*posocc.dat.compressed
 newpfiles4=index/new[57]*posocc.dat.compressed
 newpfiles5=index/newskip[57]*posocc.dat.compressed
 newpfiles6=index/newchunk[57]*posocc.dat.compressed
+newpcntfiles7=index/newskipblk*dictionary.pdat
+newpcntfiles8=index/newchunkblk*dictionary.pdat
+newpfiles7=index/newskipblk*posocc.dat.compressed
+newpfiles8=index/newchunkblk*posocc.dat.compressed
 
-if checksame $newpcntfiles1 && checksame $newpcntfiles1b && checksame $newpcntfiles1c && checksame $newpfiles1 && checksame $newpcntfiles2 && checksame $newpcntfiles2b && checksame $newpcntfiles2c && checksame $newpfiles2 && checksame $newpcntfiles3 && checksame $newpcntfiles3b && checksame $newpcntfiles3c && checksame $newpfiles3 && checksame $newpcntfiles4 && checksame $newpcntfiles4b && checksame $newpcntfiles4c && checksame $newpfiles4 && checksame $newpcntfiles5 && checksame $newpcntfiles5b && checksame $newpcntfiles5c && checksame $newpfiles5 && checksame $newpcntfiles6 && checksame $newpcntfiles6b && checksame $newpcntfiles6c && checksame $newpfiles6
+if checksame $newpcntfiles1 && checksame $newpcntfiles1b && checksame $newpcntfiles1c && checksame $newpfiles1 && checksame $newpcntfiles2 && checksame $newpcntfiles2b && checksame $newpcntfiles2c && checksame $newpfiles2 && checksame $newpcntfiles3 && checksame $newpcntfiles3b && checksame $newpcntfiles3c && checksame $newpfiles3 && checksame $newpcntfiles4 && checksame $newpcntfiles4b && checksame $newpcntfiles4c && checksame $newpfiles4 && checksame $newpcntfiles5 && checksame $newpcntfiles5b && checksame $newpcntfiles5c && checksame $newpfiles5 && checksame $newpcntfiles6 && checksame $newpcntfiles6b && checksame $newpcntfiles6c && checksame $newpfiles6 && checksame $newpcntfiles7 && checksame $newpfiles7 && checksame $newpcntfiles8 && checksame $newpfiles8
 then
   echo SUCCESS: Files match up
   exit 0
@@ -17,6 +17,12 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchlib/util/filekit.h>
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/data/fileheader.h>
+#include <vespa/fastos/file.h>
+#include <algorithm>
 
 namespace search {
 
@@ -42,7 +48,8 @@ private:
     Schema _schema;
     const Schema & getSchema() const { return _schema; }
 
-    void requireThatFusionIsWorking(const vespalib::string &prefix, bool directio, bool readmmap);
+    void requireThatFusionIsWorking(const vespalib::string &prefix, bool directio, bool readmmap, bool blockPosOcc);
+    void requireThatSerialAndParallelFusionGiveIdenticalOutput(const vespalib::string &prefix, bool blockPosOcc);
 public:
     Test();
     int Main() override;
@@ -238,7 +245,8 @@ validateDiskIndex(DiskIndex &dw,
 void
 Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                  bool directio,
-                                 bool readmmap)
+                                 bool readmmap,
+                                 bool blockPosOcc)
 {
     Schema schema;
     Schema schema2;
@@ -337,6 +345,7 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
     }
     if (readmmap)
         tuneFileSearch._read.setWantMemoryMap();
+    vespalib::ThreadStackExecutor executor(4, 0x10000);
     ib.open(numDocs, numWords, tuneFileIndexing, fileHeaderContext);
     d.dump(ib);
     ib.close();
@@ -363,8 +372,10 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                        prefix + "dump3",
                                        sources, selector,
                                        dynamicKPosOcc,
+                                       blockPosOcc,
                                        tuneFileIndexing,
-                                       fileHeaderContext)))
+                                       fileHeaderContext,
+                                       executor)))
             return;
     } while (0);
     do {
@@ -381,8 +392,10 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                        prefix + "dump4",
                                        sources, selector,
                                        dynamicKPosOcc,
+                                       blockPosOcc,
                                        tuneFileIndexing,
-                                       fileHeaderContext)))
+                                       fileHeaderContext,
+                                       executor)))
             return;
     } while (0);
     do {
@@ -399,8 +412,10 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                        prefix + "dump5",
                                        sources, selector,
                                        dynamicKPosOcc,
+                                       blockPosOcc,
                                        tuneFileIndexing,
-                                       fileHeaderContext)))
+                                       fileHeaderContext,
+                                       executor)))
             return;
     } while (0);
     do {
@@ -417,8 +432,10 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                        prefix + "dump6",
                                        sources, selector,
                                        !dynamicKPosOcc,
+                                       false,
                                        tuneFileIndexing,
-                                       fileHeaderContext)))
+                                       fileHeaderContext,
+                                       executor)))
             return;
     } while (0);
     do {
@@ -435,8 +452,10 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                        prefix + "dump3",
                                        sources, selector,
                                        dynamicKPosOcc,
+                                       blockPosOcc,
                                        tuneFileIndexing,
-                                       fileHeaderContext)))
+                                       fileHeaderContext,
+                                       executor)))
             return;
     } while (0);
     do {
@@ -447,6 +466,112 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
     } while (0);
 }
 
+namespace {
+
+vespalib::string
+readFileBody(const vespalib::string &name)
+{
+    FastOS_File file;
+    file.OpenReadOnlyExisting(true, name.c_str());
+    size_t headerLen = 0;
+    try {
+        vespalib::FileHeader header;
+        headerLen = header.readFile(file);
+    } catch (const vespalib::IllegalHeaderException &) {
+        // File without header, e.g. schema.txt
+    }
+    int64_t fileSize = file.GetSize();
+    vespalib::string body(fileSize - headerLen, '\0');
+    file.ReadBuf(&body[0], body.size(), headerLen);
+    return body;
+}
+
+void
+assertIdenticalDirs(const vespalib::string &lhs, const vespalib::string &rhs)
+{
+    vespalib::DirectoryList lhsFiles = vespalib::listDirectory(lhs);
+    vespalib::DirectoryList rhsFiles = vespalib::listDirectory(rhs);
+    std::sort(lhsFiles.begin(), lhsFiles.end());
+    std::sort(rhsFiles.begin(), rhsFiles.end());
+    if (!EXPECT_TRUE(lhsFiles == rhsFiles)) {
+        return;
+    }
+    for (const auto &name : lhsFiles) {
+        vespalib::string lhsName = lhs + "/" + name;
+        vespalib::string rhsName = rhs + "/" + name;
+        TEST_STATE(lhsName.c_str());
+        if (vespalib::isDirectory(lhsName)) {
+            EXPECT_TRUE(vespalib::isDirectory(rhsName));
+            TEST_DO(assertIdenticalDirs(lhsName, rhsName));
+        } else {
+            // Headers contain freeze times, compare what follows them
+            EXPECT_TRUE(readFileBody(lhsName) == readFileBody(rhsName));
+        }
+    }
+}
+
+}
+
+void
+Test::requireThatSerialAndParallelFusionGiveIdenticalOutput(const vespalib::string &prefix, bool blockPosOcc)
+{
+    const Schema &schema(getSchema());
+    Dictionary d(schema);
+    DocBuilder b(schema);
+    SequencedTaskExecutor invertThreads(2);
+    SequencedTaskExecutor pushThreads(2);
+    DocumentInverter inv(schema, invertThreads, pushThreads);
+    uint32_t numDocs = 1000 + 1;
+    for (uint32_t docId = 1; docId < numDocs; ++docId) {
+        b.startDocument(vespalib::make_string("doc::%u", docId));
+        b.startIndexField("f0");
+        for (uint32_t i = 0; i < 1 + docId % 7; ++i) {
+            b.addStr(vespalib::make_string("w%u", (docId * 3 + i) % 97));
+        }
+        b.endField();
+        b.startIndexField("f1").
+            addStr(vespalib::make_string("x%u", docId % 13)).
+            addStr(vespalib::make_string("y%u", docId % 211)).
+            endField();
+        b.startIndexField("f2").
+            startElement(1).addStr(vespalib::make_string("a%u", docId % 5)).endElement().
+            startElement(1).addStr(vespalib::make_string("b%u", docId % 31)).endElement().
+            endField();
+        b.startIndexField("f3").
+            startElement(docId % 17).addStr(vespalib::make_string("c%u", docId % 53)).endElement().
+            endField();
+        Document::UP doc = b.endDocument();
+        inv.invertDocument(docId, *doc);
+        invertThreads.sync();
+        myPushDocument(inv, d);
+        pushThreads.sync();
+    }
+
+    IndexBuilder ib(schema);
+    vespalib::string dumpdir = prefix + "pdump";
+    ib.setPrefix(dumpdir);
+    TuneFileIndexing tuneFileIndexing;
+    DummyFileHeaderContext fileHeaderContext;
+    ib.open(numDocs, d.getNumUniqueWords(), tuneFileIndexing, fileHeaderContext);
+    d.dump(ib);
+    ib.close();
+
+    std::vector<vespalib::string> sources;
+    sources.push_back(dumpdir);
+    SelectorArray selector(numDocs, 0);
+    vespalib::ThreadStackExecutor serialExecutor(1, 0x10000);
+    vespalib::ThreadStackExecutor parallelExecutor(4, 0x10000);
+    if (!EXPECT_TRUE(Fusion::merge(schema, prefix + "pserial", sources, selector,
+                                   false, blockPosOcc, tuneFileIndexing,
+                                   fileHeaderContext, serialExecutor)))
+        return;
+    if (!EXPECT_TRUE(Fusion::merge(schema, prefix + "pparallel", sources, selector,
+                                   false, blockPosOcc, tuneFileIndexing,
+                                   fileHeaderContext, parallelExecutor)))
+        return;
+    TEST_DO(assertIdenticalDirs(prefix + "pserial", prefix + "pparallel"));
+}
+
 Test::Test()
     : _schema()
 {
@@ -465,10 +590,14 @@ Test::Main()
         DummyFileHeaderContext::setCreator(_argv[0]);
     }
 
-    TEST_DO(requireThatFusionIsWorking("", false, false));
-    TEST_DO(requireThatFusionIsWorking("d", true, false));
-    TEST_DO(requireThatFusionIsWorking("m", false, true));
-    TEST_DO(requireThatFusionIsWorking("dm", true, true));
+    TEST_DO(requireThatFusionIsWorking("", false, false, false));
+    TEST_DO(requireThatFusionIsWorking("d", true, false, false));
+    TEST_DO(requireThatFusionIsWorking("m", false, true, false));
+    TEST_DO(requireThatFusionIsWorking("dm", true, true, false));
+    TEST_DO(requireThatFusionIsWorking("b", false, false, true));
+    TEST_DO(requireThatFusionIsWorking("bm", false, true, true));
+    TEST_DO(requireThatSerialAndParallelFusionGiveIdenticalOutput("", false));
+    TEST_DO(requireThatSerialAndParallelFusionGiveIdenticalOutput("b", true));
 
     TEST_DONE();
 }
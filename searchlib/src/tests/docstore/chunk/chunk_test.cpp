@@ -8,11 +8,14 @@
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 LOG_SETUP("chunk_test");
 
 using namespace search;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 TEST("require that Chunk obey limits")
 {
@@ -98,4 +101,41 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), 282);
 }
 
+vespalib::string
+makeEntry(uint32_t lid) {
+    return vespalib::make_string("{\"title\":\"Some title %u\",\"body\":\"A body text that is common for all entries\","
+                                 "\"popularity\":%u}", lid, (lid * 17) % 1000);
+}
+
+TEST("require that chunks compressed with a dictionary can only be read with the dictionary") {
+    std::vector<vespalib::string> entries;
+    std::vector<vespalib::ConstBufferRef> samples;
+    for (uint32_t lid(0); lid < 2000; lid++) {
+        entries.push_back(makeEntry(lid));
+    }
+    for (const vespalib::string & entry : entries) {
+        samples.emplace_back(entry.c_str(), entry.size());
+    }
+    ZStdDictionary::SP dictionary = ZStdDictionary::train(samples, 4096, 9);
+    ASSERT_TRUE(dictionary);
+
+    Chunk c(0, Chunk::Config(0x1000));
+    for (uint32_t lid(1); lid <= 3; lid++) {
+        vespalib::string entry = makeEntry(lid + 5000);
+        c.append(lid, entry.c_str(), entry.size());
+    }
+    CompressionConfig cfg(CompressionConfig::ZSTD);
+    vespalib::DataBuffer withDictionary;
+    c.pack(7, withDictionary, cfg, dictionary.get());
+
+    Chunk deserialized(0, withDictionary.getData(), withDictionary.getDataLen(), false, dictionary.get());
+    EXPECT_EQUAL(3u, deserialized.count());
+    for (uint32_t lid(1); lid <= 3; lid++) {
+        vespalib::string expected = makeEntry(lid + 5000);
+        vespalib::ConstBufferRef buf = deserialized.getLid(lid);
+        EXPECT_EQUAL(expected, vespalib::string(buf.c_str(), buf.size()));
+    }
+    EXPECT_EXCEPTION(Chunk(0, withDictionary.getData(), withDictionary.getDataLen()), std::runtime_error, "unprocess failed");
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -10,9 +10,11 @@
 #include <vespa/searchlib/docstore/visitcache.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/test/directory_handler.h>
+#include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <iomanip>
 
@@ -439,7 +441,7 @@ makeDoc(const DocumentTypeRepo &repo, uint32_t i, bool extra_field)
 
 class VisitCacheStore {
 public:
-    VisitCacheStore();
+    VisitCacheStore(size_t maxCacheBytes = 1000000);
     ~VisitCacheStore();
     IDocumentStore & getStore() { return _datastore; }
     void write(uint32_t id) {
@@ -469,6 +471,18 @@ public:
         VerifyVisitor vv(*this, expected, allowCaching);
         _datastore.visit(lids, _repo, vv);
     }
+    void verifyBatchRead(const std::vector<uint32_t> & lids) {
+        IDocumentStore::DocumentVector docs = _datastore.read(lids, _repo);
+        ASSERT_EQUAL(lids.size(), docs.size());
+        for (size_t i(0); i < lids.size(); i++) {
+            if (_inserted.find(lids[i]) != _inserted.end()) {
+                ASSERT_TRUE(docs[i]);
+                verifyDoc(*docs[i], lids[i]);
+            } else {
+                EXPECT_FALSE(docs[i]);
+            }
+        }
+    }
 private:
     class VerifyVisitor : public IDocumentVisitor {
     public:
@@ -509,10 +523,10 @@ VisitCacheStore::VerifyVisitor::~VerifyVisitor() {
     EXPECT_EQUAL(_expected.size(), _actual.size());
 }
 
-VisitCacheStore::VisitCacheStore() :
+VisitCacheStore::VisitCacheStore(size_t maxCacheBytes) :
     _myDir("visitcache"),
     _repo(makeDocTypeRepoConfig()),
-    _config(DocumentStore::Config(CompressionConfig::LZ4, 1000000, 0).allowVisitCaching(true),
+    _config(DocumentStore::Config(CompressionConfig::LZ4, maxCacheBytes, 0).allowVisitCaching(true),
             LogDataStore::Config().setMaxFileSize(50000).setMaxBucketSpread(3.0)
                     .setFileConfig(WriteableFileChunk::Config(CompressionConfig(), 16384))),
     _fileHeaderContext(),
@@ -582,6 +596,31 @@ TEST("test that the integrated visit cache works.") {
     TEST_DO(verifyCacheStats(ds.getCacheStats(), 101, 108, 99, 20944));
 }
 
+void
+verifyBatchReads(VisitCacheStore & vcs) {
+    for (size_t i(1); i <= 100; i++) {
+        vcs.write(i);
+    }
+    vcs.verifyBatchRead({});
+    vcs.verifyBatchRead({42});
+    vcs.verifyBatchRead({88, 7, 150, 19, 1, 67});
+    vcs.remove(17);
+    vcs.rewrite(19);
+    vcs.verifyBatchRead({19, 17, 7, 19, 100, 7, 2});
+}
+
+TEST("require that documents can be read in batches without cache") {
+    VisitCacheStore vcs(0);
+    TEST_DO(verifyBatchReads(vcs));
+    TEST_DO(verifyCacheStats(vcs.getStore().getCacheStats(), 0, 14, 0, 0));
+}
+
+TEST("require that documents can be read in batches through cache") {
+    VisitCacheStore vcs;
+    TEST_DO(verifyBatchReads(vcs));
+    EXPECT_EQUAL(14u, vcs.getStore().getCacheStats().hits + vcs.getStore().getCacheStats().misses);
+}
+
 TEST("testWriteRead") {
     FastOS_File::RemoveDirectory("empty");
     const char * bufA = "aaaaaaaaaaaaaaaaaaaaa";
@@ -978,6 +1017,171 @@ TEST("require that config equality operator detects inequality") {
     EXPECT_FALSE(C() == C().disableCrcOnRead(true));
     EXPECT_FALSE(C() == C().compact2ActiveFile(false));
     EXPECT_FALSE(C() == C().compactCompression({CompressionConfig::ZSTD}));
+    EXPECT_FALSE(C() == C().setCompactedFileCompression({CompressionConfig::ZSTD}));
+    EXPECT_FALSE(C() == C().setDictionarySize(0x4000));
+}
+
+TEST("require that the dictionary follows the compression of compacted files") {
+    using C = LogDataStore::Config;
+    WriteableFileChunk::Config lz4({CompressionConfig::LZ4, 9, 60}, 1000);
+    WriteableFileChunk::Config zstd({CompressionConfig::ZSTD, 3, 60}, 1000);
+    EXPECT_FALSE(C().setFileConfig(zstd).useDictionary());
+    EXPECT_TRUE(C().setFileConfig(zstd).setDictionarySize(0x4000).useDictionary());
+    EXPECT_TRUE(C().setFileConfig(lz4).setDictionarySize(0x4000)
+                   .setCompactedFileCompression({CompressionConfig::ZSTD, 19, 60}).useDictionary());
+    EXPECT_FALSE(C().setFileConfig(zstd).setDictionarySize(0x4000)
+                    .setCompactedFileCompression({CompressionConfig::LZ4, 9, 60}).useDictionary());
+}
+
+struct CompactedCompressionFixture {
+    vespalib::ThreadStackExecutor executor;
+    DummyFileHeaderContext fileHeaderContext;
+    MyTlSyncer tlSyncer;
+    vespalib::string dir;
+    LogDataStore::Config config;
+    std::unique_ptr<LogDataStore> store;
+    SerialNum serialNum;
+
+    CompactedCompressionFixture(const vespalib::string &dirName, const LogDataStore::Config &config_in = getConfig())
+        : executor(1, 0x10000),
+          fileHeaderContext(),
+          tlSyncer(),
+          dir(dirName),
+          config(config_in),
+          store(),
+          serialNum(0)
+    {
+        reopen();
+    }
+    ~CompactedCompressionFixture() {
+        store.reset();
+        FastOS_File::EmptyAndRemoveDirectory(dir.c_str());
+    }
+    static LogDataStore::Config getConfig() {
+        // A min file size factor of 0 makes compaction always write to a new file
+        LogDataStore::Config config;
+        config.setMaxFileSize(4096 * 2).setMaxDiskBloatFactor(0.1).setMinFileSizeFactor(0.0)
+              .compact2ActiveFile(false).compactCompression({CompressionConfig::LZ4})
+              .setFileConfig({{CompressionConfig::LZ4, 9, 60}, 1000})
+              .setCompactedFileCompression({CompressionConfig::ZSTD, 9, 60});
+        return config;
+    }
+    void reopen() {
+        store.reset();
+        store = std::make_unique<LogDataStore>(executor, dir, config, GrowStrategy(), TuneFileSummary(),
+                                               fileHeaderContext, tlSyncer, std::make_shared<DummyBucketizer>(100));
+    }
+    void flush() {
+        store->flush(store->initFlush(serialNum));
+    }
+    static vespalib::string genDocument(uint32_t lid) {
+        return vespalib::make_string("{\"title\":\"Document title %u\",\"body\":\"A body text shared by all documents\","
+                                     "\"year\":%u,\"popularity\":%u}", lid, 1950 + (lid % 70), (lid * 17) % 1000);
+    }
+    // Writes until a second file is started, then removes every odd lid and compacts.
+    // Returns the lid limit of the written documents.
+    uint32_t writeFilledFileAndCompactIt(bool documents = false) {
+        uint32_t lid = 1;
+        while (store->getFileChunkStats().size() < 2) {
+            vespalib::string data = documents ? genDocument(lid) : genData(lid, 1024);
+            store->write(++serialNum, lid++, data.c_str(), data.size());
+        }
+        for (uint32_t removeLid = 1; removeLid < lid; removeLid += 2) {
+            store->remove(++serialNum, removeLid);
+        }
+        flush();
+        store->compact(serialNum);
+        return lid;
+    }
+    void assertDocuments(uint32_t lidLimit) {
+        for (uint32_t lid = 1; lid < lidLimit; ++lid) {
+            vespalib::DataBuffer buffer;
+            store->read(lid, buffer);
+            vespalib::string expected = ((lid % 2) == 0) ? genDocument(lid) : "";
+            EXPECT_EQUAL(expected, vespalib::string(buffer.getData(), buffer.getDataLen()));
+        }
+    }
+    bool hasDictionary(const DataStoreFileChunkStats &chunk) const {
+        FastOS_File file((chunk.createName(dir) + ".dat").c_str());
+        ASSERT_TRUE(file.OpenReadOnly());
+        vespalib::FileHeader header;
+        header.readFile(file);
+        return header.hasTag("zstdDictionary");
+    }
+    std::vector<DataStoreFileChunkStats> getCompressedWith(CompressionConfig::Type type) const {
+        std::vector<DataStoreFileChunkStats> result;
+        for (const auto &chunk : store->getFileChunkStats()) {
+            if (chunk.compressionKnown() && (chunk.compression() == type)) {
+                result.push_back(chunk);
+            }
+        }
+        return result;
+    }
+};
+
+TEST_F("require that files written by compaction use the compacted file compression", CompactedCompressionFixture("compactedcompression"))
+{
+    f.writeFilledFileAndCompactIt();
+    auto compacted = f.getCompressedWith(CompressionConfig::ZSTD);
+    ASSERT_EQUAL(1u, compacted.size());
+    EXPECT_LESS(1.0, compacted[0].compressionRatio());
+    auto written = f.getCompressedWith(CompressionConfig::LZ4);
+    ASSERT_EQUAL(1u, written.size());
+    EXPECT_NOT_EQUAL(compacted[0].nameId(), written[0].nameId());
+
+    // The compression is read back from the header of the compacted file.
+    f.reopen();
+    auto reloaded = f.getCompressedWith(CompressionConfig::ZSTD);
+    ASSERT_EQUAL(1u, reloaded.size());
+    EXPECT_EQUAL(compacted[0].nameId(), reloaded[0].nameId());
+    EXPECT_LESS(1.0, reloaded[0].compressionRatio());
+}
+
+TEST_F("require that files without compression in header report unknown compression", CompactedCompressionFixture("unknowncompression"))
+{
+    f.writeFilledFileAndCompactIt();
+    auto compacted = f.getCompressedWith(CompressionConfig::ZSTD);
+    ASSERT_EQUAL(1u, compacted.size());
+    f.store.reset();
+    {
+        // Strip the tag to get a file as written before the compression was stored
+        FastOS_File file((compacted[0].createName(f.dir) + ".dat").c_str());
+        ASSERT_TRUE(file.OpenReadWrite());
+        vespalib::FileHeader header;
+        header.readFile(file);
+        EXPECT_TRUE(header.removeTag("compression"));
+        header.rewriteFile(file);
+    }
+    f.reopen();
+    EXPECT_EQUAL(0u, f.getCompressedWith(CompressionConfig::ZSTD).size());
+    size_t numUnknown = 0;
+    for (const auto &chunk : f.store->getFileChunkStats()) {
+        if (chunk.nameId() == compacted[0].nameId()) {
+            EXPECT_FALSE(chunk.compressionKnown());
+            ++numUnknown;
+        } else {
+            EXPECT_TRUE(chunk.compressionKnown());
+        }
+    }
+    EXPECT_EQUAL(1u, numUnknown);
+}
+
+TEST_F("require that compaction writes and reads back files compressed with a dictionary",
+       CompactedCompressionFixture("dictionarycompression",
+                                   CompactedCompressionFixture::getConfig().setMaxFileSize(0x10000).setDictionarySize(0x400)
+                                           .setCompactedFileCompression({CompressionConfig::ZSTD, 0, 60})))
+{
+    // Level 0 selects the default zstd level, also when compressing with the dictionary.
+    uint32_t lidLimit = f.writeFilledFileAndCompactIt(true);
+    auto compacted = f.getCompressedWith(CompressionConfig::ZSTD);
+    ASSERT_EQUAL(1u, compacted.size());
+    EXPECT_TRUE(f.hasDictionary(compacted[0]));
+    EXPECT_LESS(1.0, compacted[0].compressionRatio());
+    TEST_DO(f.assertDocuments(lidLimit));
+
+    // After a restart the dictionary is read back from the header of the compacted file.
+    f.reopen();
+    TEST_DO(f.assertDocuments(lidLimit));
 }
 
 TEST_MAIN() {
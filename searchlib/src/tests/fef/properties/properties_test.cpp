@@ -295,6 +295,30 @@ TEST("test stuff") {
             p.add("vespa.matching.numsearchpartitions", "50");
             EXPECT_EQUAL(matching::NumSearchPartitions::lookup(p), 50u);
         }
+        {
+            EXPECT_EQUAL(matching::UseWorkStealing::NAME, vespalib::string("vespa.matching.workstealing"));
+            EXPECT_EQUAL(matching::UseWorkStealing::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matching::UseWorkStealing::lookup(p), false);
+            p.add("vespa.matching.workstealing", "true");
+            EXPECT_EQUAL(matching::UseWorkStealing::lookup(p), true);
+        }
+        {
+            EXPECT_EQUAL(matching::ResultCacheMaxBytes::NAME, vespalib::string("vespa.matching.resultcache.maxbytes"));
+            EXPECT_EQUAL(matching::ResultCacheMaxBytes::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::ResultCacheMaxBytes::lookup(p), 0u);
+            p.add("vespa.matching.resultcache.maxbytes", "1000000");
+            EXPECT_EQUAL(matching::ResultCacheMaxBytes::lookup(p), 1000000u);
+        }
+        {
+            EXPECT_EQUAL(matching::ResultCacheMaxHits::NAME, vespalib::string("vespa.matching.resultcache.maxhits"));
+            EXPECT_EQUAL(matching::ResultCacheMaxHits::DEFAULT_VALUE, 100u);
+            Properties p;
+            EXPECT_EQUAL(matching::ResultCacheMaxHits::lookup(p), 100u);
+            p.add("vespa.matching.resultcache.maxhits", "400");
+            EXPECT_EQUAL(matching::ResultCacheMaxHits::lookup(p), 400u);
+        }
         { // vespa.matchphase.degradation.attribute
             EXPECT_EQUAL(matchphase::DegradationAttribute::NAME, vespalib::string("vespa.matchphase.degradation.attribute"));
             EXPECT_EQUAL(matchphase::DegradationAttribute::DEFAULT_VALUE, "");
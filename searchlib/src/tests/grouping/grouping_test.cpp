@@ -5,6 +5,8 @@
 #include <vespa/searchlib/aggregation/aggregation.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
 #include <vespa/searchlib/attribute/attributemanager.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
 #include <vespa/searchlib/aggregation/fs4hit.h>
 #include <vespa/searchlib/aggregation/predicates.h>
@@ -12,6 +14,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <numeric>
 
 using namespace vespalib;
 using namespace search;
@@ -146,6 +149,9 @@ public:
     void testAggregationGroupOrder();
     void testAggregationGroupRank();
     void testAggregationGroupCapping();
+    void testAggregationBatching();
+    void testPostingListCounts();
+    void testPostingListCountsOnlyWhenCheaper();
     void testMergeSimpleSum();
     void testMergeLevels();
     void testMergeGroups();
@@ -705,6 +711,175 @@ Test::testAggregationGroupCapping()
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Verify that grouping more hits than fit in a single batch gives
+ * the same groups, ranks and sums as grouping them one by one.
+ **/
+void
+Test::testAggregationBatching()
+{
+    const uint32_t numDocs = 3000;
+    IntAttrBuilder attr1("attr1");
+    IntAttrBuilder attr2("attr2");
+    IntAttrBuilder attr3("attr3");
+    AggregationContext ctx;
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        attr1.add(i % 7);
+        attr2.add(i % 13);
+        attr3.add(i);
+        ctx.result().add(i, i % 100);
+    }
+    ctx.add(attr1.sp());
+    ctx.add(attr2.sp());
+    ctx.add(attr3.sp());
+
+    Grouping request;
+    request.setFirstLevel(0)
+           .setLastLevel(2)
+           .setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("attr3"))))
+           .addLevel(createGL(MU<AttributeNode>("attr1"), MU<AttributeNode>("attr3")))
+           .addLevel(createGL(MU<AttributeNode>("attr2"), MU<AttributeNode>("attr3")));
+
+    Group expect;
+    expect.addResult(SumAggregationResult()
+                     .setExpression(MU<AttributeNode>("attr3"))
+                     .setResult(Int64ResultNode(int64_t(numDocs) * (numDocs - 1) / 2)));
+    for (uint32_t a = 0; a < 7; ++a) {
+        int64_t sum[13] = {};
+        HitRank rank[13] = {};
+        for (uint32_t i = a; i < numDocs; i += 7) {
+            sum[i % 13] += i;
+            rank[i % 13] = std::max(rank[i % 13], HitRank(i % 100));
+        }
+        Group child;
+        child.setId(Int64ResultNode(a))
+             .setRank(RawRank(*std::max_element(rank, rank + 13)))
+             .addResult(SumAggregationResult()
+                        .setExpression(MU<AttributeNode>("attr3"))
+                        .setResult(Int64ResultNode(std::accumulate(sum, sum + 13, int64_t(0)))));
+        for (uint32_t b = 0; b < 13; ++b) {
+            child.addChild(Group().setId(Int64ResultNode(b)).setRank(RawRank(rank[b]))
+                           .addResult(SumAggregationResult()
+                                      .setExpression(MU<AttributeNode>("attr3"))
+                                      .setResult(Int64ResultNode(sum[b]))));
+        }
+        expect.addChild(child);
+    }
+
+    EXPECT_TRUE(testAggregation(ctx, request, expect));
+}
+
+/**
+ * Verify that counting hits per value of a fast-search attribute
+ * gives the same groups as evaluating the grouping for each hit,
+ * both when posting lists can be used and when hit ranks differ.
+ **/
+void
+Test::testPostingListCounts()
+{
+    const uint32_t numDocs = 5000;
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    cfg.setFastSearch(true);
+    AttributeVector::SP attr = AttributeFactory::createAttribute("attr", cfg);
+    IntegerAttribute &intAttr = static_cast<IntegerAttribute &>(*attr);
+    attr->addReservedDoc();
+    for (uint32_t i = 1; i < numDocs; ++i) {
+        DocId docId;
+        attr->addDoc(docId);
+        intAttr.update(docId, (i % 5 == 0) ? 100 : (i % 3));
+    }
+    attr->commit();
+
+    auto count = []() { return createAggr<CountAggregationResult>(MU<ConstantNode>(MU<Int64ResultNode>(0))); };
+    auto attrNode = MU<AttributeNode>("attr");
+    attrNode->useEnumOptimization();
+    GroupingLevel level;
+    level.setExpression(std::move(attrNode)).addResult(count());
+    Grouping request;
+    request.setFirstLevel(0)
+           .setLastLevel(1)
+           .setRoot(Group().addResult(count()))
+           .addLevel(std::move(level));
+
+    for (bool sameRank : {true, false}) {
+        AggregationContext ctx;
+        ctx.add(attr);
+        uint32_t numHits = 0;
+        for (uint32_t i = 1; i < numDocs; i += 2, ++numHits) {
+            ctx.result().add(i, sameRank ? 10 : (i % 7));
+        }
+        Grouping perHit = request;
+        ctx.setup(perHit);
+        perHit.aggregate(ctx.result().hits(), ctx.result().size());
+        Grouping counted = request;
+        ctx.setup(counted);
+        counted.aggregate(ctx.result().hits(), ctx.result().size(), nullptr);
+        EXPECT_EQUAL(perHit.getRoot().asString(), counted.getRoot().asString());
+        const Group &root = counted.getRoot();
+        EXPECT_EQUAL(numHits, static_cast<const CountAggregationResult &>(root.getAggregationResult(0)).getCount());
+        ASSERT_EQUAL(4u, root.getChildrenSize());
+        EXPECT_EQUAL(Int64ResultNode(100).asString(), root.groups()[3]->getId().asString());
+        EXPECT_EQUAL(500u, static_cast<const CountAggregationResult &>(root.groups()[3]->getAggregationResult(0)).getCount());
+    }
+}
+
+/**
+ * Verify that posting lists are only used for counting when there are
+ * enough hits compared to the number of documents and unique values,
+ * and that both paths give the same groups.
+ **/
+void
+Test::testPostingListCountsOnlyWhenCheaper()
+{
+    EXPECT_TRUE(Grouping::preferPostingCounts(2500, 5000, 5));
+    EXPECT_FALSE(Grouping::preferPostingCounts(10, 5000, 5));
+    EXPECT_TRUE(Grouping::preferPostingCounts(2500, 5000, 5000));
+    EXPECT_FALSE(Grouping::preferPostingCounts(1000, 5000, 5000));
+
+    const uint32_t numDocs = 5000;
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    cfg.setFastSearch(true);
+    AttributeVector::SP attr = AttributeFactory::createAttribute("attr", cfg);
+    IntegerAttribute &intAttr = static_cast<IntegerAttribute &>(*attr);
+    attr->addReservedDoc();
+    for (uint32_t i = 1; i < numDocs; ++i) {
+        DocId docId;
+        attr->addDoc(docId);
+        intAttr.update(docId, i);
+    }
+    attr->commit();
+
+    auto count = []() { return createAggr<CountAggregationResult>(MU<ConstantNode>(MU<Int64ResultNode>(0))); };
+    auto attrNode = MU<AttributeNode>("attr");
+    attrNode->useEnumOptimization();
+    GroupingLevel level;
+    level.setExpression(std::move(attrNode)).addResult(count());
+    Grouping request;
+    request.setFirstLevel(0)
+           .setLastLevel(1)
+           .setRoot(Group().addResult(count()))
+           .addLevel(std::move(level));
+
+    // a few hits grouped one by one, then all documents using posting lists
+    for (uint32_t step : {997u, 1u}) {
+        EXPECT_EQUAL(step == 1u, Grouping::preferPostingCounts((numDocs - 1 + step - 1) / step, numDocs, numDocs - 1));
+        AggregationContext ctx;
+        ctx.add(attr);
+        uint32_t numHits = 0;
+        for (uint32_t i = 1; i < numDocs; i += step, ++numHits) {
+            ctx.result().add(i, 10);
+        }
+        Grouping perHit = request;
+        ctx.setup(perHit);
+        perHit.aggregate(ctx.result().hits(), ctx.result().size());
+        Grouping counted = request;
+        ctx.setup(counted);
+        counted.aggregate(ctx.result().hits(), ctx.result().size(), nullptr);
+        EXPECT_EQUAL(perHit.getRoot().asString(), counted.getRoot().asString());
+        EXPECT_EQUAL(numHits, counted.getRoot().getChildrenSize());
+    }
+}
+
 /**
  * Test merging the sum of the values from a single attribute vector
  * that was collected directly into the root node. Consider this a
@@ -1900,6 +2075,9 @@ Test::Main()
     testAggregationGroupOrder();
     testAggregationGroupRank();
     testAggregationGroupCapping();
+    testAggregationBatching();
+    testPostingListCounts();
+    testPostingListCountsOnlyWhenCheaper();
     testMergeSimpleSum();
     testMergeLevels();
     testMergeGroups();
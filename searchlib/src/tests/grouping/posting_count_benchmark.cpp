@@ -0,0 +1,90 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/aggregation/aggregation.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributemanager.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/expression/constantnode.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+
+using namespace search;
+using namespace search::aggregation;
+using namespace search::attribute;
+using namespace search::expression;
+
+namespace {
+
+const uint32_t numDocs = 10000000;
+const uint32_t numValues = 10;
+
+ExpressionNode::UP
+makeCount()
+{
+    auto count = std::make_unique<CountAggregationResult>();
+    count->setExpression(std::make_unique<ConstantNode>(std::make_unique<Int64ResultNode>(0)));
+    return count;
+}
+
+struct Fixture {
+    AttributeManager        attrMan;
+    IAttributeContext::UP   attrCtx;
+    std::vector<RankedHit>  hits;
+    Grouping                request;
+
+    Fixture() : attrMan(), attrCtx(), hits(), request() {
+        Config cfg(BasicType::INT32, CollectionType::SINGLE);
+        cfg.setFastSearch(true);
+        AttributeVector::SP attr = AttributeFactory::createAttribute("attr", cfg);
+        IntegerAttribute &intAttr = static_cast<IntegerAttribute &>(*attr);
+        attr->addReservedDoc();
+        for (uint32_t i = 1; i < numDocs; ++i) {
+            DocId docId;
+            attr->addDoc(docId);
+            intAttr.update(docId, i % numValues);
+            if ((i % 4096) == 0) {
+                attr->commit();
+            }
+        }
+        attr->commit();
+        attrMan.add(attr);
+        attrCtx = attrMan.createContext();
+        for (uint32_t i = 1; i < numDocs; ++i) {
+            RankedHit hit;
+            hit._docId = i;
+            hit._rankValue = 0.0;
+            hits.push_back(hit);
+        }
+        auto attrNode = std::make_unique<AttributeNode>("attr");
+        attrNode->useEnumOptimization();
+        GroupingLevel level;
+        level.setExpression(std::move(attrNode)).addResult(makeCount());
+        request.setFirstLevel(0)
+               .setLastLevel(1)
+               .setRoot(Group().addResult(makeCount()))
+               .addLevel(std::move(level));
+    }
+
+    template <typename Aggregate>
+    double benchmark(Aggregate aggregate) {
+        return vespalib::BenchmarkTimer::benchmark([this, &aggregate]()
+                                                   {
+                                                       Grouping g = request;
+                                                       g.configureStaticStuff(ConfigureStaticParams(attrCtx.get(), nullptr));
+                                                       aggregate(g, hits);
+                                                       EXPECT_EQUAL(numValues, g.getRoot().getChildrenSize());
+                                                   }, 5.0);
+    }
+};
+
+}
+
+TEST_F("count hits per value by evaluating grouping for each hit vs intersecting posting lists", Fixture) {
+    double perHit = f1.benchmark([](Grouping &g, const std::vector<RankedHit> &hits) { g.aggregate(&hits[0], hits.size()); });
+    double postings = f1.benchmark([](Grouping &g, const std::vector<RankedHit> &hits) { g.aggregate(&hits[0], hits.size(), nullptr); });
+    fprintf(stderr, "grouping %zu hits on %u values: per hit: %g ms, posting lists: %g ms\n",
+            f1.hits.size(), numValues, perHit * 1000.0, postings * 1000.0);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -110,12 +110,12 @@ struct Fixture
         return schema;
     }
 
-    Fixture()
+    Fixture(uint32_t numShards = 1)
         : _schema(makeSchema()),
           _b(_schema),
           _invertThreads(2),
           _pushThreads(2),
-          _inv(_schema, _invertThreads, _pushThreads),
+          _inv(_schema, _invertThreads, _pushThreads, numShards),
           _inserter()
     {
     }
@@ -124,11 +124,13 @@ struct Fixture
     pushDocuments()
     {
         _invertThreads.sync();
-        uint32_t fieldId = 0;
-        for (auto &inverter : _inv.getInverters()) {
+        for (uint32_t fieldId = 0; fieldId < _inv.getNumFields(); ++fieldId) {
+            std::vector<FieldInverter *> inverters;
+            for (uint32_t shardId = 0; shardId < _inv.getNumShards(); ++shardId) {
+                inverters.push_back(_inv.getInverter(fieldId, shardId));
+            }
             _inserter.setFieldId(fieldId);
-            inverter->pushDocuments(_inserter);
-            ++fieldId;
+            FieldInverter::pushDocuments(inverters, _inserter);
         }
         _pushThreads.sync();
     }
@@ -280,6 +282,72 @@ TEST_F("require that empty document can be inverted", Fixture)
 }
 
 
+struct ShardedFixture : public Fixture
+{
+    ShardedFixture()
+        : Fixture(3)
+    {
+    }
+};
+
+
+TEST_F("require that sharded inverters are merged in word and docid order", ShardedFixture)
+{
+    EXPECT_EQUAL(3u, f._inv.getNumShards());
+    f._inv.invertDocument(10, *makeDoc10(f._b));
+    f._inv.invertDocument(11, *makeDoc11(f._b));
+    f._inv.invertDocument(12, *makeDoc12(f._b));
+    f._inv.invertDocument(13, *makeDoc13(f._b));
+    f.pushDocuments();
+    EXPECT_EQUAL("f=0,w=a,a=10,a=11,"
+                 "w=b,a=10,a=11,"
+                 "w=c,a=10,w=d,a=10,"
+                 "w=doc12,a=12,"
+                 "w=doc13,a=13,"
+                 "w=e,a=11,"
+                 "w=f,a=11,"
+                 "w=h,a=12,"
+                 "w=i,a=13,"
+                 "f=1,w=a,a=11,"
+                 "w=g,a=11",
+                 f._inserter.toStr());
+}
+
+
+TEST_F("require that removes are merged across shards", ShardedFixture)
+{
+    f._inv.getInverter(0, 2)->remove("a", 11);
+    f._inv.getInverter(0, 0)->remove("c", 9);
+    f._inv.getInverter(0, 1)->remove("d", 10);
+    f._inv.getInverter(0, 0)->remove("z", 12);
+    f._inv.invertDocument(10, *makeDoc10(f._b));
+    f.pushDocuments();
+    EXPECT_EQUAL("f=0,w=a,a=10,r=11,"
+                 "w=b,a=10,"
+                 "w=c,r=9,a=10,"
+                 "w=d,r=10,a=10,"
+                 "w=z,r=12",
+                 f._inserter.toStr());
+}
+
+
+TEST_F("require that reput in a shard works", ShardedFixture)
+{
+    f._inv.invertDocument(10, *makeDoc10(f._b));
+    f._inv.invertDocument(11, *makeDoc11(f._b));
+    f._inv.invertDocument(10, *makeDoc11(f._b));
+    f._inv.removeDocument(11);
+    f.pushDocuments();
+    EXPECT_EQUAL("f=0,w=a,a=10,"
+                 "w=b,a=10,"
+                 "w=e,a=10,"
+                 "w=f,a=10,"
+                 "f=1,w=a,a=10,"
+                 "w=g,a=10",
+                 f._inserter.toStr());
+}
+
+
 } // namespace memoryindex
 } // namespace search
 
@@ -661,6 +661,79 @@ SearchIterator::UP create_wand(bool use_dwa,
     return SearchIterator::UP(ParallelWeakAndSearch::create(terms, matchParams, RankParams(tfmd, std::move(childrenMatchData)), strict));
 }
 
+TEST("require that block max weights give the same hits as global max weights") {
+    DocumentWeightAttributeHelper helper;
+    helper.add_docs(1000);
+    for (uint32_t docid = 1; docid < 1000; ++docid) {
+        if ((docid % 2) == 0) {
+            helper.set_doc(docid, 2, 2);
+        } else {
+            helper.set_doc(docid, 1, ((docid % 97) == 1) ? 100 : 1);
+        }
+    }
+    std::vector<int32_t> weights = {1, 1};
+    std::vector<IDocumentWeightAttribute::LookupResult> dict_entries = {helper.dwa().lookup("1"), helper.dwa().lookup("2")};
+    // all hits until the heap is full, then those beating the lowest score in the heap
+    FakeResult expect;
+    for (uint32_t docid: {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 14, 16, 18, 195, 389, 583, 777, 971}) {
+        uint32_t weight = ((docid % 2) == 0) ? 2 : (((docid % 97) == 1) ? 100 : 1);
+        expect.doc(docid).score(weight);
+    }
+    for (bool use_dwa: {false, true}) {
+        // the attribute iterators prune using the max weight of each b-tree leaf
+        SharedWeakAndPriorityQueue heap(10);
+        TermFieldMatchData tfmd;
+        MatchParams match_params(heap, 0, 1.0, 1);
+        SearchIterator::UP search = create_wand(use_dwa, tfmd, match_params, weights, dict_entries, helper.dwa(), true);
+        EXPECT_EQUAL(expect, doSearch(*search, tfmd));
+    }
+}
+
+SimpleResult seek_unstrict(SearchIterator &search, uint32_t stride, uint32_t docid_limit) {
+    SimpleResult hits;
+    search.initRange(1, docid_limit);
+    for (uint32_t docid = 1; docid < docid_limit; docid += stride) {
+        if (search.seek(docid)) {
+            hits.addHit(docid);
+        }
+    }
+    return hits;
+}
+
+TEST("require that block max weights do not skip hits in unstrict search") {
+    DocumentWeightAttributeHelper helper;
+    helper.add_docs(1000);
+    std::vector<uint32_t> hits;
+    for (uint32_t docid = 1; docid < 1000; ++docid) {
+        if ((docid % 10) == 0) {
+            helper.set_doc(docid, 2, 100);
+            hits.push_back(docid);
+        } else {
+            helper.set_doc(docid, 1, (docid == 1) ? 100 : 1);
+        }
+    }
+    hits.insert(hits.begin(), 1);
+    std::vector<int32_t> weights = {1, 1};
+    std::vector<IDocumentWeightAttribute::LookupResult> dict_entries = {helper.dwa().lookup("1"), helper.dwa().lookup("2")};
+    for (uint32_t stride: {1, 2, 3, 7}) {
+        TEST_STATE(vespalib::make_string("stride: %u", stride).c_str());
+        SimpleResult expect;
+        for (uint32_t docid: hits) {
+            if (((docid - 1) % stride) == 0) {
+                expect.addHit(docid);
+            }
+        }
+        DummyHeap heap;
+        TermFieldMatchData tfmd;
+        MatchParams match_params(heap, 50, 1.0, 1);
+        // the term search iterators give no block information and act as baseline
+        SearchIterator::UP baseline = create_wand(false, tfmd, match_params, weights, dict_entries, helper.dwa(), false);
+        SearchIterator::UP search = create_wand(true, tfmd, match_params, weights, dict_entries, helper.dwa(), false);
+        EXPECT_EQUAL(expect, seek_unstrict(*baseline, stride, 1000));
+        EXPECT_EQUAL(expect, seek_unstrict(*search, stride, 1000));
+    }
+}
+
 class Verifier : public search::test::DwaIteratorChildrenVerifier {
 public:
     Verifier(bool use_dwa) : _use_dwa(use_dwa) { }
@@ -4,6 +4,8 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/objects/identifiable.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/common/gatecallback.h>
+#include <vespa/vespalib/io/fileutil.h>
 #include <vespa/fastos/file.h>
 #include <map>
 
@@ -52,12 +54,24 @@ private:
     void testMany();
     void testErase();
     void testSync();
+    void testGroupCommit();
+    void testAckAfterSync();
+    void testCommitFailure();
     void testTruncateOnShortRead();
     void testTruncateOnVersionMismatch();
 };
 
 TEST_APPHOOK(Test);
 
+class FailureCallback : public GateCallback, public CommitFailureListener
+{
+public:
+    FailureCallback(vespalib::Gate & gate, vespalib::string & error) : GateCallback(gate), _error(error) { }
+    void commitFailed(const vespalib::string & error) override { _error = error; }
+private:
+    vespalib::string & _error;
+};
+
 class CallBackTest : public TransLogClient::Visitor::Callback
 {
 private:
@@ -760,6 +774,121 @@ Test::testSync()
 }
 
 
+void
+Test::testGroupCommit()
+{
+    const unsigned int NUM_PACKETS = 100;
+    const unsigned int NUM_ENTRIES = 10;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+
+    DummyFileHeaderContext fileHeaderContext;
+    DomainConfig cfg;
+    cfg.setPartSizeLimit(0x1000000)
+       .setChunkAgeLimit(std::chrono::milliseconds(10))
+       .setFSyncOnCommit(true);
+    TransLogServer tlss("test14", 18377, ".", fileHeaderContext, cfg, 4);
+    TransLogClient tls("tcp/localhost:18377");
+
+    createDomainTest(tls, "groupcommit", 0);
+    TransLogClient::Session::UP s1 = openDomainTest(tls, "groupcommit");
+
+    vespalib::Gate gate;
+    vespalib::string error;
+    {
+        auto onDone = std::make_shared<GateCallback>(gate);
+        SerialNum serial(0);
+        for (size_t i(0); i < NUM_PACKETS; i++) {
+            Packet p;
+            for (size_t j(0); j < NUM_ENTRIES; j++) {
+                ++serial;
+                ASSERT_TRUE(p.add(Packet::Entry(serial, 1, vespalib::ConstBufferRef(&serial, sizeof(serial)))));
+            }
+            tlss.commit("groupcommit", p, onDone);
+        }
+        Packet old;
+        ASSERT_TRUE(old.add(Packet::Entry(1, 1, vespalib::ConstBufferRef(&serial, sizeof(serial)))));
+        vespalib::Gate refused;
+        tlss.commit("groupcommit", old, std::make_shared<FailureCallback>(refused, error));
+        refused.await();
+    }
+    EXPECT_EQUAL("Incomming serial number(1) must be bigger than the last one (1000).", error);
+    // Acknowledged only when written and synced
+    gate.await();
+    assertStatus(*s1, 1, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES);
+    SerialNum syncedTo(0);
+    EXPECT_TRUE(s1->sync(TOTAL_NUM_ENTRIES, syncedTo));
+    EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
+    TEST_DO(assertVisitStats(tls, "groupcommit", 0, TOTAL_NUM_ENTRIES, 1, TOTAL_NUM_ENTRIES,
+                             TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+}
+
+
+void
+Test::testAckAfterSync()
+{
+    DummyFileHeaderContext fileHeaderContext;
+    DomainConfig cfg;
+    cfg.setPartSizeLimit(0x1000000)
+       .setFSyncInterval(std::chrono::milliseconds(100));
+    TransLogServer tlss("test16", 18377, ".", fileHeaderContext, cfg, 4);
+    TransLogClient tls("tcp/localhost:18377");
+
+    createDomainTest(tls, "acksync", 0);
+    TransLogClient::Session::UP s1 = openDomainTest(tls, "acksync");
+
+    SerialNum serial(1);
+    Packet p;
+    ASSERT_TRUE(p.add(Packet::Entry(serial, 1, vespalib::ConstBufferRef(&serial, sizeof(serial)))));
+    vespalib::Gate gate;
+    auto start = std::chrono::steady_clock::now();
+    tlss.commit("acksync", p, std::make_shared<GateCallback>(gate));
+    // Held until the interval has passed and the part is synced
+    gate.await();
+    EXPECT_TRUE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(100));
+    TEST_DO(assertStatus(*s1, 1, 1, 1));
+}
+
+
+void
+Test::testCommitFailure()
+{
+    DummyFileHeaderContext fileHeaderContext;
+    DomainConfig cfg;
+    // rotate to a new part file on every commit
+    cfg.setPartSizeLimit(1);
+    TransLogServer tlss("test15", 18377, ".", fileHeaderContext, cfg, 4);
+    TransLogClient tls("tcp/localhost:18377");
+
+    createDomainTest(tls, "failing", 0);
+    TransLogClient::Session::UP s1 = openDomainTest(tls, "failing");
+    fillDomainTest(s1.get(), 1, 1, 100);
+
+    // creating the next part file fails when the domain directory is gone
+    vespalib::rmdir("test15/failing", true);
+    Packet p;
+    SerialNum serial(2);
+    ASSERT_TRUE(p.add(Packet::Entry(serial, 1, vespalib::ConstBufferRef(&serial, sizeof(serial)))));
+    vespalib::Gate gate;
+    vespalib::string error;
+    tlss.commit("failing", p, std::make_shared<FailureCallback>(gate, error));
+    gate.await();
+    EXPECT_EQUAL(size_t(0), error.find("Failed opening new file"));
+
+    // later commits are rejected right away
+    Packet next;
+    serial = 3;
+    ASSERT_TRUE(next.add(Packet::Entry(serial, 1, vespalib::ConstBufferRef(&serial, sizeof(serial)))));
+    EXPECT_EXCEPTION(s1->commit(vespalib::ConstBufferRef(next.getHandle().c_str(), next.getHandle().size())),
+                     std::runtime_error, "commit failed with code -2. server says: Exception during commit on failing : "
+                                         "Domain 'failing' has failed an earlier commit: Failed opening new file");
+    vespalib::Gate refused;
+    error.clear();
+    tlss.commit("failing", next, std::make_shared<FailureCallback>(refused, error));
+    refused.await();
+    EXPECT_EQUAL(size_t(0), error.find("Domain 'failing' has failed an earlier commit: Failed opening new file"));
+}
+
+
 void
 Test::testTruncateOnVersionMismatch()
 {
@@ -877,6 +1006,9 @@ int Test::Main()
     testRemove();
     
     testSync();
+    testGroupCommit();
+    testAckAfterSync();
+    testCommitFailure();
 
     testTruncateOnShortRead();
     testTruncateOnVersionMismatch();
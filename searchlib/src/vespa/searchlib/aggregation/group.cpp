@@ -94,6 +94,23 @@ Group::groupNext(const GroupingLevel & level, const Doc & doc, HitRank rank)
     level.group(*this, selectResult, doc, rank);
 }
 
+void
+Group::aggregate(const Grouping & grouping, uint32_t currentLevel, const DocId * docIds, const HitRank * ranks, uint32_t numDocs)
+{
+    if (currentLevel >= grouping.getFirstLevel()) {
+        _aggr.collect(docIds, ranks, numDocs);
+    }
+    if (currentLevel < grouping.getLevels().size()) {
+        groupNext(grouping.getLevels()[currentLevel], docIds, ranks, numDocs);
+    }
+}
+
+void
+Group::groupNext(const GroupingLevel & level, const DocId * docIds, const HitRank * ranks, uint32_t numDocs)
+{
+    level.group(*this, docIds, ranks, numDocs);
+}
+
 Group *
 Group::Value::groupSingle(const ResultNode & selectResult, HitRank rank, const GroupingLevel & level)
 {
@@ -268,6 +285,16 @@ void Group::Value::collect(const Doc & doc, HitRank rank)
     }
 }
 
+void Group::Value::collect(const DocId * docIds, const HitRank * ranks, uint32_t numDocs)
+{
+    for(size_t i(0), m(getAggrSize()); i < m; i++) {
+        AggregationResult & aggr = *getAggr(i);
+        for (uint32_t j(0); j < numDocs; j++) {
+            aggr.aggregate(docIds[j], ranks[j]);
+        }
+    }
+}
+
 void
 Group::Value::addResult(ExpressionNode::UP aggr)
 {
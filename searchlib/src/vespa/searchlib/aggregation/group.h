@@ -123,6 +123,7 @@ private:
 
         template <typename Doc>
         void collect(const Doc & docId, HitRank rank);
+        void collect(const DocId * docIds, const HitRank * ranks, uint32_t numDocs);
     private:
 
         using  ExpressionVector = ExpressionNode::CP *;
@@ -171,6 +172,7 @@ private:
 
     template <typename Doc>
     VESPA_DLL_LOCAL void groupNext(const GroupingLevel & level, const Doc & docId, HitRank rank);
+    VESPA_DLL_LOCAL void groupNext(const GroupingLevel & level, const DocId * docIds, const HitRank * ranks, uint32_t numDocs);
 public:
     DECLARE_IDENTIFIABLE_NS2(search, aggregation, Group);
     DECLARE_NBO_SERIALIZE;
@@ -250,6 +252,15 @@ public:
     template <typename Doc>
     VESPA_DLL_LOCAL void aggregate(const Grouping & grouping, uint32_t currentLevel, const Doc & docId, HitRank rank);
 
+    /**
+     * Aggregate a batch of hits. Each level is evaluated for all the hits
+     * in the batch before descending into the groups they were placed in,
+     * keeping the level expression and child map hot. The order of the
+     * hits within each group is the same as for per hit aggregation.
+     */
+    VESPA_DLL_LOCAL void aggregate(const Grouping & grouping, uint32_t currentLevel,
+                                   const DocId * docIds, const HitRank * ranks, uint32_t numDocs);
+
     template <typename Doc>
     void collect(const Doc & docId, HitRank rank) { _aggr.collect(docId, rank); }
     void postAggregate() { _aggr.postAggregate(); }
@@ -2,12 +2,14 @@
 
 #include "grouping.h"
 #include "hitsaggregationresult.h"
+#include "countaggregationresult.h"
 #include <vespa/searchlib/expression/stringresultnode.h>
 #include <vespa/searchlib/expression/enumresultnode.h>
 #include <vespa/searchlib/expression/resultvector.h>
 #include <vespa/searchlib/expression/attributenode.h>
 #include <vespa/searchlib/expression/documentaccessornode.h>
 #include <vespa/searchlib/attribute/stringbase.h>
+#include <vespa/searchlib/attribute/ipostinglistattributebase.h>
 #include <vespa/vespalib/objects/serializer.hpp>
 #include <vespa/vespalib/objects/deserializer.hpp>
 #include <vespa/searchlib/common/idocumentmetastore.h>
@@ -25,6 +27,70 @@ namespace search::aggregation {
 
 namespace {
 
+/**
+ * Collects hits and feeds them to grouping in batches.
+ **/
+class HitBatch
+{
+    static constexpr uint32_t BATCH_SIZE = 1024;
+    Grouping & _grouping;
+    uint32_t   _size;
+    DocId      _docIds[BATCH_SIZE];
+    HitRank    _ranks[BATCH_SIZE];
+public:
+    HitBatch(Grouping & grouping) : _grouping(grouping), _size(0) { }
+    void add(DocId docId, HitRank rank) {
+        _docIds[_size] = docId;
+        _ranks[_size] = rank;
+        if (++_size == BATCH_SIZE) {
+            flush();
+        }
+    }
+    void flush() {
+        if (_size > 0) {
+            _grouping.aggregateBatch(_docIds, _ranks, _size);
+            _size = 0;
+        }
+    }
+};
+
+bool onlyCounts(const Group & group)
+{
+    for (size_t i(0), m(group.getAggrSize()); i < m; i++) {
+        if ( ! group.getAggregationResult(i).inherits(CountAggregationResult::classId)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void addCounts(Group & group, uint64_t count)
+{
+    for (size_t i(0), m(group.getAggrSize()); i < m; i++) {
+        CountAggregationResult & aggr = static_cast<CountAggregationResult &>(group.getAggregationResult(i));
+        aggr.setCount(aggr.getCount() + count);
+    }
+}
+
+/**
+ * Returns the attribute the level groups on, if it is a plain single
+ * value fast-search attribute grouped by enum.
+ **/
+const AttributeVector *
+getPostingListAttribute(const GroupingLevel & level)
+{
+    const ExpressionNode * root = level.getExpression().getRoot();
+    if ((root == NULL) || ! root->inherits(AttributeNode::classId) ||
+        ! level.getExpression().getResult().inherits(EnumResultNode::classId)) {
+        return NULL;
+    }
+    const AttributeVector * attr = dynamic_cast<const AttributeVector *>(static_cast<const AttributeNode *>(root)->getAttribute());
+    if ((attr == NULL) || attr->hasMultiValue() || (attr->getIPostingListAttributeBase() == NULL)) {
+        return NULL;
+    }
+    return attr;
+}
+
 void selectGroups(const vespalib::ObjectPredicate &p, vespalib::ObjectOperation &op,
                   Group &group, uint32_t first, uint32_t last, uint32_t curr)
 {
@@ -173,9 +239,11 @@ void Grouping::aggregate(DocId from, DocId to)
 {
     preAggregate(false);
     if (to > from) {
+        HitBatch batch(*this);
         for(DocId i(from), m(i + getMaxN(to-from)); i < m; i++) {
-            aggregate(i, 0.0);
+            batch.add(i, 0.0);
         }
+        batch.flush();
     }
     postProcess();
 }
@@ -205,15 +273,19 @@ void Grouping::postProcess()
 }
 
 void Grouping::aggregateWithoutClock(const RankedHit * rankedHit, unsigned int len) {
+    HitBatch batch(*this);
     for(unsigned int i(0); i < len; i++) {
-        aggregate(rankedHit[i]._docId, rankedHit[i]._rankValue);
+        batch.add(rankedHit[i]._docId, rankedHit[i]._rankValue);
     }
+    batch.flush();
 }
 
 void Grouping::aggregateWithClock(const RankedHit * rankedHit, unsigned int len) {
+    HitBatch batch(*this);
     for(unsigned int i(0); (i < len) && !hasExpired(); i++) {
-        aggregate(rankedHit[i]._docId, rankedHit[i]._rankValue);
+        batch.add(rankedHit[i]._docId, rankedHit[i]._rankValue);
     }
+    batch.flush();
 }
 
 void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
@@ -230,9 +302,78 @@ void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
     postProcess();
 }
 
+bool Grouping::preferPostingCounts(uint64_t numHits, uint64_t docIdLimit, uint64_t numUniqueValues)
+{
+    // Evaluating the grouping for one hit costs roughly as much as
+    // visiting 16 documents in posting lists, or 4 dictionary entries.
+    return (numHits * 16) >= (docIdLimit + (numUniqueValues * 4));
+}
+
+/**
+ * Counting hits per unique value of a fast-search attribute does not
+ * need to look at the hits one by one. The count of each group is the
+ * size of the intersection between the hits and the posting list of
+ * the value. Group rank is the best hit rank in the group, which the
+ * posting lists do not know, so this is only done when all hits have
+ * the same rank. Since all posting lists are visited no matter how
+ * few hits there are, it is also only done when there are enough hits
+ * compared to the number of documents and unique values.
+ **/
+bool Grouping::aggregatePostingCounts(const RankedHit * rankedHit, unsigned int len, const BitVector * bVec)
+{
+    if ((_levels.size() != 1) || (_firstLevel != 0) || (_lastLevel < 1) || (getTopN() > 0) ||
+        ! onlyCounts(_root) || ! onlyCounts(_levels[0].getGroupPrototype())) {
+        return false;
+    }
+    const AttributeVector * attr = getPostingListAttribute(_levels[0]);
+    if (attr == NULL) {
+        return false;
+    }
+    bool hasBits = (bVec != NULL) && (bVec->getFirstTrueBit() < bVec->size());
+    uint64_t numHits = len + (hasBits ? bVec->countTrueBits() : 0);
+    if ( ! preferPostingCounts(numHits, attr->getCommittedDocIdLimit(), attr->getUniqueValueCount())) {
+        return false;
+    }
+    const attribute::IPostingListAttributeBase * postings = attr->getIPostingListAttributeBase();
+    HitRank rank = (len > 0) ? rankedHit[0]._rankValue : 0.0;
+    if (hasBits && (rank != 0.0)) {
+        return false;
+    }
+    DocId docIdLimit = hasBits ? bVec->size() : 0;
+    for (unsigned int i(0); i < len; i++) {
+        if (rankedHit[i]._rankValue != rank) {
+            return false;
+        }
+        docIdLimit = std::max(docIdLimit, rankedHit[i]._docId + 1);
+    }
+    if (hasBits && (docIdLimit > bVec->size())) {
+        return false;
+    }
+    BitVector::UP hits(hasBits ? BitVector::create(*bVec) : BitVector::create(docIdLimit));
+    for (unsigned int i(0); i < len; i++) {
+        hits->setBit(rankedHit[i]._docId);
+    }
+    hits->invalidateCachedCount();
+    std::vector<attribute::IPostingListAttributeBase::EnumCount> counts;
+    postings->countPostings(*hits, counts);
+    addCounts(_root, hits->countTrueBits());
+    const GroupingLevel & level = _levels[0];
+    for (const auto & count : counts) {
+        Group * group = _root.groupSingle(EnumResultNode(count.first), rank, level);
+        if (group != NULL) {
+            addCounts(*group, count.second);
+        }
+    }
+    return true;
+}
+
 void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len, const BitVector * bVec)
 {
     preAggregate(false);
+    if (aggregatePostingCounts(rankedHit, len, bVec)) {
+        postProcess();
+        return;
+    }
     if (_clock == NULL) {
         aggregateWithoutClock(rankedHit, getMaxN(len));
     } else {
@@ -240,27 +381,29 @@ void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len, const Bi
     }
     if (bVec != NULL) {
         unsigned int sz(bVec->size());
+        HitBatch batch(*this);
         if (_clock == NULL) {
             if (getTopN() > 0) {
                 for(DocId d(bVec->getFirstTrueBit()), i(0), m(getMaxN(sz)); (d < sz) && (i < m); d = bVec->getNextTrueBit(d+1), i++) {
-                    aggregate(d, 0.0);
+                    batch.add(d, 0.0);
                 }
             } else {
                 for(DocId d(bVec->getFirstTrueBit()); d < sz; d = bVec->getNextTrueBit(d+1)) {
-                    aggregate(d, 0.0);
+                    batch.add(d, 0.0);
                 }
             }
         } else {
             if (getTopN() > 0) {
                 for(DocId d(bVec->getFirstTrueBit()), i(0), m(getMaxN(sz)); (d < sz) && (i < m) && !hasExpired(); d = bVec->getNextTrueBit(d+1), i++) {
-                    aggregate(d, 0.0);
+                    batch.add(d, 0.0);
                 }
             } else {
                 for(DocId d(bVec->getFirstTrueBit()); (d < sz) && !hasExpired(); d = bVec->getNextTrueBit(d+1)) {
-                    aggregate(d, 0.0);
+                    batch.add(d, 0.0);
                 }
             }
         }
+        batch.flush();
     }
     postProcess();
 }
@@ -275,6 +418,11 @@ void Grouping::aggregate(const document::Document & doc, HitRank rank)
     _root.aggregate(*this, 0, doc, rank);
 }
 
+void Grouping::aggregateBatch(const DocId * docIds, const HitRank * ranks, uint32_t numDocs)
+{
+    _root.aggregate(*this, 0, docIds, ranks, numDocs);
+}
+
 void Grouping::convertToGlobalId(const search::IDocumentMetaStore &metaStore)
 {
     GlobalIdConverter conv(metaStore);
@@ -36,6 +36,7 @@ private:
     bool hasExpired() const { return _clock->getTimeNS() >= _timeOfDoom; }
     void aggregateWithoutClock(const RankedHit * rankedHit, unsigned int len);
     void aggregateWithClock(const RankedHit * rankedHit, unsigned int len);
+    bool aggregatePostingCounts(const RankedHit * rankedHit, unsigned int len, const BitVector * bVec);
     void postProcess();
 public:
     DECLARE_IDENTIFIABLE_NS2(search, aggregation, Grouping);
@@ -72,6 +73,13 @@ public:
     const Group &getRoot()   const { return _root; }
     bool needResort() const;
 
+    /**
+     * Whether counting hits per value by intersecting them with all the
+     * posting lists of an attribute is expected to be cheaper than
+     * grouping the hits one by one.
+     **/
+    static bool preferPostingCounts(uint64_t numHits, uint64_t docIdLimit, uint64_t numUniqueValues);
+
     GroupingLevelList &levels() { return _levels; }
     Group &root() { return _root; }
 
@@ -88,6 +96,12 @@ public:
     void aggregate(const RankedHit * rankedHit, unsigned int len, const BitVector * bVec);
     void aggregate(DocId docId, HitRank rank = 0);
     void aggregate(const document::Document & doc, HitRank rank = 0);
+    /**
+     * Aggregate a batch of hits. Gives the same result as aggregating
+     * the hits one by one, but evaluates one level at a time for all
+     * hits in the batch.
+     **/
+    void aggregateBatch(const DocId * docIds, const HitRank * ranks, uint32_t numDocs);
     void convertToGlobalId(const IDocumentMetaStore &metaStore);
     void postAggregate();
     void sortById();
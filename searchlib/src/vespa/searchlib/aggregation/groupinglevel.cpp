@@ -3,6 +3,7 @@
 #include "groupinglevel.h"
 #include "grouping.h"
 #include <vespa/searchlib/expression/resultvector.h>
+#include <algorithm>
 
 namespace search::aggregation {
 
@@ -74,6 +75,52 @@ bool GroupingLevel::Grouper::hasNext(size_t level) const
     return level < _grouping->getLevels().size();
 }
 
+void
+GroupingLevel::Grouper::group(Group & g, const DocId * docIds, const HitRank * ranks, uint32_t numDocs) const
+{
+    const ExpressionTree & selector = _grouping->getLevels()[_level].getExpression();
+    _batch.clear();
+    for (uint32_t i(0); i < numDocs; i++) {
+        if (!selector.execute(docIds[i], ranks[i])) {
+            throw std::runtime_error("Does not know how to handle failed select statements");
+        }
+        addToBatch(g, selector.getResult(), docIds[i], ranks[i]);
+    }
+    if (_batch.empty()) {
+        return;
+    }
+    std::sort(_batch.begin(), _batch.end());
+    _batchDocIds.resize(_batch.size());
+    _batchRanks.resize(_batch.size());
+    for (size_t i(0), m(_batch.size()); i < m; i++) {
+        _batchDocIds[i] = _batch[i].docId;
+        _batchRanks[i] = _batch[i].rank;
+    }
+    for (size_t start(0), end(0), m(_batch.size()); start < m; start = end) {
+        Group * next = _batch[start].group;
+        for (end = start + 1; (end < m) && (_batch[end].group == next); end++) { }
+        next->aggregate(*_grouping, _level + 1, &_batchDocIds[start], &_batchRanks[start], end - start);
+    }
+}
+
+void
+GroupingLevel::SingleValueGrouper::addToBatch(Group & g, const ResultNode & result, DocId doc, HitRank rank) const
+{
+    Group * next = g.groupSingle(result, rank, _grouping->getLevels()[_level]);
+    if ((next != NULL) && doNext()) { // do next level ?
+        _batch.emplace_back(next, _batch.size(), doc, rank);
+    }
+}
+
+void
+GroupingLevel::MultiValueGrouper::addToBatch(Group & g, const ResultNode & result, DocId doc, HitRank rank) const
+{
+    const ResultNodeVector & rv(static_cast<const ResultNodeVector &>(result));
+    for (size_t i(0), m(rv.size()); i < m; i++) {
+        SingleValueGrouper::addToBatch(g, rv.get(i), doc, rank);
+    }
+}
+
 template<typename Doc>
 void GroupingLevel::SingleValueGrouper::groupDoc(Group & g, const ResultNode & result, const Doc & doc, HitRank rank) const
 {
@@ -3,6 +3,7 @@
 
 #include "group.h"
 #include <vespa/searchlib/expression/aggregationrefnode.h>
+#include <vector>
 
 namespace search::aggregation {
 
@@ -25,9 +26,27 @@ private:
         virtual ~Grouper() { }
         virtual void group(Group & group, const ResultNode & result, DocId doc, HitRank rank) const = 0;
         virtual void group(Group & group, const ResultNode & result, const document::Document & doc, HitRank rank) const = 0;
+        void group(Group & group, const DocId * docIds, const HitRank * ranks, uint32_t numDocs) const;
         virtual Grouper * clone() const = 0;
     protected:
+        /**
+         * A hit placed in a group on the next level. Sorted by group and
+         * then by arrival order, so each group sees its hits in order.
+         */
+        struct BatchEntry {
+            BatchEntry(Group * group_, uint32_t seq_, DocId docId_, HitRank rank_)
+                : group(group_), seq(seq_), docId(docId_), rank(rank_)
+            { }
+            bool operator < (const BatchEntry & rhs) const {
+                return (group != rhs.group) ? (group < rhs.group) : (seq < rhs.seq);
+            }
+            Group  * group;
+            uint32_t seq;
+            DocId    docId;
+            HitRank  rank;
+        };
         Grouper(const Grouping * grouping, uint32_t level);
+        virtual void addToBatch(Group & group, const ResultNode & result, DocId doc, HitRank rank) const = 0;
         bool isFrozen() const { return _frozen; }
         bool  hasNext() const { return _hasNext; }
         bool   doNext() const { return _doNext; }
@@ -38,6 +57,10 @@ private:
         bool       _frozen;
         bool       _hasNext;
         bool       _doNext;
+        // Scratch buffers for batched grouping, reused across batches.
+        mutable std::vector<BatchEntry> _batch;
+        mutable std::vector<DocId>      _batchDocIds;
+        mutable std::vector<HitRank>    _batchRanks;
     };
     class SingleValueGrouper : public Grouper {
     public:
@@ -51,6 +74,7 @@ private:
         void group(Group & g, const ResultNode & result, const document::Document & doc, HitRank rank) const override {
             groupDoc(g, result, doc, rank);
         }
+        void addToBatch(Group & g, const ResultNode & result, DocId doc, HitRank rank) const override;
         SingleValueGrouper * clone() const override { return new SingleValueGrouper(*this); }
     };
     class MultiValueGrouper : public SingleValueGrouper {
@@ -65,6 +89,7 @@ private:
         void group(Group & g, const ResultNode & result, const document::Document & doc, HitRank rank) const override {
             groupDoc(g, result, doc, rank);
         }
+        void addToBatch(Group & g, const ResultNode & result, DocId doc, HitRank rank) const override;
         MultiValueGrouper * clone() const override { return new MultiValueGrouper(*this); }
     };
     int64_t        _maxGroups;
@@ -119,6 +144,9 @@ public:
     void group(Group & g, const ResultNode & result, const Doc & doc, HitRank rank) const {
         _grouper->group(g, result, doc, rank);
     }
+    void group(Group & g, const DocId * docIds, const HitRank * ranks, uint32_t numDocs) const {
+        _grouper->group(g, docIds, ranks, numDocs);
+    }
 
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
     void selectMembers(const vespalib::ObjectPredicate &predicate, vespalib::ObjectOperation &operation) override;
@@ -27,6 +27,28 @@ FilterAttributeIterator::FilterAttributeIterator(fef::TermFieldMatchData * match
     _matchPosition->setElementWeight(1);
 }
 
+ScanFilterAttributeIterator::ScanFilterAttributeIterator(fef::TermFieldMatchData * matchData)
+    : FilterAttributeIterator(matchData),
+      _hits()
+{ }
+
+ScanFilterAttributeIterator::~ScanFilterAttributeIterator() = default;
+
+void
+ScanFilterAttributeIterator::doSeek(uint32_t docId)
+{
+    if (!_hits || (docId >= _hits->size())) {
+        setAtEnd();
+        return;
+    }
+    uint32_t nextId = _hits->getNextTrueBit(docId);
+    if (nextId < _hits->size()) {
+        setDocId(nextId);
+    } else {
+        setAtEnd();
+    }
+}
+
 void
 AttributeIterator::visitMembers(vespalib::ObjectVisitor &visitor) const
 {
@@ -148,6 +148,41 @@ public:
     { }
 };
 
+/**
+ * This class acts as a strict filter iterator over documents that are
+ * results for the subquery represented by the search context object
+ * associated with this iterator.  When the docid range is set, the
+ * search context evaluates the term for all documents in the range in
+ * one pass into a bit vector owned by the iterator, which is then
+ * iterated.  Each iterator only scans its own range, so a search split
+ * over several threads still evaluates each document once.
+ */
+class ScanFilterAttributeIterator : public FilterAttributeIterator
+{
+public:
+    ScanFilterAttributeIterator(fef::TermFieldMatchData * matchData);
+    ~ScanFilterAttributeIterator();
+    Trinary is_strict() const override { return Trinary::True; }
+protected:
+    void doSeek(uint32_t docId) override;
+    std::unique_ptr<const BitVector> _hits;
+};
+
+template <typename SC>
+class ScanFilterAttributeIteratorT : public ScanFilterAttributeIterator
+{
+private:
+    void initRange(uint32_t begin, uint32_t end) override;
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    const SC & _searchContext;
+
+public:
+    ScanFilterAttributeIteratorT(const SC &searchContext, fef::TermFieldMatchData *matchData)
+        : ScanFilterAttributeIterator(matchData),
+          _searchContext(searchContext)
+    { }
+};
+
 /**
  * This class acts as an iterator over documents that are results for
  * the subquery represented by the search context object associated
@@ -212,6 +212,24 @@ FilterAttributeIteratorT<SC>::visitMembers(vespalib::ObjectVisitor &visitor) con
     visit(visitor, "searchcontext.queryterm", _searchContext.queryTerm());
 }
 
+template <typename SC>
+void
+ScanFilterAttributeIteratorT<SC>::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    ScanFilterAttributeIterator::visitMembers(visitor);
+    visit(visitor, "searchcontext.attribute", _searchContext.attribute().getName());
+    visit(visitor, "searchcontext.queryterm", _searchContext.queryTerm());
+}
+
+template <typename SC>
+void
+ScanFilterAttributeIteratorT<SC>::initRange(uint32_t begin, uint32_t end)
+{
+    ScanFilterAttributeIterator::initRange(begin, end);
+    _hits = _searchContext.scan(begin, end);
+    doSeek(begin);
+}
+
 template <typename SC>
 AttributeIteratorT<SC>::AttributeIteratorT(const SC &searchContext, fef::TermFieldMatchData *matchData)
     : AttributeIterator(matchData),
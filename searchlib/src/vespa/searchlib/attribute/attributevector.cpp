@@ -178,7 +178,8 @@ AttributeVector::AttributeVector(const vespalib::stringref &baseFileName, const
       _hasEnum(false),
       _hasSortedEnum(false),
       _loaded(false),
-      _enableEnumeratedSave(false)
+      _enableEnumeratedSave(false),
+      _loadExecutor(nullptr)
 { }
 
 
@@ -207,6 +208,12 @@ AttributeVector::isEnumerated(const vespalib::GenericHeader &header)
            header.getTag(enumeratedTag).asInteger() != 0;
 }
 
+vespalib::alloc::Alloc
+AttributeVector::createInitialAlloc(const Config &cfg)
+{
+    return cfg.getHugePages() ? vespalib::alloc::Alloc::allocHugePages() : vespalib::alloc::Alloc::alloc();
+}
+
 void
 AttributeVector::commit(bool forceUpdateStat)
 {
@@ -529,7 +536,14 @@ AttributeVector::isEnumeratedSaveFormat() const
 
 bool
 AttributeVector::load() {
+    return load(nullptr);
+}
+
+bool
+AttributeVector::load(vespalib::ThreadExecutor *executor) {
+    _loadExecutor = executor;
     bool loaded = onLoad();
+    _loadExecutor = nullptr;
     if (loaded) {
         commit();
     }
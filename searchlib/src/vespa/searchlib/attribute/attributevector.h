@@ -36,6 +36,7 @@ namespace document {
 
 namespace vespalib {
     class GenericHeader;
+    class ThreadExecutor;
 }
 
 namespace search {
@@ -325,6 +326,12 @@ protected:
         return _genHandler;
     }
 
+    /**
+     * Returns the executor that can be used to parallelize loading,
+     * or nullptr when loading in a single thread.  Only valid during load.
+     */
+    vespalib::ThreadExecutor *getLoadExecutor() const { return _loadExecutor; }
+
     GenerationHolder & getGenerationHolder() {
         return _genHolder;
     }
@@ -456,6 +463,12 @@ public:
 
     bool isEnumeratedSaveFormat() const;
     bool load();
+    /**
+     * Loads this attribute vector, using the threads in the given
+     * executor to sort loaded values and build posting lists.  The
+     * result is the same as when loading without an executor.
+     */
+    bool load(vespalib::ThreadExecutor *executor);
     void commit(bool forceStatUpdate = false);
     void commit(uint64_t firstSyncToken, uint64_t lastSyncToken);
     void setCreateSerialNum(uint64_t createSerialNum);
@@ -609,6 +622,7 @@ private:
     bool                   _hasSortedEnum;
     bool                   _loaded;
     bool                   _enableEnumeratedSave;
+    vespalib::ThreadExecutor *_loadExecutor;
     fastos::TimeStamp      _nextStatUpdateTime;
 
 ////// Locking strategy interface. only available from the Guards.
@@ -686,6 +700,12 @@ public:
 
     static bool isEnumerated(const vespalib::GenericHeader &header);
 
+    /**
+     * Initial allocation for vectors indexed by document id, backed by
+     * huge pages if enabled in the config.
+     */
+    static vespalib::alloc::Alloc createInitialAlloc(const Config &cfg);
+
     virtual MemoryUsage getChangeVectorMemoryUsage() const;
 };
 
@@ -69,6 +69,9 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setEnableOnlyBitVector(cfg.enableonlybitvector);
     retval.setIsFilter(cfg.enableonlybitvector);
     retval.setFastAccess(cfg.fastaccess);
+    retval.setHashDictionary(cfg.hashdictionary);
+    retval.setHugePages(cfg.hugepages);
+    retval.setPaged(cfg.paged);
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
     predicateParams.setDensePostingListThreshold(cfg.densepostinglistthreshold);
@@ -12,9 +12,12 @@ EnumAttribute<B>::
 EnumAttribute(const vespalib::string &baseFileName,
               const AttributeVector::Config &cfg)
     : B(baseFileName, cfg),
-      _enumStore(0, cfg.fastSearch())
+      _enumStore(0, cfg.fastSearch(), cfg.getHashDictionary())
 {
     this->setEnum(true);
+    if (cfg.getHugePages()) {
+        _enumStore.enableHugePages();
+    }
 }
 
 template <typename B>
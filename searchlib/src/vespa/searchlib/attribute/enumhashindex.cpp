@@ -0,0 +1,175 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "enumhashindex.h"
+#include <vespa/searchlib/datastore/datastore.hpp>
+#include <vespa/vespalib/util/array.hpp>
+
+namespace search {
+
+namespace {
+
+constexpr uint32_t NUMCLUSTERS_FOR_NEW_HASH_NODE_BUFFER = 1024u;
+
+}
+
+EnumHashIndex::Buckets::Buckets(uint32_t numBuckets)
+    : _mask(numBuckets - 1),
+      _heads(numBuckets, 0u)
+{
+}
+
+EnumHashIndex::Buckets::~Buckets() = default;
+
+/*
+ * Holds a replaced bucket array until readers are done with it.
+ */
+class EnumHashIndex::BucketsHold : public vespalib::GenerationHeldBase
+{
+    std::unique_ptr<Buckets> _buckets;
+public:
+    BucketsHold(std::unique_ptr<Buckets> buckets)
+        : GenerationHeldBase(sizeof(Buckets) + buckets->_heads.size() * sizeof(uint32_t)),
+          _buckets(std::move(buckets))
+    {
+    }
+    ~BucketsHold() override = default;
+};
+
+EnumHashIndex::EnumHashIndex()
+    : _store(),
+      _type(1, 1u, RefType::offsetSize(), NUMCLUSTERS_FOR_NEW_HASH_NODE_BUFFER),
+      _typeId(0),
+      _buckets(new Buckets(MIN_BUCKETS)),
+      _size(0),
+      _dead(0)
+{
+    _typeId = _store.addType(&_type);
+    _store.initActiveBuffers();
+}
+
+EnumHashIndex::~EnumHashIndex()
+{
+    _store.clearHoldLists();
+    _store.dropBuffers();
+    delete _buckets.load(std::memory_order_relaxed);
+}
+
+uint32_t
+EnumHashIndex::allocNode(Index key, uint32_t hash, uint32_t next)
+{
+    return _store.allocator<Node>(_typeId).alloc(key, hash, next).ref.ref();
+}
+
+void
+EnumHashIndex::rebuild(uint32_t numBuckets)
+{
+    std::unique_ptr<Buckets> oldBuckets(_buckets.load(std::memory_order_relaxed));
+    auto buckets = std::make_unique<Buckets>(numBuckets);
+    std::vector<uint32_t> toHold = _store.startCompact(_typeId);
+    for (uint32_t ref : oldBuckets->_heads) {
+        while (ref != 0) {
+            // Copy node, allocation might resize the buffer it lives in
+            Node node = getNode(ref);
+            uint32_t &head = buckets->head(node._hash);
+            head = allocNode(node._key, node._hash, head);
+            ref = node._next;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    _buckets.store(buckets.release(), std::memory_order_release);
+    _store.getGenerationHolder().hold(std::make_unique<BucketsHold>(std::move(oldBuckets)));
+    _store.finishCompact(toHold);
+    _dead = 0;
+}
+
+void
+EnumHashIndex::insert(Index key, uint32_t hash)
+{
+    Buckets *buckets = _buckets.load(std::memory_order_relaxed);
+    if (_size >= buckets->_heads.size()) {
+        rebuild(buckets->_heads.size() * 2);
+        buckets = _buckets.load(std::memory_order_relaxed);
+    }
+    uint32_t &head = buckets->head(hash);
+    uint32_t ref = allocNode(key, hash, head);
+    std::atomic_thread_fence(std::memory_order_release);
+    head = ref;
+    ++_size;
+}
+
+void
+EnumHashIndex::remove(Index key, uint32_t hash)
+{
+    Buckets *buckets = _buckets.load(std::memory_order_relaxed);
+    uint32_t *prev = &buckets->head(hash);
+    uint32_t ref = *prev;
+    while (ref != 0) {
+        Node &node = getNode(ref);
+        if (node._key == key) {
+            // Readers positioned at the node can still follow its link
+            *prev = node._next;
+            _store.holdElem(datastore::EntryRef(ref), 1);
+            --_size;
+            ++_dead;
+            if (_dead > _size && _dead >= MIN_BUCKETS) {
+                rebuild(buckets->_heads.size());
+            }
+            return;
+        }
+        prev = &node._next;
+        ref = node._next;
+    }
+}
+
+void
+EnumHashIndex::rekey(Index oldKey, Index newKey, uint32_t hash)
+{
+    const Buckets *buckets = _buckets.load(std::memory_order_relaxed);
+    uint32_t ref = buckets->head(hash);
+    while (ref != 0) {
+        Node &node = getNode(ref);
+        if (node._key == oldKey) {
+            std::atomic_thread_fence(std::memory_order_release);
+            node._key = newKey;
+            return;
+        }
+        ref = node._next;
+    }
+}
+
+void
+EnumHashIndex::clear()
+{
+    _store.clearHoldLists();
+    _store.dropBuffers();
+    _store.initActiveBuffers();
+    delete _buckets.load(std::memory_order_relaxed);
+    _buckets.store(new Buckets(MIN_BUCKETS), std::memory_order_release);
+    _size = 0;
+    _dead = 0;
+}
+
+MemoryUsage
+EnumHashIndex::getMemoryUsage() const
+{
+    MemoryUsage usage = _store.getMemoryUsage();
+    const Buckets *buckets = _buckets.load(std::memory_order_relaxed);
+    size_t bucketsBytes = sizeof(Buckets) + buckets->_heads.size() * sizeof(uint32_t);
+    usage.incAllocatedBytes(bucketsBytes);
+    usage.incUsedBytes(bucketsBytes);
+    return usage;
+}
+
+void
+EnumHashIndex::transferHoldLists(generation_t generation)
+{
+    _store.transferHoldLists(generation);
+}
+
+void
+EnumHashIndex::trimHoldLists(generation_t firstUsed)
+{
+    _store.trimHoldLists(firstUsed);
+}
+
+}
@@ -0,0 +1,135 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "enumstorebase.h"
+#include <vespa/searchlib/datastore/datastore.h>
+#include <vespa/searchlib/datastore/buffer_type.h>
+#include <vespa/searchlib/util/memoryusage.h>
+#include <vespa/vespalib/util/array.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <atomic>
+
+namespace search {
+
+/**
+ * Hash index mapping values in an enum store to their enum index,
+ * used for exact match lookups.  The btree dictionary is still the
+ * owner of the unique values and is needed for ordered access.
+ *
+ * Each bucket is a chain of nodes allocated in a data store.  A node is
+ * not changed after being linked into a chain, except for the key
+ * which is rewritten when the enum store is compacted.  Unlinked nodes
+ * and replaced bucket arrays are held until no reader can see them,
+ * thus lookups can run concurrently with a single writer.
+ */
+class EnumHashIndex
+{
+public:
+    using Index = EnumStoreIndex;
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+private:
+    using RefType = datastore::EntryRefT<22>;
+
+    struct Node {
+        Index    _key;
+        uint32_t _hash;
+        uint32_t _next; // ref to next node in chain, 0 terminates chain
+        Node()
+            : _key(),
+              _hash(0),
+              _next(0)
+        {
+        }
+        Node(Index key, uint32_t hash, uint32_t next)
+            : _key(key),
+              _hash(hash),
+              _next(next)
+        {
+        }
+    };
+
+    struct Buckets {
+        uint32_t                  _mask;
+        vespalib::Array<uint32_t> _heads;
+        Buckets(uint32_t numBuckets);
+        ~Buckets();
+        uint32_t &head(uint32_t hash) { return _heads[hash & _mask]; }
+        uint32_t head(uint32_t hash) const { return _heads[hash & _mask]; }
+    };
+
+    class BucketsHold;
+
+    datastore::DataStoreT<RefType> _store;
+    datastore::BufferType<Node>    _type;
+    uint32_t                       _typeId;
+    std::atomic<Buckets *>         _buckets;
+    uint32_t                       _size;
+    uint32_t                       _dead; // nodes unlinked since last rebuild
+
+    static constexpr uint32_t MIN_BUCKETS = 64;
+
+    Node &getNode(uint32_t ref) {
+        RefType iRef((datastore::EntryRef(ref)));
+        return *_store.getBufferEntry<Node>(iRef.bufferId(), iRef.offset());
+    }
+    const Node &getNode(uint32_t ref) const {
+        RefType iRef((datastore::EntryRef(ref)));
+        return *_store.getBufferEntry<Node>(iRef.bufferId(), iRef.offset());
+    }
+    uint32_t allocNode(Index key, uint32_t hash, uint32_t next);
+    void rebuild(uint32_t numBuckets);
+
+public:
+    EnumHashIndex();
+    ~EnumHashIndex();
+
+    /**
+     * Find the enum index for a value with the given hash.  The equal
+     * functor is called with candidate enum indexes and must return
+     * true if the candidate represents the value.  Safe to call from
+     * reader threads.
+     *
+     * @return the enum index, or an invalid index if not found
+     */
+    template <typename Equal>
+    Index find(uint32_t hash, const Equal &equal) const {
+        const Buckets *buckets = _buckets.load(std::memory_order_acquire);
+        uint32_t ref = buckets->head(hash);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        while (ref != 0) {
+            const Node &node = getNode(ref);
+            if (node._hash == hash) {
+                Index key = node._key;
+                if (equal(key)) {
+                    return key;
+                }
+            }
+            ref = node._next;
+        }
+        return Index();
+    }
+
+    void insert(Index key, uint32_t hash);
+    void remove(Index key, uint32_t hash);
+
+    /*
+     * Replace the key for a value that has been moved by compaction of
+     * the enum store.
+     */
+    void rekey(Index oldKey, Index newKey, uint32_t hash);
+
+    /*
+     * Drop all entries.  Must only be used when there are no readers,
+     * i.e. during load.
+     */
+    void clear();
+
+    uint32_t size() const { return _size; }
+    MemoryUsage getMemoryUsage() const;
+    void transferHoldLists(generation_t generation);
+    void trimHoldLists(generation_t firstUsed);
+};
+
+}
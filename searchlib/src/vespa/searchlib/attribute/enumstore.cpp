@@ -2,10 +2,59 @@
 
 #include "enumstore.h"
 #include "enumstore.hpp"
+#include <vespa/vespalib/stllike/hash_fun.h>
 #include <iomanip>
 
 namespace search {
 
+namespace {
+
+template <typename T>
+uint32_t
+hashFloatingPoint(T value)
+{
+    // Values comparing equal must hash equal, thus all NaNs and both
+    // zeros are mapped to a single bit pattern.
+    if (std::isnan(value)) {
+        value = std::numeric_limits<T>::quiet_NaN();
+    } else if (value == 0) {
+        value = 0;
+    }
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(T));
+    return (bits * 0x9e3779b97f4a7c15ul) >> 32;
+}
+
+}
+
+template <>
+uint32_t
+EnumStoreT<StringEntryType>::hashValue(Type value)
+{
+    return vespalib::hashValue(value);
+}
+
+template <>
+bool
+EnumStoreT<StringEntryType>::equalValue(Type lhs, Type rhs)
+{
+    return strcmp(lhs, rhs) == 0;
+}
+
+template <>
+uint32_t
+EnumStoreT<NumericEntryType<float> >::hashValue(Type value)
+{
+    return hashFloatingPoint(value);
+}
+
+template <>
+uint32_t
+EnumStoreT<NumericEntryType<double> >::hashValue(Type value)
+{
+    return hashFloatingPoint(value);
+}
+
 template <>
 void
 EnumStoreT<StringEntryType>::
@@ -148,6 +197,7 @@ EnumStoreT<StringEntryType>::deserialize(const void *src,
                                        Entry(dst).getValue()) < 0);
     }
     idx = Index(offset, activeBufferId);
+    insertHashIndex(idx);
     return sz;
 }
 
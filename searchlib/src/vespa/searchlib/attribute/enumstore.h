@@ -112,9 +112,22 @@ protected:
 
     void freeUnusedEnum(Index idx, IndexSet & unused) override;
 
+    /**
+     * Hash of a value, consistent with the equality of ComparatorType.
+     **/
+    static uint32_t hashValue(Type value);
+    static bool equalValue(Type lhs, Type rhs);
+
+    bool findHashIndex(Type value, Index &idx) const;
+    void insertHashIndex(Index idx);
+
 public:
-    EnumStoreT(uint64_t initBufferSize, bool hasPostings)
-        : EnumStoreBase(initBufferSize, hasPostings)
+    /**
+     * @param hasHashIndex also maintain a hash index over the unique
+     *                     values for exact match lookups
+     **/
+    EnumStoreT(uint64_t initBufferSize, bool hasPostings, bool hasHashIndex = false)
+        : EnumStoreBase(initBufferSize, hasPostings, hasHashIndex)
     {
     }
 
@@ -206,6 +219,22 @@ EnumStoreT<StringEntryType>::Entry::getValue() const
 }
 
 
+template <>
+uint32_t
+EnumStoreT<StringEntryType>::hashValue(Type value);
+
+template <>
+bool
+EnumStoreT<StringEntryType>::equalValue(Type lhs, Type rhs);
+
+template <>
+uint32_t
+EnumStoreT<NumericEntryType<float> >::hashValue(Type value);
+
+template <>
+uint32_t
+EnumStoreT<NumericEntryType<double> >::hashValue(Type value);
+
 template <>
 void
 EnumStoreT<StringEntryType>::writeValues(BufferWriter &writer,
@@ -4,6 +4,7 @@
 
 #include "enumstore.h"
 #include "enumcomparator.h"
+#include "enumhashindex.h"
 
 #include <vespa/searchlib/btree/btreenode.hpp>
 #include <vespa/searchlib/btree/btreenodestore.hpp>
@@ -25,10 +26,51 @@ void EnumStoreT<EntryType>::freeUnusedEnum(Index idx, IndexSet & unused)
         Type value = e.getValue();
         if (unused.insert(idx).second) {
             _store.incDead(idx.bufferId(), getEntrySize(value));
+            if (this->_hashIndex) {
+                this->_hashIndex->remove(idx, hashValue(value));
+            }
         }
     }
 }
 
+template <typename EntryType>
+uint32_t
+EnumStoreT<EntryType>::hashValue(Type value) // implementation for integers
+{
+    uint64_t v = static_cast<uint64_t>(static_cast<int64_t>(value));
+    return (v * 0x9e3779b97f4a7c15ul) >> 32;
+}
+
+template <typename EntryType>
+bool
+EnumStoreT<EntryType>::equalValue(Type lhs, Type rhs)
+{
+    return ComparatorType::compare(lhs, rhs) == 0;
+}
+
+template <typename EntryType>
+bool
+EnumStoreT<EntryType>::findHashIndex(Type value, Index &idx) const
+{
+    Index found = this->_hashIndex->find(hashValue(value),
+                                         [this, value](Index candidate)
+                                         { return equalValue(value, getValue(candidate)); });
+    if (!found.valid()) {
+        return false;
+    }
+    idx = found;
+    return true;
+}
+
+template <typename EntryType>
+void
+EnumStoreT<EntryType>::insertHashIndex(Index idx)
+{
+    if (this->_hashIndex) {
+        this->_hashIndex->insert(idx, hashValue(getValue(idx)));
+    }
+}
+
 template <typename EntryType>
 void
 EnumStoreT<EntryType>::
@@ -169,6 +211,7 @@ EnumStoreT<EntryType>::deserialize(const void *src,
                                        Entry(dst).getValue()) < 0);
     }
     idx = Index(offset, activeBufferId);
+    insertHashIndex(idx);
     return sz;
 }
 
@@ -189,8 +232,15 @@ bool
 EnumStoreT<EntryType>::findEnum(Type value,
                                    EnumStoreBase::EnumHandle &e) const
 {
-    ComparatorType cmp(*this, value);
     Index idx;
+    if (this->_hashIndex) {
+        if (findHashIndex(value, idx)) {
+            e = idx.ref();
+            return true;
+        }
+        return false;
+    }
+    ComparatorType cmp(*this, value);
     if (_enumDict->findFrozenIndex(cmp, idx)) {
         e = idx.ref();
         return true;
@@ -202,6 +252,9 @@ template <typename EntryType>
 bool
 EnumStoreT<EntryType>::findIndex(Type value, Index &idx) const
 {
+    if (this->_hashIndex) {
+        return findHashIndex(value, idx);
+    }
     ComparatorType cmp(*this, value);
     return _enumDict->findIndex(cmp, idx);
 }
@@ -260,6 +313,9 @@ EnumStoreT<EntryType>::addEnum(Type value,
     }
 
     // check if already present
+    if (this->_hashIndex && findHashIndex(value, newIdx)) {
+        return;
+    }
     ComparatorType cmp(*this, value);
     DictionaryIterator it(btree::BTreeNode::Ref(), dict.getAllocator());
     it.lower_bound(dict.getRoot(), Index(), cmp);
@@ -277,6 +333,7 @@ EnumStoreT<EntryType>::addEnum(Type value,
 
     // update tree with new index
     dict.insert(it, newIdx, typename Dictionary::DataType());
+    insertHashIndex(newIdx);
 
     // Copy posting list idx from next entry if same
     // folded value.
@@ -369,6 +426,7 @@ EnumStoreT<EntryType>::reset(Builder &builder, Dictionary &dict)
 
         // update DictionaryBuilder with enum index and posting index
         TreeBuilderInserter<Dictionary>::insert(treeBuilder, idx, datastore::EntryRef(iter->_pidx));
+        insertHashIndex(idx);
     }
 
     // reset Dictionary
@@ -445,6 +503,9 @@ EnumStoreT<EntryType>::performCompaction(Dictionary &dict)
         // update tree with new index
         std::atomic_thread_fence(std::memory_order_release);
         iter.writeKey(newIdx);
+        if (this->_hashIndex) {
+            this->_hashIndex->rekey(activeIdx, newIdx, hashValue(value));
+        }
 
         // update index map with new index
         this->_indexMap[oldEnum] = newIdx;
@@ -2,6 +2,7 @@
 
 #include "enumstorebase.h"
 #include "enumstore.h"
+#include "enumhashindex.h"
 #include <vespa/searchlib/datastore/datastore.hpp>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/searchlib/btree/btreeiterator.hpp>
@@ -58,8 +59,10 @@ EnumStoreBase::EnumBufferType::calcClustersToAlloc(uint32_t bufferId, size_t siz
 }
 
 EnumStoreBase::EnumStoreBase(uint64_t initBufferSize,
-                             bool hasPostings)
+                             bool hasPostings,
+                             bool hasHashIndex)
     : _enumDict(NULL),
+      _hashIndex(),
       _store(),
       _type(),
       _nextEnum(0),
@@ -71,6 +74,9 @@ EnumStoreBase::EnumStoreBase(uint64_t initBufferSize,
         _enumDict = new EnumStoreDict<EnumPostingTree>(*this);
     else
         _enumDict = new EnumStoreDict<EnumTree>(*this);
+    if (hasHashIndex) {
+        _hashIndex = std::make_unique<EnumHashIndex>();
+    }
     _store.addType(&_type);
     _type.setSizeNeededAndDead(initBufferSize, 0);
     _store.initActiveBuffers();
@@ -92,6 +98,9 @@ EnumStoreBase::reset(uint64_t initBufferSize)
     _store.initActiveBuffers();
     clearIndexMap();
     _enumDict->onReset();
+    if (_hashIndex) {
+        _hashIndex->clear();
+    }
     _nextEnum = 0;
 }
 
@@ -123,6 +132,16 @@ EnumStoreBase::getMemoryUsage() const
     return _store.getMemoryUsage();
 }
 
+MemoryUsage
+EnumStoreBase::getTreeMemoryUsage() const
+{
+    MemoryUsage usage = _enumDict->getTreeMemoryUsage();
+    if (_hashIndex) {
+        usage.merge(_hashIndex->getMemoryUsage());
+    }
+    return usage;
+}
+
 AddressSpace
 EnumStoreBase::getAddressSpaceUsage() const
 {
@@ -144,6 +163,9 @@ void
 EnumStoreBase::transferHoldLists(generation_t generation)
 {
     _enumDict->onTransferHoldLists(generation);
+    if (_hashIndex) {
+        _hashIndex->transferHoldLists(generation);
+    }
     _store.transferHoldLists(generation);
 }
 
@@ -152,6 +174,9 @@ EnumStoreBase::trimHoldLists(generation_t firstUsed)
 {
     // remove generations in the range [0, firstUsed>
     _enumDict->onTrimHoldLists(firstUsed);
+    if (_hashIndex) {
+        _hashIndex->trimHoldLists(firstUsed);
+    }
     _store.trimHoldLists(firstUsed);
 }
 
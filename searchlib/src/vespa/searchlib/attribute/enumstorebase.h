@@ -19,6 +19,7 @@ class BufferWriter;
 namespace attribute { class Status; }
 
 class EnumStoreBase;
+class EnumHashIndex;
 class EnumStoreComparator;
 class EnumStoreComparatorWrapper;
 
@@ -229,6 +230,7 @@ protected:
     };
 
     EnumStoreDictBase    *_enumDict;
+    std::unique_ptr<EnumHashIndex> _hashIndex; // optional, for exact match lookups
     DataStoreType         _store;
     EnumBufferType        _type;
     uint32_t              _nextEnum;
@@ -239,7 +241,7 @@ protected:
 
     static const uint32_t TYPE_ID = 0;
 
-    EnumStoreBase(uint64_t initBufferSize, bool hasPostings);
+    EnumStoreBase(uint64_t initBufferSize, bool hasPostings, bool hasHashIndex);
 
     virtual ~EnumStoreBase();
 
@@ -289,7 +291,9 @@ public:
         return _store.getBufferState(_store.getActiveBufferId(TYPE_ID)).remaining();
     }
     MemoryUsage getMemoryUsage() const;
-    MemoryUsage getTreeMemoryUsage() const { return _enumDict->getTreeMemoryUsage(); }
+    MemoryUsage getTreeMemoryUsage() const;
+    bool hasHashIndex() const { return static_cast<bool>(_hashIndex); }
+    void enableHugePages() { _store.enableHugePages(); }
 
     AddressSpace getAddressSpaceUsage() const;
 
@@ -2,16 +2,21 @@
 
 #pragma once
 
+#include <vector>
 
 namespace search
 {
 
+class BitVector;
+
 namespace attribute
 {
 
 class IPostingListAttributeBase
 {
 public:
+    using EnumCount = std::pair<IAttributeVector::EnumHandle, uint32_t>;
+
     virtual
     ~IPostingListAttributeBase()
     {
@@ -22,6 +27,14 @@ public:
                   uint32_t fromLid,
                   uint32_t toLid) = 0;
 
+    /**
+     * Count the documents in the given bit vector having each unique
+     * value by intersecting it with the posting list of the value.
+     * Counts are appended in value order, skipping values without
+     * any of the documents.
+     */
+    virtual void countPostings(const BitVector &docs, std::vector<EnumCount> &counts) const = 0;
+
     virtual void forwardedShrinkLidSpace(uint32_t newSize) = 0;
     virtual MemoryUsage getMemoryUsage() const = 0;
 };
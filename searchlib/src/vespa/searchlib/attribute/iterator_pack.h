@@ -43,6 +43,22 @@ public:
         return _children[ref].getData();
     }
 
+    static constexpr bool has_block_max() { return true; }
+
+    /**
+     * Max weight in the posting list block (b-tree leaf node) the child
+     * is positioned in. blockEnd is set to the last docid in the block.
+     */
+    int32_t get_block_max_weight(uint16_t ref, uint32_t &blockEnd) const {
+        const DocumentWeightIterator &child = _children[ref];
+        if (__builtin_expect(child.valid(), true)) {
+            blockEnd = child.getLeafLastKey();
+            return child.getLeafAggregated().getMax();
+        }
+        blockEnd = endDocId;
+        return 0;
+    }
+
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id, uint32_t end_id);
     void or_hits_into(BitVector &result, uint32_t begin_id);
 
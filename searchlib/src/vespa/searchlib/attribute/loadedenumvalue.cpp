@@ -2,19 +2,24 @@
 
 #include "loadedenumvalue.h"
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/searchlib/common/parallel_radix_sort.h>
 
 namespace search {
 namespace attribute {
 
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::ThreadExecutor *executor)
 {
-    ShiftBasedRadixSorter<LoadedEnumAttribute,
-        LoadedEnumAttribute::EnumRadix,
-        LoadedEnumAttribute::EnumCompare, 56>::
-        radix_sort(LoadedEnumAttribute::EnumRadix(),
-                   LoadedEnumAttribute::EnumCompare(),
-                   &loaded[0], loaded.size(), 16);
+    parallel_radix_sort(executor, LoadedEnumAttribute::EnumRadix(), &loaded[0], loaded.size(),
+                        [](LoadedEnumAttribute *a, size_t n)
+                        {
+                            ShiftBasedRadixSorter<LoadedEnumAttribute,
+                                LoadedEnumAttribute::EnumRadix,
+                                LoadedEnumAttribute::EnumCompare, 56>::
+                                radix_sort(LoadedEnumAttribute::EnumRadix(),
+                                           LoadedEnumAttribute::EnumCompare(),
+                                           a, n, 16);
+                        });
 }
 
 } // namespace attribute
@@ -5,6 +5,8 @@
 #include <vespa/vespalib/util/array.h>
 #include <vespa/searchlib/attribute/enumstorebase.h>
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace search
 {
 
@@ -141,7 +143,7 @@ public:
 };
 
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded);
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::ThreadExecutor *executor);
 
 } // namespace attribute
 
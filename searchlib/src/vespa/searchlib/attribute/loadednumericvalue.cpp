@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "loadednumericvalue.h"
+#include <vespa/searchlib/common/parallel_radix_sort.h>
 
 
 namespace search {
@@ -8,81 +9,103 @@ namespace attribute {
 
 template <typename T>
 void
-sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<T>> & loaded)
+sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<T>> & loaded,
+                  vespalib::ThreadExecutor *executor)
 {
-    ShiftBasedRadixSorter<LoadedNumericValue<T>,
-        typename LoadedNumericValue<T>::ValueRadix,
-        typename LoadedNumericValue<T>::ValueCompare, 56>::
-        radix_sort(typename LoadedNumericValue<T>::ValueRadix(),
-                   typename LoadedNumericValue<T>::ValueCompare(),
-                   &loaded[0],
-                   loaded.size(),
-                   16);
+    parallel_radix_sort(executor, typename LoadedNumericValue<T>::ValueRadix(), &loaded[0], loaded.size(),
+                        [](LoadedNumericValue<T> *a, size_t n)
+                        {
+                            ShiftBasedRadixSorter<LoadedNumericValue<T>,
+                                typename LoadedNumericValue<T>::ValueRadix,
+                                typename LoadedNumericValue<T>::ValueCompare, 56>::
+                                radix_sort(typename LoadedNumericValue<T>::ValueRadix(),
+                                           typename LoadedNumericValue<T>::ValueCompare(),
+                                           a,
+                                           n,
+                                           16);
+                        });
 }
 
 
 template <typename T>
 void
-sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<T>> & loaded)
+sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<T>> & loaded,
+                  vespalib::ThreadExecutor *executor)
 {
-    ShiftBasedRadixSorter<LoadedNumericValue<T>,
-        typename LoadedNumericValue<T>::DocRadix,
-        typename LoadedNumericValue<T>::DocOrderCompare, 56>::
-        radix_sort(typename LoadedNumericValue<T>::DocRadix(),
-                   typename LoadedNumericValue<T>::DocOrderCompare(),
-                   &loaded[0],
-                   loaded.size(),
-                   16);
+    parallel_radix_sort(executor, typename LoadedNumericValue<T>::DocRadix(), &loaded[0], loaded.size(),
+                        [](LoadedNumericValue<T> *a, size_t n)
+                        {
+                            ShiftBasedRadixSorter<LoadedNumericValue<T>,
+                                typename LoadedNumericValue<T>::DocRadix,
+                                typename LoadedNumericValue<T>::DocOrderCompare, 56>::
+                                radix_sort(typename LoadedNumericValue<T>::DocRadix(),
+                                           typename LoadedNumericValue<T>::DocOrderCompare(),
+                                           a,
+                                           n,
+                                           16);
+                        });
 }
 
 
 template
 void 
-sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<int8_t>> & loaded);
+sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<int8_t>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template
 void 
-sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<int16_t>> & loaded);
+sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<int16_t>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template
 void 
-sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<int32_t>> & loaded);
+sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<int32_t>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template
 void 
-sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<int64_t>> & loaded);
+sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<int64_t>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template
 void 
-sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<float>> & loaded);
+sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<float>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template
 void 
-sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<double>> & loaded);
+sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<double>> & loaded,
+                  vespalib::ThreadExecutor *executor);
                   
 template
 void 
-sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<int8_t>> & loaded);
+sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<int8_t>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template
 void 
-sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<int16_t>> & loaded);
+sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<int16_t>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template
 void 
-sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<int32_t>> & loaded);
+sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<int32_t>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template
 void 
-sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<int64_t>> & loaded);
+sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<int64_t>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template
 void 
-sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<float>> & loaded);
+sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<float>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template
 void 
-sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<double>> & loaded);
+sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<double>> & loaded,
+                  vespalib::ThreadExecutor *executor);
                   
 
 } // namespace attribute
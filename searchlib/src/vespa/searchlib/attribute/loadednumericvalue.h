@@ -6,6 +6,8 @@
 #include <vespa/searchlib/util/fileutil.h>
 #include "loadedvalue.h"
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace search {
 
 namespace attribute {
@@ -40,11 +42,13 @@ struct LoadedNumericValue : public LoadedValue<T>
 
 template <typename T>
 void
-sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<T>> & loaded);
+sortLoadedByValue(SequentialReadModifyWriteVector<LoadedNumericValue<T>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 template <typename T>
 void
-sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<T>> & loaded);
+sortLoadedByDocId(SequentialReadModifyWriteVector<LoadedNumericValue<T>> & loaded,
+                  vespalib::ThreadExecutor *executor);
 
 } // namespace attribute
 
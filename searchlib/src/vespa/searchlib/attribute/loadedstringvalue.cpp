@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "loadedstringvalue.h"
+#include <vespa/searchlib/common/parallel_radix_sort.h>
 
 using vespalib::Array;
 using vespalib::alloc::Alloc;
@@ -27,16 +28,20 @@ sortLoadedByValue(LoadedStringVectorReal &loaded)
 }
 
 void
-sortLoadedByDocId(LoadedStringVectorReal &loaded)
+sortLoadedByDocId(LoadedStringVectorReal &loaded, vespalib::ThreadExecutor *executor)
 {
-    ShiftBasedRadixSorter<LoadedStringValue,
-        LoadedStringValue::DocRadix,
-        LoadedStringValue::DocOrderCompare, 56>::
-        radix_sort(LoadedStringValue::DocRadix(),
-                   LoadedStringValue::DocOrderCompare(),
-                   &loaded[0],
-                   loaded.size(),
-                   16);
+    parallel_radix_sort(executor, LoadedStringValue::DocRadix(), &loaded[0], loaded.size(),
+                        [](LoadedStringValue *a, size_t n)
+                        {
+                            ShiftBasedRadixSorter<LoadedStringValue,
+                                LoadedStringValue::DocRadix,
+                                LoadedStringValue::DocOrderCompare, 56>::
+                                radix_sort(LoadedStringValue::DocRadix(),
+                                           LoadedStringValue::DocOrderCompare(),
+                                           a,
+                                           n,
+                                           16);
+                        });
 }
 
 
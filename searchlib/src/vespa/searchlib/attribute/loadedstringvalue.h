@@ -9,6 +9,8 @@
 #include <vespa/vespalib/text/lowercase.h>
 #include "loadedvalue.h"
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace search
 {
 
@@ -86,7 +88,7 @@ void
 sortLoadedByValue(LoadedStringVectorReal &loaded);
 
 void
-sortLoadedByDocId(LoadedStringVectorReal &loaded);
+sortLoadedByDocId(LoadedStringVectorReal &loaded, vespalib::ThreadExecutor *executor);
 
 
 } // namespace attribute
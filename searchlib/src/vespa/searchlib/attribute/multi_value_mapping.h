@@ -28,7 +28,8 @@ public:
     MultiValueMapping(const MultiValueMapping &) = delete;
     MultiValueMapping & operator = (const MultiValueMapping &) = delete;
     MultiValueMapping(const datastore::ArrayStoreConfig &storeCfg,
-                      const GrowStrategy &gs = GrowStrategy());
+                      const GrowStrategy &gs = GrowStrategy(),
+                      bool hugePages = false);
     virtual ~MultiValueMapping();
     ConstArrayRef get(uint32_t docId) const { return _store.get(_indices[docId]); }
     ConstArrayRef getDataForIdx(EntryRef idx) const { return _store.get(idx); }
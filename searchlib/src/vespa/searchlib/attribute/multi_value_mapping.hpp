@@ -10,10 +10,15 @@ namespace search {
 namespace attribute {
 
 template <typename EntryT, typename RefT>
-MultiValueMapping<EntryT,RefT>::MultiValueMapping(const datastore::ArrayStoreConfig &storeCfg, const GrowStrategy &gs)
-    : MultiValueMappingBase(gs, _store.getGenerationHolder()),
+MultiValueMapping<EntryT,RefT>::MultiValueMapping(const datastore::ArrayStoreConfig &storeCfg, const GrowStrategy &gs,
+                                                  bool hugePages)
+    : MultiValueMappingBase(gs, _store.getGenerationHolder(),
+                            hugePages ? vespalib::alloc::Alloc::allocHugePages() : vespalib::alloc::Alloc::alloc()),
       _store(storeCfg)
 {
+    if (hugePages) {
+        _store.enableHugePages();
+    }
 }
 
 template <typename EntryT, typename RefT>
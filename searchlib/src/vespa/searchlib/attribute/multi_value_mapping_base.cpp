@@ -15,8 +15,9 @@ constexpr size_t DEAD_CLUSTERS_SLACK = 0x10000u;
 }
 
 MultiValueMappingBase::MultiValueMappingBase(const GrowStrategy &gs,
-                                               vespalib::GenerationHolder &genHolder)
-    : _indices(gs, genHolder),
+                                               vespalib::GenerationHolder &genHolder,
+                                               const vespalib::alloc::Alloc &initialAlloc)
+    : _indices(gs, genHolder, initialAlloc),
       _totalValues(0u),
       _cachedArrayStoreMemoryUsage(),
       _cachedArrayStoreAddressSpaceUsage(0, 0, (1ull << 32))
@@ -29,7 +29,8 @@ protected:
     MemoryUsage _cachedArrayStoreMemoryUsage;
     AddressSpace _cachedArrayStoreAddressSpaceUsage;
 
-    MultiValueMappingBase(const GrowStrategy &gs, vespalib::GenerationHolder &genHolder);
+    MultiValueMappingBase(const GrowStrategy &gs, vespalib::GenerationHolder &genHolder,
+                          const vespalib::alloc::Alloc &initialAlloc);
     virtual ~MultiValueMappingBase();
 
     void updateValueCount(size_t oldValues, size_t newValues) {
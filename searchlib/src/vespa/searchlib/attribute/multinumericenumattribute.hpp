@@ -39,11 +39,11 @@ MultiValueNumericEnumAttribute<B, M>::loadAllAtOnce(AttributeReader & attrReader
         }
     }
 
-    attribute::sortLoadedByValue(loaded);
+    attribute::sortLoadedByValue(loaded, this->getLoadExecutor());
     this->fillPostings(loaded);
     loaded.rewind();
     this->fillEnum(loaded);
-    attribute::sortLoadedByDocId(loaded);
+    attribute::sortLoadedByDocId(loaded, this->getLoadExecutor());
 
     loaded.rewind();
     this->fillValues(loaded);
@@ -84,7 +84,7 @@ MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase &attrReader)
         if (numDocs > 0) {
             this->onAddDoc(numDocs - 1);
         }
-        attribute::sortLoadedByEnum(loaded);
+        attribute::sortLoadedByEnum(loaded, this->getLoadExecutor());
         this->fillPostingsFixupEnum(loaded);
     } else {
         this->fixupEnumRefCounts(enumHist);
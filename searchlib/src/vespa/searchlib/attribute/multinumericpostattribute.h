@@ -97,7 +97,7 @@ public:
     }
     
     void fillPostings(LoadedVector & loaded) override {
-        handleFillPostings(loaded);
+        handleFillPostings(loaded, this->getLoadExecutor());
     }
 
     attribute::IPostingListAttributeBase *getIPostingListAttributeBase() override {
@@ -21,7 +21,7 @@ MultiValueAttribute(const vespalib::string &baseFileName,
       _mvMapping(MultiValueMapping::optimizedConfigForHugePage(1023,
                                                                multivalueattribute::HUGE_MEMORY_PAGE_SIZE,
                                                                multivalueattribute::SMALL_MEMORY_PAGE_SIZE,
-                                                               8 * 1024), cfg.getGrowStrategy())
+                                                               8 * 1024), cfg.getGrowStrategy(), cfg.getHugePages())
 {
 }
 
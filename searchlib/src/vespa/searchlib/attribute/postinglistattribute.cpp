@@ -3,12 +3,57 @@
 #include "postinglistattribute.h"
 #include "loadednumericvalue.h"
 #include "enumcomparator.h"
+#include "postingstore.hpp"
 #include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/threadexecutor.h>
+#include <atomic>
+#include <deque>
 
 namespace search {
 
 using attribute::LoadedNumericValue;
 
+namespace {
+
+// Duplicate removal for values with fewer additions is done by the loading thread
+constexpr size_t minParallelRemoveDupsAdditions = 16 * 1024;
+// Limit memory used for values waiting for duplicate removal
+constexpr size_t maxPendingAdditions = 16 * 1024 * 1024;
+
+/*
+ * Posting list changes for a single value and the loaded values that
+ * should refer to the resulting posting list.  Duplicate removal is
+ * performed once, either by a task or by the loading thread.
+ */
+template <typename P, typename LoadedType>
+struct PendingPostings
+{
+    PostingChange<P> _postings;
+    vespalib::Array<LoadedType> _similarValues;
+    size_t _numAdditions;
+    std::atomic<bool> _claimed;
+    vespalib::Gate _done;
+
+    PendingPostings(size_t numAdditions)
+        : _postings(),
+          _similarValues(),
+          _numAdditions(numAdditions),
+          _claimed(false),
+          _done()
+    { }
+
+    void removeDups() {
+        if (!_claimed.exchange(true)) {
+            _postings.removeDups();
+            _done.countDown();
+        }
+    }
+};
+
+}
+
 template <typename P>
 PostingListAttributeBase<P>::
 PostingListAttributeBase(AttributeVector &attr,
@@ -209,6 +254,38 @@ PostingListAttributeBase<P>::getMemoryUsage() const
     return _postingList.getMemoryUsage();
 }
 
+template <typename P>
+void
+PostingListAttributeBase<P>::countPostings(const BitVector &docs, std::vector<EnumCount> &counts) const
+{
+    auto frozenDictionary = _dict.getFrozenView();
+    for (auto it = frozenDictionary.begin(); it.valid(); ++it) {
+        EntryRef pidx(it.getData());
+        if (!pidx.valid()) {
+            continue;
+        }
+        uint32_t count = 0;
+        uint32_t typeId = _postingList.getTypeId(pidx);
+        const attribute::BitVectorEntry *bve = _postingList.isBitVector(typeId) ? _postingList.getBitVectorEntry(pidx) : nullptr;
+        if (bve != nullptr) {
+            // Word by word intersection, the smaller vector must be on the left side
+            const BitVector &bv = *bve->_bv;
+            count = (docs.size() <= bv.size()) ? docs.andCount(bv) : bv.andCount(docs);
+        } else {
+            uint32_t docIdLimit = docs.size();
+            _postingList.foreach_frozen_key(pidx, [&docs, &count, docIdLimit](uint32_t docId)
+                                            {
+                                                if ((docId < docIdLimit) && docs.testBit(docId)) {
+                                                    ++count;
+                                                }
+                                            });
+        }
+        if (count > 0) {
+            counts.emplace_back(EnumIndex(it.getKey()).ref(), count);
+        }
+    }
+}
+
 template <typename P, typename LoadedVector, typename LoadedValueType,
           typename EnumStoreType>
 PostingListAttributeSubBase<P, LoadedVector, LoadedValueType, EnumStoreType>::
@@ -232,16 +309,76 @@ template <typename P, typename LoadedVector, typename LoadedValueType,
           typename EnumStoreType>
 void
 PostingListAttributeSubBase<P, LoadedVector, LoadedValueType, EnumStoreType>::
-handleFillPostings(LoadedVector &loaded)
+handleFillPostings(LoadedVector &loaded, vespalib::ThreadExecutor *executor)
 {
+    typedef typename LoadedVector::Type LoadedType;
+    typedef PendingPostings<P, LoadedType> Pending;
     clearAllPostings();
-    EntryRef newIndex;
     PostingChange<P> postings;
     uint32_t docIdLimit = _attr.getNumDocs();
     _postingList.resizeBitVectors(docIdLimit, docIdLimit);
     if ( ! loaded.empty() ) {
-        vespalib::Array<typename LoadedVector::Type> similarValues;
-        typename LoadedVector::Type v = loaded.read();
+        vespalib::Array<LoadedType> similarValues;
+        // Values waiting for duplicate removal, posting lists are added in value order.
+        std::deque<std::shared_ptr<Pending>> pending;
+        size_t pendingAdditions = 0;
+        auto applyPostings = [this, &loaded](PostingChange<P> &change, vespalib::Array<LoadedType> &values)
+                             {
+                                 EntryRef newIndex;
+                                 _postingList.apply(newIndex,
+                                                    &change._additions[0],
+                                                    &change._additions[0] +
+                                                    change._additions.size(),
+                                                    &change._removals[0],
+                                                    &change._removals[0] +
+                                                    change._removals.size());
+                                 values[0]._pidx = newIndex;
+                                 for(size_t j(0), k(values.size()); j < k; j++) {
+                                     loaded.write(values[j]);
+                                 }
+                             };
+        auto applyPending = [&](bool drain)
+                            {
+                                while (!pending.empty()) {
+                                    Pending &front = *pending.front();
+                                    if (!drain && pendingAdditions <= maxPendingAdditions &&
+                                        !front._done.await(0)) {
+                                        break;
+                                    }
+                                    front.removeDups();
+                                    front._done.await();
+                                    applyPostings(front._postings, front._similarValues);
+                                    pendingAdditions -= front._numAdditions;
+                                    pending.pop_front();
+                                }
+                            };
+        auto flushPostings = [&]()
+                             {
+                                 size_t numAdditions = postings._additions.size();
+                                 if (executor == nullptr ||
+                                     (pending.empty() && numAdditions < minParallelRemoveDupsAdditions))
+                                 {
+                                     postings.removeDups();
+                                     applyPostings(postings, similarValues);
+                                 } else {
+                                     auto entry = std::make_shared<Pending>(numAdditions);
+                                     std::swap(entry->_postings._additions, postings._additions);
+                                     std::swap(entry->_postings._removals, postings._removals);
+                                     std::swap(entry->_similarValues, similarValues);
+                                     if (numAdditions >= minParallelRemoveDupsAdditions) {
+                                         auto task = vespalib::makeLambdaTask([entry]() { entry->removeDups(); });
+                                         executor->execute(std::move(task));
+                                     } else {
+                                         entry->removeDups();
+                                     }
+                                     pending.push_back(std::move(entry));
+                                     pendingAdditions += numAdditions;
+                                     applyPending(false);
+                                 }
+                                 postings.clear();
+                                 similarValues.clear();
+                             };
+        LoadedType v = loaded.read();
         LoadedValueType prev = v.getValue();
         for(size_t i(0), m(loaded.size()); i < m; i++, loaded.next()) {
             v = loaded.read();
@@ -254,42 +391,16 @@ handleFillPostings(LoadedVector &loaded)
                     similarValues.push_back(v);
                 }
             } else {
-                postings.removeDups();
-
-                newIndex = EntryRef();
-                _postingList.apply(newIndex,
-                                   &postings._additions[0],
-                                   &postings._additions[0] +
-                                   postings._additions.size(),
-                                   &postings._removals[0],
-                                   &postings._removals[0] +
-                                   postings._removals.size());
-                postings.clear();
+                flushPostings();
                 if (v._docId < docIdLimit) {
                     postings.add(v._docId, v.getWeight());
                 }
-                similarValues[0]._pidx = newIndex;
-                for(size_t j(0), k(similarValues.size()); j < k; j++) {
-                    loaded.write(similarValues[j]);
-                }
-                similarValues.clear();
                 similarValues.push_back(v);
                 prev = v.getValue();
             }
         }
-
-        postings.removeDups();
-        newIndex = EntryRef();
-        _postingList.apply(newIndex,
-                           &postings._additions[0],
-                           &postings._additions[0] +
-                           postings._additions.size(),
-                           &postings._removals[0],
-                           &postings._removals[0] + postings._removals.size());
-        similarValues[0]._pidx = newIndex;
-        for(size_t i(0), m(similarValues.size()); i < m; i++) {
-            loaded.write(similarValues[i]);
-        }
+        flushPostings();
+        applyPending(true);
     }
 }
 
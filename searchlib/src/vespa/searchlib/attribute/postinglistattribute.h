@@ -13,6 +13,8 @@
 #include "postingchange.h"
 #include "ipostinglistattributebase.h"
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace search {
 
 class EnumPostingPair
@@ -66,6 +68,7 @@ protected:
 
     void forwardedShrinkLidSpace(uint32_t newSize) override;
     virtual MemoryUsage getMemoryUsage() const override;
+    void countPostings(const BitVector &docs, std::vector<EnumCount> &counts) const override;
 
 public:
     const PostingList & getPostingList() const { return _postingList; }
@@ -104,7 +107,12 @@ public:
     PostingListAttributeSubBase(AttributeVector &attr, EnumStore &enumStore);
     virtual ~PostingListAttributeSubBase();
 
-    void handleFillPostings(LoadedVector &loaded);
+    /*
+     * Build posting lists from loaded values sorted by value.  Duplicate
+     * removal for values with many documents is done by tasks on the
+     * executor, while posting lists are still added in value order.
+     */
+    void handleFillPostings(LoadedVector &loaded, vespalib::ThreadExecutor *executor);
     void updatePostings(PostingMap &changePost) override;
     void printPostingListContent(vespalib::asciistream & os) const;
     void clearPostings(attribute::IAttributeVector::EnumHandle eidx, uint32_t fromLid, uint32_t toLid) override;
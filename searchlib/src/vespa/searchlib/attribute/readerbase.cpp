@@ -179,4 +179,11 @@ ReaderBase::getNextValueCount()
     return numValues;
 }
 
+vespalib::alloc::Alloc
+ReaderBase::mapData() const
+{
+    return vespalib::alloc::Alloc::mapFile(_datFile->GetFileName(), _datHeaderLen,
+                                           _datFileSize - _datHeaderLen);
+}
+
 }
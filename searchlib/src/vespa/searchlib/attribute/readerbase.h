@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchlib/util/fileutil.h>
+#include <vespa/vespalib/util/alloc.h>
 #include <cassert>
 
 namespace search {
@@ -47,6 +48,13 @@ public:
     const vespalib::GenericHeader &getDatHeader() const {
         return _datHeader;
     }
+
+    /**
+     * Map the data part of the dat file, private and copy-on-write.
+     * Returns an empty allocation if the data part is empty, not page
+     * aligned in the file or could not be mapped.
+     */
+    vespalib::alloc::Alloc mapData() const;
 protected:
     std::unique_ptr<FastOS_FileInterface>  _datFile;
 private:
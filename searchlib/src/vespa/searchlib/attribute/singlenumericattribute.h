@@ -5,6 +5,7 @@
 #include "integerbase.h"
 #include "floatbase.h"
 #include <vespa/searchlib/common/rcuvector.h>
+#include <vespa/searchlib/common/bitvector.h>
 #include <limits>
 
 namespace search {
@@ -40,6 +41,7 @@ private:
     {
     private:
         const T * _data;
+        uint32_t  _docIdLimit;
 
         bool onCmp(DocId docId, int32_t & weight) const override {
             return cmp(docId, weight);
@@ -51,7 +53,33 @@ private:
 
         bool valid() const override;
 
+        /*
+         * Match 64 consecutive values into a bit vector word. Kept free
+         * of branches so the compiler vectorizes it.
+         */
+        uint64_t matchWord(const T * values) const {
+            uint8_t hits[64];
+            for (uint32_t i = 0; i < 64; ++i) {
+                hits[i] = this->match(values[i]) ? 1 : 0;
+            }
+            uint64_t word = 0;
+            for (uint32_t i = 0; i < 64; ++i) {
+                word |= static_cast<uint64_t>(hits[i]) << i;
+            }
+            return word;
+        }
+
+        /*
+         * Estimate the hit ratio by evaluating the term for a sample of
+         * evenly spread documents.
+         */
+        double estimateHitRatio() const;
+
     public:
+        // Strict filters scan all documents up front when at least this
+        // part of the sampled documents are hits.
+        static constexpr double MIN_SCAN_HIT_RATIO = 0.5;
+
     SingleSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const NumericAttribute & toBeSearched);
         bool cmp(DocId docId, int32_t & weight) const {
             const T v = _data[docId];
@@ -66,6 +94,13 @@ private:
 
         Int64Range getAsIntegerTerm() const override;
 
+        /*
+         * Evaluate the term for all documents in the given range in one
+         * pass over the raw values. Returns nullptr if no documents in
+         * the attribute are in the range.
+         */
+        BitVector::UP scan(uint32_t begin, uint32_t end) const;
+
         std::unique_ptr<queryeval::SearchIterator>
         createFilterIterator(fef::TermFieldMatchData * matchData, bool strict) override;
     };
@@ -18,7 +18,8 @@ SingleValueNumericAttribute(const vespalib::string & baseFileName, const Attribu
     _data(c.getGrowStrategy().getDocsInitialCapacity(),
           c.getGrowStrategy().getDocsGrowPercent(),
           c.getGrowStrategy().getDocsGrowDelta(),
-          getGenerationHolder())
+          getGenerationHolder(),
+          AttributeVector::createInitialAlloc(c))
 { }
 
 template <typename B>
@@ -141,9 +142,18 @@ SingleValueNumericAttribute<B>::onLoad()
     const size_t sz(attrReader.getDataCount());
     getGenerationHolder().clearHoldLists();
     _data.reset();
-    _data.unsafe_reserve(sz);
-    for (uint32_t i = 0; i < sz; ++i) {
-        _data.push_back(attrReader.getNextData());
+    vespalib::alloc::Alloc mapped;
+    if (this->getConfig().getPaged()) {
+        mapped = attrReader.mapData();
+    }
+    if (mapped.get() != nullptr) {
+        // Values are paged in on access, and pages are copied on write
+        _data.unsafe_assign(std::move(mapped), sz);
+    } else {
+        _data.unsafe_reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            _data.push_back(attrReader.getNextData());
+        }
     }
 
     B::setNumDocs(sz);
@@ -210,9 +220,55 @@ SingleValueNumericAttribute<B>::SingleSearchContext<M>::SingleSearchContext(Quer
                                                                             const NumericAttribute & toBeSearched) :
     M(*qTerm, true),
     AttributeVector::SearchContext(toBeSearched),
-    _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0])
+    _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0]),
+    _docIdLimit(toBeSearched.getCommittedDocIdLimit())
 { }
 
+template <typename B>
+template <typename M>
+double
+SingleValueNumericAttribute<B>::SingleSearchContext<M>::estimateHitRatio() const
+{
+    if (_docIdLimit <= 1) {
+        return 0.0;
+    }
+    const uint32_t numDocs = _docIdLimit - 1;
+    const uint32_t numSamples = std::min(numDocs, 1024u);
+    uint32_t hits = 0;
+    for (uint32_t i = 0; i < numSamples; ++i) {
+        hits += this->match(_data[1 + (static_cast<uint64_t>(i) * numDocs) / numSamples]) ? 1 : 0;
+    }
+    return static_cast<double>(hits) / numSamples;
+}
+
+template <typename B>
+template <typename M>
+BitVector::UP
+SingleValueNumericAttribute<B>::SingleSearchContext<M>::scan(uint32_t begin, uint32_t end) const
+{
+    const uint32_t limit = std::min(end, _docIdLimit);
+    if (begin >= limit) {
+        return BitVector::UP();
+    }
+    BitVector::UP bv(BitVector::create(begin, limit));
+    uint64_t * words = static_cast<uint64_t *>(bv->getStart());
+    uint32_t docId = std::max(begin, 1u); // skip the reserved document
+    for (; (docId < limit) && ((docId % 64) != 0); ++docId) {
+        if (this->match(_data[docId])) {
+            bv->setBit(docId);
+        }
+    }
+    for (; docId + 64 <= limit; docId += 64) {
+        words[docId / 64] = matchWord(_data + docId);
+    }
+    for (; docId < limit; ++docId) {
+        if (this->match(_data[docId])) {
+            bv->setBit(docId);
+        }
+    }
+    bv->invalidateCachedCount();
+    return bv;
+}
 
 template <typename B>
 template <typename M>
@@ -230,6 +286,11 @@ createFilterIterator(fef::TermFieldMatchData * matchData, bool strict)
     if (!valid()) {
         return queryeval::SearchIterator::UP(new queryeval::EmptySearch());
     }
+    if (strict && (getIsFilter() || matchData->isNotNeeded()) && (estimateHitRatio() >= MIN_SCAN_HIT_RATIO)) {
+        // When most documents are hits, evaluate the term for all of
+        // them in one vectorized pass instead of one compare per seek.
+        return queryeval::SearchIterator::UP(new ScanFilterAttributeIteratorT<SingleSearchContext<M> >(*this, matchData));
+    }
     if (getIsFilter()) {
         return queryeval::SearchIterator::UP
                 (strict
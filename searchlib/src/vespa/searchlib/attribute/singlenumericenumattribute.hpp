@@ -102,7 +102,7 @@ SingleValueNumericEnumAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
         if (numDocs > 0) {
             this->onAddDoc(numDocs - 1);
         }
-        attribute::sortLoadedByEnum(loaded);
+        attribute::sortLoadedByEnum(loaded, this->getLoadExecutor());
         this->fillPostingsFixupEnum(loaded);
     } else {
         this->fixupEnumRefCounts(enumHist);
@@ -141,11 +141,11 @@ SingleValueNumericEnumAttribute<B>::onLoad()
         loaded[docIdx].setValue(attrReader.getNextData());
     }
 
-    attribute::sortLoadedByValue(loaded);
+    attribute::sortLoadedByValue(loaded, this->getLoadExecutor());
     this->fillPostings(loaded);
     loaded.rewind();
     this->fillEnum(loaded);
-    attribute::sortLoadedByDocId(loaded);
+    attribute::sortLoadedByDocId(loaded, this->getLoadExecutor());
     loaded.rewind();
     this->fillValues(loaded);
     
@@ -93,7 +93,7 @@ public:
         forwardedOnAddDoc(docIdLimit, this->_enumIndices.size(), this->_enumIndices.capacity());
     }
     
-    void fillPostings(LoadedVector & loaded) override { handleFillPostings(loaded); }
+    void fillPostings(LoadedVector & loaded) override { handleFillPostings(loaded, this->getLoadExecutor()); }
     attribute::IPostingListAttributeBase *getIPostingListAttributeBase() override { return this; }
     const attribute::IPostingListAttributeBase *getIPostingListAttributeBase() const override { return this; }
     void fillPostingsFixupEnum(const LoadedEnumAttributeVector &loaded) override { fillPostingsFixupEnumBase(loaded); }
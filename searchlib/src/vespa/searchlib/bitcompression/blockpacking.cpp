@@ -0,0 +1,152 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "blockpacking.h"
+#include <cassert>
+#include <cstring>
+
+namespace search::bitcompression {
+
+namespace {
+
+typedef uint32_t V4 __attribute__ ((vector_size (16)));
+
+constexpr uint32_t NUM_ROWS = BlockPacking::BLOCK_SIZE / 4;
+
+inline V4
+load(const uint32_t *p)
+{
+    V4 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void
+store(uint32_t *p, V4 v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+template <uint32_t B>
+void
+packBlock(const uint32_t *values, uint32_t *packed)
+{
+    V4 acc = { 0, 0, 0, 0 };
+    uint32_t shift = 0;
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        V4 v = load(values + row * 4);
+        acc |= v << shift;
+        shift += B;
+        if (shift >= 32) {
+            store(packed, acc);
+            packed += 4;
+            shift -= 32;
+            acc = (shift > 0) ? (v >> (B - shift)) : V4{ 0, 0, 0, 0 };
+        }
+    }
+}
+
+template <>
+void
+packBlock<0>(const uint32_t *, uint32_t *)
+{
+}
+
+template <>
+void
+packBlock<32>(const uint32_t *values, uint32_t *packed)
+{
+    memcpy(packed, values, BlockPacking::BLOCK_SIZE * sizeof(uint32_t));
+}
+
+template <uint32_t B>
+void
+unpackBlock(const uint32_t *packed, uint32_t *values)
+{
+    const V4 mask = { (1u << B) - 1, (1u << B) - 1, (1u << B) - 1, (1u << B) - 1 };
+    V4 acc = load(packed);
+    packed += 4;
+    uint32_t shift = 0;
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        V4 v = acc >> shift;
+        shift += B;
+        if (shift >= 32 && row + 1 < NUM_ROWS) {
+            shift -= 32;
+            acc = load(packed);
+            packed += 4;
+            if (shift > 0) {
+                v |= acc << (B - shift);
+            }
+        }
+        store(values + row * 4, v & mask);
+    }
+}
+
+template <>
+void
+unpackBlock<0>(const uint32_t *, uint32_t *values)
+{
+    memset(values, 0, BlockPacking::BLOCK_SIZE * sizeof(uint32_t));
+}
+
+template <>
+void
+unpackBlock<32>(const uint32_t *packed, uint32_t *values)
+{
+    memcpy(values, packed, BlockPacking::BLOCK_SIZE * sizeof(uint32_t));
+}
+
+typedef void (*PackFunc)(const uint32_t *, uint32_t *);
+
+template <uint32_t... B>
+struct FuncTable {
+    static constexpr PackFunc pack[] = { &packBlock<B>... };
+    static constexpr PackFunc unpack[] = { &unpackBlock<B>... };
+};
+
+template <uint32_t... B>
+constexpr PackFunc FuncTable<B...>::pack[];
+
+template <uint32_t... B>
+constexpr PackFunc FuncTable<B...>::unpack[];
+
+using Funcs = FuncTable<0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+                        17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32>;
+
+}
+
+uint32_t
+BlockPacking::bitWidth(const uint32_t *values, uint32_t numValues)
+{
+    uint32_t bits = 0;
+    for (uint32_t i = 0; i < numValues; ++i) {
+        bits |= values[i];
+    }
+    return (bits == 0) ? 0 : 32 - __builtin_clz(bits);
+}
+
+void
+BlockPacking::pack(const uint32_t *values, uint32_t bitWidth, uint32_t *packed)
+{
+    assert(bitWidth <= 32);
+    Funcs::pack[bitWidth](values, packed);
+}
+
+void
+BlockPacking::unpack(const uint32_t *packed, uint32_t bitWidth, uint32_t *values)
+{
+    assert(bitWidth <= 32);
+    Funcs::unpack[bitWidth](packed, values);
+}
+
+void
+BlockPacking::unpackDocIds(const uint32_t *packed, uint32_t bitWidth, uint32_t prevDocId, uint32_t *docIds)
+{
+    unpack(packed, bitWidth, docIds);
+    uint32_t docId = prevDocId;
+    for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+        docId += docIds[i] + 1;
+        docIds[i] = docId;
+    }
+}
+
+}
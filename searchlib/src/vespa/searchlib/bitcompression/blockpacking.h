@@ -0,0 +1,52 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace search::bitcompression {
+
+/*
+ * Frame of reference bit packing of fixed size blocks of 32-bit values.
+ *
+ * A block of BLOCK_SIZE values is packed using the same bit width for
+ * all values.  The values are distributed over 4 interleaved lanes
+ * (value i belongs to lane i % 4), and each lane is bit packed into
+ * its own sequence of 32-bit words, with word j of lane l stored at
+ * index 4 * j + l.  This layout allows 4 values to be decoded in
+ * parallel using 128-bit vector operations.  A packed block with bit
+ * width b uses 4 * b words.
+ */
+class BlockPacking
+{
+public:
+    static constexpr uint32_t BLOCK_SIZE = 128;
+
+    /*
+     * Number of bits needed to represent the largest of the values.
+     */
+    static uint32_t bitWidth(const uint32_t *values, uint32_t numValues);
+
+    static uint32_t packedWords(uint32_t bitWidth) { return 4 * bitWidth; }
+
+    /*
+     * Pack BLOCK_SIZE values into packedWords(bitWidth) words.
+     */
+    static void pack(const uint32_t *values, uint32_t bitWidth, uint32_t *packed);
+
+    /*
+     * Unpack BLOCK_SIZE values from packedWords(bitWidth) words.  The
+     * packed words don't need to be aligned.
+     */
+    static void unpack(const uint32_t *packed, uint32_t bitWidth, uint32_t *values);
+
+    /*
+     * Unpack BLOCK_SIZE document id deltas and convert them to document
+     * ids, where each delta is the distance to the previous document
+     * id minus 1.
+     */
+    static void unpackDocIds(const uint32_t *packed, uint32_t bitWidth, uint32_t prevDocId, uint32_t *docIds);
+};
+
+}
@@ -440,6 +440,27 @@ public:
     const AggrT &
     getAggregated() const;
 
+    /**
+     * Get aggregated values for the current leaf node, i.e. for the
+     * block of entries containing the current position.  Must only be
+     * called when the iterator is valid.
+     */
+    const AggrT &
+    getLeafAggregated() const
+    {
+        return _leaf.getNode()->getAggregated();
+    }
+
+    /**
+     * Get the last key in the current leaf node.  Must only be called
+     * when the iterator is valid.
+     */
+    const KeyType &
+    getLeafLastKey() const
+    {
+        return _leaf.getNode()->getLastKey();
+    }
+
     bool
     identical(const BTreeIteratorBase &rhs) const;
 
@@ -605,6 +605,7 @@ lower_bound(const KeyType & key, CompareT comp)
         --level;
         assert(!_allocator->isLeafRef(childRef));
         inode = _allocator->mapInternalRef(childRef);
+        BTreeNode::prefetch(inode);
         idx = inode->template lower_bound<CompareT>(key, comp);
         assert(idx < inode->validSlots());
         _path[level].setNodeAndIdx(inode, idx);
@@ -613,6 +614,7 @@ lower_bound(const KeyType & key, CompareT comp)
     }
     assert(_allocator->isLeafRef(childRef));
     const LeafNodeType *lnode = _allocator->mapLeafRef(childRef);
+    BTreeNode::prefetch(lnode);
     idx = lnode->template lower_bound<CompareT>(key, comp);
     assert(idx < lnode->validSlots());
     _leaf.setNodeAndIdx(lnode, idx);
@@ -658,6 +660,7 @@ lower_bound(BTreeNode::Ref rootRef, const KeyType & key, CompareT comp)
     while (pidx != 0) {
         --pidx;
         inode = _allocator->mapInternalRef(childRef);
+        BTreeNode::prefetch(inode);
         idx = inode->template lower_bound<CompareT>(key, comp);
         assert(idx < inode->validSlots());
         _path[pidx].setNodeAndIdx(inode, idx);
@@ -665,6 +668,7 @@ lower_bound(BTreeNode::Ref rootRef, const KeyType & key, CompareT comp)
         assert(childRef.valid());
     }
     const LeafNodeType *lnode = _allocator->mapLeafRef(childRef);
+    BTreeNode::prefetch(lnode);
     idx = lnode->template lower_bound<CompareT>(key, comp);
     assert(idx < lnode->validSlots());
     _leaf.setNodeAndIdx(lnode, idx);
@@ -721,10 +725,12 @@ binarySeek(const KeyType & key, CompareT comp)
             while (level > 0) {
                 --level;
                 node = _allocator->mapInternalRef(node->getChild(idx));
+                BTreeNode::prefetch(node);
                 idx = node->template lower_bound<CompareT>(0, key, comp);
                 _path[level].setNodeAndIdx(node, idx);
             }
             lnode = _allocator->mapLeafRef(node->getChild(idx));
+            BTreeNode::prefetch(lnode);
             _leaf.setNode(lnode);
             lidx = 0;
         }
@@ -779,6 +785,7 @@ linearSeek(const KeyType & key, CompareT comp)
                 _path[level].setNodeAndIdx(node, idx);
             }
             lnode = _allocator->mapLeafRef(node->getChild(idx));
+            BTreeNode::prefetch(lnode);
             _leaf.setNode(lnode);
             lidx = 0;
         }
@@ -839,10 +846,12 @@ binarySeekPast(const KeyType & key, CompareT comp)
             while (level > 0) {
                 --level;
                 node = _allocator->mapInternalRef(node->getChild(idx));
+                BTreeNode::prefetch(node);
                 idx = node->template upper_bound<CompareT>(0, key, comp);
                 _path[level].setNodeAndIdx(node, idx);
             }
             lnode = _allocator->mapLeafRef(node->getChild(idx));
+            BTreeNode::prefetch(lnode);
             _leaf.setNode(lnode);
             lidx = 0;
         }
@@ -897,6 +906,7 @@ linearSeekPast(const KeyType & key, CompareT comp)
                 _path[level].setNodeAndIdx(node, idx);
             }
             lnode = _allocator->mapLeafRef(node->getChild(idx));
+            BTreeNode::prefetch(lnode);
             _leaf.setNode(lnode);
             lidx = 0;
         }
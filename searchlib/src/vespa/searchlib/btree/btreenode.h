@@ -74,6 +74,19 @@ public:
     uint32_t getLevel() const { return _level; }
     uint32_t validSlots() const { return _validSlots; }
     void setValidSlots(uint16_t validSlots_) { _validSlots = validSlots_; }
+
+    /*
+     * Prefetch all cache lines of a node, letting the cache misses
+     * overlap instead of being taken one by one during key search.
+     */
+    template <typename NodeType>
+    static void prefetch(const NodeType *node) {
+        const char *p = reinterpret_cast<const char *>(node);
+        for (size_t offset = 0; offset < sizeof(NodeType); offset += CACHE_LINE_SIZE) {
+            __builtin_prefetch(p + offset);
+        }
+    }
+    static constexpr size_t CACHE_LINE_SIZE = 64;
 };
 
 
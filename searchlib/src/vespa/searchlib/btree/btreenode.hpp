@@ -4,6 +4,8 @@
 
 #include "btreenode.h"
 #include <algorithm>
+#include <functional>
+#include <type_traits>
 
 namespace search {
 namespace btree {
@@ -38,15 +40,65 @@ public:
 
 }
 
+/*
+ * Search for key position within a node.  The generic version uses
+ * binary search with the supplied comparator.
+ */
+template <typename KeyT, typename CompareT,
+          bool Counting = std::is_integral<KeyT>::value &&
+                          std::is_same<CompareT, std::less<KeyT>>::value>
+struct BTreeNodeKeySearch {
+    static uint32_t
+    lower_bound(const KeyT *keys, uint32_t sidx, uint32_t eidx, const KeyT &key, CompareT comp)
+    {
+        return std::lower_bound<const KeyT *, KeyT, CompareT>(keys + sidx, keys + eidx, key, comp) - keys;
+    }
+
+    static uint32_t
+    upper_bound(const KeyT *keys, uint32_t sidx, uint32_t eidx, const KeyT &key, CompareT comp)
+    {
+        return std::upper_bound<const KeyT *, KeyT, CompareT>(keys + sidx, keys + eidx, key, comp) - keys;
+    }
+};
+
+/*
+ * Integer keys in natural order are located by counting the keys
+ * before the wanted position.  The loop has no data dependent branches
+ * and is vectorized by the compiler, comparing several keys per
+ * instruction, which beats binary search for the node sizes in use.
+ */
+template <typename KeyT, typename CompareT>
+struct BTreeNodeKeySearch<KeyT, CompareT, true> {
+    static uint32_t
+    lower_bound(const KeyT *keys, uint32_t sidx, uint32_t eidx, const KeyT &key, CompareT)
+    {
+        const KeyT wanted = key;
+        uint32_t count = 0;
+        for (uint32_t i = sidx; i < eidx; ++i) {
+            count += (keys[i] < wanted) ? 1 : 0;
+        }
+        return sidx + count;
+    }
+
+    static uint32_t
+    upper_bound(const KeyT *keys, uint32_t sidx, uint32_t eidx, const KeyT &key, CompareT)
+    {
+        const KeyT wanted = key;
+        uint32_t count = 0;
+        for (uint32_t i = sidx; i < eidx; ++i) {
+            count += (keys[i] <= wanted) ? 1 : 0;
+        }
+        return sidx + count;
+    }
+};
+
 template <typename KeyT, uint32_t NumSlots>
 template <typename CompareT>
 uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 lower_bound(uint32_t sidx, const KeyT & key, CompareT comp) const
 {
-    const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
-        (_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    return BTreeNodeKeySearch<KeyT, CompareT>::lower_bound(_keys, sidx, validSlots(), key, comp);
 }
 
 template <typename KeyT, uint32_t NumSlots>
@@ -54,10 +106,7 @@ template <typename CompareT>
 uint32_t
 BTreeNodeT<KeyT, NumSlots>::lower_bound(const KeyT & key, CompareT comp) const
 {
-    
-    const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
-        (_keys, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    return BTreeNodeKeySearch<KeyT, CompareT>::lower_bound(_keys, 0, validSlots(), key, comp);
 }
 
 
@@ -67,9 +116,7 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 upper_bound(uint32_t sidx, const KeyT & key, CompareT comp) const
 {
-    const KeyT * itr = std::upper_bound<const KeyT *, KeyT, CompareT>
-        (_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    return BTreeNodeKeySearch<KeyT, CompareT>::upper_bound(_keys, sidx, validSlots(), key, comp);
 }
 
 
@@ -17,6 +17,13 @@ using vespalib::alloc::Alloc;
 
 namespace {
 
+const IAccelrated &
+accelrator()
+{
+    static IAccelrated::UP accel(IAccelrated::getAccelrator());
+    return *accel;
+}
+
 void verifyContains(const search::BitVector & a, const search::BitVector & b) __attribute__((noinline));
 
 void verifyContains(const search::BitVector & a, const search::BitVector & b)
@@ -135,11 +142,7 @@ BitVector::count() const
 BitVector::Index
 BitVector::internalCount(const Word *tarr, size_t sz)
 {
-    Index count(0);
-    for (size_t i(0); i < sz; i++) {
-        count += Optimized::popCount(tarr[i]);
-    }
-    return count;
+    return accelrator().populationCount(tarr, sz);
 }
 
 BitVector::Index
@@ -185,7 +188,7 @@ void
 BitVector::orWith(const BitVector & right)
 {
     verifyContains(*this, right);
-    IAccelrated::getAccelrator()->orBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
+    accelrator().orBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
 
     repairEnds();
     invalidateCachedCount();
@@ -208,7 +211,7 @@ BitVector::andWith(const BitVector & right)
 {
     verifyContains(*this, right);
 
-    IAccelrated::getAccelrator()->andBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
+    accelrator().andBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
 
     setGuardBit();
     invalidateCachedCount();
@@ -220,15 +223,37 @@ BitVector::andNotWith(const BitVector& right)
 {
     verifyContains(*this, right);
 
-    IAccelrated::getAccelrator()->andNotBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
+    accelrator().andNotBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
 
     setGuardBit();
     invalidateCachedCount();
 }
 
+BitVector::Index
+BitVector::andCount(const BitVector & right) const
+{
+    verifyContains(*this, right);
+
+    Index count = accelrator().andCount(getActiveStart(), right.getWordIndex(getStartIndex()), numActiveWords());
+    // Do not count bits below the start index in the first word, or the
+    // guard bit and the bits after it in the last word.
+    Index start(getStartIndex());
+    Index startw(wordNum(start));
+    Index endw(wordNum(size()));
+    Word startOutside(startBits(start));
+    Word endOutside(~startBits(size()));
+    if (startw == endw) {
+        count -= Optimized::popCount(_words[startw] & right._words[startw] & (startOutside | endOutside));
+    } else {
+        count -= Optimized::popCount(_words[startw] & right._words[startw] & startOutside);
+        count -= Optimized::popCount(_words[endw] & right._words[endw] & endOutside);
+    }
+    return count;
+}
+
 void
 BitVector::notSelf() {
-    IAccelrated::getAccelrator()->notBit(getActiveStart(), getActiveBytes());
+    accelrator().notBit(getActiveStart(), getActiveBytes());
     setGuardBit();
     invalidateCachedCount();
 }
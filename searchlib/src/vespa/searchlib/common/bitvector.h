@@ -147,6 +147,14 @@ public:
     void andNotWith(const BitVector &right);
     void notSelf();
 
+    /**
+     * Count the bits that are set in both this and right, without computing the intersection.
+     *
+     * @param right bit vector that must contain the range of this one
+     * @return number of common true bits
+     */
+    Index andCount(const BitVector &right) const;
+
     /**
      * Clear all bits in the bit vector.
      */
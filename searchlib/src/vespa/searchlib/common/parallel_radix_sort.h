@@ -0,0 +1,137 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/threadexecutor.h>
+#include <atomic>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace search {
+
+namespace parallel_radix_sort_detail {
+
+using Partition = std::pair<size_t, size_t>; // start, count
+
+/*
+ * Move elements into 256 buckets in place based on the radix byte
+ * selected by shift.  last[] gets the start of each bucket.
+ */
+template <typename T, typename GR>
+void
+radix_partition(GR &R, T *a, size_t n, int shift, size_t last[257])
+{
+    size_t cnt[256];
+    memset(cnt, 0, sizeof(cnt));
+    for (size_t i = 0; i < n; ++i) {
+        ++cnt[(R(a[i]) >> shift) & 0xFF];
+    }
+    size_t ptr[256];
+    last[0] = 0;
+    for (unsigned int i = 0; i < 256; ++i) {
+        ptr[i] = last[i];
+        last[i + 1] = last[i] + cnt[i];
+    }
+    for (unsigned int i = 0; i < 256; ++i) {
+        while (ptr[i] != last[i + 1]) {
+            T swap = a[ptr[i]];
+            unsigned int k = (R(swap) >> shift) & 0xFF;
+            while (k != i) {
+                std::swap(swap, a[ptr[k]++]);
+                k = (R(swap) >> shift) & 0xFF;
+            }
+            a[ptr[i]++] = swap;
+        }
+    }
+}
+
+/*
+ * Split elements into partitions with no more than maxCount elements,
+ * starting at the most significant radix byte.  Partitions are ordered,
+ * i.e. all elements in a partition sort before the elements in the
+ * next partition.
+ */
+template <typename T, typename GR>
+void
+radix_split(GR &R, T *a, size_t start, size_t count, int shift, size_t maxCount,
+            std::vector<Partition> &partitions)
+{
+    if (count <= maxCount || shift < 0) {
+        partitions.emplace_back(start, count);
+        return;
+    }
+    size_t last[257];
+    radix_partition(R, a + start, count, shift, last);
+    for (unsigned int i = 0; i < 256; ++i) {
+        size_t c = last[i + 1] - last[i];
+        if (c != 0) {
+            radix_split(R, a, start + last[i], c, shift - 8, maxCount, partitions);
+        }
+    }
+}
+
+}
+
+/**
+ * Sort elements using the threads in the given executor.  The elements
+ * are first split in place into ordered partitions using the most
+ * significant bytes of the 64-bit radix returned by R, then each
+ * partition is sorted by sortFunc(T *, size_t) in a separate task.  The
+ * calling thread also sorts partitions while waiting, thus it is safe to
+ * call this from a task running in the same executor.
+ *
+ * The radix must order elements the same way as sortFunc.  Falls back to
+ * calling sortFunc for all elements when no executor is given or there
+ * are too few elements to gain anything from multiple threads.
+ */
+template <typename T, typename GR, typename SortFunc>
+void
+parallel_radix_sort(vespalib::ThreadExecutor *executor, GR R, T *a, size_t n, SortFunc sortFunc)
+{
+    using namespace parallel_radix_sort_detail;
+    constexpr size_t minParallelSortCount = 64 * 1024;
+    size_t numThreads = (executor != nullptr) ? executor->getNumThreads() : 0;
+    if (numThreads < 2 || n < minParallelSortCount) {
+        sortFunc(a, n);
+        return;
+    }
+    std::vector<Partition> partitions;
+    size_t maxCount = std::max(n / (numThreads * 4), minParallelSortCount / 4);
+    radix_split(R, a, 0, n, 56, maxCount, partitions);
+
+    struct State {
+        std::vector<Partition> partitions;
+        std::atomic<size_t> next;
+        vespalib::CountDownLatch latch;
+        State(std::vector<Partition> partitions_in)
+            : partitions(std::move(partitions_in)),
+              next(0),
+              latch(partitions.size())
+        { }
+        bool sortNext(T *base, SortFunc &sort) {
+            size_t i = next.fetch_add(1);
+            if (i >= partitions.size()) {
+                return false;
+            }
+            sort(base + partitions[i].first, partitions[i].second);
+            latch.countDown();
+            return true;
+        }
+    };
+    auto state = std::make_shared<State>(std::move(partitions));
+    size_t numHelpers = std::min(numThreads, state->partitions.size()) - 1;
+    for (size_t i = 0; i < numHelpers; ++i) {
+        // Helper tasks that start after all partitions are taken just exit
+        auto task = vespalib::makeLambdaTask([state, a, sortFunc]() mutable
+                                             {
+                                                 while (state->sortNext(a, sortFunc)) { }
+                                             });
+        executor->execute(std::move(task));
+    }
+    while (state->sortNext(a, sortFunc)) { }
+    state->latch.await();
+}
+
+}
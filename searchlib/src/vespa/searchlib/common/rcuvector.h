@@ -122,6 +122,12 @@ public:
 
     void reset();
     void shrink(size_t newSize) __attribute__((noinline));
+
+    /**
+     * Take ownership of an allocation (e.g. a mapped file) holding n
+     * elements.  Assumes no readers at this moment.
+     **/
+    void unsafe_assign(Alloc && buf, size_t n);
 };
 
 template <typename T>
@@ -42,17 +42,25 @@ template <typename T>
 void
 RcuVectorBase<T>::reset() {
     // Assumes no readers at this moment
-    Array().swap(_data);
+    Array(_data.getAlloc()).swap(_data);
     _data.reserve(16);
 }
 
+template <typename T>
+void
+RcuVectorBase<T>::unsafe_assign(Alloc && buf, size_t n) {
+    // Assumes no readers at this moment
+    assert(n * sizeof(T) <= buf.size());
+    Array(std::move(buf), n).swap(_data);
+}
+
 template <typename T>
 RcuVectorBase<T>::~RcuVectorBase() { }
 
 template <typename T>
 void
 RcuVectorBase<T>::expand(size_t newCapacity) {
-    std::unique_ptr<Array> tmpData(new Array());
+    std::unique_ptr<Array> tmpData(new Array(_data.getAlloc()));
     tmpData->reserve(newCapacity);
     tmpData->resize(_data.size());
     memcpy(tmpData->begin(), _data.begin(), _data.size() * sizeof(T));
@@ -83,7 +91,7 @@ RcuVectorBase<T>::shrink(size_t newSize)
         return;
     }
     if (!_data.try_unreserve(wantedCapacity)) {
-        std::unique_ptr <Array> tmpData(new Array());
+        std::unique_ptr <Array> tmpData(new Array(_data.getAlloc()));
         tmpData->reserve(wantedCapacity);
         tmpData->resize(newSize);
         for (uint32_t i = 0; i < newSize; ++i) {
@@ -140,6 +148,7 @@ RcuVectorBase<T>::getMemoryUsage() const
     MemoryUsage retval;
     retval.incAllocatedBytes(_data.capacity() * sizeof(T));
     retval.incUsedBytes(_data.size() * sizeof(T));
+    retval.incHugePageBytes(_data.getAlloc().hugePageBytes());
     return retval;
 }
 
@@ -101,15 +101,18 @@ private:
     TuneControl _tuneControl;
     int         _mmapFlags;
     int         _advise;
+    bool        _wantPrefetch;
 public:
     TuneFileRandRead()
         : _tuneControl(NORMAL),
           _mmapFlags(0),
-          _advise(0)
+          _advise(0),
+          _wantPrefetch(false)
     { }
 
     void setMemoryMapFlags(int flags) { _mmapFlags = flags; }
     void setAdvise(int advise)        { _advise = advise; }
+    void setWantPrefetch(bool wantPrefetch) { _wantPrefetch = wantPrefetch; }
     void setWantMemoryMap() { _tuneControl = MMAP; }
     void setWantDirectIO()  { _tuneControl = DIRECTIO; }
     void setWantNormal()    { _tuneControl = NORMAL; }
@@ -117,6 +120,8 @@ public:
     bool getWantMemoryMap()  const { return _tuneControl == MMAP; }
     int  getMemoryMapFlags() const { return _mmapFlags; }
     int  getAdvise()         const { return _advise; }
+    // Whether to ask the os to read ahead memory mapped data as soon as it is known to be needed.
+    bool getWantPrefetch()   const { return _wantPrefetch; }
 
     template <typename TuneControlConfig, typename MMapConfig>
     void
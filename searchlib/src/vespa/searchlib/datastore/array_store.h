@@ -98,6 +98,7 @@ public:
     void trimHoldLists(generation_t firstUsed) { _store.trimHoldLists(firstUsed); }
     vespalib::GenerationHolder &getGenerationHolder() { return _store.getGenerationHolder(); }
     void setInitializing(bool initializing) { _store.setInitializing(initializing); }
+    void enableHugePages() { _store.enableHugePages(); }
 
     // Should only be used for unit testing
     const BufferState &bufferState(EntryRef ref) const;
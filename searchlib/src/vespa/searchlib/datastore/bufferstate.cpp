@@ -30,6 +30,7 @@ BufferState::BufferState()
       _typeId(0),
       _clusterSize(0),
       _compacting(false),
+      _hugePages(false),
       _buffer(Alloc::alloc())
 {
 }
@@ -46,6 +47,13 @@ BufferState::~BufferState()
 }
 
 
+Alloc
+BufferState::allocBuffer(size_t bytes) const
+{
+    return _hugePages ? Alloc::allocHugePages(bytes) : Alloc::alloc(bytes);
+}
+
+
 void
 BufferState::onActive(uint32_t bufferId, uint32_t typeId,
                       BufferTypeBase *typeHandler,
@@ -72,7 +80,7 @@ BufferState::onActive(uint32_t bufferId, uint32_t typeId,
     size_t allocClusters = typeHandler->calcClustersToAlloc(bufferId, sizeNeeded, false);
     size_t allocSize = allocClusters * typeHandler->getClusterSize();
     assert(allocSize >= reservedElements + sizeNeeded);
-    _buffer.create(allocSize * typeHandler->elementSize()).swap(_buffer);
+    allocBuffer(allocSize * typeHandler->elementSize()).swap(_buffer);
     buffer = _buffer.get();
     assert(buffer != NULL || allocSize == 0u);
     _allocElems = allocSize;
@@ -240,7 +248,7 @@ BufferState::fallbackResize(uint32_t bufferId,
     size_t allocSize = allocClusters * _typeHandler->getClusterSize();
     assert(allocSize >= _usedElems + sizeNeeded);
     assert(allocSize > _allocElems);
-    Alloc newBuffer = _buffer.create(allocSize * _typeHandler->elementSize());
+    Alloc newBuffer = allocBuffer(allocSize * _typeHandler->elementSize());
     _typeHandler->fallbackCopy(newBuffer.get(), buffer, _usedElems);
     holdBuffer.swap(_buffer);
     std::atomic_thread_fence(std::memory_order_release);
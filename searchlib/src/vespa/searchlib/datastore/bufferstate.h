@@ -59,8 +59,11 @@ private:
     uint32_t        _typeId;
     uint32_t        _clusterSize;
     bool            _compacting;
+    bool            _hugePages;
     Alloc           _buffer;
 
+    Alloc allocBuffer(size_t bytes) const;
+
 public:
     /*
      * TODO: Check if per-buffer free lists are useful, or if
@@ -151,6 +154,11 @@ public:
     size_t getExtraHoldBytes() const { return _extraHoldBytes; }
     bool getCompacting() const { return _compacting; }
     void setCompacting() { _compacting = true; }
+    /*
+     * Back buffer memory allocated from now on with huge pages.
+     */
+    void setHugePages(bool hugePages) { _hugePages = hugePages; }
+    size_t getHugePageBytes() const { return _buffer.hugePageBytes(); }
     void fallbackResize(uint32_t bufferId, uint64_t sizeNeeded, void *&buffer, Alloc &holdBuffer);
 
     bool isActive(uint32_t typeId) const {
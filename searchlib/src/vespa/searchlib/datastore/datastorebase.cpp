@@ -224,6 +224,9 @@ DataStoreBase::getMemoryUsage() const
     usage.setUsedBytes(stats._usedBytes);
     usage.setDeadBytes(stats._deadBytes);
     usage.setAllocatedBytesOnHold(stats._holdBytes);
+    for (const BufferState & bState : _states) {
+        usage.incHugePageBytes(bState.getHugePageBytes());
+    }
     return usage;
 }
 
@@ -238,6 +241,15 @@ DataStoreBase::holdBuffer(uint32_t bufferId)
 }
 
 
+void
+DataStoreBase::enableHugePages()
+{
+    for (BufferState & bState : _states) {
+        bState.setHugePages(true);
+    }
+}
+
+
 void
 DataStoreBase::enableFreeLists()
 {
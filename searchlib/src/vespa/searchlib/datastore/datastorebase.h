@@ -280,6 +280,11 @@ public:
         state.incDeadElems(dead);
     }
 
+    /**
+     * Back buffers allocated or resized from now on with huge pages.
+     */
+    void enableHugePages();
+
     /**
      * Enable free list management.  This only works for fixed size elements.
      */
@@ -0,0 +1,70 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "blockposocc.h"
+#include <vespa/searchlib/index/postinglistcounts.h>
+#include <vespa/searchlib/index/postinglistcountfile.h>
+#include <vespa/searchlib/index/postinglistfile.h>
+#include <vespa/searchlib/index/docidandfeatures.h>
+
+namespace search::diskindex {
+
+using search::bitcompression::PosOccFieldsParams;
+using search::bitcompression::EGPosOccDecodeContext;
+using search::index::PostingListCountFileSeqRead;
+using search::index::PostingListCountFileSeqWrite;
+
+BlockPosOccSeqRead::BlockPosOccSeqRead(PostingListCountFileSeqRead *countFile)
+    : BlockPostingSeqRead(countFile),
+      _fieldsParams(),
+      _cookedDecodeContext(&_fieldsParams),
+      _rawDecodeContext(&_fieldsParams)
+{
+    _decodeContext = &_cookedDecodeContext;
+    _decodeContext->setReadContext(&_readContext);
+    _readContext.setDecodeContext(_decodeContext);
+}
+
+
+void
+BlockPosOccSeqRead::
+setFeatureParams(const PostingListParams &params)
+{
+    bool oldCooked = _decodeContext == &_cookedDecodeContext;
+    bool newCooked = oldCooked;
+    params.get("cooked", newCooked);
+    if (oldCooked != newCooked) {
+        if (newCooked) {
+            _cookedDecodeContext = _rawDecodeContext;
+            _decodeContext = &_cookedDecodeContext;
+        } else {
+            _rawDecodeContext = _cookedDecodeContext;
+            _decodeContext = &_rawDecodeContext;
+        }
+        _readContext.setDecodeContext(_decodeContext);
+    }
+}
+
+
+const vespalib::string &
+BlockPosOccSeqRead::getSubIdentifier()
+{
+    PosOccFieldsParams fieldsParams;
+    EGPosOccDecodeContext<true> d(&fieldsParams);
+    return d.getIdentifier();
+}
+
+
+BlockPosOccSeqWrite::BlockPosOccSeqWrite(const Schema &schema,
+                                         uint32_t indexId,
+                                         PostingListCountFileSeqWrite *countFile)
+    : BlockPostingSeqWrite(countFile),
+      _fieldsParams(),
+      _realEncodeFeatures(&_fieldsParams)
+{
+    _encodeFeatures = &_realEncodeFeatures;
+    _encodeFeatures->setWriteContext(&_featureWriteContext);
+    _featureWriteContext.setEncodeContext(_encodeFeatures);
+    _fieldsParams.setSchemaParams(schema, indexId);
+}
+
+}
@@ -0,0 +1,308 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "blockposting.h"
+#include <vespa/searchlib/index/docidandfeatures.h>
+#include <vespa/searchlib/index/postinglistcounts.h>
+#include <vespa/searchlib/index/postinglistcountfile.h>
+
+namespace {
+
+vespalib::string myIdBlock("Blk.1");
+
+}
+
+namespace search::diskindex {
+
+using index::PostingListCountFileSeqRead;
+using index::PostingListCountFileSeqWrite;
+using bitcompression::BlockPacking;
+using bitcompression::FeatureEncodeContextBE;
+
+BlockPostingSeqRead::BlockPostingSeqRead(PostingListCountFileSeqRead *countFile)
+    : ZcPostingSeqRead(countFile),
+      _blockSkip(),
+      _packedDocIds(),
+      _blockDocIds(),
+      _blockDocIdPos(0),
+      _blockFeaturesStart(0)
+{
+}
+
+
+BlockPostingSeqRead::~BlockPostingSeqRead()
+{
+}
+
+
+void
+BlockPostingSeqRead::readCommonWordDocIdAndFeatures(DocIdAndFeatures &features)
+{
+    if (_blockDocIdPos >= _numDocs && _hasMore)
+        readWordStart();    // Read start of next chunk
+    assert(_blockDocIdPos < _numDocs);
+    uint32_t blockNo = _blockDocIdPos / BlockPacking::BLOCK_SIZE;
+    const BlockSkipEntry &skip = _blockSkip[blockNo];
+    if ((_blockDocIdPos % BlockPacking::BLOCK_SIZE) == 0) {
+        // Validate skip information at start of block
+        uint64_t featuresPos = _decodeContext->getReadOffset();
+        assert(featuresPos == _blockFeaturesStart + skip._featuresOffset);
+        (void) featuresPos;
+    }
+    uint32_t docId = _blockDocIds[_blockDocIdPos];
+    ++_blockDocIdPos;
+    features._docId = docId;
+    _prevDocId = docId;
+    assert(docId <= skip._lastDocId);
+    if ((_blockDocIdPos % BlockPacking::BLOCK_SIZE) == 0 || _blockDocIdPos == _numDocs) {
+        // Assert that last document in block matches skip information
+        assert(docId == skip._lastDocId);
+    }
+    (void) skip;
+    if (docId < _lastDocId) {
+        // Assert more documents available when not yet at last docid
+        assert(_blockDocIdPos < _numDocs);
+    } else {
+        // Assert that all documents have been used when at last docid
+        assert(docId == _lastDocId);
+        assert(_blockDocIdPos == _numDocs);
+        if (!_hasMore) {
+            _chunkNo = 0;
+        }
+    }
+    _decodeContext->readFeatures(features);
+    --_residue;
+}
+
+
+void
+BlockPostingSeqRead::readWordStartWithSkip()
+{
+    typedef FeatureEncodeContextBE EC;
+    DecodeContext &d = *_decodeContext;
+    UC64_DECODECONTEXT_CONSTRUCTOR(o, d._);
+    uint32_t length;
+    uint64_t val64;
+    const uint64_t *valE = d._valE;
+
+    if (_hasMore)
+        ++_chunkNo;
+    else
+        _chunkNo = 0;
+    assert(_numDocs >= _minSkipDocs || _hasMore);
+    bool hasMore = false;
+    if (__builtin_expect(_numDocs >= _minChunkDocs, false)) {
+        hasMore = static_cast<int64_t>(oVal) < 0;
+        oVal <<= 1;
+        length = 1;
+        UC64BE_READBITS_NS(o, EC);
+    }
+    _docIdK = EC::calcDocIdK((_hasMore || hasMore) ? 1 : _numDocs, _docIdLimit);
+    if (_hasMore || hasMore) {
+        if (_rangeEndOffset == 0) {
+            assert(hasMore == (_chunkNo + 1 < _counts._segments.size()));
+            assert(_numDocs == _counts._segments[_chunkNo]._numDocs);
+        }
+        if (hasMore) {
+            assert(_numDocs >= _minSkipDocs);
+            assert(_numDocs >= _minChunkDocs);
+        }
+    } else {
+        assert(_numDocs >= _minSkipDocs);
+        if (_rangeEndOffset == 0) {
+            assert(_numDocs == _counts._numDocs);
+        }
+    }
+    if (__builtin_expect(oCompr >= valE, false)) {
+        UC64_DECODECONTEXT_STORE(o, d._);
+        _readContext.readComprBuffer();
+        valE = d._valE;
+        UC64_DECODECONTEXT_LOAD(o, d._);
+    }
+    UC64BE_DECODEEXPGOLOMB_NS(o,
+                              K_VALUE_ZCPOSTING_DOCIDSSIZE,
+                              EC);
+    uint32_t packedWords = val64;
+    UC64BE_DECODEEXPGOLOMB_NS(o,
+                              K_VALUE_ZCPOSTING_FEATURESSIZE,
+                              EC);
+    _featuresSize = val64;
+    if (__builtin_expect(oCompr >= valE, false)) {
+        UC64_DECODECONTEXT_STORE(o, d._);
+        _readContext.readComprBuffer();
+        valE = d._valE;
+        UC64_DECODECONTEXT_LOAD(o, d._);
+    }
+    UC64BE_DECODEEXPGOLOMB_NS(o,
+                              _docIdK,
+                              EC);
+    _lastDocId = _docIdLimit - 1 - val64;
+    if (_hasMore || hasMore) {
+        if (_rangeEndOffset == 0) {
+            assert(_lastDocId == _counts._segments[_chunkNo]._lastDoc);
+        }
+    }
+
+    if (__builtin_expect(oCompr >= valE, false)) {
+        UC64_DECODECONTEXT_STORE(o, d._);
+        _readContext.readComprBuffer();
+        valE = d._valE;
+        UC64_DECODECONTEXT_LOAD(o, d._);
+    }
+    uint64_t bytePad = oPreRead & 7;
+    if (bytePad > 0) {
+        length = bytePad;
+        oVal <<= length;
+        UC64BE_READBITS_NS(o, EC);
+    }
+    UC64_DECODECONTEXT_STORE(o, d._);
+    if (__builtin_expect(oCompr >= valE, false)) {
+        _readContext.readComprBuffer();
+    }
+    uint32_t numBlocks = (_numDocs + BlockPacking::BLOCK_SIZE - 1) / BlockPacking::BLOCK_SIZE;
+    _blockSkip.resize(numBlocks);
+    _packedDocIds.resize(packedWords);
+    _decodeContext->readBytes(reinterpret_cast<uint8_t *>(&_blockSkip[0]),
+                              numBlocks * sizeof(BlockSkipEntry));
+    if (packedWords > 0) {
+        _decodeContext->readBytes(reinterpret_cast<uint8_t *>(&_packedDocIds[0]),
+                                  packedWords * sizeof(uint32_t));
+    }
+    // Decode all document ids in word or chunk
+    _blockDocIds.resize(numBlocks * BlockPacking::BLOCK_SIZE);
+    uint32_t prevDocId = _prevDocId;
+    for (uint32_t blockNo = 0; blockNo < numBlocks; ++blockNo) {
+        const BlockSkipEntry &skip = _blockSkip[blockNo];
+        uint32_t packedEnd = (blockNo + 1 < numBlocks) ? _blockSkip[blockNo + 1]._packedOffset : packedWords;
+        assert(packedEnd >= skip._packedOffset && packedEnd <= packedWords);
+        uint32_t bitWidth = (packedEnd - skip._packedOffset) / 4;
+        BlockPacking::unpackDocIds(&_packedDocIds[skip._packedOffset], bitWidth, prevDocId,
+                                   &_blockDocIds[blockNo * BlockPacking::BLOCK_SIZE]);
+        prevDocId = skip._lastDocId;
+    }
+    assert(prevDocId == _lastDocId);
+    _blockDocIdPos = 0;
+    _blockFeaturesStart = _decodeContext->getReadOffset();
+    _hasMore = hasMore;
+    // Decode context is now positioned at start of features
+}
+
+
+const vespalib::string &
+BlockPostingSeqRead::getFormatIdentifier() const
+{
+    return myIdBlock;
+}
+
+
+const vespalib::string &
+BlockPostingSeqRead::getIdentifier()
+{
+    return myIdBlock;
+}
+
+
+BlockPostingSeqWrite::BlockPostingSeqWrite(PostingListCountFileSeqWrite *countFile)
+    : ZcPostingSeqWrite(countFile),
+      _blockSkip(),
+      _packedDocIds()
+{
+}
+
+
+BlockPostingSeqWrite::~BlockPostingSeqWrite()
+{
+}
+
+
+void
+BlockPostingSeqWrite::flushWordWithSkip(bool hasMore)
+{
+    assert(_docIds.size() >= _minSkipDocs || !_counts._segments.empty());
+
+    _encodeFeatures->flush();
+    EncodeContext &e = _encodeContext;
+
+    uint32_t numDocs = _docIds.size();
+
+    e.encodeExpGolomb(numDocs - 1, K_VALUE_ZCPOSTING_NUMDOCS);
+    if (numDocs >= _minChunkDocs)
+        e.writeBits((hasMore ? 1 : 0), 1);
+
+    // Pack document id deltas, one skip entry per block
+    uint32_t deltas[BlockPacking::BLOCK_SIZE];
+    uint32_t prevDocId = _counts._segments.empty() ? 0u : _counts._segments.back()._lastDoc;
+    uint64_t featurePos = 0;
+    for (uint32_t blockStart = 0; blockStart < numDocs; blockStart += BlockPacking::BLOCK_SIZE) {
+        uint32_t blockDocs = std::min(numDocs - blockStart, BlockPacking::BLOCK_SIZE);
+        BlockSkipEntry skip;
+        skip._packedOffset = _packedDocIds.size();
+        skip._featuresOffset = featurePos;
+        for (uint32_t i = 0; i < blockDocs; ++i) {
+            const DocIdAndFeatureSize &docIdAndFeatureSize = _docIds[blockStart + i];
+            uint32_t docId = docIdAndFeatureSize.first;
+            assert(docId > prevDocId);
+            deltas[i] = docId - prevDocId - 1;
+            prevDocId = docId;
+            featurePos += docIdAndFeatureSize.second;
+        }
+        std::fill(deltas + blockDocs, deltas + BlockPacking::BLOCK_SIZE, 0u);
+        skip._lastDocId = prevDocId;
+        uint32_t bitWidth = BlockPacking::bitWidth(deltas, blockDocs);
+        _packedDocIds.resize(skip._packedOffset + BlockPacking::packedWords(bitWidth));
+        BlockPacking::pack(deltas, bitWidth, &_packedDocIds[skip._packedOffset]);
+        _blockSkip.push_back(skip);
+    }
+    assert(featurePos == _featureOffset);
+
+    uint32_t packedWords = _packedDocIds.size();
+    e.encodeExpGolomb(packedWords, K_VALUE_ZCPOSTING_DOCIDSSIZE);
+    e.encodeExpGolomb(_featureOffset, K_VALUE_ZCPOSTING_FEATURESSIZE);
+
+    // Encode last document id in chunk or word.
+    uint32_t docIdK = e.calcDocIdK((_counts._segments.empty() &&
+                                    !hasMore) ?
+                                   numDocs : 1,
+                                   _docIdLimit);
+    e.encodeExpGolomb(_docIdLimit - 1 - _docIds.back().first,
+                      docIdK);
+
+    e.smallAlign(8);    // Byte align
+
+    e.writeBits(reinterpret_cast<const uint64_t *>(&_blockSkip[0]),
+                0,
+                _blockSkip.size() * sizeof(BlockSkipEntry) * 8);
+    if (packedWords > 0) {
+        e.writeBits(reinterpret_cast<const uint64_t *>(&_packedDocIds[0]),
+                    0,
+                    packedWords * sizeof(uint32_t) * 8);
+    }
+
+    // Write features
+    e.writeBits(static_cast<const uint64_t *>(_featureWriteContext._comprBuf),
+                0,
+                _featureOffset);
+
+    _counts._numDocs += numDocs;
+    if (hasMore || !_counts._segments.empty()) {
+        uint64_t writePos = e.getWriteOffset();
+        PostingListCounts::Segment seg;
+        seg._bitLength = writePos - (_writePos + _counts._bitLength);
+        seg._numDocs = numDocs;
+        seg._lastDoc = _docIds.back().first;
+        _counts._segments.push_back(seg);
+        _counts._bitLength += seg._bitLength;
+    }
+    // reset tables in preparation for next word or next chunk
+    _blockSkip.clear();
+    _packedDocIds.clear();
+    resetWord();
+}
+
+
+const vespalib::string &
+BlockPostingSeqWrite::getFormatIdentifier() const
+{
+    return myIdBlock;
+}
+
+}
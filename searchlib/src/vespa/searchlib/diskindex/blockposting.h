@@ -0,0 +1,63 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "zcposting.h"
+#include <vespa/searchlib/bitcompression/blockpacking.h>
+
+namespace search::diskindex {
+
+/*
+ * Skip entry for a block of document ids in the block posting list
+ * format.  Skip entries are stored in host (little endian) byte order
+ * before the packed document id deltas for a word or chunk.
+ */
+struct BlockSkipEntry
+{
+    uint32_t _lastDocId;      // Last document id in block
+    uint32_t _packedOffset;   // Offset of packed docid deltas, in 32-bit words
+    uint64_t _featuresOffset; // Offset of features for first document, in bits
+};
+
+static_assert(sizeof(BlockSkipEntry) == 16, "BlockSkipEntry must be 16 bytes");
+
+/*
+ * Sequential reader for the block posting list format.  Rare words are
+ * stored as in the Zc.5 format.  Words with skip information store the
+ * document ids as frame of reference bit packed blocks of deltas with
+ * one skip entry per block, followed by the features.
+ */
+class BlockPostingSeqRead : public ZcPostingSeqRead
+{
+protected:
+    std::vector<BlockSkipEntry> _blockSkip;
+    std::vector<uint32_t> _packedDocIds;
+    std::vector<uint32_t> _blockDocIds; // Decoded document ids in chunk
+    uint32_t _blockDocIdPos;            // Next document in chunk
+    uint64_t _blockFeaturesStart;       // Start of features for chunk
+
+public:
+    BlockPostingSeqRead(index::PostingListCountFileSeqRead *countFile);
+    ~BlockPostingSeqRead();
+
+    void readCommonWordDocIdAndFeatures(DocIdAndFeatures &features) override;
+    void readWordStartWithSkip() override;
+    const vespalib::string &getFormatIdentifier() const override;
+    static const vespalib::string &getIdentifier();
+};
+
+class BlockPostingSeqWrite : public ZcPostingSeqWrite
+{
+protected:
+    std::vector<BlockSkipEntry> _blockSkip;
+    std::vector<uint32_t> _packedDocIds;
+
+public:
+    BlockPostingSeqWrite(index::PostingListCountFileSeqWrite *countFile);
+    ~BlockPostingSeqWrite();
+
+    void flushWordWithSkip(bool hasMore) override;
+    const vespalib::string &getFormatIdentifier() const override;
+};
+
+}
@@ -0,0 +1,236 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "blockpostingiterators.h"
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+
+namespace search::diskindex {
+
+using search::fef::TermFieldMatchDataArray;
+using search::bitcompression::FeatureEncodeContext;
+using search::bitcompression::PosOccFieldsParams;
+using search::index::PostingListCounts;
+
+template <bool bigEndian>
+BlockPostingIterator<bigEndian>::
+BlockPostingIterator(uint32_t minChunkDocs,
+                     const PostingListCounts &counts,
+                     const TermFieldMatchDataArray &matchData,
+                     Position start, uint32_t docIdLimit)
+    : ZcIteratorBase(matchData, start, docIdLimit),
+      _decodeContext(nullptr),
+      _minChunkDocs(minChunkDocs),
+      _numDocs(0),
+      _skipBase(nullptr),
+      _packedBase(nullptr),
+      _packedWords(0),
+      _numBlocks(0),
+      _blockNo(0),
+      _blockDocIdPos(0),
+      _blockLastDocId(0),
+      _chunkPrevDocId(0),
+      _chunkLastDocId(0),
+      _featureSeekPos(0),
+      _featuresSize(0),
+      _hasMore(false),
+      _chunkNo(0),
+      _featuresValI(nullptr),
+      _featuresBitOffset(0),
+      _counts(counts)
+{
+}
+
+
+template <bool bigEndian>
+void
+BlockPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
+{
+    typedef FeatureEncodeContext<bigEndian> EC;
+    DecodeContextBase &d = *_decodeContext;
+    UC64_DECODECONTEXT_CONSTRUCTOR(o, d._);
+    uint32_t length;
+    uint64_t val64;
+
+    uint32_t prevDocId = _hasMore ? _chunkLastDocId : 0u;
+    UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_NUMDOCS, EC);
+
+    _numDocs = static_cast<uint32_t>(val64) + 1;
+    bool hasMore = false;
+    if (__builtin_expect(_numDocs >= _minChunkDocs, false)) {
+        if (bigEndian) {
+            hasMore = static_cast<int64_t>(oVal) < 0;
+            oVal <<= 1;
+            length = 1;
+        } else {
+            hasMore = (oVal & 1) != 0;
+            oVal >>= 1;
+            length = 1;
+        }
+        UC64_READBITS_NS(o, EC);
+    }
+    uint32_t docIdK = EC::calcDocIdK((_hasMore || hasMore) ? 1 : _numDocs, docIdLimit);
+    UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_DOCIDSSIZE, EC);
+    _packedWords = val64;
+    UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_FEATURESSIZE, EC);
+    _featuresSize = val64;
+    UC64_DECODEEXPGOLOMB_NS(o, docIdK, EC);
+    _chunkLastDocId = docIdLimit - 1 - val64;
+    if (_hasMore || hasMore) {
+        if (!_counts._segments.empty()) {
+            assert(_chunkLastDocId == _counts._segments[_chunkNo]._lastDoc);
+        }
+    }
+
+    uint64_t bytePad = oPreRead & 7;
+    if (bytePad > 0) {
+        length = bytePad;
+        UC64_READBITS_NS(o, EC);
+    }
+
+    UC64_DECODECONTEXT_STORE(o, d._);
+    assert((d.getBitOffset() & 7) == 0);
+    const uint8_t *bcompr = d.getByteCompr();
+    _numBlocks = (_numDocs + BlockPacking::BLOCK_SIZE - 1) / BlockPacking::BLOCK_SIZE;
+    _skipBase = bcompr;
+    bcompr += _numBlocks * sizeof(BlockSkipEntry);
+    _packedBase = bcompr;
+    bcompr += _packedWords * sizeof(uint32_t);
+    d.setByteCompr(bcompr);
+    _hasMore = hasMore;
+    _chunkPrevDocId = prevDocId;
+    // Save information about start of next chunk
+    _featuresValI = d.getCompr();
+    _featuresBitOffset = d.getBitOffset();
+    _featureSeekPos = 0;
+    clearUnpacked();
+    // Decode first block in chunk
+    decodeBlock(0);
+}
+
+
+template <bool bigEndian>
+void
+BlockPostingIterator<bigEndian>::decodeBlock(uint32_t blockNo)
+{
+    BlockSkipEntry skip = getSkipEntry(blockNo);
+    uint32_t prevDocId = (blockNo == 0) ? _chunkPrevDocId : getSkipEntry(blockNo - 1)._lastDocId;
+    uint32_t packedEnd = (blockNo + 1 < _numBlocks) ? getSkipEntry(blockNo + 1)._packedOffset : _packedWords;
+    uint32_t bitWidth = (packedEnd - skip._packedOffset) / 4;
+    BlockPacking::unpackDocIds(reinterpret_cast<const uint32_t *>(_packedBase + skip._packedOffset * sizeof(uint32_t)),
+                               bitWidth, prevDocId, _blockDocIds);
+    _blockNo = blockNo;
+    _blockDocIdPos = 0;
+    _blockLastDocId = skip._lastDocId;
+    if (blockNo != 0) {
+        // Defer feature position seek until unpack
+        _featureSeekPos = skip._featuresOffset;
+    }
+    setDocId(_blockDocIds[0]);
+}
+
+
+template <bool bigEndian>
+void
+BlockPostingIterator<bigEndian>::doChunkSkipSeek(uint32_t docId)
+{
+    while (docId > _chunkLastDocId && _hasMore) {
+        // Skip to start of next chunk
+        _featureSeekPos = 0;
+        featureSeek(_featuresSize);
+        _chunkNo++;
+        readWordStart(getDocIdLimit()); // Read word start for next chunk
+    }
+    if (docId > _chunkLastDocId) {
+        _blockLastDocId = _chunkLastDocId = search::endDocId;
+        setAtEnd();
+    }
+}
+
+
+template <bool bigEndian>
+void
+BlockPostingIterator<bigEndian>::doBlockSkipSeek(uint32_t docId)
+{
+    if (__builtin_expect(docId > _chunkLastDocId, false)) {
+        doChunkSkipSeek(docId);
+        if (docId <= _blockLastDocId)
+            return;
+    }
+    uint32_t blockNo = _blockNo + 1;
+    while (getSkipEntry(blockNo)._lastDocId < docId) {
+        ++blockNo;
+    }
+    decodeBlock(blockNo);
+    clearUnpacked();
+}
+
+
+template <bool bigEndian>
+void
+BlockPostingIterator<bigEndian>::doSeek(uint32_t docId)
+{
+    if (docId > _blockLastDocId) {
+        doBlockSkipSeek(docId);
+    }
+    uint32_t oDocId = getDocId();
+    uint32_t blockDocIdPos = _blockDocIdPos;
+    while (__builtin_expect(oDocId < docId, true)) {
+        oDocId = _blockDocIds[++blockDocIdPos];
+        incNeedUnpack();
+    }
+    _blockDocIdPos = blockDocIdPos;
+    setDocId(oDocId);
+}
+
+
+template <bool bigEndian>
+void
+BlockPostingIterator<bigEndian>::doUnpack(uint32_t docId)
+{
+    if (!_matchData.valid() || getUnpacked())
+        return;
+    if (_featureSeekPos != 0) {
+        // Handle deferred feature position seek now.
+        featureSeek(_featureSeekPos);
+        _featureSeekPos = 0;
+    }
+    assert(docId == getDocId());
+    uint32_t needUnpack = getNeedUnpack();
+    if (needUnpack > 1)
+        _decodeContext->skipFeatures(needUnpack - 1);
+    _decodeContext->unpackFeatures(_matchData, docId);
+    setUnpacked();
+}
+
+
+template <bool bigEndian>
+void
+BlockPostingIterator<bigEndian>::rewind(Position start)
+{
+    _decodeContext->setPosition(start);
+    _hasMore = false;
+    _chunkLastDocId = 0;
+    _chunkNo = 0;
+}
+
+
+template <bool bigEndian>
+BlockPosOccIterator<bigEndian>::
+BlockPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
+                    uint32_t minChunkDocs, const PostingListCounts &counts,
+                    const PosOccFieldsParams *fieldsParams,
+                    const TermFieldMatchDataArray &matchData)
+    : BlockPostingIterator<bigEndian>(minChunkDocs, counts, matchData, start, docIdLimit),
+      _decodeContextReal(start.getOccurences(), start.getBitOffset(), bitLength, fieldsParams)
+{
+    assert(!matchData.valid() || (fieldsParams->getNumFields() == matchData.size()));
+    _decodeContext = &_decodeContextReal;
+}
+
+
+template class BlockPostingIterator<true>;
+template class BlockPostingIterator<false>;
+
+template class BlockPosOccIterator<true>;
+template class BlockPosOccIterator<false>;
+
+}
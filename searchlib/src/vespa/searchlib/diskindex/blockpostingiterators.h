@@ -0,0 +1,103 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "zcpostingiterators.h"
+#include "blockposting.h"
+#include <vespa/searchlib/bitcompression/posocccompression.h>
+#include <cstring>
+
+namespace search::diskindex {
+
+/*
+ * Iterator for words with skip information in the block posting list
+ * format.  Document ids are decoded one block at a time, and the skip
+ * entries are used to locate the block containing the seek target.
+ */
+template <bool bigEndian>
+class BlockPostingIterator : public ZcIteratorBase
+{
+private:
+    typedef ZcIteratorBase ParentClass;
+    using ParentClass::getDocId;
+
+public:
+    typedef bitcompression::FeatureDecodeContext<bigEndian> DecodeContextBase;
+    typedef index::PostingListCounts PostingListCounts;
+    typedef bitcompression::BlockPacking BlockPacking;
+
+    DecodeContextBase *_decodeContext;
+    uint32_t _minChunkDocs;
+    uint32_t _numDocs;
+    const uint8_t *_skipBase;   // Skip entries for chunk
+    const uint8_t *_packedBase; // Packed document id deltas for chunk
+    uint32_t _packedWords;
+    uint32_t _numBlocks;
+    uint32_t _blockNo;
+    uint32_t _blockDocIdPos;
+    uint32_t _blockLastDocId;
+    uint32_t _chunkPrevDocId;
+    uint32_t _chunkLastDocId;
+    uint64_t _featureSeekPos;
+    uint64_t _featuresSize;
+    bool _hasMore;
+    uint32_t _chunkNo;
+    // Start of current features block, needed for seeks
+    const uint64_t *_featuresValI;
+    int _featuresBitOffset;
+    // Counts used for assertions
+    const PostingListCounts &_counts;
+    uint32_t _blockDocIds[BlockPacking::BLOCK_SIZE] __attribute__((aligned(16)));
+
+    BlockPostingIterator(uint32_t minChunkDocs,
+                         const PostingListCounts &counts,
+                         const search::fef::TermFieldMatchDataArray &matchData,
+                         Position start, uint32_t docIdLimit);
+
+    void doSeek(uint32_t docId) override;
+    void doUnpack(uint32_t docId) override;
+    void readWordStart(uint32_t docIdLimit) override;
+    void rewind(Position start) override;
+
+    BlockSkipEntry getSkipEntry(uint32_t blockNo) const {
+        BlockSkipEntry skip;
+        memcpy(&skip, _skipBase + blockNo * sizeof(BlockSkipEntry), sizeof(BlockSkipEntry));
+        return skip;
+    }
+
+    void featureSeek(uint64_t offset) {
+        _decodeContext->_valI = _featuresValI + (_featuresBitOffset + offset) / 64;
+        _decodeContext->setupBits((_featuresBitOffset + offset) & 63);
+    }
+
+private:
+    VESPA_DLL_LOCAL void decodeBlock(uint32_t blockNo);
+    VESPA_DLL_LOCAL void doChunkSkipSeek(uint32_t docId);
+    VESPA_DLL_LOCAL void doBlockSkipSeek(uint32_t docId);
+};
+
+
+template <bool bigEndian>
+class BlockPosOccIterator : public BlockPostingIterator<bigEndian>
+{
+private:
+    typedef BlockPostingIterator<bigEndian> ParentClass;
+    using ParentClass::_decodeContext;
+
+    typedef bitcompression::EGPosOccDecodeContextCooked<bigEndian> DecodeContext;
+    DecodeContext _decodeContextReal;
+public:
+    BlockPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
+                        uint32_t minChunkDocs, const index::PostingListCounts &counts,
+                        const bitcompression::PosOccFieldsParams *fieldsParams,
+                        const search::fef::TermFieldMatchDataArray &matchData);
+};
+
+
+extern template class BlockPostingIterator<true>;
+extern template class BlockPostingIterator<false>;
+
+extern template class BlockPosOccIterator<true>;
+extern template class BlockPosOccIterator<false>;
+
+}
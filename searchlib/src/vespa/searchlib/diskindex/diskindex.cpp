@@ -104,6 +104,7 @@ DiskIndex::openField(const vespalib::string &fieldDir,
     BitVectorDictionary::SP bDict;
     FileHeader fileHeader;
     bool dynamicK = false;
+    bool blockFormat = false;
     if (fileHeader.taste(postingName, tuneFileSearch._read)) {
         if (fileHeader.getVersion() == 1 &&
             fileHeader.getBigEndian() &&
@@ -113,6 +114,14 @@ DiskIndex::openField(const vespalib::string &fieldDir,
             fileHeader.getFormats()[1] ==
             DiskPostingFileDynamicKReal::getSubIdentifier()) {
             dynamicK = true;
+        } else if (fileHeader.getVersion() == 1 &&
+                   fileHeader.getBigEndian() &&
+                   fileHeader.getFormats().size() == 2 &&
+                   fileHeader.getFormats()[0] ==
+                   DiskPostingFileBlockReal::getIdentifier() &&
+                   fileHeader.getFormats()[1] ==
+                   DiskPostingFileBlockReal::getSubIdentifier()) {
+            blockFormat = true;
         } else if (fileHeader.getVersion() == 1 &&
                    fileHeader.getBigEndian() &&
                    fileHeader.getFormats().size() == 2 &&
@@ -127,9 +136,13 @@ DiskIndex::openField(const vespalib::string &fieldDir,
                 postingName.c_str());
         }
     }
-    pFile.reset(dynamicK ?
-                new DiskPostingFileDynamicKReal() :
-                new DiskPostingFileReal());
+    if (blockFormat) {
+        pFile.reset(new DiskPostingFileBlockReal());
+    } else {
+        pFile.reset(dynamicK ?
+                    new DiskPostingFileDynamicKReal() :
+                    new DiskPostingFileReal());
+    }
     if (!pFile->open(postingName, tuneFileSearch._read)) {
         LOG(warning,
             "Could not open posting list file '%s'",
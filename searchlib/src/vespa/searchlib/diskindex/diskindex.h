@@ -67,6 +67,7 @@ private:
     typedef index::PostingListFileRandRead DiskPostingFile;
     typedef Zc4PosOccRandRead DiskPostingFileReal;
     typedef ZcPosOccRandRead DiskPostingFileDynamicKReal;
+    typedef BlockPosOccRandRead DiskPostingFileBlockReal;
     typedef vespalib::cache<vespalib::CacheParam<vespalib::LruParam<Key, LookupResultVector>, DiskIndex>> Cache;
 
     vespalib::string                       _indexDir;
@@ -2,6 +2,7 @@
 
 #include "extposocc.h"
 #include "zcposocc.h"
+#include "blockposocc.h"
 #include "fileheader.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
 #include <vespa/searchlib/index/docidandfeatures.h>
@@ -60,6 +61,7 @@ PostingListFileSeqWrite *
 makePosOccWrite(const vespalib::string &name,
                 PostingListCountFileSeqWrite *const posOccCountWrite,
                 bool dynamicK,
+                bool blockFormat,
                 const PostingListParams &params,
                 const PostingListParams &featureParams,
                 const Schema &schema,
@@ -78,6 +80,16 @@ makePosOccWrite(const vespalib::string &name,
             fileHeader.getFormats()[1] ==
             ZcPosOccSeqRead::getSubIdentifier()) {
             dynamicK = true;
+            blockFormat = false;
+        } else if (fileHeader.getVersion() == 1 &&
+                   fileHeader.getBigEndian() &&
+                   fileHeader.getFormats().size() == 2 &&
+                   fileHeader.getFormats()[0] ==
+                   BlockPosOccSeqRead::getIdentifier() &&
+                   fileHeader.getFormats()[1] ==
+                   BlockPosOccSeqRead::getSubIdentifier()) {
+            dynamicK = true;
+            blockFormat = true;
         } else if (fileHeader.getVersion() == 1 &&
                    fileHeader.getBigEndian() &&
                    fileHeader.getFormats().size() == 2 &&
@@ -86,13 +98,16 @@ makePosOccWrite(const vespalib::string &name,
                    fileHeader.getFormats()[1] ==
                    Zc4PosOccSeqRead::getSubIdentifier()) {
             dynamicK = false;
+            blockFormat = false;
         } else {
             LOG(warning,
                 "Could not detect format for posocc file write %s",
                 name.c_str());
         }
     }
-    if (dynamicK)
+    if (blockFormat)
+        posOccWrite = new BlockPosOccSeqWrite(schema, indexId, posOccCountWrite);
+    else if (dynamicK)
         posOccWrite =  new ZcPosOccSeqWrite(schema, indexId, posOccCountWrite);
     else
         posOccWrite =
@@ -108,6 +123,7 @@ PostingListFileSeqRead *
 makePosOccRead(const vespalib::string &name,
                PostingListCountFileSeqRead *const posOccCountRead,
                bool dynamicK,
+               bool blockFormat,
                const PostingListParams &featureParams,
                const TuneFileSeqRead &tuneFileRead)
 {
@@ -123,6 +139,16 @@ makePosOccRead(const vespalib::string &name,
             fileHeader.getFormats()[1] ==
             ZcPosOccSeqRead::getSubIdentifier()) {
             dynamicK = true;
+            blockFormat = false;
+        } else if (fileHeader.getVersion() == 1 &&
+                   fileHeader.getBigEndian() &&
+                   fileHeader.getFormats().size() == 2 &&
+                   fileHeader.getFormats()[0] ==
+                   BlockPosOccSeqRead::getIdentifier() &&
+                   fileHeader.getFormats()[1] ==
+                   BlockPosOccSeqRead::getSubIdentifier()) {
+            dynamicK = true;
+            blockFormat = true;
         } else if (fileHeader.getVersion() == 1 &&
                    fileHeader.getBigEndian() &&
                    fileHeader.getFormats().size() == 2 &&
@@ -131,13 +157,16 @@ makePosOccRead(const vespalib::string &name,
                    fileHeader.getFormats()[1] ==
                    Zc4PosOccSeqRead::getSubIdentifier()) {
             dynamicK = false;
+            blockFormat = false;
         } else {
             LOG(warning,
                 "Could not detect format for posocc file read %s",
                 name.c_str());
         }
     }
-    if (dynamicK)
+    if (blockFormat)
+        posOccRead = new BlockPosOccSeqRead(posOccCountRead);
+    else if (dynamicK)
         posOccRead =  new ZcPosOccSeqRead(posOccCountRead);
     else
         posOccRead =  new Zc4PosOccSeqRead(posOccCountRead);
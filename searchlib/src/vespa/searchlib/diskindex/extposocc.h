@@ -35,6 +35,7 @@ index::PostingListFileSeqWrite *
 makePosOccWrite(const vespalib::string &name,
                 index::PostingListCountFileSeqWrite *const posOccCountWrite,
                 bool dynamicK,
+                bool blockFormat,
                 const index::PostingListParams &params,
                 const index::PostingListParams &featureParams,
                 const index::Schema &schema,
@@ -45,6 +46,7 @@ index::PostingListFileSeqRead *
 makePosOccRead(const vespalib::string &name,
                index::PostingListCountFileSeqRead *const posOccCountRead,
                bool dynamicK,
+               bool blockFormat,
                const index::PostingListParams &featureParams,
                const TuneFileSeqRead &tuneFileRead);
 
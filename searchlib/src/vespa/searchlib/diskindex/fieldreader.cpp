@@ -114,6 +114,7 @@ FieldReader::open(const vespalib::string &prefix,
     bool statres;
 
     bool dynamicKPosOccFormat = false;  // Will autodetect anyway
+    bool blockPosOccFormat = false;     // Will autodetect anyway
     statres = FastOS_File::Stat(name.c_str(), &statInfo);
     if (!statres) {
         LOG(error,
@@ -127,6 +128,7 @@ FieldReader::open(const vespalib::string &prefix,
     _oldposoccfile.reset(makePosOccRead(name,
                                         _dictFile.get(),
                                         dynamicKPosOccFormat,
+                                        blockPosOccFormat,
                                         featureParams,
                                         tuneFileRead));
     vespalib::string cname = prefix + "dictionary";
@@ -37,6 +37,7 @@ FieldWriter::open(const vespalib::string &prefix,
                   uint32_t minSkipDocs,
                   uint32_t minChunkDocs,
                   bool dynamicKPosOccFormat,
+                  bool blockPosOccFormat,
                   const Schema &schema,
                   const uint32_t indexId,
                   const TuneFileSeqWrite &tuneFileWrite,
@@ -69,6 +70,7 @@ FieldWriter::open(const vespalib::string &prefix,
     _posoccfile.reset(diskindex::makePosOccWrite(name,
                                                  _dictFile.get(),
                                                  dynamicKPosOccFormat,
+                                                 blockPosOccFormat,
                                                  params,
                                                  featureParams,
                                                  schema,
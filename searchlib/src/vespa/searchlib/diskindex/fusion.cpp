@@ -9,6 +9,9 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/searchlib/common/documentsummary.h>
 #include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/threadexecutor.h>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -25,6 +28,8 @@ using search::index::Schema;
 using search::index::SchemaUtil;
 using search::index::schema::DataType;
 using vespalib::getLastErrorString;
+using vespalib::makeLambdaTask;
+using vespalib::CountDownLatch;
 
 
 namespace search {
@@ -38,13 +43,14 @@ FusionInputIndex::setSchema(const Schema::SP &schema)
 }
 
 Fusion::Fusion(bool dynamicKPosIndexFormat,
+               bool blockPosIndexFormat,
                const TuneFileIndexing &tuneFileIndexing,
                const FileHeaderContext &fileHeaderContext)
     : _schema(NULL),
       _oldIndexes(),
       _docIdLimit(0u),
-      _numWordIds(0u),
       _dynamicKPosIndexFormat(dynamicKPosIndexFormat),
+      _blockPosIndexFormat(blockPosIndexFormat),
       _outDir("merged"),
       _tuneFileIndexing(tuneFileIndexing),
       _fileHeaderContext(fileHeaderContext)
@@ -53,7 +59,6 @@ Fusion::Fusion(bool dynamicKPosIndexFormat,
 
 Fusion::~Fusion()
 {
-    ReleaseMappingTables();
 }
 
 
@@ -103,9 +108,9 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
     for (auto &i : getOldIndexes()) {
         OldIndex &oi = *i;
         auto reader(std::make_unique<DictionaryWordReader>());
-        const vespalib::string &tmpindexpath = oi.getTmpPath();
         const vespalib::string &oldindexpath = oi.getPath();
-        vespalib::string wordMapName = tmpindexpath + "/old2new.dat";
+        vespalib::string wordMapName =
+            getOld2NewName(oi.getTmpPath(), index.getName());
         vespalib::string fieldDir(oldindexpath + "/" + index.getName());
         vespalib::string dictName(fieldDir + "/dictionary");
         const Schema &oldSchema = oi.getSchema();
@@ -131,7 +136,9 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
 
 
 bool
-Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
+Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index,
+                             WordNumMappingList &list,
+                             uint64_t &numWordIds)
 {
     vespalib::string indexName = index.getName();
     LOG(debug, "Renumber word IDs for field %s", indexName.c_str());
@@ -146,7 +153,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     heap.merge(out, 4);
     assert(heap.empty());
-    _numWordIds = out.getWordNum();
+    numWordIds = out.getWordNum();
 
     // Close files
     for (auto &i : readers) {
@@ -155,7 +162,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     // Now read mapping files back into an array
     // XXX: avoid this, and instead make the array here
-    if (!ReadMappingFiles(&index))
+    if (!ReadMappingFiles(index, list))
         return false;
 
     LOG(debug, "Finished renumbering words IDs for field %s",
@@ -166,15 +173,41 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
 
 bool
-Fusion::mergeFields()
+Fusion::mergeFields(vespalib::ThreadExecutor &executor)
 {
-   typedef SchemaUtil::IndexIterator IndexIterator;
+    typedef SchemaUtil::IndexIterator IndexIterator;
 
     const Schema &schema = getSchema();
+    std::vector<uint32_t> ids;
     for (IndexIterator index(schema); index.isValid(); ++index) {
-        if (!mergeField(index.getIndex()))
+        ids.push_back(index.getIndex());
+    }
+    makeTmpDirs();
+    // Each field has its own output directory, word number mapping and
+    // renumbering files, thus fields can be merged concurrently.
+    std::vector<uint8_t> results(ids.size(), 0u);
+    CountDownLatch latch(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        uint32_t id = ids[i];
+        uint8_t &result = results[i];
+        auto task = makeLambdaTask([this, id, &result, &latch]()
+                                   {
+                                       result = mergeField(id) ? 1u : 0u;
+                                       latch.countDown();
+                                   });
+        task = executor.execute(std::move(task));
+        if (task) {
+            // Executor rejected task, merge field in this thread
+            task->run();
+        }
+    }
+    latch.await();
+    for (auto result : results) {
+        if (result == 0u)
             return false;
     }
+    if (!CleanTmpDirs())
+        return false;
     return true;
 }
 
@@ -201,16 +234,16 @@ Fusion::mergeField(uint32_t id)
     LOG(debug, "mergeField for field %s dir %s",
         indexName.c_str(), indexDir.c_str());
 
-    makeTmpDirs();
-
-    if (!renumberFieldWordIds(index)) {
+    WordNumMappingList list(_oldIndexes.size());
+    uint64_t numWordIds(0u);
+    if (!renumberFieldWordIds(index, list, numWordIds)) {
         LOG(error, "Could not renumber field word ids for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
         return false;
     }
 
     // Tokamak
-    bool res = mergeFieldPostings(index);
+    bool res = mergeFieldPostings(index, list, numWordIds);
     if (!res) {
         LOG(error, "Could not merge field postings for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
@@ -219,9 +252,6 @@ Fusion::mergeField(uint32_t id)
     if (!FileKit::createStamp(indexDir +  "/.mergeocc_done"))
         return false;
 
-    if (!CleanTmpDirs())
-        return false;
-
     LOG(debug, "Finished mergeField for field %s dir %s",
         indexName.c_str(), indexDir.c_str());
 
@@ -285,18 +315,22 @@ Fusion::selectCookedOrRawFeatures(Reader &reader, Writer &writer)
 
 bool
 Fusion::openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+                              const WordNumMappingList &list,
                               std::vector<std::unique_ptr<FieldReader> > &
                               readers)
 {
     vespalib::string indexName = index.getName();
+    uint32_t oldIndexId = 0;
     for (auto &i : _oldIndexes) {
         OldIndex &oi = *i;
+        const WordNumMapping &wordNumMapping = list[oldIndexId];
+        ++oldIndexId;
         const Schema &oldSchema = oi.getSchema();
         if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
         auto reader = FieldReader::allocFieldReader(index, oldSchema);
-        reader->setup(oi.getWordNumMapping(),
+        reader->setup(wordNumMapping,
                       oi.getDocIdMapping());
         if (!reader->open(oi.getPath() + "/" +
                           indexName + "/",
@@ -318,6 +352,7 @@ Fusion::openFieldWriter(const SchemaUtil::IndexIterator &index,
                      64,
                      262144,
                      _dynamicKPosIndexFormat,
+                     _blockPosIndexFormat,
                      index.getSchema(),
                      index.getIndex(),
                      _tuneFileIndexing._write,
@@ -350,15 +385,17 @@ Fusion::setupMergeHeap(const std::vector<std::unique_ptr<FieldReader> > &
 
 
 bool
-Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
+Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index,
+                           const WordNumMappingList &list,
+                           uint64_t numWordIds)
 {
     std::vector<std::unique_ptr<FieldReader>> readers;
     PostingPriorityQueue<FieldReader> heap;
     /* OUTPUT */
-    FieldWriter fieldWriter(_docIdLimit, _numWordIds);
+    FieldWriter fieldWriter(_docIdLimit, numWordIds);
     vespalib::string indexName = index.getName();
 
-    if (!openInputFieldReaders(index, readers))
+    if (!openInputFieldReaders(index, list, readers))
         return false;
     if (!openFieldWriter(index, fieldWriter))
         return false;
@@ -382,15 +419,14 @@ Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
 
 
 bool
-Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
+Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator &index,
+                         WordNumMappingList &list)
 {
-    ReleaseMappingTables();
-
     size_t numberOfOldIndexes = _oldIndexes.size();
     for (uint32_t i = 0; i < numberOfOldIndexes; i++)
     {
         OldIndex &oi = *_oldIndexes[i];
-        WordNumMapping &wordNumMapping = oi.getWordNumMapping();
+        WordNumMapping &wordNumMapping = list[i];
         std::vector<uint32_t> oldIndexes;
         const Schema &oldSchema = oi.getSchema();
         if (!SchemaUtil::getIndexIds(oldSchema,
@@ -401,12 +437,13 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
             wordNumMapping.noMappingFile();
             continue;
         }
-        if (index && !index->hasOldFields(oldSchema, false)) {
+        if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
 
         // Open word mapping file
-        vespalib::string old2newname = oi.getTmpPath() + "/old2new.dat";
+        vespalib::string old2newname =
+            getOld2NewName(oi.getTmpPath(), index.getName());
         wordNumMapping.readMappingFile(old2newname, _tuneFileIndexing._read);
     }
 
@@ -414,16 +451,11 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
 }
 
 
-bool
-Fusion::ReleaseMappingTables()
+vespalib::string
+Fusion::getOld2NewName(const vespalib::string &tmpPath,
+                       const vespalib::string &indexName)
 {
-    size_t numberOfOldIndexes = _oldIndexes.size();
-    for (uint32_t i = 0; i < numberOfOldIndexes; i++)
-    {
-        OldIndex &oi = *_oldIndexes[i];
-        oi.getWordNumMapping().clear();
-    }
-    return true;
+    return tmpPath + "/" + indexName + ".old2new.dat";
 }
 
 
@@ -513,8 +545,10 @@ Fusion::merge(const Schema &schema,
               const std::vector<vespalib::string> &sources,
               const SelectorArray &selector,
               bool dynamicKPosOccFormat,
+              bool blockPosOccFormat,
               const TuneFileIndexing &tuneFileIndexing,
-              const FileHeaderContext &fileHeaderContext)
+              const FileHeaderContext &fileHeaderContext,
+              vespalib::ThreadExecutor &executor)
 {
     assert(sources.size() <= 255);
     uint32_t docIdLimit = selector.size();
@@ -553,6 +587,7 @@ Fusion::merge(const Schema &schema,
     }
 
     std::unique_ptr<Fusion> fusion(new Fusion(dynamicKPosOccFormat,
+                                         blockPosOccFormat,
                                          tuneFileIndexing,
                                          fileHeaderContext));
     fusion->setSchema(&schema);
@@ -583,7 +618,7 @@ Fusion::merge(const Schema &schema,
                            idx);
     }
     fusion->setDocIdLimit(trimmedDocIdLimit);
-    if (!fusion->mergeFields())
+    if (!fusion->mergeFields(executor))
         return false;
     return true;
 }
@@ -9,6 +9,8 @@
 #include <vector>
 #include <string>
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace search
 {
 
@@ -37,7 +39,6 @@ public:
     typedef diskindex::DocIdMapping DocIdMapping;
 private:
     vespalib::string _path;
-    WordNumMapping _wordNumMapping;
     DocIdMapping _docIdMapping;
     vespalib::string _tmpPath;
     index::Schema::SP _schema;
@@ -45,7 +46,6 @@ private:
 public:
     FusionInputIndex()
         : _path(),
-          _wordNumMapping(),
           _docIdMapping(),
           _tmpPath(),
           _schema()
@@ -81,18 +81,6 @@ public:
         return _tmpPath;
     }
 
-    const WordNumMapping &
-    getWordNumMapping() const
-    {
-        return _wordNumMapping;
-    }
-
-    WordNumMapping &
-    getWordNumMapping()
-    {
-        return _wordNumMapping;
-    }
-
     const DocIdMapping &
     getDocIdMapping() const
     {
@@ -122,6 +110,7 @@ class Fusion
 public:
     typedef search::index::Schema Schema;
     typedef search::index::SchemaUtil SchemaUtil;
+    typedef std::vector<WordNumMapping> WordNumMappingList;
 
 private:
     Fusion(const Fusion &);
@@ -129,6 +118,7 @@ private:
 
 public:
     Fusion(bool dynamicKPosIndexFormat,
+           bool blockPosIndexFormat,
            const TuneFileIndexing &tuneFileIndexing,
            const search::common::FileHeaderContext &fileHeaderContext);
 
@@ -137,9 +127,16 @@ public:
 
     void SetOldIndexList(const std::vector<vespalib::string> &oldIndexList);
 
-    bool mergeFields();
+    /**
+     * Merge all index fields.  Each field is merged by a separate
+     * task on the given executor, and this method returns when all
+     * fields have been merged.  The fields are independent of each
+     * other, so the output is identical to merging them one by one.
+     */
+    bool mergeFields(vespalib::ThreadExecutor &executor);
     bool mergeField(uint32_t id);
     bool openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+                               const WordNumMappingList &list,
                                std::vector<std::unique_ptr<FieldReader> > &
                                readers);
     bool openFieldWriter(const SchemaUtil::IndexIterator &index,
@@ -148,13 +145,17 @@ public:
                         readers,
                         FieldWriter &writer,
                         PostingPriorityQueue<FieldReader> &heap);
-    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index);
+    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index,
+                            const WordNumMappingList &list,
+                            uint64_t numWordIds);
     bool openInputWordReaders(const SchemaUtil::IndexIterator &index,
                               std::vector<
                                  std::unique_ptr<DictionaryWordReader> > &
                               readers,
                               PostingPriorityQueue<DictionaryWordReader> &heap);
-    bool renumberFieldWordIds(const SchemaUtil::IndexIterator &index);
+    bool renumberFieldWordIds(const SchemaUtil::IndexIterator &index,
+                              WordNumMappingList &list,
+                              uint64_t &numWordIds);
 
     void
     setSchema(const Schema *schema);
@@ -177,8 +178,12 @@ public:
     selectCookedOrRawFeatures(Reader &reader, Writer &writer);
 
 protected:
-    bool ReadMappingFiles(const SchemaUtil::IndexIterator *index);
-    bool ReleaseMappingTables();
+    bool ReadMappingFiles(const SchemaUtil::IndexIterator &index,
+                          WordNumMappingList &list);
+
+    static vespalib::string
+    getOld2NewName(const vespalib::string &tmpPath,
+                   const vespalib::string &indexName);
 
     static unsigned int noGen()
     {
@@ -197,10 +202,10 @@ protected:
     // OUTPUT:
 
     uint32_t _docIdLimit;
-    uint64_t _numWordIds;
 
     // Index format parameters.
     bool _dynamicKPosIndexFormat;
+    bool _blockPosIndexFormat;
 
     // Index location parameters
 
@@ -226,12 +231,6 @@ public:
         _docIdLimit = docIdLimit;
     }
 
-    void
-    setNumWordIds(uint64_t numWordIds)
-    {
-        _numWordIds = numWordIds;
-    }
-
     std::vector<std::shared_ptr<OldIndex> > &
     getOldIndexes()
     {
@@ -253,8 +252,10 @@ public:
           const std::vector<vespalib::string> &sources,
           const SelectorArray &docIdSelector,
           bool dynamicKPosOccFormat,
+          bool blockPosOccFormat,
           const TuneFileIndexing &tuneFileIndexing,
-          const search::common::FileHeaderContext &fileHeaderContext);
+          const search::common::FileHeaderContext &fileHeaderContext,
+          vespalib::ThreadExecutor &executor);
 };
 
 } // namespace diskindex
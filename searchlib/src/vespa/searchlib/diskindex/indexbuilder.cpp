@@ -49,6 +49,7 @@ public:
     open(const vespalib::stringref &dir,
          const SchemaUtil::IndexIterator &index,
          uint32_t docIdLimit, uint64_t numWordIds,
+         bool blockPosOccFormat,
          const TuneFileSeqWrite &tuneFileWrite,
          const FileHeaderContext &fileHeaderContext);
 
@@ -285,6 +286,7 @@ void
 FileHandle::open(const vespalib::stringref &dir,
                  const SchemaUtil::IndexIterator &index,
                  uint32_t docIdLimit, uint64_t numWordIds,
+                 bool blockPosOccFormat,
                  const TuneFileSeqWrite &tuneFileWrite,
                  const FileHeaderContext &fileHeaderContext)
 {
@@ -292,7 +294,7 @@ FileHandle::open(const vespalib::stringref &dir,
 
     _fieldWriter = new FieldWriter(docIdLimit, numWordIds);
 
-    if (!_fieldWriter->open(dir + "/", 64, 262144u, false,
+    if (!_fieldWriter->open(dir + "/", 64, 262144u, false, blockPosOccFormat,
                             index.getSchema(), index.getIndex(),
                             tuneFileWrite, fileHeaderContext)) {
         LOG(error, "Could not open term writer %s for write (%s)",
@@ -475,7 +477,8 @@ IndexBuilder::FieldHandle::open(uint32_t docIdLimit, uint64_t numWordIds,
 {
     _files.open(getDir(),
                 SchemaUtil::IndexIterator(*_schema, getIndexId()),
-                docIdLimit, numWordIds, tuneFileWrite, fileHeaderContext);
+                docIdLimit, numWordIds, _ib->getBlockPosOccFormat(),
+                tuneFileWrite, fileHeaderContext);
 }
 
 
@@ -533,6 +536,7 @@ IndexBuilder::IndexBuilder(const Schema &schema)
       _prefix(),
       _docIdLimit(0u),
       _numWordIds(0u),
+      _blockPosOccFormat(false),
       _schema(schema)
 {
     // TODO: Filter for text indexes
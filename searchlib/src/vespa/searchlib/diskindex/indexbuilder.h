@@ -33,6 +33,7 @@ private:
     vespalib::string         _prefix;
     uint32_t                 _docIdLimit;
     uint64_t                 _numWordIds;
+    bool                     _blockPosOccFormat;
 
     const Schema &_schema;  // Ptr to allow being std::vector member
 
@@ -67,6 +68,10 @@ public:
     inline FieldHandle & getIndexFieldHandle(uint32_t fieldId); 
     void setPrefix(const vespalib::stringref &prefix);
 
+    // Write posting lists for words with skip info in the block format.
+    void setBlockPosOccFormat(bool blockPosOccFormat) { _blockPosOccFormat = blockPosOccFormat; }
+    bool getBlockPosOccFormat() const { return _blockPosOccFormat; }
+
     vespalib::string appendToPrefix(const vespalib::stringref &name);
 
     void
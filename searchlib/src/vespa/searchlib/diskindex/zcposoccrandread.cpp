@@ -2,9 +2,12 @@
 
 #include "zcposoccrandread.h"
 #include "zcposocciterators.h"
+#include "blockpostingiterators.h"
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/fastos/file.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.zcposoccrandread");
@@ -25,6 +28,7 @@ namespace {
 
 vespalib::string myId4("Zc.4");
 vespalib::string myId5("Zc.5");
+vespalib::string myIdBlock("Blk.1");
 
 }
 
@@ -44,7 +48,8 @@ ZcPosOccRandRead::ZcPosOccRandRead()
       _fileBitSize(0),
       _headerBitSize(0),
       _fieldsParams(),
-      _dynamicK(true)
+      _dynamicK(true),
+      _prefetch(false)
 { }
 
 
@@ -124,16 +129,20 @@ ZcPosOccRandRead::readPostingList(const PostingListCounts &counts,
     // Align start at 64-bit boundary
     startOffset -= (startOffset & 7);
 
+    uint64_t endOffset = (handle._bitOffset + _headerBitSize +
+                          handle._bitLength + 7) >> 3;
+    // Align end at 64-bit boundary
+    endOffset += (-endOffset & 7);
+
     void *mapPtr = _file->MemoryMapPtr(startOffset);
     if (mapPtr != NULL) {
         handle._mem = mapPtr;
         handle._allocMem = NULL;
         handle._allocSize = 0;
+        if (_prefetch) {
+            prefetch(startOffset, endOffset);
+        }
     } else {
-        uint64_t endOffset = (handle._bitOffset + _headerBitSize +
-                              handle._bitLength + 7) >> 3;
-        // Align end at 64-bit boundary
-        endOffset += (-endOffset & 7);
 
         uint64_t vectorLen = endOffset - startOffset;
         size_t padBefore;
@@ -169,12 +178,35 @@ ZcPosOccRandRead::readPostingList(const PostingListCounts &counts,
 }
 
 
+void
+ZcPosOccRandRead::prefetch(uint64_t startOffset, uint64_t endOffset) const
+{
+    static const uint64_t pageSize = sysconf(_SC_PAGESIZE);
+    // The first page is touched right away when the iterator is set up,
+    // so only advise the kernel about the pages following it.
+    uint64_t adviseStart = (startOffset & ~(pageSize - 1)) + pageSize;
+    endOffset = std::min(endOffset, _fileSize);
+    if (adviseStart >= endOffset) {
+        return;
+    }
+    void *adviseMem = _file->MemoryMapPtr(adviseStart);
+    if (adviseMem != NULL) {
+        int eCode = posix_madvise(adviseMem, endOffset - adviseStart, POSIX_MADV_WILLNEED);
+        if (eCode != 0) {
+            LOG(debug, "posix_madvise(%p, %" PRIu64 ", WILLNEED) on %s failed: %d",
+                adviseMem, endOffset - adviseStart, _file->GetFileName(), eCode);
+        }
+    }
+}
+
+
 bool
 ZcPosOccRandRead::
 open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead)
 {
     if (tuneFileRead.getWantMemoryMap()) {
         _file->enableMemoryMap(tuneFileRead.getMemoryMapFlags());
+        _prefetch = tuneFileRead.getWantPrefetch();
     } else  if (tuneFileRead.getWantDirectIO())
         _file->EnableDirectIO();
     bool res = _file->OpenReadOnly(name.c_str());
@@ -200,6 +232,13 @@ ZcPosOccRandRead::close()
 
 void
 ZcPosOccRandRead::readHeader()
+{
+    readHeader(myId5);
+}
+
+
+void
+ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
 {
     EGPosOccDecodeContext<true> d(&_fieldsParams);
     ComprFileReadContext drc(d);
@@ -225,7 +264,7 @@ ZcPosOccRandRead::readHeader()
     assert(header.hasTag("minSkipDocs"));
     assert(header.getTag("frozen").asInteger() != 0);
     _fileBitSize = header.getTag("fileBitSize").asInteger();
-    assert(header.getTag("format.0").asString() == myId5);
+    assert(header.getTag("format.0").asString() == identifier);
     assert(header.getTag("format.1").asString() == d.getIdentifier());
     _numWords = header.getTag("numWords").asInteger();
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
@@ -365,6 +404,78 @@ Zc4PosOccRandRead::getSubIdentifier()
     return d.getIdentifier();
 }
 
+
+BlockPosOccRandRead::BlockPosOccRandRead()
+    : ZcPosOccRandRead()
+{
+}
+
+
+search::queryeval::SearchIterator *
+BlockPosOccRandRead::
+createIterator(const PostingListCounts &counts,
+               const PostingListHandle &handle,
+               const search::fef::TermFieldMatchDataArray &matchData,
+               bool usebitVector) const
+{
+    (void) usebitVector;
+    typedef EGPosOccEncodeContext<true> EC;
+
+    assert((handle._bitLength != 0) == (counts._bitLength != 0));
+    assert((counts._numDocs != 0) == (counts._bitLength != 0));
+    assert(handle._bitOffsetMem <= handle._bitOffset);
+
+    if (handle._bitLength == 0)
+        return new search::queryeval::EmptySearch;
+
+    const char *cmem = static_cast<const char *>(handle._mem);
+    uint64_t memOffset = reinterpret_cast<unsigned long>(cmem) & 7;
+    const uint64_t *mem = reinterpret_cast<const uint64_t *>
+                          (cmem - memOffset) +
+                          (memOffset * 8 + handle._bitOffset -
+                           handle._bitOffsetMem) / 64;
+    int bitOffset = (memOffset * 8 + handle._bitOffset -
+                     handle._bitOffsetMem) & 63;
+
+    Position start(mem, bitOffset);
+    EGPosOccDecodeContext<true> d(mem, bitOffset, &_fieldsParams);
+
+    UC64_DECODECONTEXT_CONSTRUCTOR(o, d._);
+    uint32_t length;
+    uint64_t val64;
+
+    UC64BE_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_NUMDOCS, EC);
+
+    uint32_t numDocs = static_cast<uint32_t>(val64) + 1;
+
+    if (numDocs < _minSkipDocs) {
+        return new ZcRareWordPosOccIterator<true>(start, handle._bitLength, _docIdLimit, &_fieldsParams, matchData);
+    } else {
+        return new BlockPosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+    }
+}
+
+
+void
+BlockPosOccRandRead::readHeader()
+{
+    ZcPosOccRandRead::readHeader(myIdBlock);
+}
+
+
+const vespalib::string &
+BlockPosOccRandRead::getIdentifier()
+{
+    return myIdBlock;
+}
+
+
+const vespalib::string &
+BlockPosOccRandRead::getSubIdentifier()
+{
+    return ZcPosOccRandRead::getSubIdentifier();
+}
+
 } // namespace diskindex
 
 } // namespace search
@@ -26,7 +26,10 @@ protected:
     uint64_t _headerBitSize;
     bitcompression::PosOccFieldsParams _fieldsParams;
     bool _dynamicK;
+    bool _prefetch;         // madvise(WILLNEED) memory mapped posting lists when read
 
+    void prefetch(uint64_t startOffset, uint64_t endOffset) const;
+    void readHeader(const vespalib::string &identifier);
 
 public:
     ZcPosOccRandRead();
@@ -82,6 +85,27 @@ public:
     static const vespalib::string &getSubIdentifier();
 };
 
+class BlockPosOccRandRead : public ZcPosOccRandRead
+{
+public:
+    BlockPosOccRandRead();
+
+    /**
+     * Create iterator for single word.  Semantic lifetime of counts and
+     * handle must exceed lifetime of iterator.
+     */
+    search::queryeval::SearchIterator *
+    createIterator(const PostingListCounts &counts,
+                   const PostingListHandle &handle,
+                   const search::fef::TermFieldMatchDataArray &matchData,
+                   bool usebitVector) const override;
+
+    void readHeader() override;
+
+    static const vespalib::string &getIdentifier();
+    static const vespalib::string &getSubIdentifier();
+};
+
 
 } // namespace diskindex
 
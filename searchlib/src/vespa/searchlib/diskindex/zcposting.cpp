@@ -530,7 +530,7 @@ void
 Zc4PostingSeqRead::readHeader()
 {
     FeatureDecodeContextBE &d = *_decodeContext;
-    const vespalib::string &myId = _dynamicK ? myId5 : myId4;
+    const vespalib::string &myId = getFormatIdentifier();
 
     vespalib::FileHeader header;
     d.readHeader(header, _file.getSize());
@@ -575,6 +575,13 @@ Zc4PostingSeqRead::getIdentifier()
 }
 
 
+const vespalib::string &
+Zc4PostingSeqRead::getFormatIdentifier() const
+{
+    return _dynamicK ? myId5 : myId4;
+}
+
+
 uint64_t
 Zc4PostingSeqRead::getCurrentPostingOffset() const
 {
@@ -690,7 +697,7 @@ Zc4PostingSeqWrite::readHeader(const vespalib::string &name)
     FeatureDecodeContextBE d;
     ComprFileReadContext drc(d);
     FastOS_File file;
-    const vespalib::string &myId = _dynamicK ? myId5 : myId4;
+    const vespalib::string &myId = getFormatIdentifier();
 
     d.setReadContext(&drc);
     bool res = file.OpenReadOnly(name.c_str());
@@ -742,6 +749,13 @@ Zc4PostingSeqWrite::readHeader(const vespalib::string &name)
 }
 
 
+const vespalib::string &
+Zc4PostingSeqWrite::getFormatIdentifier() const
+{
+    return _dynamicK ? myId5 : myId4;
+}
+
+
 void
 Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
 {
@@ -749,7 +763,7 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     EncodeContext &e = _encodeContext;
     ComprFileWriteContext &wce = _writeContext;
 
-    const vespalib::string &myId = _dynamicK ? myId5 : myId4;
+    const vespalib::string &myId = getFormatIdentifier();
     vespalib::FileHeader header;
 
     typedef vespalib::GenericHeader::Tag Tag;
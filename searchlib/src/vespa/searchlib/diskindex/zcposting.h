@@ -99,11 +99,16 @@ public:
     bool close() override;
     void getParams(PostingListParams &params) override;
     void getFeatureParams(PostingListParams &params) override;
-    void readWordStartWithSkip();
+    virtual void readWordStartWithSkip();
     void readWordStart();
     void readHeader();
     static const vespalib::string &getIdentifier();
 
+    /**
+     * Get identifier of posting list format, stored as format.0 in file header.
+     */
+    virtual const vespalib::string &getFormatIdentifier() const;
+
     // Methods used when generating posting list for common word pairs.
 
     /*
@@ -189,7 +194,7 @@ public:
     /**
      * Flush word with skip info to disk
      */
-    void flushWordWithSkip(bool hasMore);
+    virtual void flushWordWithSkip(bool hasMore);
 
 
     /**
@@ -212,6 +217,11 @@ public:
      * Read header, using temporary feature decode context.
      */
     uint32_t readHeader(const vespalib::string &name);
+
+    /**
+     * Get identifier of posting list format, stored as format.0 in file header.
+     */
+    virtual const vespalib::string &getFormatIdentifier() const;
 };
 
 
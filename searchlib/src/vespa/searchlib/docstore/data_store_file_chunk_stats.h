@@ -4,6 +4,7 @@
 
 #include "data_store_storage_stats.h"
 #include "data_store_file_chunk_id.h"
+#include <vespa/vespalib/util/compressionconfig.h>
 
 namespace search {
 
@@ -13,19 +14,44 @@ namespace search {
 class DataStoreFileChunkStats : public DataStoreStorageStats,
                                 public DataStoreFileChunkId
 {
+public:
+    using CompressionType = vespalib::compression::CompressionConfig::Type;
+private:
+    CompressionType _compression;
+    bool            _compressionKnown;
+    double          _compressionRatio;
 public:
     DataStoreFileChunkStats(uint64_t diskUsage_in, uint64_t diskBloat_in,
                             double maxBucketSpread_in,
                             uint64_t lastSerialNum_in,
                             uint64_t lastFlushedSerialNum_in,
                             uint32_t docIdLimit_in,
-                            uint64_t nameId_in)
+                            uint64_t nameId_in,
+                            CompressionType compression_in = CompressionType::NONE,
+                            bool compressionKnown_in = false,
+                            double compressionRatio_in = 1.0)
         : DataStoreStorageStats(diskUsage_in, diskBloat_in,
                                 maxBucketSpread_in, lastSerialNum_in,
                                 lastFlushedSerialNum_in, docIdLimit_in),
-          DataStoreFileChunkId(nameId_in)
+          DataStoreFileChunkId(nameId_in),
+          _compression(compression_in),
+          _compressionKnown(compressionKnown_in),
+          _compressionRatio(compressionRatio_in)
     {
     }
+    /*
+     * Compression the chunks in the file were written with.
+     * Only valid if compressionKnown().
+     */
+    CompressionType compression() const { return _compression; }
+    /*
+     * False for files written before the compression was recorded.
+     */
+    bool compressionKnown() const { return _compressionKnown; }
+    /*
+     * Bytes added to the file divided by its data size on disk.
+     */
+    double compressionRatio() const { return _compressionRatio; }
 };
 
 } // namespace search
@@ -7,6 +7,7 @@
 #include <vespa/vespalib/stllike/cache.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <algorithm>
 
 using document::DocumentTypeRepo;
 using vespalib::compression::CompressionConfig;
@@ -39,6 +40,47 @@ DocumentVisitorAdapter::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
     }
 }
 
+/**
+ * Places visited documents at the position of their lid in a batch read.
+ */
+class DocumentCollector : public IDocumentVisitor
+{
+public:
+    DocumentCollector(const IDocumentStore::LidVector & lids, IDocumentStore::DocumentVector & docs);
+    ~DocumentCollector();
+    void visit(uint32_t lid, document::Document::UP doc) override;
+    bool allowVisitCaching() const override { return false; }
+private:
+    using LidAndPos = std::pair<uint32_t, uint32_t>;
+    std::vector<LidAndPos>           _positions;
+    IDocumentStore::DocumentVector & _docs;
+};
+
+DocumentCollector::DocumentCollector(const IDocumentStore::LidVector & lids, IDocumentStore::DocumentVector & docs)
+    : _positions(),
+      _docs(docs)
+{
+    _positions.reserve(lids.size());
+    for (uint32_t i(0); i < lids.size(); i++) {
+        _positions.emplace_back(lids[i], i);
+    }
+    std::sort(_positions.begin(), _positions.end());
+}
+
+DocumentCollector::~DocumentCollector() { }
+
+void
+DocumentCollector::visit(uint32_t lid, document::Document::UP doc) {
+    // The same lid may be requested more than once, use the first free position
+    auto it = std::lower_bound(_positions.begin(), _positions.end(), LidAndPos(lid, 0));
+    for (; (it != _positions.end()) && (it->first == lid); ++it) {
+        if ( ! _docs[it->second]) {
+            _docs[it->second] = std::move(doc);
+            return;
+        }
+    }
+}
+
 }
 
 using vespalib::nbostream;
@@ -264,6 +306,21 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
     return retval;
 }
 
+IDocumentStore::DocumentVector
+DocumentStore::read(const LidVector & lids, const DocumentTypeRepo &repo) const
+{
+    if (useCache()) {
+        // Keep the cache warm by reading each document through it.
+        return IDocumentStore::read(lids, repo);
+    }
+    DocumentVector docs(lids.size());
+    _uncached_lookups.fetch_add(lids.size());
+    DocumentCollector collector(lids, docs);
+    // Lids are grouped by file and chunk, each chunk is decompressed once.
+    _store->visit(lids, repo, collector);
+    return docs;
+}
+
 void
 DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const document::Document& doc) {
     nbostream stream(12345);
@@ -29,6 +29,46 @@ namespace {
 constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string DICTIONARY_KEY("zstdDictionary");
+const vespalib::string DICTIONARY_LEVEL_KEY("zstdDictionaryLevel");
+const vespalib::string COMPRESSION_KEY("compression");
+
+// Header tags are null terminated strings, so the binary dictionary is stored hex encoded.
+vespalib::string
+hexEncode(vespalib::ConstBufferRef raw)
+{
+    static const char hex[] = "0123456789abcdef";
+    vespalib::string encoded;
+    encoded.reserve(raw.size() * 2);
+    for (size_t i(0); i < raw.size(); i++) {
+        uint8_t v = raw.c_str()[i];
+        encoded.push_back(hex[v >> 4]);
+        encoded.push_back(hex[v & 0xf]);
+    }
+    return encoded;
+}
+
+uint8_t
+hexValue(char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    } else if ((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+    throw std::runtime_error(vespalib::make_string("Illegal hex character '%c' in dictionary", c));
+}
+
+std::vector<char>
+hexDecode(const vespalib::string & encoded)
+{
+    std::vector<char> raw;
+    raw.reserve(encoded.size() / 2);
+    for (size_t i(0); i + 1 < encoded.size(); i += 2) {
+        raw.push_back((hexValue(encoded[i]) << 4) | hexValue(encoded[i + 1]));
+    }
+    return raw;
+}
 
 }
 
@@ -82,7 +122,10 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _lastPersistedSerialNum(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
-      _modificationTime()
+      _modificationTime(),
+      _dictionary(),
+      _compression(CompressionConfig::NONE),
+      _compressionKnown(false)
 {
     FastOS_File dataFile(_dataFileName.c_str());
     if (dataFile.OpenReadOnly()) {
@@ -274,6 +317,13 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    vespalib::DataBuffer h(_dataHeaderLen, ALIGNMENT);
+    _file->read(0, h, _dataHeaderLen);
+    GenericHeader::BufferReader rd(h);
+    GenericHeader header;
+    header.read(rd);
+    _dictionary = readDictionary(header, !frozen());
+    _compressionKnown = readCompression(header, _compression);
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -349,7 +399,7 @@ FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWr
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false, _dictionary.get()));
         }));
 
         singleExecutor.execute(vespalib::makeLambdaTask([args = &fixedParams, chunk = std::move(futureChunk)]() mutable {
@@ -384,7 +434,7 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -409,7 +459,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     return chunk.read(lid, buffer);
 }
 
@@ -471,6 +521,71 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::ZStdDictionary::SP
+FileChunk::readDictionary(const vespalib::GenericHeader &header, bool forCompression)
+{
+    if ( ! header.hasTag(DICTIONARY_KEY)) {
+        return ZStdDictionary::SP();
+    }
+    std::vector<char> raw = hexDecode(header.getTag(DICTIONARY_KEY).asString());
+    vespalib::ConstBufferRef rawRef(raw.data(), raw.size());
+    if ( ! forCompression) {
+        return std::make_shared<ZStdDictionary>(rawRef);
+    }
+    int level = header.hasTag(DICTIONARY_LEVEL_KEY) ? header.getTag(DICTIONARY_LEVEL_KEY).asInteger() : 0;
+    return std::make_shared<ZStdDictionary>(rawRef, level);
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary)
+{
+    header.putTag(vespalib::GenericHeader::Tag(DICTIONARY_KEY, hexEncode(dictionary.getRaw())));
+    header.putTag(vespalib::GenericHeader::Tag(DICTIONARY_LEVEL_KEY, int64_t(dictionary.getCompressionLevel())));
+}
+
+bool
+FileChunk::readCompression(const vespalib::GenericHeader &header, CompressionConfig::Type &compression)
+{
+    if (header.hasTag(COMPRESSION_KEY)) {
+        compression = CompressionConfig::toType(header.getTag(COMPRESSION_KEY).asInteger());
+        return true;
+    }
+    compression = CompressionConfig::NONE;
+    return false;
+}
+
+void
+FileChunk::writeCompression(vespalib::GenericHeader &header, CompressionConfig::Type compression)
+{
+    header.putTag(vespalib::GenericHeader::Tag(COMPRESSION_KEY, int64_t(compression)));
+}
+
+std::vector<vespalib::string>
+FileChunk::sampleEntries(size_t maxBytes) const
+{
+    std::vector<vespalib::string> samples;
+    const size_t numChunks(_chunkInfo.size());
+    // Visit every stride'th chunk first, so the samples are spread across the file.
+    const size_t stride(std::max(1ul, numChunks / 64));
+    size_t sampledBytes(0);
+    for (size_t start(0); (start < stride) && (sampledBytes < maxBytes); start++) {
+        for (size_t chunkId(start); (chunkId < numChunks) && (sampledBytes < maxBytes); chunkId += stride) {
+            const ChunkInfo & ci = _chunkInfo[chunkId];
+            vespalib::DataBuffer whole(0ul, ALIGNMENT);
+            FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
+            const Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
+            const vespalib::nbostream & data = chunk.getData();
+            for (const Chunk::Entry & e : chunk.getLids()) {
+                if (e.netSize() > 0) {
+                    samples.emplace_back(data.c_str() + e.getNetOffset(), e.netSize());
+                    sampledBytes += e.netSize();
+                }
+            }
+        }
+    }
+    return samples;
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -485,7 +600,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _dictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -585,8 +700,13 @@ FileChunk::getStats() const
     uint64_t serialNum = getLastPersistedSerialNum();
     uint32_t docIdLimit = getDocIdLimit();
     uint64_t nameId = getNameId().getId();
+    size_t headerFootprint = getDiskHeaderFootprint();
+    double compressionRatio = (diskFootprint > headerFootprint)
+                              ? double(getAddedBytes()) / (diskFootprint - headerFootprint)
+                              : 1.0;
     return DataStoreFileChunkStats(diskFootprint, diskBloat, bucketSpread,
-                                   serialNum, serialNum, docIdLimit, nameId);
+                                   serialNum, serialNum, docIdLimit, nameId,
+                                   getCompression(), isCompressionKnown(), compressionRatio);
 }
 
 } // namespace search
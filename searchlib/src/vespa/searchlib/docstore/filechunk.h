@@ -12,6 +12,7 @@
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 class FastOS_FileInterface;
 
@@ -105,6 +106,8 @@ public:
     typedef vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>> LidBufferMap;
     typedef std::unique_ptr<FileChunk> UP;
     typedef uint32_t SubChunkId;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
+    using CompressionConfig = vespalib::compression::CompressionConfig;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
@@ -181,6 +184,25 @@ public:
      */
     void verify(bool reportOnly) const;
 
+    /**
+     * The dictionary the chunks in this file are compressed with, if any.
+     * It is stored in the header of the '.dat' file.
+     */
+    const ZStdDictionary::SP & getDictionary() const { return _dictionary; }
+    /**
+     * The compression configured when the file was written. Stored in the
+     * header of the '.dat' file. Files written before it was stored have
+     * unknown compression, see isCompressionKnown().
+     */
+    CompressionConfig::Type getCompression() const { return _compression; }
+    bool isCompressionKnown() const { return _compressionKnown; }
+    /**
+     * Collect entries from chunks spread across the file until at least
+     * maxBytes have been sampled or the file is exhausted. Used as training
+     * data for a compression dictionary.
+     */
+    std::vector<vespalib::string> sampleEntries(size_t maxBytes) const;
+
     uint32_t      getNumChunks() const;
     size_t       getNumBuckets() const { return _sumNumBuckets; }
     size_t getNumUniqueBuckets() const { return _numUniqueBuckets; }
@@ -236,6 +258,10 @@ protected:
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static ZStdDictionary::SP readDictionary(const vespalib::GenericHeader &header, bool forCompression);
+    static void writeDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary);
+    static bool readCompression(const vespalib::GenericHeader &header, CompressionConfig::Type &compression);
+    static void writeCompression(vespalib::GenericHeader &header, CompressionConfig::Type compression);
 
     typedef vespalib::Array<ChunkInfo> ChunkInfoVector;
     const IBucketizer * _bucketizer;
@@ -249,6 +275,9 @@ protected:
     uint64_t            _lastPersistedSerialNum;
     uint32_t            _docIdLimit; // Limit when the file was created. Stored in idx file header.
     fastos::TimeStamp   _modificationTime;
+    ZStdDictionary::SP  _dictionary;
+    CompressionConfig::Type _compression;
+    bool                _compressionKnown;
 };
 
 } // namespace search
@@ -12,6 +12,16 @@ IDocumentStore::~IDocumentStore()
 {
 }
 
+IDocumentStore::DocumentVector
+IDocumentStore::read(const LidVector & lids, const document::DocumentTypeRepo &repo) const {
+    DocumentVector docs;
+    docs.reserve(lids.size());
+    for (uint32_t lid : lids) {
+        docs.push_back(read(lid, repo));
+    }
+    return docs;
+}
+
 void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const {
     for (uint32_t lid : lids) {
         visitor.visit(lid, read(lid, repo));
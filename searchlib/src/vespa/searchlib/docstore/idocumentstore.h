@@ -57,6 +57,7 @@ public:
      **/
     using SP = std::shared_ptr<IDocumentStore>;
     using LidVector = std::vector<uint32_t>;
+    using DocumentVector = std::vector<document::Document::UP>;
 
 
     /**
@@ -75,6 +76,14 @@ public:
      * @return NULL if there is no document associated with the lid.
      **/
     virtual document::Document::UP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
+
+    /**
+     * Make Documents for a batch of local IDs. Implementations may read
+     * documents stored close together in one go.
+     * @param lids The local IDs associated with the documents.
+     * @return documents in the same order as the lids, NULL where there is no document.
+     **/
+    virtual DocumentVector read(const LidVector & lids, const document::DocumentTypeRepo &repo) const;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
     /**
@@ -37,7 +37,10 @@ LogDataStore::Config::Config()
       _skipCrcOnRead(false),
       _compact2ActiveFile(true),
       _compactCompression(CompressionConfig::LZ4),
-      _fileConfig()
+      _fileConfig(),
+      _compactedFileCompression(),
+      _hasCompactedFileCompression(false),
+      _dictionarySize(0)
 { }
 
 bool
@@ -49,7 +52,9 @@ LogDataStore::Config::operator == (const Config & rhs) const {
             (_compact2ActiveFile == rhs._compact2ActiveFile) &&
             (_skipCrcOnRead == rhs._skipCrcOnRead) &&
             (_compactCompression == rhs._compactCompression) &&
-            (_fileConfig == rhs._fileConfig);
+            (_fileConfig == rhs._fileConfig) &&
+            (getCompactedFileConfig() == rhs.getCompactedFileConfig()) &&
+            (_dictionarySize == rhs._dictionarySize);
 }
 
 LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::string &dirName, const Config &config,
@@ -74,13 +79,16 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
       _tlSyncer(tlSyncer),
       _bucketizer(bucketizer),
       _currentlyCompacting(),
-      _compactLidSpaceGeneration()
+      _compactLidSpaceGeneration(),
+      _dictionary(),
+      _compactedDictionary()
 {
     // Reserve space for 1TB summary in order to avoid locking.
     _fileChunks.reserve(LidInfo::getFileIdLimit());
     _holdFileChunks.resize(LidInfo::getFileIdLimit());
 
     preload();
+    adoptDictionary();
     updateLidMap(getLastFileChunkDocIdLimit());
     updateSerialNum();
 }
@@ -459,19 +467,84 @@ void LogDataStore::setNewFileChunk(const LockGuard & guard, FileChunk::UP file)
     _fileChunks[fileId] = std::move(file);
 }
 
+void LogDataStore::trainDictionary(const FileChunk & fc)
+{
+    // zstd recommends roughly 100 times the dictionary size as training data.
+    std::vector<vespalib::string> samples = fc.sampleEntries(_config.getDictionarySize() * 100);
+    std::vector<vespalib::ConstBufferRef> sampleRefs;
+    sampleRefs.reserve(samples.size());
+    for (const vespalib::string & sample : samples) {
+        sampleRefs.emplace_back(sample.data(), sample.size());
+    }
+    FileChunk::ZStdDictionary::SP dictionary =
+        FileChunk::ZStdDictionary::train(sampleRefs, _config.getDictionarySize(),
+                                         _config.getCompactedFileConfig().getCompression().compressionLevel);
+    if (dictionary) {
+        LOG(info, "Trained compression dictionary of %zu bytes from %zu entries in file '%s'",
+                  dictionary->getRaw().size(), samples.size(), fc.getName().c_str());
+        LockGuard guard(_updateLock);
+        setDictionary(guard, *dictionary);
+    } else {
+        LOG(warning, "Failed training compression dictionary from %zu entries in file '%s'",
+                     samples.size(), fc.getName().c_str());
+    }
+}
+
+void LogDataStore::adoptDictionary()
+{
+    // Continue using the dictionary of the newest file that has one.
+    if ( ! _config.useDictionary()) {
+        return;
+    }
+    for (auto it(_fileChunks.rbegin()); it != _fileChunks.rend(); ++it) {
+        if (*it && (*it)->getDictionary()) {
+            LockGuard guard(_updateLock);
+            setDictionary(guard, *(*it)->getDictionary());
+            return;
+        }
+    }
+}
+
+void LogDataStore::setDictionary(const LockGuard & guard, const FileChunk::ZStdDictionary & dictionary)
+{
+    (void) guard;
+    // The compression level is part of the prepared dictionary, so fresh and compacted files need one each.
+    _dictionary = std::make_shared<FileChunk::ZStdDictionary>(dictionary.getRaw(),
+                                                              _config.getFileConfig().getCompression().compressionLevel);
+    _compactedDictionary = std::make_shared<FileChunk::ZStdDictionary>(dictionary.getRaw(),
+                                                                       _config.getCompactedFileConfig().getCompression().compressionLevel);
+}
+
+FileChunk::ZStdDictionary::SP
+LogDataStore::getDictionary(const WriteableFileChunk::Config & fileConfig) const
+{
+    if ( ! _config.useDictionary() || (fileConfig.getCompression().type != CompressionConfig::ZSTD)) {
+        return FileChunk::ZStdDictionary::SP();
+    }
+    if (_compactedDictionary && (_compactedDictionary->getCompressionLevel() == fileConfig.getCompression().compressionLevel)) {
+        return _compactedDictionary;
+    }
+    return _dictionary;
+}
+
 void LogDataStore::compactFile(FileId fileId)
 {
     FileChunk::UP & fc(_fileChunks[fileId.getId()]);
     NameId compactedNameId = fc->getNameId();
     LOG(info, "Compacting file '%s' which has bloat '%2.2f' and bucket-spread '%1.4f",
               fc->getName().c_str(), 100*fc->getDiskBloat()/double(fc->getDiskFootprint()), fc->getBucketSpread());
+    if (_config.useDictionary() && ! _dictionary) {
+        // Files created from now on, including the destination of this compaction, compress with the dictionary.
+        trainDictionary(*fc);
+    }
     IWriteData::UP compacter;
     FileId destinationFileId = FileId::active();
     if (_bucketizer) {
         if ( ! shouldCompactToActiveFile(fc->getDiskFootprint() - fc->getDiskBloat())) {
             LockGuard guard(_updateLock);
             destinationFileId = allocateFileId(guard);
-            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(), fc->getNameId().next()));
+            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(), fc->getNameId().next(),
+                                                      _config.getCompactedFileConfig()));
         }
         size_t numSignificantBucketBits = computeNumberOfSignificantBucketIdBits(*_bucketizer, fc->getFileId());
         compacter.reset(new BucketCompacter(numSignificantBucketBits, _config.compactCompression(), *this, _executor,
@@ -635,7 +708,8 @@ LogDataStore::createReadOnlyFile(FileId fileId, NameId nameId) {
 }
 
 FileChunk::UP
-LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId)
+LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId,
+                                 const WriteableFileChunk::Config & fileConfig)
 {
     for (const auto & fc : _fileChunks) {
         if (fc && (fc->getNameId() == nameId)) {
@@ -646,8 +720,9 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     }
     uint32_t docIdLimit = (getDocIdLimit() != 0) ? getDocIdLimit() : std::numeric_limits<uint32_t>::max();
     FileChunk::UP file(new WriteableFileChunk(_executor, fileId, nameId, getBaseDir(),
-                                              serialNum, docIdLimit,
-                                              _config.getFileConfig(), _tune, _fileHeaderContext,
+                                              serialNum, docIdLimit, fileConfig,
+                                              getDictionary(fileConfig),
+                                              _tune, _fileHeaderContext,
                                               _bucketizer.get(), _config.crcOnReadDisabled()));
     file->enableRead();
     return file;
@@ -656,7 +731,7 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
 FileChunk::UP
 LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum)
 {
-    return createWritableFile(fileId, serialNum, NameId(fastos::ClockSystem::now()));
+    return createWritableFile(fileId, serialNum, NameId(fastos::ClockSystem::now()), _config.getFileConfig());
 }
 
 namespace {
@@ -785,7 +860,8 @@ LogDataStore::preload()
         }
         _fileChunks.push_back(isReadOnly()
             ? createReadOnlyFile(FileId(_fileChunks.size()), *partList.rbegin())
-            : createWritableFile(FileId(_fileChunks.size()), getMinLastPersistedSerialNum(), *partList.rbegin()));
+            : createWritableFile(FileId(_fileChunks.size()), getMinLastPersistedSerialNum(), *partList.rbegin(),
+                                 _config.getFileConfig()));
     } else {
         if ( ! isReadOnly() ) {
             _fileChunks.push_back(createWritableFile(FileId::first(), 0));
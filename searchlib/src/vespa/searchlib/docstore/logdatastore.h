@@ -45,6 +45,22 @@ public:
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
+        /**
+         * Compression of the files written by compaction when it does not
+         * write to the active file, e.g. to recompress cold data harder than
+         * fresh writes. Defaults to the compression of the file config.
+         */
+        Config & setCompactedFileCompression(CompressionConfig v) {
+            _compactedFileCompression = v;
+            _hasCompactedFileCompression = true;
+            return *this;
+        }
+        /**
+         * Max size of the zstd dictionary trained during compaction, 0 disables it.
+         * Only used when compaction writes files compressed with ZSTD. Other
+         * files compressed with ZSTD then use the dictionary as well.
+         */
+        Config & setDictionarySize(size_t v) { _dictionarySize = v; return *this; }
 
         size_t getMaxFileSize() const { return _maxFileSize; }
         double getMaxDiskBloatFactor() const { return _maxDiskBloatFactor; }
@@ -56,6 +72,16 @@ public:
         const CompressionConfig & compactCompression() const { return _compactCompression; }
 
         const WriteableFileChunk::Config & getFileConfig() const { return _fileConfig; }
+        WriteableFileChunk::Config getCompactedFileConfig() const {
+            return _hasCompactedFileCompression
+                   ? WriteableFileChunk::Config(_compactedFileCompression, _fileConfig.getMaxChunkBytes())
+                   : _fileConfig;
+        }
+        size_t getDictionarySize() const { return _dictionarySize; }
+        bool useDictionary() const {
+            return (_dictionarySize > 0) &&
+                   (getCompactedFileConfig().getCompression().type == CompressionConfig::ZSTD);
+        }
         Config & disableCrcOnRead(bool v) { _skipCrcOnRead = v; return *this;}
         Config & compact2ActiveFile(bool v) { _compact2ActiveFile = v; return *this; }
 
@@ -69,6 +95,9 @@ public:
         bool                        _compact2ActiveFile;
         CompressionConfig           _compactCompression;
         WriteableFileChunk::Config  _fileConfig;
+        CompressionConfig           _compactedFileCompression;
+        bool                        _hasCompactedFileCompression;
+        size_t                      _dictionarySize;
     };
 public:
     /**
@@ -188,6 +217,10 @@ private:
 
     void compactWorst(double bloatLimit, double spreadLimit);
     void compactFile(FileId chunkId);
+    void trainDictionary(const FileChunk & fc);
+    void adoptDictionary();
+    void setDictionary(const LockGuard & guard, const FileChunk::ZStdDictionary & dictionary);
+    FileChunk::ZStdDictionary::SP getDictionary(const WriteableFileChunk::Config & fileConfig) const;
 
     typedef attribute::RcuVector<uint64_t> LidInfoVector;
     typedef std::vector<FileChunk::UP> FileChunkVector;
@@ -235,7 +268,8 @@ private:
 
     FileChunk::UP createReadOnlyFile(FileId fileId, NameId nameId);
     FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum);
-    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId);
+    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId,
+                                     const WriteableFileChunk::Config & fileConfig);
     vespalib::string createFileName(NameId id) const;
     vespalib::string createDatFileName(NameId id) const;
     vespalib::string createIdxFileName(NameId id) const;
@@ -287,6 +321,8 @@ private:
     IBucketizer::SP                          _bucketizer;
     NameIdSet                                _currentlyCompacting;
     uint64_t                                 _compactLidSpaceGeneration;
+    FileChunk::ZStdDictionary::SP            _dictionary;
+    FileChunk::ZStdDictionary::SP            _compactedDictionary;
 };
 
 } // namespace search
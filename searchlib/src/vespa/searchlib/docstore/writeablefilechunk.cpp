@@ -83,6 +83,7 @@ WriteableFileChunk(vespalib::ThreadExecutor &executor,
                    SerialNum initialSerialNum,
                    uint32_t docIdLimit,
                    const Config &config,
+                   const ZStdDictionary::SP &dictionary,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
                    const IBucketizer * bucketizer,
@@ -121,7 +122,7 @@ WriteableFileChunk(vespalib::ThreadExecutor &executor,
     if (_dataFile.OpenReadWrite()) {
         readDataHeader();
         if (_dataHeaderLen == 0) {
-            writeDataHeader(fileHeaderContext);
+            writeDataHeader(fileHeaderContext, dictionary);
         }
         _dataFile.SetPosition(_dataFile.GetSize());
         if (tune._write.getWantDirectIO()) {
@@ -278,7 +279,7 @@ WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum)
     if (_alignment > 1) {
         tmp->getBuf().ensureFree(active->getMaxPackSize(_config.getCompression()) + _alignment - 1);
     }
-    active->pack(serialNum, tmp->getBuf(), _config.getCompression());
+    active->pack(serialNum, tmp->getBuf(), _config.getCompression(), getDictionary().get());
     tmp->setPayLoad();
     if (_alignment > 1) {
         const size_t padAfter((_alignment - tmp->getPayLoad() % _alignment) % _alignment);
@@ -784,7 +785,7 @@ WriteableFileChunk::readIdxHeader(FastOS_FileInterface & idxFile)
 
 
 void
-WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
+WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext, const ZStdDictionary::SP & dictionary)
 {
     typedef FileHeader::Tag Tag;
     FileHeader h(headerAlign);
@@ -793,6 +794,10 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
     assert(_dataFile.GetPosition() == 0);
     fileHeaderContext.addTags(h, _dataFile.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk data"));
+    writeCompression(h, _config.getCompression().type);
+    if (dictionary && (_config.getCompression().type == vespalib::compression::CompressionConfig::ZSTD)) {
+        writeDictionary(h, *dictionary);
+    }
     _dataHeaderLen = h.writeFile(_dataFile);
 }
 
@@ -915,7 +920,8 @@ WriteableFileChunk::getStats() const
     DataStoreFileChunkStats stats = FileChunk::getStats();
     uint64_t serialNum = getSerialNum();
     return DataStoreFileChunkStats(stats.diskUsage(), stats.diskBloat(), stats.maxBucketSpread(),
-                                   serialNum, stats.lastFlushedSerialNum(), stats.docIdLimit(), stats.nameId());
+                                   serialNum, stats.lastFlushedSerialNum(), stats.docIdLimit(), stats.nameId(),
+                                   _config.getCompression().type, true, stats.compressionRatio());
 };
 
 PendingChunk::PendingChunk(uint64_t lastSerial, uint64_t dataOffset, uint32_t dataLen)
@@ -44,7 +44,7 @@ public:
     typedef std::unique_ptr<WriteableFileChunk> UP;
     WriteableFileChunk(vespalib::ThreadExecutor & executor, FileId fileId, NameId nameId,
                        const vespalib::string & baseName, uint64_t initialSerialNum,
-                       uint32_t docIdLimit, const Config & config,
+                       uint32_t docIdLimit, const Config & config, const ZStdDictionary::SP & dictionary,
                        const TuneFileSummary &tune, const common::FileHeaderContext &fileHeaderContext,
                        const IBucketizer * bucketizer, bool crcOnReadDisabled);
     ~WriteableFileChunk();
@@ -87,7 +87,7 @@ private:
     ProcessedChunkQ drainQ();
     void readDataHeader();
     void readIdxHeader(FastOS_FileInterface & idxFile);
-    void writeDataHeader(const common::FileHeaderContext &fileHeaderContext);
+    void writeDataHeader(const common::FileHeaderContext &fileHeaderContext, const ZStdDictionary::SP & dictionary);
     bool needFlushPendingChunks(uint64_t serialNum, uint64_t datFileLen);
     bool needFlushPendingChunks(const vespalib::MonitorGuard & guard, uint64_t serialNum, uint64_t datFileLen);
     fastos::TimeStamp unconditionallyFlushPendingChunks(const vespalib::LockGuard & flushGuard, uint64_t serialNum, uint64_t datFileLen);
@@ -14,6 +14,7 @@ LOG_SETUP(".features.euclidean_distance_feature");
 
 using namespace search::attribute;
 using namespace search::fef;
+using vespalib::hwaccelrated::IAccelrated;
 
 namespace search {
 namespace features {
@@ -24,20 +25,38 @@ EuclideanDistanceExecutor<DataType>::EuclideanDistanceExecutor(const search::att
     FeatureExecutor(),
     _attribute(attribute),
     _vector(std::move(vector)),
-    _attributeBuffer()
+    _attributeBuffer(),
+    _accelrator(IAccelrated::getAccelrator())
 {
 }
 
+namespace {
+
 template <typename DataType>
-feature_t EuclideanDistanceExecutor<DataType>::euclideanDistance(const BufferType &v1, const QueryVectorType &v2)
+feature_t
+squaredEuclideanDistance(const IAccelrated &, const DataType * a, const DataType * b, size_t sz)
 {
     feature_t val = 0;
-    size_t commonRange = std::min(static_cast<size_t>( v1.size() ), v2.size());
-    for (size_t i = 0; i < commonRange; ++i)  {
-        feature_t diff = v1[i] - v2[i];
+    for (size_t i = 0; i < sz; ++i)  {
+        feature_t diff = a[i] - b[i];
         val += diff * diff;
     }
-    return std::sqrt(val);
+    return val;
+}
+
+feature_t
+squaredEuclideanDistance(const IAccelrated & accelrator, const double * a, const double * b, size_t sz)
+{
+    return accelrator.squaredEuclideanDistance(a, b, sz);
+}
+
+}
+
+template <typename DataType>
+feature_t EuclideanDistanceExecutor<DataType>::euclideanDistance(const BufferType &v1, const QueryVectorType &v2)
+{
+    size_t commonRange = std::min(static_cast<size_t>( v1.size() ), v2.size());
+    return std::sqrt(squaredEuclideanDistance(*_accelrator, v1.begin(), v2.data(), commonRange));
 }
 
 
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/fef/blueprint.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
 #include <vespa/searchcommon/attribute/attributecontent.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 
 
 namespace search {
@@ -25,6 +26,7 @@ private:
     const search::attribute::IAttributeVector &_attribute;
     const QueryVectorType _vector;
     BufferType _attributeBuffer;
+    vespalib::hwaccelrated::IAccelrated::UP _accelrator;
 
     feature_t euclideanDistance(const BufferType &v1, const QueryVectorType &v2);
 
@@ -190,6 +190,51 @@ NumSearchPartitions::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string UseWorkStealing::NAME("vespa.matching.workstealing");
+const bool UseWorkStealing::DEFAULT_VALUE(false);
+
+bool
+UseWorkStealing::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+UseWorkStealing::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string ResultCacheMaxBytes::NAME("vespa.matching.resultcache.maxbytes");
+const uint32_t ResultCacheMaxBytes::DEFAULT_VALUE(0);
+
+uint32_t
+ResultCacheMaxBytes::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+ResultCacheMaxBytes::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string ResultCacheMaxHits::NAME("vespa.matching.resultcache.maxhits");
+const uint32_t ResultCacheMaxHits::DEFAULT_VALUE(100);
+
+uint32_t
+ResultCacheMaxHits::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+ResultCacheMaxHits::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 const vespalib::string MinHitsPerThread::NAME("vespa.matching.minhitsperthread");
 const uint32_t MinHitsPerThread::DEFAULT_VALUE(0);
 
@@ -133,6 +133,40 @@ namespace matching {
         static uint32_t lookup(const Properties &props);
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
+    /**
+     * Property for using work-stealing between the search threads
+     * instead of cooperative work-sharing. Only used when the number
+     * of partitions inside the docid space is 0 (adaptive).
+     **/
+    struct UseWorkStealing {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+    /**
+     * Property for the memory limit (in bytes) of the query result
+     * cache. The cache keeps the best hits for repeated queries so
+     * that requests for other offsets can be answered without
+     * matching. The cache is disabled when this is 0.
+     **/
+    struct ResultCacheMaxBytes {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+    /**
+     * Property for the number of best hits stored for each query in
+     * the query result cache. Requests for hits beyond this limit
+     * are not cached.
+     **/
+    struct ResultCacheMaxHits {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
 }
 
 namespace softtimeout {
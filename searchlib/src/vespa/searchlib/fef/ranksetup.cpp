@@ -38,6 +38,9 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _numThreads(0),
       _minHitsPerThread(0),
       _numSearchPartitions(0),
+      _useWorkStealing(false),
+      _resultCacheMaxBytes(0),
+      _resultCacheMaxHits(0),
       _heapSize(0),
       _arraySize(0),
       _estimatePoint(0),
@@ -81,6 +84,9 @@ RankSetup::configure()
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
+    setUseWorkStealing(matching::UseWorkStealing::lookup(_indexEnv.getProperties()));
+    setResultCacheMaxBytes(matching::ResultCacheMaxBytes::lookup(_indexEnv.getProperties()));
+    setResultCacheMaxHits(matching::ResultCacheMaxHits::lookup(_indexEnv.getProperties()));
     setHeapSize(hitcollector::HeapSize::lookup(_indexEnv.getProperties()));
     setArraySize(hitcollector::ArraySize::lookup(_indexEnv.getProperties()));
     setDegradationAttribute(matchphase::DegradationAttribute::lookup(_indexEnv.getProperties()));
@@ -36,6 +36,9 @@ private:
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
+    bool                     _useWorkStealing;
+    uint32_t                 _resultCacheMaxBytes;
+    uint32_t                 _resultCacheMaxHits;
     uint32_t                 _heapSize;
     uint32_t                 _arraySize;
     uint32_t                 _estimatePoint;
@@ -158,6 +161,18 @@ public:
 
     uint32_t getNumSearchPartitions() const { return _numSearchPartitions; }
 
+    void setUseWorkStealing(bool useWorkStealing) { _useWorkStealing = useWorkStealing; }
+
+    bool getUseWorkStealing() const { return _useWorkStealing; }
+
+    void setResultCacheMaxBytes(uint32_t maxBytes) { _resultCacheMaxBytes = maxBytes; }
+
+    uint32_t getResultCacheMaxBytes() const { return _resultCacheMaxBytes; }
+
+    void setResultCacheMaxHits(uint32_t maxHits) { _resultCacheMaxHits = maxHits; }
+
+    uint32_t getResultCacheMaxHits() const { return _resultCacheMaxHits; }
+
     /**
      * Sets the heap size to be used in the hit collector.
      *
@@ -8,6 +8,7 @@
 #include <vespa/document/datatype/urldatatype.h>
 #include <vespa/document/annotation/alternatespanlist.h>
 #include <vespa/searchlib/util/url.h>
+#include <algorithm>
 #include <stdexcept>
 #include <vespa/vespalib/text/utf8.h>
 #include <vespa/vespalib/text/lowercase.h>
@@ -45,37 +46,54 @@ using vespalib::make_string;
 using search::util::URL;
 
 
+DocumentInverter::Shard::Shard()
+    : _inverters(),
+      _urlInverters()
+{
+}
+
+
+DocumentInverter::Shard::Shard(Shard &&) = default;
+
+
+DocumentInverter::Shard::~Shard() = default;
+
+
 DocumentInverter::DocumentInverter(const Schema &schema,
                                    ISequencedTaskExecutor &invertThreads,
-                                   ISequencedTaskExecutor &pushThreads)
+                                   ISequencedTaskExecutor &pushThreads,
+                                   uint32_t numShards)
     : _schema(schema),
       _indexedFieldPaths(),
       _dataType(nullptr),
       _schemaIndexFields(),
-      _inverters(),
-      _urlInverters(),
+      _shards(),
       _invertThreads(invertThreads),
       _pushThreads(pushThreads)
 {
     _schemaIndexFields.setup(schema);
 
-    for (uint32_t fieldId = 0; fieldId < _schema.getNumIndexFields();
-         ++fieldId) {
-        _inverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId));
-    }
-    for (auto &urlField : _schemaIndexFields._uriFields) {
-        Schema::CollectionType collectionType =
-            _schema.getIndexField(urlField._all).getCollectionType();
-        _urlInverters.push_back(std::make_unique<UrlFieldInverter>
-                                (collectionType,
-                                 _inverters[urlField._all].get(),
-                                 _inverters[urlField._scheme].get(),
-                                 _inverters[urlField._host].get(),
-                                 _inverters[urlField._port].get(),
-                                 _inverters[urlField._path].get(),
-                                 _inverters[urlField._query].get(),
-                                 _inverters[urlField._fragment].get(),
-                                 _inverters[urlField._hostname].get()));
+    _shards.resize(std::max(numShards, 1u));
+    for (auto &shard : _shards) {
+        auto &inverters = shard._inverters;
+        for (uint32_t fieldId = 0; fieldId < _schema.getNumIndexFields();
+             ++fieldId) {
+            inverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId));
+        }
+        for (auto &urlField : _schemaIndexFields._uriFields) {
+            Schema::CollectionType collectionType =
+                _schema.getIndexField(urlField._all).getCollectionType();
+            shard._urlInverters.push_back(std::make_unique<UrlFieldInverter>
+                                          (collectionType,
+                                           inverters[urlField._all].get(),
+                                           inverters[urlField._scheme].get(),
+                                           inverters[urlField._host].get(),
+                                           inverters[urlField._port].get(),
+                                           inverters[urlField._path].get(),
+                                           inverters[urlField._query].get(),
+                                           inverters[urlField._fragment].get(),
+                                           inverters[urlField._hostname].get()));
+        }
     }
 }
 
@@ -129,6 +147,8 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
     if (_indexedFieldPaths.empty() || _dataType != dataType) {
         buildFieldPath(doc.getType(), dataType);
     }
+    uint32_t shardId = getShardId(docId);
+    Shard &shard = _shards[shardId];
     for (uint32_t fieldId : _schemaIndexFields._textFields) {
         const FieldPath *const fieldPath(_indexedFieldPaths[fieldId].get());
         FieldValue::UP fv;
@@ -137,8 +157,8 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
             // FieldValue::UP fv = doc.getNestedFieldValue(fieldPath.begin(), fieldPath.end());
             fv = doc.getValue(*fieldPath);
         }
-        FieldInverter *inverter = _inverters[fieldId].get();
-        _invertThreads.execute(fieldId,
+        FieldInverter *inverter = shard._inverters[fieldId].get();
+        _invertThreads.execute(getInvertId(fieldId, shardId),
                                [inverter, docId, fv(std::move(fv))]()
                                { inverter->invertField(docId, fv); });
     }
@@ -152,8 +172,8 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
             // FieldValue::UP fv = doc.getNestedFieldValue(fieldPath.begin(), fieldPath.end());
             fv = doc.getValue(*fieldPath);
         }
-        UrlFieldInverter *inverter = _urlInverters[urlId].get();
-        _invertThreads.execute(fieldId,
+        UrlFieldInverter *inverter = shard._urlInverters[urlId].get();
+        _invertThreads.execute(getInvertId(fieldId, shardId),
                                [inverter, docId, fv(std::move(fv))]()
                                { inverter->invertField(docId, fv); });
         ++urlId;
@@ -164,17 +184,19 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
 void
 DocumentInverter::removeDocument(uint32_t docId)
 {
+    uint32_t shardId = getShardId(docId);
+    Shard &shard = _shards[shardId];
     for (uint32_t fieldId : _schemaIndexFields._textFields) {
-        FieldInverter *inverter = _inverters[fieldId].get();
-        _invertThreads.execute(fieldId,
+        FieldInverter *inverter = shard._inverters[fieldId].get();
+        _invertThreads.execute(getInvertId(fieldId, shardId),
                                [inverter, docId]()
                                { inverter->removeDocument(docId); });
     }
     uint32_t urlId = 0;
     for (const auto & fi : _schemaIndexFields._uriFields) {
         uint32_t fieldId = fi._all;
-        UrlFieldInverter *inverter = _urlInverters[urlId].get();
-        _invertThreads.execute(fieldId,
+        UrlFieldInverter *inverter = shard._urlInverters[urlId].get();
+        _invertThreads.execute(getInvertId(fieldId, shardId),
                                [inverter, docId]()
                                { inverter->removeDocument(docId); });
         ++urlId;
@@ -188,21 +210,25 @@ DocumentInverter::pushDocuments(Dictionary &dict,
                                 onWriteDone)
 {
     auto indexFieldIterator = dict.getFieldIndexes().begin();
-    uint32_t fieldId = 0;
-    for (auto &inverter : _inverters) {
+    uint32_t numFields = getNumFields();
+    for (uint32_t fieldId = 0; fieldId < numFields; ++fieldId) {
         MemoryFieldIndex &fieldIndex(**indexFieldIterator);
         DocumentRemover &remover(fieldIndex.getDocumentRemover());
         OrderedDocumentInserter &inserter(fieldIndex.getInserter());
+        std::vector<FieldInverter *> inverters;
+        for (auto &shard : _shards) {
+            inverters.push_back(shard._inverters[fieldId].get());
+        }
         _pushThreads.execute(fieldId,
-                             [inverter(inverter.get()), &remover, &inserter,
-                              &fieldIndex, onWriteDone]()
-                             { inverter->applyRemoves(remover);
-                                 inverter->pushDocuments(inserter);
+                             [inverters(std::move(inverters)), &remover,
+                              &inserter, &fieldIndex, onWriteDone]()
+                             { for (FieldInverter *inverter : inverters) {
+                                     inverter->applyRemoves(remover);
+                                 }
+                                 FieldInverter::pushDocuments(inverters, inserter);
                                  fieldIndex.commit(); });
         ++indexFieldIterator;
-        ++fieldId;
     }
 }
 
 }
-
@@ -58,8 +58,20 @@ private:
 
     DocTypeBuilder::SchemaIndexFields  _schemaIndexFields;
 
-    std::vector<std::unique_ptr<FieldInverter>> _inverters;
-    std::vector<std::unique_ptr<UrlFieldInverter>> _urlInverters;
+    /*
+     * Inverters for a subset of the documents.  A document is always
+     * inverted by the shard selected by its local id, thus shards hold
+     * disjoint sets of documents and can be inverted in parallel.
+     */
+    struct Shard {
+        std::vector<std::unique_ptr<FieldInverter>> _inverters;
+        std::vector<std::unique_ptr<UrlFieldInverter>> _urlInverters;
+        Shard();
+        Shard(Shard &&);
+        ~Shard();
+    };
+
+    std::vector<Shard> _shards;
     ISequencedTaskExecutor &_invertThreads;
     ISequencedTaskExecutor &_pushThreads;
 
@@ -74,15 +86,28 @@ private:
         return _schema;
     }
 
+    uint32_t getShardId(uint32_t docId) const { return docId % _shards.size(); }
+
+    /*
+     * Get the component id used to select invert thread for the given
+     * field and shard.
+     */
+    uint32_t getInvertId(uint32_t fieldId, uint32_t shardId) const {
+        return fieldId + shardId * getNumFields();
+    }
+
 public:
     /**
      * Create a new memory index based on the given schema.
      *
      * @param schema the index schema to use
+     * @param numShards number of disjoint document sets to invert
+     *                  each field in parallel for
      */
     DocumentInverter(const index::Schema &schema,
                      ISequencedTaskExecutor &invertThreads,
-                     ISequencedTaskExecutor &pushThreads);
+                     ISequencedTaskExecutor &pushThreads,
+                     uint32_t numShards = 1);
 
     ~DocumentInverter();
 
@@ -112,14 +137,15 @@ public:
      */
     void removeDocument(uint32_t docId);
 
-    FieldInverter *getInverter(uint32_t fieldId) const {
-        return _inverters[fieldId].get();
+    FieldInverter *getInverter(uint32_t fieldId, uint32_t shardId = 0) const {
+        return _shards[shardId]._inverters[fieldId].get();
     }
 
     const std::vector<std::unique_ptr<FieldInverter> > &
-    getInverters() const { return _inverters; }
+    getInverters(uint32_t shardId = 0) const { return _shards[shardId]._inverters; }
 
-    uint32_t getNumFields() const { return _inverters.size(); }
+    uint32_t getNumFields() const { return _shards[0]._inverters.size(); }
+    uint32_t getNumShards() const { return _shards.size(); }
 };
 
 } // namespace memoryindex
@@ -335,6 +335,7 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId)
       _wpos(0u),
       _docId(0),
       _oldPosSize(0),
+      _pushPos(0),
       _schema(schema),
       _words(),
       _elems(),
@@ -486,14 +487,14 @@ FieldInverter::applyRemoves(DocumentRemover &remover)
 }
 
 
-void
-FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
+bool
+FieldInverter::preparePush()
 {
     trimAbortedDocs();
 
     if (_positions.empty()) {
         reset();
-        return;             // All documents with words aborted
+        return false;       // All documents with words aborted
     }
 
     sortWords();
@@ -501,50 +502,41 @@ FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
     // Sort for terms.
     ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
         radix_sort(FullRadix(), std::less<PosInfo>(), &_positions[0], _positions.size(), 16);
+    _pushPos = 0;
+    return true;
+}
 
+
+void
+FieldInverter::pushNextDoc(IOrderedDocumentInserter &inserter)
+{
     constexpr uint32_t NO_ELEMENT_ID = std::numeric_limits<uint32_t>::max();
     constexpr uint32_t NO_WORD_POS = std::numeric_limits<uint32_t>::max();
-    uint32_t lastWordNum = 0;
-    uint32_t lastElemId = 0;
-    uint32_t lastWordPos = 0;
-    uint32_t numWordIds = _wordRefs.size() - 1;
-    uint32_t lastDocId = 0;
-    vespalib::stringref word;
+    uint32_t pos = _pushPos;
+    uint32_t posEnd = _positions.size();
+    uint32_t wordNum = _positions[pos]._wordNum;
+    uint32_t docId = _positions[pos]._docId;
+    uint32_t lastElemId = NO_ELEMENT_ID;
+    uint32_t lastWordPos = NO_WORD_POS;
     bool emptyFeatures = true;
 
-    inserter.rewind();
-
-    for (auto &i : _positions) {
-        assert(i._wordNum <= numWordIds);
-        (void) numWordIds;
-        if (lastWordNum != i._wordNum || lastDocId != i._docId) {
-            if (!emptyFeatures) {
-                inserter.add(lastDocId, _features);
-                emptyFeatures = true;
-            }
-            if (lastWordNum != i._wordNum) {
-                lastWordNum = i._wordNum;
-                word = getWordFromNum(lastWordNum);
-                inserter.setNextWord(word);
-            }
-            lastDocId = i._docId;
-            if (i.removed()) {
-                inserter.remove(lastDocId);
-                continue;
-            }
+    if (_positions[pos].removed()) {
+        inserter.remove(docId);
+        ++pos;
+    }
+    for (; pos < posEnd; ++pos) {
+        const PosInfo &i = _positions[pos];
+        if (i._wordNum != wordNum || i._docId != docId) {
+            break;
         }
-        if (emptyFeatures) {
-            if (!i.removed()) {
-                emptyFeatures = false;
-                _features.clear(lastDocId);
-                lastElemId = NO_ELEMENT_ID;
-                lastWordPos = NO_WORD_POS;
-            } else {
-                continue; // ignore dup remove
-            }
-        } else {
+        if (i.removed()) {
             // removes must come before non-removes
-            assert(!i.removed());
+            assert(emptyFeatures);
+            continue; // ignore dup remove
+        }
+        if (emptyFeatures) {
+            emptyFeatures = false;
+            _features.clear(docId);
         }
         const ElemInfo &elem = _elems[i._elemRef];
         if (i._wordPos != lastWordPos || i._elemId != lastElemId) {
@@ -556,12 +548,75 @@ FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
             // silently ignore duplicate annotations
         }
     }
-
     if (!emptyFeatures) {
-        inserter.add(lastDocId, _features);
+        inserter.add(docId, _features);
+    }
+    _pushPos = pos;
+}
+
+
+void
+FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
+{
+    pushDocuments(std::vector<FieldInverter *>{ this }, inserter);
+}
+
+
+void
+FieldInverter::pushDocuments(const std::vector<FieldInverter *> &inverters,
+                             IOrderedDocumentInserter &inserter)
+{
+    std::vector<FieldInverter *> active;
+    for (FieldInverter *inverter : inverters) {
+        if (inverter->preparePush()) {
+            active.push_back(inverter);
+        }
+    }
+    if (active.empty()) {
+        return;
+    }
+
+    FieldInverter *lastInverter = nullptr;
+    uint32_t lastWordNum = 0;
+    const char *lastWord = nullptr;
+
+    inserter.rewind();
+
+    while (!active.empty()) {
+        // Pick the shard with the lowest (word, docId) pair.  The shards
+        // hold disjoint sets of documents.
+        size_t best = 0;
+        const PosInfo *bestPos = &active[0]->_positions[active[0]->_pushPos];
+        const char *bestWord = active[0]->getWordFromNum(bestPos->_wordNum);
+        for (size_t i = 1; i < active.size(); ++i) {
+            const PosInfo *pos = &active[i]->_positions[active[i]->_pushPos];
+            const char *word = active[i]->getWordFromNum(pos->_wordNum);
+            int cmp = strcmp(word, bestWord);
+            if (cmp < 0 || (cmp == 0 && pos->_docId < bestPos->_docId)) {
+                best = i;
+                bestPos = pos;
+                bestWord = word;
+            }
+        }
+        FieldInverter *inverter = active[best];
+        if (inverter != lastInverter || bestPos->_wordNum != lastWordNum) {
+            if (lastWord == nullptr || strcmp(bestWord, lastWord) != 0) {
+                inserter.setNextWord(bestWord);
+                lastWord = bestWord;
+            }
+            lastInverter = inverter;
+            lastWordNum = bestPos->_wordNum;
+        }
+        inverter->pushNextDoc(inserter);
+        if (inverter->_pushPos == inverter->_positions.size()) {
+            active.erase(active.begin() + best);
+        }
     }
     inserter.flush();
-    reset();
+    // Words referenced by the inserter are owned by the inverters
+    for (FieldInverter *inverter : inverters) {
+        inverter->reset();
+    }
 }
 
 
@@ -180,6 +180,7 @@ private:
     uint32_t                       _wpos;      // current word pos
     uint32_t                       _docId;
     uint32_t                       _oldPosSize;
+    uint32_t                       _pushPos;   // next position to push
 
     const index::Schema           &_schema;
 
@@ -363,6 +364,22 @@ private:
     void
     abortPendingDoc(uint32_t docId);
 
+    /*
+     * Trim aborted documents and sort positions by word and document
+     * id before pushing.
+     *
+     * @return false if there is nothing to push
+     */
+    bool
+    preparePush();
+
+    /*
+     * Push the features for the (word, document) pair at the current
+     * push position to the inserter and step past it.
+     */
+    void
+    pushNextDoc(IOrderedDocumentInserter &inserter);
+
 public:
     /**
      * Create a new memory index based on the given schema.
@@ -391,6 +408,19 @@ public:
     void
     pushDocuments(IOrderedDocumentInserter &inserter);
 
+    /**
+     * Push inverted documents from several inverters for the same
+     * field to memory index structure.  The inverters must hold
+     * disjoint sets of documents.  Their positions are merged in
+     * word and document id order.
+     *
+     * @param inverters  inverters to push from
+     * @param inserter   ordered document inserter
+     */
+    static void
+    pushDocuments(const std::vector<FieldInverter *> &inverters,
+                  IOrderedDocumentInserter &inserter);
+
     /*
      * Invert a normal text field, based on annotations.
      */
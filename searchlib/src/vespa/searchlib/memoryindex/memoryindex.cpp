@@ -49,12 +49,13 @@ namespace memoryindex {
 
 MemoryIndex::MemoryIndex(const Schema &schema,
                          ISequencedTaskExecutor &invertThreads,
-                         ISequencedTaskExecutor &pushThreads)
+                         ISequencedTaskExecutor &pushThreads,
+                         uint32_t numInvertShards)
     : _schema(schema),
       _invertThreads(invertThreads),
       _pushThreads(pushThreads),
-      _inverter0(_schema, _invertThreads, _pushThreads),
-      _inverter1(_schema, _invertThreads, _pushThreads),
+      _inverter0(_schema, _invertThreads, _pushThreads, numInvertShards),
+      _inverter1(_schema, _invertThreads, _pushThreads, numInvertShards),
       _inverter(&_inverter0),
       _dictionary(_schema),
       _frozen(false),
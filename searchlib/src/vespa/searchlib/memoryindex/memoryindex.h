@@ -73,10 +73,13 @@ public:
      * Create a new memory index based on the given schema.
      *
      * @param schema the index schema to use
+     * @param numInvertShards number of disjoint document sets each
+     *                        field is inverted in parallel for
      **/
     MemoryIndex(const index::Schema &schema,
                 ISequencedTaskExecutor &invertThreads,
-                ISequencedTaskExecutor &pushThreads);
+                ISequencedTaskExecutor &pushThreads,
+                uint32_t numInvertShards = 1);
 
     /**
      * Class destructor.  Clean up washlist.
@@ -4,6 +4,7 @@
 
 #include "searchiterator.h"
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <limits>
 
 namespace search {
 
@@ -49,6 +50,13 @@ public:
         _children[ref]->doUnpack(docid);
     }
 
+    // Generic search iterators have no per block weight information
+    static constexpr bool has_block_max() { return false; }
+    int32_t get_block_max_weight(uint32_t, uint32_t &blockEnd) const {
+        blockEnd = endDocId;
+        return std::numeric_limits<int32_t>::max();
+    }
+
     size_t size() const {
         return _children.size();
     }
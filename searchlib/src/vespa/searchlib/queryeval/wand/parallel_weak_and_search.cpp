@@ -41,9 +41,20 @@ private:
         }
     }
 
+    bool check_block_max(docid_t &skipTo) {
+        return (!VectorizedTerms::has_block_max() ||
+                _algo.check_block_max(_terms, _heaps, DotProductScorer(), GreaterThan(_boostedThreshold), skipTo));
+    }
+
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
+        docid_t skipTo;
         while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
+            if (!check_block_max(skipTo)) {
+                // skip the blocks that cannot give a hit
+                _algo.set_candidate(_terms, _heaps, skipTo);
+                continue;
+            }
             if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                 setDocId(_algo.get_candidate());
                 return;
@@ -57,7 +68,8 @@ private:
     void seek_unstrict(uint32_t docid) {
         if (docid > _algo.get_candidate()) {
             _algo.set_candidate(_terms, _heaps, docid);
-            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
+            docid_t skipTo;
+            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold)) && check_block_max(skipTo)) {
                 if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                     setDocId(_algo.get_candidate());
                 }
@@ -177,6 +177,8 @@ public:
 
     uint32_t seek(uint16_t ref, uint32_t docid) { return _iteratorPack.seek(ref, docid); }
     int32_t get_weight(uint16_t ref, uint32_t docid) { return _iteratorPack.get_weight(ref, docid); }
+    static constexpr bool has_block_max() { return IteratorPack::has_block_max(); }
+    int32_t get_block_max_weight(uint16_t ref, docid_t &blockEnd) const { return _iteratorPack.get_block_max_weight(ref, blockEnd); }
     
     vespalib::string stringify_docid() const;
 };
@@ -445,6 +447,13 @@ struct DotProductScorer
     static score_t calculateScore(VectorizedTerms &terms, ref_t ref, docid_t docId) {
         return terms.weight(ref) * (score_t)terms.get_weight(ref, docId);
     }
+
+    // upper bound for the term within the posting list block it is positioned in
+    template <typename VectorizedTerms>
+    static score_t calculate_block_max_score(const VectorizedTerms &terms, ref_t ref, docid_t &blockEnd) {
+        score_t blockMaxScore = terms.weight(ref) * (score_t)terms.get_block_max_weight(ref, blockEnd);
+        return (terms.weight(ref) < 0) ? terms.maxScore(ref) : std::min(blockMaxScore, terms.maxScore(ref));
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -616,6 +625,35 @@ public:
         return true;
     }
 
+    /**
+     * Bound the score of the candidate using the max weight of the
+     * posting list blocks the present terms are positioned in. Terms in
+     * the past still use their global max score. If this bound is not
+     * above the threshold, no document before the end of the first of
+     * these blocks (or the next future term) can be a hit, and that
+     * docid is returned in 'skipTo'. The candidate is left untouched,
+     * since only strict search may move it past the requested docid.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
+    bool check_block_max(VectorizedTerms &terms, Heaps &heaps, Scorer &&, AboveThreshold &&aboveThreshold, docid_t &skipTo) {
+        score_t bound = _maxUpperBound - _upperBound;
+        docid_t blockEnd = search::endDocId;
+        ref_t *end = heaps.present_end();
+        for (ref_t *ref = heaps.present_begin(); ref != end; ++ref) {
+            docid_t termBlockEnd;
+            bound += Scorer::calculate_block_max_score(terms, *ref, termBlockEnd);
+            blockEnd = std::min(blockEnd, termBlockEnd);
+        }
+        if (aboveThreshold(bound)) {
+            return true;
+        }
+        skipTo = (blockEnd < search::endDocId) ? (blockEnd + 1) : search::endDocId;
+        if (heaps.has_future()) {
+            skipTo = std::min(skipTo, terms.docId(heaps.future()));
+        }
+        return false;
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
     bool check_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&scorer, AboveThreshold &&aboveThreshold) {
         _partial_score = 0;
@@ -13,6 +13,7 @@ using vespalib::tensor::Tensor;
 using vespalib::tensor::DenseTensor;
 using vespalib::tensor::DenseTensorView;
 using vespalib::tensor::MutableDenseTensorView;
+using vespalib::tensor::TypedCells;
 using vespalib::eval::ValueType;
 
 namespace search {
@@ -54,7 +55,7 @@ DenseTensorStore::DenseTensorStore(const ValueType &type)
       _type(type),
       _numBoundCells(1u),
       _numUnboundDims(0u),
-      _cellSize(sizeof(double)),
+      _cellSize(ValueType::cell_size(type.cell_type())),
       _emptyCells()
 {
     for (const auto & dim : _type.dimensions()) {
@@ -64,7 +65,7 @@ DenseTensorStore::DenseTensorStore(const ValueType &type)
             ++_numUnboundDims;
         }
     }
-    _emptyCells.resize(_numBoundCells, 0.0);
+    _emptyCells.resize(_numBoundCells * _cellSize, 0);
     _bufferType.setUnboundDimSizesSize(_numUnboundDims * sizeof(uint32_t));
     _store.addType(&_bufferType);
     _store.initActiveBuffers();
@@ -176,15 +177,13 @@ DenseTensorStore::getTensor(EntryRef ref) const
     }
     auto raw = getRawBuffer(ref);
     size_t numCells = getNumCells(raw);
+    TypedCells cells(raw, _type.cell_type(), numCells);
     if (_numUnboundDims == 0) {
-        return std::make_unique<DenseTensorView>
-                (_type,
-                 DenseTensorView::CellsRef(static_cast<const double *>(raw), numCells));
+        return std::make_unique<DenseTensorView>(_type, cells);
     } else {
         std::unique_ptr <MutableDenseTensorView> result =
-                std::make_unique<MutableDenseTensorView>(_type,
-                                                         DenseTensorView::CellsRef(static_cast<const double *>(raw),
-                                                                               numCells));
+                std::make_unique<MutableDenseTensorView>(_type);
+        result->setCells(cells);
         makeConcreteType(*result, raw, _numUnboundDims);
         return result;
     }
@@ -194,14 +193,14 @@ void
 DenseTensorStore::getTensor(EntryRef ref, MutableDenseTensorView &tensor) const
 {
     if (!ref.valid()) {
-        tensor.setCells(DenseTensorView::CellsRef(&_emptyCells[0], _emptyCells.size()));
+        tensor.setCells(TypedCells(_emptyCells.data(), _type.cell_type(), _numBoundCells));
         if (_numUnboundDims > 0) {
             tensor.setUnboundDimensionsForEmptyTensor();
         }
     } else {
         auto raw = getRawBuffer(ref);
         size_t numCells = getNumCells(raw);
-        tensor.setCells(DenseTensorView::CellsRef(static_cast<const double *>(raw), numCells));
+        tensor.setCells(TypedCells(raw, _type.cell_type(), numCells));
         if (_numUnboundDims > 0) {
             makeConcreteType(tensor, raw, _numUnboundDims);
         }
@@ -259,11 +258,11 @@ template <class TensorType>
 TensorStore::EntryRef
 DenseTensorStore::setDenseTensor(const TensorType &tensor)
 {
-    size_t numCells = tensor.cellsRef().size();
+    size_t numCells = tensor.typedCells().size;
     checkMatchingType(_type, tensor.type(), numCells);
     auto raw = allocRawBuffer(numCells);
     setDenseTensorUnboundDimSizes(raw.data, _type, _numUnboundDims, tensor.type());
-    memcpy(raw.data, &tensor.cellsRef()[0], numCells * _cellSize);
+    vespalib::tensor::convertCells(tensor.typedCells(), _type.cell_type(), raw.data);
     return raw.ref;
 }
 
@@ -24,6 +24,9 @@ namespace tensor {
  * If both start of tensor dimension size information and start of
  * tensor cells were to be 32 byte aligned then tensors of type tensor(x[3])
  * would use 64 bytes.
+ *
+ * Cells are stored with the cell type of the tensor type, e.g. a
+ * tensor of type tensor<float>(x[512]) uses 2 KB for its cells.
  */
 class DenseTensorStore : public TensorStore
 {
@@ -54,7 +57,7 @@ private:
     size_t _numBoundCells; // product of bound dimension sizes
     uint32_t _numUnboundDims;
     uint32_t _cellSize; // size of a cell (e.g. double => 8)
-    std::vector<double> _emptyCells;
+    std::vector<char> _emptyCells;
 
     size_t unboundCells(const void *buffer) const;
 
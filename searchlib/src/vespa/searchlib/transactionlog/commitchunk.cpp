@@ -0,0 +1,43 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "commitchunk.h"
+#include <cassert>
+
+namespace search::transactionlog {
+
+CommitChunk::CommitChunk()
+    : _data(),
+      _callBacks(),
+      _firstArrival(),
+      _result(std::make_shared<CommitResult>())
+{ }
+
+CommitChunk::~CommitChunk() { }
+
+void
+CommitChunk::add(const Packet &packet, DoneCallback onDone)
+{
+    if (_data.empty()) {
+        _firstArrival = clock::now();
+        _data = packet;
+    } else {
+        bool merged = _data.merge(packet);
+        assert(merged);
+        (void) merged;
+    }
+    _callBacks.emplace_back(std::move(onDone));
+}
+
+void
+CommitChunk::fail(const vespalib::string & error)
+{
+    _result->setError(error);
+    for (const DoneCallback & callBack : _callBacks) {
+        auto listener = dynamic_cast<CommitFailureListener *>(callBack.get());
+        if (listener != nullptr) {
+            listener->commitFailed(error);
+        }
+    }
+}
+
+}
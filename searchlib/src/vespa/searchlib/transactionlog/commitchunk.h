@@ -0,0 +1,65 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "common.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace search::transactionlog {
+
+/**
+ * Outcome of writing a chunk, shared by all commits in it. It is set
+ * before the done callbacks of the chunk are released, so it can be
+ * inspected by anyone waiting for those callbacks.
+ */
+class CommitResult {
+public:
+    using SP = std::shared_ptr<CommitResult>;
+    CommitResult() : _error() { }
+    bool ok() const { return _error.empty(); }
+    const vespalib::string & getError() const { return _error; }
+    void setError(const vespalib::string & error) { _error = error; }
+private:
+    vespalib::string _error;
+};
+
+/**
+ * Packets from concurrent commits that are written to the domain as one
+ * unit. The done callbacks of the commits are kept until the chunk has
+ * been written (and synced if configured), then released in one go.
+ */
+class CommitChunk {
+public:
+    using DoneCallback = Writer::DoneCallback;
+    using clock = std::chrono::steady_clock;
+
+    CommitChunk();
+    ~CommitChunk();
+
+    bool empty() const { return _data.empty(); }
+    size_t sizeBytes() const { return _data.sizeBytes(); }
+    const Packet & getPacket() const { return _data; }
+    size_t getNumCallBacks() const { return _callBacks.size(); }
+    clock::time_point getFirstArrival() const { return _firstArrival; }
+    const CommitResult::SP & getResult() const { return _result; }
+
+    /**
+     * Append the packet and keep the callback. The serial numbers of the
+     * packet must be higher than those already in the chunk.
+     */
+    void add(const Packet & packet, DoneCallback onDone);
+
+    /**
+     * Mark the chunk as failed and tell the callbacks that implement
+     * CommitFailureListener about it.
+     */
+    void fail(const vespalib::string & error);
+private:
+    Packet                    _data;
+    std::vector<DoneCallback> _callBacks;
+    clock::time_point         _firstArrival;
+    CommitResult::SP          _result;
+};
+
+}
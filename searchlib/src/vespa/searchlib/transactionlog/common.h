@@ -89,6 +89,17 @@ private:
 
 int makeDirectory(const char * dir);
 
+/**
+ * Implemented by done callbacks that want to know when the commit they
+ * were passed with did not make it to disk. It is called before the
+ * callback is released.
+ */
+class CommitFailureListener {
+public:
+    virtual ~CommitFailureListener() { }
+    virtual void commitFailed(const vespalib::string & error) = 0;
+};
+
 class Writer {
 public:
     using DoneCallback = std::shared_ptr<IDestructorCallback>;
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "domain.h"
+#include "commitchunk.h"
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/closuretask.h>
 #include <vespa/fastos/file.h>
@@ -21,24 +22,40 @@ using std::runtime_error;
 
 namespace search::transactionlog {
 
+DomainConfig::DomainConfig()
+    : _crcType(DomainPart::xxh64),
+      _partSizeLimit(0x10000000),
+      _chunkSizeLimit(0x40000),
+      _chunkAgeLimit(0),
+      _fSyncOnCommit(false),
+      _fSyncInterval(0),
+      _fSyncBytes(0)
+{ }
+
 Domain::Domain(const string &domainName, const string & baseDir, Executor & commitExecutor,
-               Executor & sessionExecutor, uint64_t domainPartSize, DomainPart::Crc defaultCrcType,
+               Executor & sessionExecutor, const DomainConfig & cfg,
                const FileHeaderContext &fileHeaderContext) :
-    _defaultCrcType(defaultCrcType),
+    _config(cfg),
     _commitExecutor(commitExecutor),
     _sessionExecutor(sessionExecutor),
     _sessionId(1),
     _syncMonitor(),
     _pendingSync(false),
+    _currentChunkMonitor(),
+    _currentChunk(createCommitChunk()),
+    _writtenChunks(),
+    _writtenBytes(0),
+    _lastSerial(0),
+    _commitError(),
     _name(domainName),
-    _domainPartSize(domainPartSize),
     _parts(),
     _lock(),
     _sessionLock(),
     _sessions(),
     _baseDir(baseDir),
     _fileHeaderContext(fileHeaderContext),
-    _markedDeleted(false)
+    _markedDeleted(false),
+    _singleCommitter(1, 128*1024)
 {
     int retval(0);
     if ((retval = makeDirectory(_baseDir.c_str())) != 0) {
@@ -56,12 +73,13 @@ Domain::Domain(const string &domainName, const string & baseDir, Executor & comm
     }
     _sessionExecutor.sync();
     if (_parts.empty() || _parts.crbegin()->second->isClosed()) {
-        _parts[lastPart].reset(new DomainPart(_name, dir(), lastPart, _defaultCrcType, _fileHeaderContext, false));
+        _parts[lastPart].reset(new DomainPart(_name, dir(), lastPart, _config.getCrcType(), _fileHeaderContext, false));
     }
+    _lastSerial = end();
 }
 
 void Domain::addPart(int64_t partId, bool isLastPart) {
-    DomainPart::SP dp(new DomainPart(_name, dir(), partId, _defaultCrcType, _fileHeaderContext, isLastPart));
+    DomainPart::SP dp(new DomainPart(_name, dir(), partId, _config.getCrcType(), _fileHeaderContext, isLastPart));
     if (dp->size() == 0) {
         // Only last domain part is allowed to be truncated down to
         // empty size.
@@ -99,7 +117,11 @@ private:
     bool              & _pendingSync;
 };
 
-Domain::~Domain() { }
+Domain::~Domain()
+{
+    _singleCommitter.shutdown().sync();
+    syncWrittenChunks();
+}
 
 DomainInfo
 Domain::getDomainInfo() const
@@ -274,26 +296,193 @@ void waitPendingSync(vespalib::Monitor &syncMonitor, bool &pendingSync)
 
 }
 
-void Domain::commit(const Packet & packet)
+std::unique_ptr<CommitChunk>
+Domain::createCommitChunk() const
+{
+    return std::make_unique<CommitChunk>();
+}
+
+std::unique_ptr<CommitChunk>
+Domain::grabCurrentChunk(MonitorGuard & guard)
+{
+    (void) guard;
+    auto chunk = std::move(_currentChunk);
+    _currentChunk = createCommitChunk();
+    return chunk;
+}
+
+std::shared_ptr<const CommitResult>
+Domain::append(const Packet & packet, DoneCallback onDone)
+{
+    if (packet.empty()) {
+        return std::make_shared<CommitResult>();
+    }
+    MonitorGuard guard(_currentChunkMonitor);
+    if ( ! _commitError.empty()) {
+        throw runtime_error(make_string("Domain '%s' has failed an earlier commit: %s", _name.c_str(), _commitError.c_str()));
+    }
+    if (_lastSerial >= packet.range().from()) {
+        throw runtime_error(make_string("Incomming serial number(%" PRIu64 ") must be bigger than the last one (%" PRIu64 ").",
+                                        packet.range().from(), _lastSerial));
+    }
+    _lastSerial = packet.range().to();
+    bool firstInChunk = _currentChunk->empty();
+    _currentChunk->add(packet, std::move(onDone));
+    if (firstInChunk) {
+        // Exactly one commit task per chunk. It picks up everything appended until it gets to run.
+        _singleCommitter.execute(makeTask(makeClosure(this, &Domain::commitChunk)));
+        // Wake up a committer holding written chunks for sync, the new task takes them over.
+        guard.signal();
+    } else if (_currentChunk->sizeBytes() >= _config.getChunkSizeLimit()) {
+        guard.signal();
+    }
+    return _currentChunk->getResult();
+}
+
+void
+Domain::commitChunk()
+{
+    std::unique_ptr<CommitChunk> chunk;
+    {
+        MonitorGuard guard(_currentChunkMonitor);
+        CommitChunk::clock::time_point deadline = _currentChunk->getFirstArrival() + _config.getChunkAgeLimit();
+        while (_currentChunk->sizeBytes() < _config.getChunkSizeLimit()) {
+            CommitChunk::clock::time_point now = CommitChunk::clock::now();
+            if (now >= deadline) {
+                break;
+            }
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+            guard.wait(std::max(1l, static_cast<long>(left)));
+        }
+        chunk = grabCurrentChunk(guard);
+    }
+    doCommit(std::move(chunk));
+    waitForSyncDue();
+}
+
+bool
+Domain::syncIsDue(CommitChunk::clock::time_point now) const
+{
+    if (_writtenChunks.empty()) {
+        return false;
+    }
+    return ((_config.getFSyncBytes() > 0) && (_writtenBytes >= _config.getFSyncBytes())) ||
+           (now >= _writtenChunks.front()->getFirstArrival() + _config.getFSyncInterval());
+}
+
+void
+Domain::waitForSyncDue()
+{
+    if (_writtenChunks.empty()) {
+        return;
+    }
+    {
+        MonitorGuard guard(_currentChunkMonitor);
+        CommitChunk::clock::time_point deadline = _writtenChunks.front()->getFirstArrival() + _config.getFSyncInterval();
+        while (_currentChunk->empty()) {
+            CommitChunk::clock::time_point now = CommitChunk::clock::now();
+            if (now >= deadline) {
+                break;
+            }
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+            guard.wait(std::max(1l, static_cast<long>(left)));
+        }
+        if ( ! _currentChunk->empty()) {
+            // The commit task of the next chunk is queued and will sync when due.
+            return;
+        }
+    }
+    syncWrittenChunks();
+}
+
+void
+Domain::syncWrittenChunks()
+{
+    if (_writtenChunks.empty()) {
+        return;
+    }
+    try {
+        _parts.rbegin()->second->sync();
+    } catch (const std::exception & e) {
+        LOG(error, "Failed syncing %zu written chunks in domain '%s': %s", _writtenChunks.size(), _name.c_str(), e.what());
+        for (const auto & chunk : _writtenChunks) {
+            chunk->fail(e.what());
+        }
+        MonitorGuard guard(_currentChunkMonitor);
+        _commitError = e.what();
+    }
+    LOG(debug, "Releasing acks for %zu synced chunks and %zu bytes.", _writtenChunks.size(), _writtenBytes);
+    _writtenChunks.clear();
+    _writtenBytes = 0;
+}
+
+void
+Domain::doCommit(std::unique_ptr<CommitChunk> chunk)
+{
+    const Packet & packet = chunk->getPacket();
+    if (packet.empty()) {
+        return;
+    }
+    {
+        MonitorGuard guard(_currentChunkMonitor);
+        if ( ! _commitError.empty()) {
+            // Never write after a failed chunk, that would leave a hole in the log.
+            chunk->fail(_commitError);
+            return;
+        }
+    }
+    try {
+        vespalib::nbostream_longlivedbuf is(packet.getHandle().c_str(), packet.getHandle().size());
+        Packet::Entry entry;
+        entry.deserialize(is);
+        DomainPart::SP dp = optionallyRotateFile(entry.serial());
+        dp->commit(entry.serial(), packet);
+        if (_config.getFSyncOnCommit()) {
+            dp->sync();
+        }
+    } catch (const std::exception & e) {
+        // This runs in the committer thread, so the failure is handed back
+        // through the result of the chunk instead of being thrown.
+        LOG(error, "Failed committing %zu entries to domain '%s': %s", packet.size(), _name.c_str(), e.what());
+        chunk->fail(e.what());
+        {
+            MonitorGuard guard(_currentChunkMonitor);
+            _commitError = e.what();
+        }
+        // What was written before the failure is still acked when it is durable.
+        syncWrittenChunks();
+        return;
+    }
+    cleanSessions();
+    if ( ! _config.getFSyncOnCommit() && _config.getAckAfterSync()) {
+        _writtenBytes += packet.sizeBytes();
+        _writtenChunks.push_back(std::move(chunk));
+        if (syncIsDue(CommitChunk::clock::now())) {
+            syncWrittenChunks();
+        }
+        return;
+    }
+    LOG(debug, "Releasing %zu acks for %zu entries and %zu bytes.",
+        chunk->getNumCallBacks(), packet.size(), packet.sizeBytes());
+}
+
+DomainPart::SP
+Domain::optionallyRotateFile(SerialNum serialNum)
 {
     DomainPart::SP dp(_parts.rbegin()->second);
-    vespalib::nbostream_longlivedbuf is(packet.getHandle().c_str(), packet.getHandle().size());
-    Packet::Entry entry;
-    entry.deserialize(is);
-    if (dp->byteSize() > _domainPartSize) {
+    if (dp->byteSize() > _config.getPartSizeLimit()) {
         waitPendingSync(_syncMonitor, _pendingSync);
         triggerSyncNow();
         waitPendingSync(_syncMonitor, _pendingSync);
         dp->close();
-        dp.reset(new DomainPart(_name, dir(), entry.serial(), _defaultCrcType, _fileHeaderContext, false));
+        dp.reset(new DomainPart(_name, dir(), serialNum, _config.getCrcType(), _fileHeaderContext, false));
         {
             LockGuard guard(_lock);
-            _parts[entry.serial()] = dp;
+            _parts[serialNum] = dp;
         }
         dp = _parts.rbegin()->second;
     }
-    dp->commit(entry.serial(), packet);
-    cleanSessions();
+    return dp;
 }
 
 bool Domain::erase(SerialNum to)
@@ -344,6 +533,7 @@ int Domain::startSession(int sessionId)
 int Domain::closeSession(int sessionId)
 {
     _commitExecutor.sync();
+    _singleCommitter.sync();
     int retval(-1);
     {
         LockGuard guard(_sessionLock);
@@ -3,7 +3,8 @@
 
 #include "domainpart.h"
 #include "session.h"
-#include <vespa/vespalib/util/threadexecutor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <chrono>
 
 namespace search::transactionlog {
 
@@ -32,13 +33,58 @@ struct DomainInfo {
 
 typedef std::map<vespalib::string, DomainInfo> DomainStats;
 
+class CommitChunk;
+class CommitResult;
+
+/**
+ * Settings for how a domain writes and syncs its parts.
+ *
+ * Packets committed concurrently are collected into a chunk that is
+ * written when it exceeds the chunk size limit, when its oldest packet
+ * exceeds the chunk age limit, or when the previous chunk is done,
+ * whichever comes first.  With fsync on commit the chunk is synced
+ * before the commits in it are acknowledged.  With an fsync interval
+ * written chunks are instead held until the part is synced, which happens
+ * when the oldest held chunk exceeds the interval or the held chunks
+ * exceed the fsync byte limit, whichever comes first.
+ */
+class DomainConfig {
+public:
+    using duration = std::chrono::microseconds;
+    DomainConfig();
+    DomainConfig & setCrcType(DomainPart::Crc v)  { _crcType = v; return *this; }
+    DomainConfig & setPartSizeLimit(size_t v)     { _partSizeLimit = v; return *this; }
+    DomainConfig & setChunkSizeLimit(size_t v)    { _chunkSizeLimit = v; return *this; }
+    DomainConfig & setChunkAgeLimit(duration v)   { _chunkAgeLimit = v; return *this; }
+    DomainConfig & setFSyncOnCommit(bool v)       { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setFSyncInterval(duration v)   { _fSyncInterval = v; return *this; }
+    DomainConfig & setFSyncBytes(size_t v)        { _fSyncBytes = v; return *this; }
+    DomainPart::Crc getCrcType() const { return _crcType; }
+    size_t   getPartSizeLimit() const { return _partSizeLimit; }
+    size_t  getChunkSizeLimit() const { return _chunkSizeLimit; }
+    duration getChunkAgeLimit() const { return _chunkAgeLimit; }
+    bool     getFSyncOnCommit() const { return _fSyncOnCommit; }
+    duration getFSyncInterval() const { return _fSyncInterval; }
+    size_t      getFSyncBytes() const { return _fSyncBytes; }
+    bool    getAckAfterSync() const { return _fSyncOnCommit || (_fSyncInterval > duration::zero()); }
+private:
+    DomainPart::Crc _crcType;
+    size_t          _partSizeLimit;
+    size_t          _chunkSizeLimit;
+    duration        _chunkAgeLimit;
+    bool            _fSyncOnCommit;
+    duration        _fSyncInterval;
+    size_t          _fSyncBytes;
+};
+
 class Domain
 {
 public:
     using SP = std::shared_ptr<Domain>;
     using Executor = vespalib::ThreadExecutor;
+    using DoneCallback = Writer::DoneCallback;
     Domain(const vespalib::string &name, const vespalib::string &baseDir, Executor & commitExecutor,
-           Executor & sessionExecutor, uint64_t domainPartSize, DomainPart::Crc defaultCrcType,
+           Executor & sessionExecutor, const DomainConfig & cfg,
            const common::FileHeaderContext &fileHeaderContext);
 
     virtual ~Domain();
@@ -47,7 +93,16 @@ public:
     const vespalib::string & name() const { return _name; }
     bool erase(SerialNum to);
 
-    void commit(const Packet & packet);
+    /**
+     * Queue the packet for writing together with other concurrently
+     * committed packets.  The callback is released when the packet has
+     * been written, and synced if fsync on commit or an fsync interval is
+     * configured.  The returned result tells whether that succeeded once
+     * the callback is released, callbacks implementing
+     * CommitFailureListener are also told about a failure.  Throws if the serial numbers are not higher than those
+     * already committed, or if an earlier write to the domain failed.
+     */
+    std::shared_ptr<const CommitResult> append(const Packet & packet, DoneCallback onDone);
     int visit(const Domain::SP & self, SerialNum from, SerialNum to, FRT_Supervisor & supervisor, FNET_Connection *conn);
 
     SerialNum begin() const;
@@ -82,6 +137,14 @@ private:
     void cleanSessions();
     vespalib::string dir() const { return getDir(_baseDir, _name); }
     void addPart(int64_t partId, bool isLastPart);
+    std::unique_ptr<CommitChunk> createCommitChunk() const;
+    std::unique_ptr<CommitChunk> grabCurrentChunk(vespalib::MonitorGuard & guard);
+    void commitChunk();
+    void doCommit(std::unique_ptr<CommitChunk> chunk);
+    bool syncIsDue(std::chrono::steady_clock::time_point now) const;
+    void waitForSyncDue();
+    void syncWrittenChunks();
+    DomainPart::SP optionallyRotateFile(SerialNum serialNum);
 
     using SerialNumList = std::vector<SerialNum>;
 
@@ -90,14 +153,19 @@ private:
     using SessionList = std::map<int, Session::SP>;
     using DomainPartList = std::map<int64_t, DomainPart::SP>;
 
-    DomainPart::Crc     _defaultCrcType;
+    DomainConfig        _config;
     Executor          & _commitExecutor;
     Executor          & _sessionExecutor;
     std::atomic<int>    _sessionId;
     vespalib::Monitor   _syncMonitor;
     bool                _pendingSync;
+    vespalib::Monitor   _currentChunkMonitor;
+    std::unique_ptr<CommitChunk> _currentChunk;
+    std::vector<std::unique_ptr<CommitChunk>> _writtenChunks;
+    size_t              _writtenBytes;
+    SerialNum           _lastSerial;
+    vespalib::string    _commitError;
     vespalib::string    _name;
-    uint64_t            _domainPartSize;
     DomainPartList      _parts;
     vespalib::Lock      _lock;
     vespalib::Lock      _sessionLock;
@@ -105,6 +173,7 @@ private:
     vespalib::string    _baseDir;
     const common::FileHeaderContext &_fileHeaderContext;
     bool                _markedDeleted;
+    vespalib::ThreadStackExecutor _singleCommitter;
 };
 
 }
@@ -34,7 +34,7 @@ string
 handleWriteError(const char *text,
                  FastOS_FileInterface &file,
                  int64_t lastKnownGoodPos,
-                 const Packet::Entry &entry,
+                 SerialNumRange range,
                  int bufLen) __attribute__ ((noinline));
 
 bool
@@ -75,13 +75,13 @@ string
 handleWriteError(const char *text,
                  FastOS_FileInterface &file,
                  int64_t lastKnownGoodPos,
-                 const Packet::Entry &entry,
+                 SerialNumRange range,
                  int bufLen)
 {
     string last(FastOS_File::getLastErrorString());
-    string e(make_string("%s. File '%s' at position %" PRId64 " for entry %" PRIu64 " of length %u. "
+    string e(make_string("%s. File '%s' at position %" PRId64 " for entries [%" PRIu64 ", %" PRIu64 "] of length %u. "
                          "OS says '%s'. Rewind to last known good position %" PRId64 ".",
-                         text, file.GetFileName(), file.GetPosition(), entry.serial(), bufLen,
+                         text, file.GetFileName(), file.GetPosition(), range.from(), range.to(), bufLen,
                          last.c_str(), lastKnownGoodPos));
     LOG(error, "%s",  e.c_str());
     if ( ! file.SetPosition(lastKnownGoodPos) ) {
@@ -407,21 +407,27 @@ DomainPart::commit(SerialNum firstSerial, const Packet &packet)
     if (_range.from() == 0) {
         _range.from(firstSerial);
     }
-    for (size_t i(0); h.size() > 0; i++) {
-        //LOG(spam,
-        //"Pos(%d) Len(%d), Lim(%d), Remaining(%d)",
-        //h.getPos(), h.getLength(), h.getLimit(), h.getRemaining());
+    // Frame all entries into one buffer so the whole packet is written with a single call.
+    nbostream os;
+    SerialNum lastSerial(_range.to());
+    size_t numEntries(0);
+    while (h.size() > 0) {
         Packet::Entry entry;
         entry.deserialize(h);
-        if (_range.to() < entry.serial()) {
-            write(*_transLog, entry);
-            _sz++;
-            _range.to(entry.serial());
+        if (lastSerial < entry.serial()) {
+            serialize(os, entry);
+            lastSerial = entry.serial();
+            numEntries++;
         } else {
             throw runtime_error(make_string("Incomming serial number(%ld) must be bigger than the last one (%ld).",
-                                            entry.serial(), _range.to()));
+                                            entry.serial(), lastSerial));
         }
     }
+    if (numEntries > 0) {
+        write(*_transLog, SerialNumRange(firstSerial, lastSerial), os);
+        _sz += numEntries;
+        _range.to(lastSerial);
+    }
 
     bool merged(false);
     LockGuard guard(_lock);
@@ -574,12 +580,11 @@ DomainPart::visit(FastOS_FileInterface &file, SerialNumRange &r, Packet &packet)
 }
 
 void
-DomainPart::write(FastOS_FileInterface &file, const Packet::Entry &entry)
+DomainPart::serialize(nbostream &os, const Packet::Entry &entry) const
 {
-    int64_t lastKnownGoodPos(file.GetPosition());
     int32_t crc(0);
     uint32_t len(entry.serializedSize() + sizeof(crc));
-    nbostream os;
+    size_t entryStart(os.size());
     os << static_cast<uint8_t>(_defaultCrc);
     os << len;
     size_t start(os.size());
@@ -587,14 +592,21 @@ DomainPart::write(FastOS_FileInterface &file, const Packet::Entry &entry)
     size_t end(os.size());
     crc = calcCrc(_defaultCrc, os.c_str()+start, end - start);
     os << crc;
+    assert(os.size() - entryStart == len + sizeof(len) + sizeof(uint8_t));
+    (void) entryStart;
+}
+
+void
+DomainPart::write(FastOS_FileInterface &file, SerialNumRange range, const nbostream &os)
+{
+    int64_t lastKnownGoodPos(file.GetPosition());
     size_t osSize = os.size();
-    assert(osSize == len + sizeof(len) + sizeof(uint8_t));
 
     LockGuard guard(_writeLock);
     if ( ! file.CheckedWrite(os.c_str(), osSize) ) {
-        throw runtime_error(handleWriteError("Failed writing the entry.", file, lastKnownGoodPos, entry, end - start));
+        throw runtime_error(handleWriteError("Failed writing the entries.", file, lastKnownGoodPos, range, osSize));
     }
-    _writtenSerial = entry.serial();
+    _writtenSerial = range.to();
     _byteSize.store(lastKnownGoodPos + osSize, std::memory_order_release);
 }
 
@@ -1,5 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "translogserver.h"
+#include "commitchunk.h"
+#include <vespa/searchlib/common/gatecallback.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/exceptions.h>
@@ -88,11 +90,16 @@ TransLogServer::TransLogServer(const vespalib::string &name, int listenPort, con
 TransLogServer::TransLogServer(const vespalib::string &name, int listenPort, const vespalib::string &baseDir,
                                const FileHeaderContext &fileHeaderContext, uint64_t domainPartSize,
                                size_t maxThreads, DomainPart::Crc defaultCrcType)
+    : TransLogServer(name, listenPort, baseDir, fileHeaderContext,
+                     DomainConfig().setPartSizeLimit(domainPartSize).setCrcType(defaultCrcType), maxThreads)
+{}
+
+TransLogServer::TransLogServer(const vespalib::string &name, int listenPort, const vespalib::string &baseDir,
+                               const FileHeaderContext &fileHeaderContext, const DomainConfig & cfg, size_t maxThreads)
     : FRT_Invokable(),
       _name(name),
       _baseDir(baseDir),
-      _domainPartSize(domainPartSize),
-      _defaultCrcType(defaultCrcType),
+      _domainConfig(cfg),
       _commitExecutor(maxThreads, 128*1024),
       _sessionExecutor(maxThreads, 128*1024),
       _threadPool(8192, 1),
@@ -111,7 +118,7 @@ TransLogServer::TransLogServer(const vespalib::string &name, int listenPort, con
                 if ( ! domainName.empty()) {
                     try {
                         auto domain = std::make_shared<Domain>(domainName, dir(), _commitExecutor, _sessionExecutor,
-                                                               _domainPartSize, _defaultCrcType,_fileHeaderContext);
+                                                               _domainConfig, _fileHeaderContext);
                         _domains[domain->name()] = domain;
                     } catch (const std::exception & e) {
                         LOG(warning, "Failed creating %s domain on startup. Exception = %s", domainName.c_str(), e.what());
@@ -346,7 +353,7 @@ void TransLogServer::createDomain(FRT_RPCRequest *req)
     if ( !domain ) {
         try {
             domain = std::make_shared<Domain>(domainName, dir(), _commitExecutor, _sessionExecutor,
-                                              _domainPartSize, _defaultCrcType, _fileHeaderContext);
+                                              _domainConfig, _fileHeaderContext);
             {
                 Guard domainGuard(_lock);
                 _domains[domain->name()] = domain;
@@ -455,10 +462,19 @@ void TransLogServer::domainStatus(FRT_RPCRequest *req)
 
 void TransLogServer::commit(const vespalib::string & domainName, const Packet & packet, DoneCallback done)
 {
-    (void) done;
     Domain::SP domain(findDomain(domainName));
     if (domain) {
-        domain->commit(packet);
+        // A failed write is reported through the callback when it is
+        // released, a refused append is reported through it right away.
+        try {
+            domain->append(packet, done);
+        } catch (const std::exception & e) {
+            LOG(warning, "Refused commit to domain '%s': %s", domainName.c_str(), e.what());
+            auto listener = dynamic_cast<CommitFailureListener *>(done.get());
+            if (listener != nullptr) {
+                listener->commitFailed(e.what());
+            }
+        }
     } else {
         throw IllegalArgumentException("Could not find domain " + domainName);
     }
@@ -474,9 +490,16 @@ void TransLogServer::domainCommit(FRT_RPCRequest *req)
     if (domain) {
         Packet packet(params[1]._data._buf, params[1]._data._len);
         try {
-            domain->commit(packet);
-            ret.AddInt32(0);
-            ret.AddString("ok");
+            vespalib::Gate gate;
+            auto result = domain->append(packet, std::make_shared<GateCallback>(gate));
+            gate.await();
+            if (result->ok()) {
+                ret.AddInt32(0);
+                ret.AddString("ok");
+            } else {
+                ret.AddInt32(-2);
+                ret.AddString(make_string("Exception during commit on %s : %s", domainName, result->getError().c_str()).c_str());
+            }
         } catch (const std::exception & e) {
             ret.AddInt32(-2);
             ret.AddString(make_string("Exception during commit on %s : %s", domainName, e.what()).c_str());
@@ -39,8 +39,16 @@ DomainPart::Crc getCrc(searchlib::TranslogserverConfig::Crcmethod crcType)
 void TransLogServerApp::start()
 {
     std::shared_ptr<searchlib::TranslogserverConfig> c = _tlsConfig.get();
+    DomainConfig domainConfig;
+    domainConfig.setCrcType(getCrc(c->crcmethod))
+                .setPartSizeLimit(c->filesizemax)
+                .setChunkSizeLimit(c->chunk.sizelimit)
+                .setChunkAgeLimit(std::chrono::microseconds(static_cast<int64_t>(c->chunk.agelimit * 1000000)))
+                .setFSyncOnCommit(c->usefsync)
+                .setFSyncInterval(std::chrono::microseconds(static_cast<int64_t>(c->fsync.interval * 1000000)))
+                .setFSyncBytes(c->fsync.bytes);
     _tls.reset(new TransLogServer(c->servername, c->listenport, c->basedir, _fileHeaderContext,
-                                  c->filesizemax, c->maxthreads, getCrc(c->crcmethod)));
+                                  domainConfig, c->maxthreads));
 }
 
 TransLogServerApp::~TransLogServerApp()
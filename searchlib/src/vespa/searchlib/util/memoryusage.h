@@ -12,26 +12,30 @@ private:
     size_t _usedBytes;
     size_t _deadBytes;
     size_t _allocatedBytesOnHold;
+    size_t _hugePageBytes; // part of allocated bytes backed by huge pages
 
 public:
     MemoryUsage()
         : _allocatedBytes(0),
           _usedBytes(0),
           _deadBytes(0),
-          _allocatedBytesOnHold(0)
+          _allocatedBytesOnHold(0),
+          _hugePageBytes(0)
     { }
 
     MemoryUsage(size_t allocated, size_t used, size_t dead, size_t onHold)
         : _allocatedBytes(allocated),
           _usedBytes(used),
           _deadBytes(dead),
-          _allocatedBytesOnHold(onHold)
+          _allocatedBytesOnHold(onHold),
+          _hugePageBytes(0)
     { }
 
     size_t allocatedBytes() const { return _allocatedBytes; }
     size_t usedBytes() const { return _usedBytes; }
     size_t deadBytes() const { return _deadBytes; }
     size_t allocatedBytesOnHold() const { return _allocatedBytesOnHold; }
+    size_t hugePageBytes() const { return _hugePageBytes; }
     void incAllocatedBytes(size_t inc) { _allocatedBytes += inc; }
     void decAllocatedBytes(size_t dec) { _allocatedBytes -= dec; }
     void incUsedBytes(size_t inc) { _usedBytes += inc; }
@@ -42,6 +46,8 @@ public:
     void setUsedBytes(size_t used) { _usedBytes = used; }
     void setDeadBytes(size_t dead) { _deadBytes = dead; }
     void setAllocatedBytesOnHold(size_t onHold) { _allocatedBytesOnHold = onHold; }
+    void incHugePageBytes(size_t inc) { _hugePageBytes += inc; }
+    void setHugePageBytes(size_t hugePage) { _hugePageBytes = hugePage; }
 
     void mergeGenerationHeldBytes(size_t inc) {
         _allocatedBytes += inc;
@@ -54,6 +60,7 @@ public:
         _usedBytes += rhs._usedBytes;
         _deadBytes += rhs._deadBytes;
         _allocatedBytesOnHold += rhs._allocatedBytesOnHold;
+        _hugePageBytes += rhs._hugePageBytes;
     }
 };
 
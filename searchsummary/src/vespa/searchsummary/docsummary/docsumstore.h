@@ -3,6 +3,7 @@
 #pragma once
 
 #include "docsumstorevalue.h"
+#include <vector>
 
 namespace search::docsummary {
 
@@ -38,6 +39,15 @@ public:
      **/
     virtual DocsumStoreValue getMappedDocsum(uint32_t docid) = 0;
 
+    /**
+     * Hint that docsums for the given local document ids will be
+     * requested next, in any order. Stores may use this to fetch the
+     * underlying documents in one batch.
+     *
+     * @param docids local document ids
+     **/
+    virtual void prefetch(const std::vector<uint32_t> &docids) { (void) docids; }
+
     /**
      * Will return default input class used.
      **/
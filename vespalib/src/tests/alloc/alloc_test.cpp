@@ -4,6 +4,11 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
 
 using namespace vespalib;
 using namespace vespalib::alloc;
@@ -23,6 +28,25 @@ testSwap(T & a, T & b)
     EXPECT_EQUAL(tmpB, a.get());
 }
 
+// Number of explicit huge pages the kernel can currently hand out.
+size_t
+availableHugePages()
+{
+    size_t freePages(0);
+    std::ifstream meminfo("/proc/meminfo");
+    std::string token;
+    while (meminfo >> token) {
+        if (token == "HugePages_Free:") {
+            meminfo >> freePages;
+            break;
+        }
+    }
+    size_t overcommitPages(0);
+    std::ifstream overcommit("/proc/sys/vm/nr_overcommit_hugepages");
+    overcommit >> overcommitPages;
+    return freePages + overcommitPages;
+}
+
 TEST("test basics") {
     {
         Alloc h = Alloc::allocHeap(100);
@@ -100,6 +124,40 @@ TEST("rounding of large mmaped buffer") {
     EXPECT_EQUAL(MemoryAllocator::HUGEPAGE_SIZE*12ul, buf.size());
 }
 
+TEST("huge page alloc of large buffer is backed by huge pages when available") {
+    bool available = (availableHugePages() >= 6);
+    Alloc buf = Alloc::allocHugePages(MemoryAllocator::HUGEPAGE_SIZE*3+3);
+    EXPECT_TRUE(buf.get() != nullptr);
+    EXPECT_EQUAL(MemoryAllocator::HUGEPAGE_SIZE*4ul, buf.size());
+    EXPECT_EQUAL(available ? buf.size() : 0ul, buf.hugePageBytes());
+    memset(buf.get(), 0x55, buf.size());
+    Alloc created = buf.create(MemoryAllocator::HUGEPAGE_SIZE*2);
+    EXPECT_EQUAL(available ? MemoryAllocator::HUGEPAGE_SIZE*2ul : 0ul, created.hugePageBytes());
+}
+
+TEST("huge page alloc falls back to ordinary pages that are not reported as huge pages") {
+    size_t pages = availableHugePages() + 1;
+    if (pages > 64) {
+        fprintf(stderr, "Skipping test, %zu huge pages are available\n", pages - 1);
+        return;
+    }
+    Alloc buf = Alloc::allocHugePages(MemoryAllocator::HUGEPAGE_SIZE*pages);
+    EXPECT_TRUE(buf.get() != nullptr);
+    EXPECT_EQUAL(MemoryAllocator::HUGEPAGE_SIZE*pages, buf.size());
+    EXPECT_EQUAL(0ul, buf.hugePageBytes());
+    memset(buf.get(), 0x55, buf.size());
+    Alloc created = buf.create(MemoryAllocator::HUGEPAGE_SIZE*pages);
+    EXPECT_EQUAL(0ul, created.hugePageBytes());
+}
+
+TEST("huge page alloc of small buffer uses heap") {
+    Alloc buf = Alloc::allocHugePages(100);
+    EXPECT_EQUAL(100ul, buf.size());
+    EXPECT_EQUAL(0ul, buf.hugePageBytes());
+    EXPECT_EQUAL(0ul, Alloc::alloc(MemoryAllocator::HUGEPAGE_SIZE*4).hugePageBytes());
+    EXPECT_EQUAL(0ul, Alloc().hugePageBytes());
+}
+
 TEST("heap alloc can not be extended") {
     Alloc buf = Alloc::allocHeap(100);
     void * oldPtr = buf.get();
@@ -256,4 +314,39 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+TEST("mapped file is read on access and private on write") {
+    vespalib::string fileName("mapped_file.dat");
+    std::vector<char> data(8192 + 100);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i % 127);
+    }
+    FILE * fp = fopen(fileName.c_str(), "w");
+    ASSERT_TRUE(fp != nullptr);
+    ASSERT_EQUAL(1u, fwrite(&data[0], data.size(), 1, fp));
+    fclose(fp);
+    {
+        Alloc buf = Alloc::mapFile(fileName.c_str(), 4096, data.size() - 4096);
+        ASSERT_TRUE(buf.get() != nullptr);
+        EXPECT_EQUAL(8192ul, buf.size());
+        char * p = static_cast<char *>(buf.get());
+        EXPECT_EQUAL(0, memcmp(p, &data[4096], data.size() - 4096));
+        p[0] = 42;
+        EXPECT_EQUAL(42, p[0]);
+        Alloc copy = buf.create(100);
+        EXPECT_EQUAL(4096ul, copy.size());
+    }
+    fp = fopen(fileName.c_str(), "r");
+    ASSERT_TRUE(fp != nullptr);
+    std::vector<char> reread(data.size());
+    ASSERT_EQUAL(1u, fread(&reread[0], reread.size(), 1, fp));
+    fclose(fp);
+    EXPECT_TRUE(data == reread);
+    unlink(fileName.c_str());
+}
+
+TEST("mapping of missing file or unaligned offset gives empty alloc") {
+    EXPECT_TRUE(Alloc::mapFile("no_such_file.dat", 0, 4096).get() == nullptr);
+    EXPECT_TRUE(Alloc::mapFile("no_such_file.dat", 100, 4096).get() == nullptr);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
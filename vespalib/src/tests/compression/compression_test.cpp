@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/data/databuffer.h>
 
 #include <vespa/log/log.h>
@@ -40,6 +42,89 @@ TEST("requireThatZStdCompressFine") {
     EXPECT_EQUAL(64u, compressed.getDataLen());
 }
 
+vespalib::string
+makeDocument(uint32_t id) {
+    return make_string("{\"id\":\"id:music:music::%u\",\"fields\":{\"title\":\"Title number %u\","
+                       "\"artist\":\"Artist %u\",\"year\":%u,\"genre\":\"rock\",\"duration\":%u}}",
+                       id, id * 7, id % 13, 1950 + (id % 70), 120 + (id * 31) % 300);
+}
+
+ZStdDictionary::SP
+trainDictionary() {
+    std::vector<vespalib::string> docs;
+    for (uint32_t id(0); id < 2000; id++) {
+        docs.push_back(makeDocument(id));
+    }
+    std::vector<ConstBufferRef> samples;
+    for (const vespalib::string & doc : docs) {
+        samples.emplace_back(doc.c_str(), doc.size());
+    }
+    return ZStdDictionary::train(samples, 4096, 3);
+}
+
+TEST("requireThatZStdDictionaryCompressBetterAndRoundTrips") {
+    ZStdDictionary::SP dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    EXPECT_NOT_EQUAL(0u, dictionary->getId());
+    EXPECT_LESS_EQUAL(dictionary->getRaw().size(), 4096u);
+
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 3, 100);
+    vespalib::string doc = makeDocument(12345);
+    ConstBufferRef ref(doc.c_str(), doc.size());
+    DataBuffer plain;
+    compress(cfg, ref, plain, false);
+    DataBuffer withDictionary;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(cfg, ref, withDictionary, false, dictionary.get()));
+    EXPECT_LESS(withDictionary.getDataLen(), plain.getDataLen());
+    EXPECT_EQUAL(dictionary->getId(), ZStdDictionary::getIdFromFrame(withDictionary.getData(), withDictionary.getDataLen()));
+
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, doc.size(),
+               ConstBufferRef(withDictionary.getData(), withDictionary.getDataLen()), decompressed, false, dictionary.get());
+    EXPECT_EQUAL(doc, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+
+    DataBuffer missingDictionary;
+    EXPECT_EXCEPTION(decompress(CompressionConfig::Type::ZSTD, doc.size(),
+                                ConstBufferRef(withDictionary.getData(), withDictionary.getDataLen()), missingDictionary, false),
+                     std::runtime_error, "unprocess failed");
+}
+
+TEST("requireThatDictionaryCanBeRecreatedFromRawForm") {
+    ZStdDictionary::SP dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    ZStdDictionary decompressOnly(dictionary->getRaw());
+    EXPECT_EQUAL(dictionary->getId(), decompressOnly.getId());
+    EXPECT_FALSE(decompressOnly.canCompress());
+
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 3, 100);
+    vespalib::string doc = makeDocument(777);
+    DataBuffer compressed;
+    compress(cfg, ConstBufferRef(doc.c_str(), doc.size()), compressed, false, dictionary.get());
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, doc.size(),
+               ConstBufferRef(compressed.getData(), compressed.getDataLen()), decompressed, false, &decompressOnly);
+    EXPECT_EQUAL(doc, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+}
+
+TEST("requireThatDictionaryWithLevelZeroCompressesWithDefaultLevel") {
+    ZStdDictionary::SP trained = trainDictionary();
+    ASSERT_TRUE(trained);
+    ZStdDictionary dictionary(trained->getRaw(), 0);
+    EXPECT_TRUE(dictionary.canCompress());
+    EXPECT_EQUAL(0, dictionary.getCompressionLevel());
+
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 0, 100);
+    vespalib::string doc = makeDocument(4242);
+    DataBuffer compressed;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD,
+                 compress(cfg, ConstBufferRef(doc.c_str(), doc.size()), compressed, false, &dictionary));
+    EXPECT_EQUAL(dictionary.getId(), ZStdDictionary::getIdFromFrame(compressed.getData(), compressed.getDataLen()));
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, doc.size(),
+               ConstBufferRef(compressed.getData(), compressed.getDataLen()), decompressed, false, &dictionary);
+    EXPECT_EQUAL(doc, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
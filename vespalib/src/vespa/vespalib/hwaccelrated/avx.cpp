@@ -2,6 +2,7 @@
 
 #include "avx.h"
 #include "avxprivate.hpp"
+#include "private_helpers.hpp"
 
 namespace vespalib::hwaccelrated {
 
@@ -17,4 +18,40 @@ AvxAccelrator::dotProduct(const double * af, const double * bf, size_t sz) const
     return avx::dotProductSelectAlignment<double, 32>(af, bf, sz);
 }
 
+int64_t
+AvxAccelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return helper::dotProductInt8<16>(a, b, sz);
+}
+
+double
+AvxAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return helper::squaredEuclideanDistanceInt8<16>(a, b, sz);
+}
+
+double
+AvxAccelrator::squaredEuclideanDistance(const float * a, const float * b, size_t sz) const
+{
+    return avx::squaredEuclideanDistanceSelectAlignment<float, 32>(a, b, sz);
+}
+
+double
+AvxAccelrator::squaredEuclideanDistance(const double * a, const double * b, size_t sz) const
+{
+    return avx::squaredEuclideanDistanceSelectAlignment<double, 32>(a, b, sz);
+}
+
+size_t
+AvxAccelrator::populationCount(const uint64_t *a, size_t sz) const
+{
+    return helper::populationCount(a, sz);
+}
+
+size_t
+AvxAccelrator::andCount(const uint64_t *a, const uint64_t *b, size_t sz) const
+{
+    return helper::andCount(a, b, sz);
+}
+
 }
@@ -2,6 +2,7 @@
 
 #include "avx2.h"
 #include "avxprivate.hpp"
+#include "avx2private.hpp"
 
 namespace vespalib::hwaccelrated {
 
@@ -17,4 +18,40 @@ Avx2Accelrator::dotProduct(const double * af, const double * bf, size_t sz) cons
     return avx::dotProductSelectAlignment<double, 32>(af, bf, sz);
 }
 
+int64_t
+Avx2Accelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return avx2::dotProductInt8(a, b, sz);
+}
+
+double
+Avx2Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return avx2::squaredEuclideanDistanceInt8(a, b, sz);
+}
+
+double
+Avx2Accelrator::squaredEuclideanDistance(const float * a, const float * b, size_t sz) const
+{
+    return avx::squaredEuclideanDistanceSelectAlignment<float, 32>(a, b, sz);
+}
+
+double
+Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, size_t sz) const
+{
+    return avx::squaredEuclideanDistanceSelectAlignment<double, 32>(a, b, sz);
+}
+
+size_t
+Avx2Accelrator::populationCount(const uint64_t *a, size_t sz) const
+{
+    return avx2::populationCount(a, sz);
+}
+
+size_t
+Avx2Accelrator::andCount(const uint64_t *a, const uint64_t *b, size_t sz) const
+{
+    return avx2::andCount(a, b, sz);
+}
+
 }
@@ -0,0 +1,140 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <immintrin.h>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * AVX2 intrinsics kernels for the integer entry points. Only include this
+ * from translation units compiled with AVX2 enabled.
+ */
+namespace vespalib::hwaccelrated::avx2 {
+namespace {
+
+inline __m256i
+loadInt8AsInt16(const int8_t * p) {
+    return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+}
+
+inline int64_t
+sumInt32Lanes(__m256i v) {
+    alignas(32) int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), v);
+    int64_t sum(0);
+    for (int32_t lane : lanes) {
+        sum += lane;
+    }
+    return sum;
+}
+
+inline size_t
+sumUInt64Lanes(__m256i v) {
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+/**
+ * Each step adds at most 2*128*128 to an int32 lane, so the lanes are
+ * flushed to the int64 sum after at most 2^15 steps.
+ */
+inline int64_t
+dotProductInt8(const int8_t * a, const int8_t * b, size_t sz) {
+    constexpr size_t STEP = 16;
+    constexpr size_t BLOCK_SIZE = STEP * 0x8000;
+    const size_t vectorEnd = sz - sz % STEP;
+    int64_t sum(0);
+    size_t i(0);
+    while (i < vectorEnd) {
+        const size_t blockEnd = (vectorEnd - i < BLOCK_SIZE) ? vectorEnd : i + BLOCK_SIZE;
+        __m256i acc = _mm256_setzero_si256();
+        for (; i < blockEnd; i += STEP) {
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(loadInt8AsInt16(a + i), loadInt8AsInt16(b + i)));
+        }
+        sum += sumInt32Lanes(acc);
+    }
+    for (; i < sz; i++) {
+        sum += int32_t(a[i]) * int32_t(b[i]);
+    }
+    return sum;
+}
+
+/**
+ * Each step adds at most 2*255*255 to an int32 lane, so the lanes are
+ * flushed to the sum after at most 2^13 steps.
+ */
+inline double
+squaredEuclideanDistanceInt8(const int8_t * a, const int8_t * b, size_t sz) {
+    constexpr size_t STEP = 16;
+    constexpr size_t BLOCK_SIZE = STEP * 0x2000;
+    const size_t vectorEnd = sz - sz % STEP;
+    int64_t sum(0);
+    size_t i(0);
+    while (i < vectorEnd) {
+        const size_t blockEnd = (vectorEnd - i < BLOCK_SIZE) ? vectorEnd : i + BLOCK_SIZE;
+        __m256i acc = _mm256_setzero_si256();
+        for (; i < blockEnd; i += STEP) {
+            __m256i d = _mm256_sub_epi16(loadInt8AsInt16(a + i), loadInt8AsInt16(b + i));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(d, d));
+        }
+        sum += sumInt32Lanes(acc);
+    }
+    for (; i < sz; i++) {
+        int32_t d = int32_t(a[i]) - int32_t(b[i]);
+        sum += d * d;
+    }
+    return sum;
+}
+
+/**
+ * Counts the bits of each byte with a nibble lookup table and sums the
+ * byte counts into the four 64-bit lanes.
+ */
+inline __m256i
+populationCountEpi64(__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, lowMask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+    __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+inline __m256i
+loadWords(const uint64_t * p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+inline size_t
+populationCount(const uint64_t *a, size_t sz) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i(0);
+    for (; (i + 4) <= sz; i += 4) {
+        acc = _mm256_add_epi64(acc, populationCountEpi64(loadWords(a + i)));
+    }
+    size_t count = sumUInt64Lanes(acc);
+    for (; i < sz; i++) {
+        count += __builtin_popcountl(a[i]);
+    }
+    return count;
+}
+
+inline size_t
+andCount(const uint64_t *a, const uint64_t *b, size_t sz) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i(0);
+    for (; (i + 4) <= sz; i += 4) {
+        acc = _mm256_add_epi64(acc, populationCountEpi64(_mm256_and_si256(loadWords(a + i), loadWords(b + i))));
+    }
+    size_t count = sumUInt64Lanes(acc);
+    for (; i < sz; i++) {
+        count += __builtin_popcountl(a[i] & b[i]);
+    }
+    return count;
+}
+
+}
+}
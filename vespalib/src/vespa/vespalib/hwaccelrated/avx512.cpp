@@ -2,6 +2,7 @@
 
 #include "avx512.h"
 #include "avxprivate.hpp"
+#include "avx512private.hpp"
 
 namespace vespalib:: hwaccelrated {
 
@@ -17,4 +18,40 @@ Avx512Accelrator::dotProduct(const double * af, const double * bf, size_t sz) co
     return avx::dotProductSelectAlignment<double, 64>(af, bf, sz);
 }
 
+int64_t
+Avx512Accelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return avx512::dotProductInt8(a, b, sz);
+}
+
+double
+Avx512Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return avx512::squaredEuclideanDistanceInt8(a, b, sz);
+}
+
+double
+Avx512Accelrator::squaredEuclideanDistance(const float * a, const float * b, size_t sz) const
+{
+    return avx::squaredEuclideanDistanceSelectAlignment<float, 64>(a, b, sz);
+}
+
+double
+Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, size_t sz) const
+{
+    return avx::squaredEuclideanDistanceSelectAlignment<double, 64>(a, b, sz);
+}
+
+size_t
+Avx512Accelrator::populationCount(const uint64_t *a, size_t sz) const
+{
+    return avx512::populationCount(a, sz);
+}
+
+size_t
+Avx512Accelrator::andCount(const uint64_t *a, const uint64_t *b, size_t sz) const
+{
+    return avx512::andCount(a, b, sz);
+}
+
 }
@@ -0,0 +1,145 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <immintrin.h>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * AVX-512 intrinsics kernels for the integer entry points. They only use
+ * the F and BW subsets, as VPOPCNTQ is not available on skylake-avx512.
+ * Only include this from translation units compiled with those enabled.
+ */
+namespace vespalib::hwaccelrated::avx512 {
+namespace {
+
+inline __m512i
+loadInt8AsInt16(const int8_t * p) {
+    return _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+}
+
+inline int64_t
+sumInt32Lanes(__m512i v) {
+    alignas(64) int32_t lanes[16];
+    _mm512_store_si512(lanes, v);
+    int64_t sum(0);
+    for (int32_t lane : lanes) {
+        sum += lane;
+    }
+    return sum;
+}
+
+inline size_t
+sumUInt64Lanes(__m512i v) {
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, v);
+    size_t sum(0);
+    for (uint64_t lane : lanes) {
+        sum += lane;
+    }
+    return sum;
+}
+
+/**
+ * Each step adds at most 2*128*128 to an int32 lane, so the lanes are
+ * flushed to the int64 sum after at most 2^15 steps.
+ */
+inline int64_t
+dotProductInt8(const int8_t * a, const int8_t * b, size_t sz) {
+    constexpr size_t STEP = 32;
+    constexpr size_t BLOCK_SIZE = STEP * 0x8000;
+    const size_t vectorEnd = sz - sz % STEP;
+    int64_t sum(0);
+    size_t i(0);
+    while (i < vectorEnd) {
+        const size_t blockEnd = (vectorEnd - i < BLOCK_SIZE) ? vectorEnd : i + BLOCK_SIZE;
+        __m512i acc = _mm512_setzero_si512();
+        for (; i < blockEnd; i += STEP) {
+            acc = _mm512_add_epi32(acc, _mm512_madd_epi16(loadInt8AsInt16(a + i), loadInt8AsInt16(b + i)));
+        }
+        sum += sumInt32Lanes(acc);
+    }
+    for (; i < sz; i++) {
+        sum += int32_t(a[i]) * int32_t(b[i]);
+    }
+    return sum;
+}
+
+/**
+ * Each step adds at most 2*255*255 to an int32 lane, so the lanes are
+ * flushed to the sum after at most 2^13 steps.
+ */
+inline double
+squaredEuclideanDistanceInt8(const int8_t * a, const int8_t * b, size_t sz) {
+    constexpr size_t STEP = 32;
+    constexpr size_t BLOCK_SIZE = STEP * 0x2000;
+    const size_t vectorEnd = sz - sz % STEP;
+    int64_t sum(0);
+    size_t i(0);
+    while (i < vectorEnd) {
+        const size_t blockEnd = (vectorEnd - i < BLOCK_SIZE) ? vectorEnd : i + BLOCK_SIZE;
+        __m512i acc = _mm512_setzero_si512();
+        for (; i < blockEnd; i += STEP) {
+            __m512i d = _mm512_sub_epi16(loadInt8AsInt16(a + i), loadInt8AsInt16(b + i));
+            acc = _mm512_add_epi32(acc, _mm512_madd_epi16(d, d));
+        }
+        sum += sumInt32Lanes(acc);
+    }
+    for (; i < sz; i++) {
+        int32_t d = int32_t(a[i]) - int32_t(b[i]);
+        sum += d * d;
+    }
+    return sum;
+}
+
+/**
+ * Counts the bits of each byte with a nibble lookup table and sums the
+ * byte counts into the eight 64-bit lanes.
+ */
+inline __m512i
+populationCountEpi64(__m512i v) {
+    // Per 128-bit lane: the bit counts of the nibbles 0 to 15
+    const __m512i lookup = _mm512_set4_epi32(0x04030302, 0x03020201, 0x03020201, 0x02010100);
+    const __m512i lowMask = _mm512_set1_epi8(0x0f);
+    __m512i lo = _mm512_and_si512(v, lowMask);
+    __m512i hi = _mm512_and_si512(_mm512_srli_epi16(v, 4), lowMask);
+    __m512i bytes = _mm512_add_epi8(_mm512_shuffle_epi8(lookup, lo), _mm512_shuffle_epi8(lookup, hi));
+    return _mm512_sad_epu8(bytes, _mm512_setzero_si512());
+}
+
+inline __m512i
+loadWords(const uint64_t * p) {
+    return _mm512_loadu_si512(p);
+}
+
+inline size_t
+populationCount(const uint64_t *a, size_t sz) {
+    __m512i acc = _mm512_setzero_si512();
+    size_t i(0);
+    for (; (i + 8) <= sz; i += 8) {
+        acc = _mm512_add_epi64(acc, populationCountEpi64(loadWords(a + i)));
+    }
+    size_t count = sumUInt64Lanes(acc);
+    for (; i < sz; i++) {
+        count += __builtin_popcountl(a[i]);
+    }
+    return count;
+}
+
+inline size_t
+andCount(const uint64_t *a, const uint64_t *b, size_t sz) {
+    __m512i acc = _mm512_setzero_si512();
+    size_t i(0);
+    for (; (i + 8) <= sz; i += 8) {
+        acc = _mm512_add_epi64(acc, populationCountEpi64(_mm512_and_si512(loadWords(a + i), loadWords(b + i))));
+    }
+    size_t count = sumUInt64Lanes(acc);
+    for (; i < sz; i++) {
+        count += __builtin_popcountl(a[i] & b[i]);
+    }
+    return count;
+}
+
+}
+}
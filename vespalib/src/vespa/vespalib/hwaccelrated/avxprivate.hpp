@@ -63,6 +63,38 @@ T computeDotProduct(const T * af, const T * bf, size_t sz)
     return sum + sumT<T, V>(partial[0]);
 }
 
+template <typename T, size_t VLEN, unsigned AlignA, unsigned AlignB, size_t VectorsPerChunk>
+static double computeSquaredEuclideanDistance(const T * af, const T * bf, size_t sz) __attribute__((noinline));
+
+template <typename T, size_t VLEN, unsigned AlignA, unsigned AlignB, size_t VectorsPerChunk>
+double computeSquaredEuclideanDistance(const T * af, const T * bf, size_t sz)
+{
+    constexpr const size_t ChunkSize = VLEN*VectorsPerChunk/sizeof(T);
+    typedef T V __attribute__ ((vector_size (VLEN)));
+    typedef T A __attribute__ ((vector_size (VLEN), aligned(AlignA)));
+    typedef T B __attribute__ ((vector_size (VLEN), aligned(AlignB)));
+    V partial[VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+    const A * a = reinterpret_cast<const A *>(af);
+    const B * b = reinterpret_cast<const B *>(bf);
+
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            V d = a[VectorsPerChunk*i+j] - b[VectorsPerChunk*i+j];
+            partial[j] += d * d;
+        }
+    }
+    double sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        double d = af[i] - bf[i];
+        sum += d * d;
+    }
+    partial[0] = sumR<V, VectorsPerChunk>(partial);
+
+    return sum + sumT<T, V>(partial[0]);
+}
+
 }
 
 template <typename T, size_t VLEN, size_t VectorsPerChunk=4>
@@ -86,4 +118,25 @@ T dotProductSelectAlignment(const T * af, const T * bf, size_t sz)
     }
 }
 
+template <typename T, size_t VLEN, size_t VectorsPerChunk=4>
+VESPA_DLL_LOCAL double squaredEuclideanDistanceSelectAlignment(const T * af, const T * bf, size_t sz);
+
+template <typename T, size_t VLEN, size_t VectorsPerChunk>
+double squaredEuclideanDistanceSelectAlignment(const T * af, const T * bf, size_t sz)
+{
+    if (validAlignment(af, VLEN)) {
+        if (validAlignment(bf, VLEN)) {
+            return computeSquaredEuclideanDistance<T, VLEN, VLEN, VLEN, VectorsPerChunk>(af, bf, sz);
+        } else {
+            return computeSquaredEuclideanDistance<T, VLEN, VLEN, 1, VectorsPerChunk>(af, bf, sz);
+        }
+    } else {
+        if (validAlignment(bf, VLEN)) {
+            return computeSquaredEuclideanDistance<T, VLEN, 1, VLEN, VectorsPerChunk>(af, bf, sz);
+        } else {
+            return computeSquaredEuclideanDistance<T, VLEN, 1, 1, VectorsPerChunk>(af, bf, sz);
+        }
+    }
+}
+
 }
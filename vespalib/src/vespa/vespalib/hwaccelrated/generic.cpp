@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generic.h"
+#include "private_helpers.hpp"
 
 namespace vespalib::hwaccelrated {
 
@@ -82,6 +83,12 @@ GenericAccelrator::dotProduct(const int64_t * a, const int64_t * b, size_t sz) c
     return multiplyAdd<long long, int64_t, 4>(a, b, sz);
 }
 
+int64_t
+GenericAccelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return helper::dotProductInt8<8>(a, b, sz);
+}
+
 void
 GenericAccelrator::orBit(void * aOrg, const void * bOrg, size_t bytes) const
 {
@@ -113,4 +120,34 @@ GenericAccelrator::notBit(void * aOrg, size_t bytes) const
     }
 }
 
+double
+GenericAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return helper::squaredEuclideanDistanceInt8<8>(a, b, sz);
+}
+
+double
+GenericAccelrator::squaredEuclideanDistance(const float * a, const float * b, size_t sz) const
+{
+    return helper::squaredEuclideanDistanceT<float, float, 4>(a, b, sz);
+}
+
+double
+GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b, size_t sz) const
+{
+    return helper::squaredEuclideanDistanceT<double, double, 4>(a, b, sz);
+}
+
+size_t
+GenericAccelrator::populationCount(const uint64_t *a, size_t sz) const
+{
+    return helper::populationCount(a, sz);
+}
+
+size_t
+GenericAccelrator::andCount(const uint64_t *a, const uint64_t *b, size_t sz) const
+{
+    return helper::andCount(a, b, sz);
+}
+
 }
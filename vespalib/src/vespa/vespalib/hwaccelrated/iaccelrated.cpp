@@ -6,6 +6,7 @@
 #include "avx.h"
 #include "avx2.h"
 #include "avx512.h"
+#include <vespa/vespalib/util/memory.h>
 
 namespace vespalib::hwaccelrated {
 
@@ -64,6 +65,101 @@ void verifyAccelrator(const IAccelrated & accel)
     delete [] b;
 }
 
+template<typename T>
+void verifyEuclideanDistance(const IAccelrated & accel) {
+    const size_t testLength(255);
+    T * a = new T[testLength];
+    T * b = new T[testLength];
+    for (size_t j(0); j < 0x20; j++) {
+        double sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            a[i] = (i & 0x3f);
+            b[i] = -T(i & 0x3f);
+            double d = double(a[i]) - double(b[i]);
+            sum += d*d;
+        }
+        double hwComputedSum(accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j));
+        if (sum != hwComputedSum) {
+            fprintf(stderr, "Accelrator is not computing squaredEuclideanDistance correctly. Expected %f, computed %f\n", sum, hwComputedSum);
+            abort();
+        }
+    }
+    delete [] a;
+    delete [] b;
+}
+
+void verifyPopulationCount(const IAccelrated & accel)
+{
+    const uint64_t words[7] = {0x123456789abcdef0ul,  // 32
+                               0x0000000000000000ul,  // 0
+                               0x8000000000000000ul,  // 1
+                               0xdeadbeefbeefdeadul,  // 48
+                               0x5555555555555555ul,  // 32
+                               0x0000000000000001ul,  // 1
+                               0xfffffffffffffffful}; // 64
+    size_t hwComputedPopulationCount = accel.populationCount(words, VESPA_NELEMS(words));
+    if (hwComputedPopulationCount != 178) {
+        fprintf(stderr, "Accelrator is not computing populationCount correctly. Expected %zu, computed %zu\n", 178ul, hwComputedPopulationCount);
+        abort();
+    }
+    size_t expectedAndCount(0);
+    for (size_t i(0); i < 4; i++) {
+        expectedAndCount += __builtin_popcountl(words[i] & words[i + 3]);
+    }
+    size_t hwComputedAndCount = accel.andCount(words, words + 3, 4);
+    if (hwComputedAndCount != expectedAndCount) {
+        fprintf(stderr, "Accelrator is not computing andCount correctly. Expected %zu, computed %zu\n", expectedAndCount, hwComputedAndCount);
+        abort();
+    }
+}
+
+void verifyLongPopulationCount(const IAccelrated & accel)
+{
+    const size_t testLength(67);
+    uint64_t a[testLength];
+    uint64_t b[testLength];
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = 0x9e3779b97f4a7c15ul * (i + 1);
+        b[i] = ~a[i] ^ (0xfful << (i % 57));
+    }
+    for (size_t j(0); j < 0x10; j++) {
+        size_t expectedCount(0);
+        size_t expectedAndCount(0);
+        for (size_t i(j); i < testLength; i++) {
+            expectedCount += __builtin_popcountl(a[i]);
+            expectedAndCount += __builtin_popcountl(a[i] & b[i]);
+        }
+        if (accel.populationCount(&a[j], testLength - j) != expectedCount) {
+            fprintf(stderr, "Accelrator is not computing populationCount correctly for length %zu.\n", testLength - j);
+            abort();
+        }
+        if (accel.andCount(&a[j], &b[j], testLength - j) != expectedAndCount) {
+            fprintf(stderr, "Accelrator is not computing andCount correctly for length %zu.\n", testLength - j);
+            abort();
+        }
+    }
+}
+
+void verifyInt8DotProduct(const IAccelrated & accel)
+{
+    const size_t testLength(255);
+    int8_t a[testLength];
+    int8_t b[testLength];
+    for (size_t j(0); j < 0x20; j++) {
+        int64_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            a[i] = int8_t(i * 37);
+            b[i] = -int8_t(i);
+            sum += int64_t(a[i]) * int64_t(b[i]);
+        }
+        int64_t hwComputedSum(accel.dotProduct(&a[j], &b[j], testLength - j));
+        if (sum != hwComputedSum) {
+            fprintf(stderr, "Accelrator is not computing int8 dotproduct correctly. Expected %ld, computed %ld\n", sum, hwComputedSum);
+            abort();
+        }
+    }
+}
+
 class RuntimeVerificator
 {
 public:
@@ -77,12 +173,24 @@ RuntimeVerificator::RuntimeVerificator()
    verifyAccelrator<double>(generic); 
    verifyAccelrator<int32_t>(generic); 
    verifyAccelrator<int64_t>(generic); 
+   verifyEuclideanDistance<int8_t>(generic);
+   verifyEuclideanDistance<float>(generic);
+   verifyEuclideanDistance<double>(generic);
+   verifyPopulationCount(generic);
+   verifyLongPopulationCount(generic);
+   verifyInt8DotProduct(generic);
 
    IAccelrated::UP thisCpu(IAccelrated::getAccelrator());
    verifyAccelrator<float>(*thisCpu); 
    verifyAccelrator<double>(*thisCpu); 
    verifyAccelrator<int32_t>(*thisCpu); 
    verifyAccelrator<int64_t>(*thisCpu); 
+   verifyEuclideanDistance<int8_t>(*thisCpu);
+   verifyEuclideanDistance<float>(*thisCpu);
+   verifyEuclideanDistance<double>(*thisCpu);
+   verifyPopulationCount(*thisCpu);
+   verifyLongPopulationCount(*thisCpu);
+   verifyInt8DotProduct(*thisCpu);
    
 }
 
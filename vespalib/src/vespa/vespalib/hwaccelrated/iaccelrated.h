@@ -20,10 +20,18 @@ public:
     virtual double dotProduct(const double * a, const double * b, size_t sz) const = 0;
     virtual int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const = 0;
     virtual long long dotProduct(const int64_t * a, const int64_t * b, size_t sz) const = 0;
+    virtual int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const = 0;
     virtual void orBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void notBit(void * a, size_t bytes) const = 0;
+    virtual double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const = 0;
+    virtual double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const = 0;
+    virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const = 0;
+    // Number of set bits in the sz words starting at a.
+    virtual size_t populationCount(const uint64_t *a, size_t sz) const = 0;
+    // Number of set bits in (a & b) for the sz words, without materializing the result.
+    virtual size_t andCount(const uint64_t *a, const uint64_t *b, size_t sz) const = 0;
 
     static IAccelrated::UP getAccelrator() __attribute__((noinline));
 };
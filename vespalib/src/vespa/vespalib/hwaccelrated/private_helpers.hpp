@@ -0,0 +1,133 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Plain loops that are included by every accelrator implementation.
+ * They have internal linkage so that each translation unit gets its own copy,
+ * compiled with the instruction set that translation unit is built for.
+ */
+namespace vespalib::hwaccelrated::helper {
+namespace {
+
+inline size_t
+populationCount(const uint64_t *a, size_t sz) {
+    size_t count[4] = {0, 0, 0, 0};
+    size_t i(0);
+    for (; (i + 4) <= sz; i += 4) {
+        count[0] += __builtin_popcountl(a[i + 0]);
+        count[1] += __builtin_popcountl(a[i + 1]);
+        count[2] += __builtin_popcountl(a[i + 2]);
+        count[3] += __builtin_popcountl(a[i + 3]);
+    }
+    for (; i < sz; i++) {
+        count[0] += __builtin_popcountl(a[i]);
+    }
+    return count[0] + count[1] + count[2] + count[3];
+}
+
+inline size_t
+andCount(const uint64_t *a, const uint64_t *b, size_t sz) {
+    size_t count[4] = {0, 0, 0, 0};
+    size_t i(0);
+    for (; (i + 4) <= sz; i += 4) {
+        count[0] += __builtin_popcountl(a[i + 0] & b[i + 0]);
+        count[1] += __builtin_popcountl(a[i + 1] & b[i + 1]);
+        count[2] += __builtin_popcountl(a[i + 2] & b[i + 2]);
+        count[3] += __builtin_popcountl(a[i + 3] & b[i + 3]);
+    }
+    for (; i < sz; i++) {
+        count[0] += __builtin_popcountl(a[i] & b[i]);
+    }
+    return count[0] + count[1] + count[2] + count[3];
+}
+
+template <typename ACCUM, typename T, size_t UNROLL>
+ACCUM
+multiplyAddT(const T * a, const T * b, size_t sz)
+{
+    ACCUM partial[UNROLL];
+    for (size_t i(0); i < UNROLL; i++) {
+        partial[i] = 0;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            partial[j] += ACCUM(a[i+j]) * ACCUM(b[i+j]);
+        }
+    }
+    for (;i < sz; i++) {
+        partial[i%UNROLL] += ACCUM(a[i]) * ACCUM(b[i]);
+    }
+    ACCUM sum(0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
+template <typename ACCUM, typename T, size_t UNROLL>
+double
+squaredEuclideanDistanceT(const T * a, const T * b, size_t sz)
+{
+    ACCUM partial[UNROLL];
+    for (size_t i(0); i < UNROLL; i++) {
+        partial[i] = 0;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            ACCUM d = ACCUM(a[i+j]) - ACCUM(b[i+j]);
+            partial[j] += d * d;
+        }
+    }
+    for (;i < sz; i++) {
+        ACCUM d = ACCUM(a[i]) - ACCUM(b[i]);
+        partial[i%UNROLL] += d * d;
+    }
+    double sum(0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
+/**
+ * A squared int8 difference is at most 255*255, so an int32 accumulator per lane
+ * is safe for 2^15 elements per lane. Longer vectors are summed in blocks of that size.
+ */
+template <size_t UNROLL>
+double
+squaredEuclideanDistanceInt8(const int8_t * a, const int8_t * b, size_t sz)
+{
+    constexpr size_t BLOCK_SIZE = UNROLL * 0x8000;
+    double sum(0);
+    for (size_t i(0); i < sz; i += BLOCK_SIZE) {
+        size_t left = sz - i;
+        sum += squaredEuclideanDistanceT<int32_t, int8_t, UNROLL>(a + i, b + i, (left < BLOCK_SIZE) ? left : BLOCK_SIZE);
+    }
+    return sum;
+}
+
+/**
+ * An int8 product is at most 128*128 in magnitude, so an int32 accumulator per lane
+ * is safe for 2^16 elements per lane. Longer vectors are summed in blocks of that size.
+ */
+template <size_t UNROLL>
+int64_t
+dotProductInt8(const int8_t * a, const int8_t * b, size_t sz)
+{
+    constexpr size_t BLOCK_SIZE = UNROLL * 0x10000;
+    int64_t sum(0);
+    for (size_t i(0); i < sz; i += BLOCK_SIZE) {
+        size_t left = sz - i;
+        sum += multiplyAddT<int32_t, int8_t, UNROLL>(a + i, b + i, (left < BLOCK_SIZE) ? left : BLOCK_SIZE);
+    }
+    return sum;
+}
+
+}
+}
@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <vespa/fastos/file.h>
 #include <unistd.h>
+#include <fcntl.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".vespalib.alloc");
@@ -143,22 +144,25 @@ public:
     PtrAndSize alloc(size_t sz) const override;
     void free(PtrAndSize alloc) const override;
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
-    static size_t sresize_inplace(PtrAndSize current, size_t newSize);
-    static PtrAndSize salloc(size_t sz, void * wantedAddress);
+    static size_t sresize_inplace(PtrAndSize current, size_t newSize, bool hugePages = false);
+    static PtrAndSize salloc(size_t sz, void * wantedAddress, bool hugePages = false);
+    static PtrAndSize smapFile(const char * fileName, size_t offset, size_t sz);
     static void sfree(PtrAndSize alloc);
     static MemoryAllocator & getDefault();
 private:
-    static size_t extend_inplace(PtrAndSize current, size_t newSize);
+    static size_t extend_inplace(PtrAndSize current, size_t newSize, bool hugePages);
     static size_t shrink_inplace(PtrAndSize current, size_t newSize);
 };
 
 class AutoAllocator : public MemoryAllocator {
 public:
-    AutoAllocator(size_t mmapLimit, size_t alignment) : _mmapLimit(mmapLimit), _alignment(alignment) { }
+    AutoAllocator(size_t mmapLimit, size_t alignment, bool hugePages = false)
+        : _mmapLimit(mmapLimit), _alignment(alignment), _hugePages(hugePages) { }
     PtrAndSize alloc(size_t sz) const override;
     void free(PtrAndSize alloc) const override;
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
     static MemoryAllocator & getDefault();
+    static MemoryAllocator & getHugePages();
     static MemoryAllocator & getAllocator(size_t mmapLimit, size_t alignment);
 private:
     size_t roundUpToHugePages(size_t sz) const {
@@ -176,6 +180,7 @@ private:
     }
     size_t _mmapLimit;
     size_t _alignment;
+    bool   _hugePages;
 };
 
 
@@ -213,6 +218,7 @@ alloc::AlignedHeapAllocator _G_4KalignedHeapAllocator(1024);
 alloc::AlignedHeapAllocator _G_1KalignedHeapAllocator(4096);
 alloc::AlignedHeapAllocator _G_512BalignedHeapAllocator(512);
 alloc::MMapAllocator _G_mmapAllocatorDefault;
+alloc::AutoAllocator _G_hugePageAutoAllocator(MemoryAllocator::HUGEPAGE_SIZE, 0, true);
 
 }
 
@@ -240,6 +246,10 @@ MemoryAllocator & AutoAllocator::getDefault() {
     return getAllocator(1 * MemoryAllocator::HUGEPAGE_SIZE, 0);
 }
 
+MemoryAllocator & AutoAllocator::getHugePages() {
+    return _G_hugePageAutoAllocator;
+}
+
 MemoryAllocator & AutoAllocator::getAllocator(size_t mmapLimit, size_t alignment) {
     MMapLimitAndAlignment key(mmapLimit, alignment);
     auto found = _G_availableAutoAllocators.find(key);
@@ -289,9 +299,10 @@ MMapAllocator::alloc(size_t sz) const {
 }
 
 MemoryAllocator::PtrAndSize
-MMapAllocator::salloc(size_t sz, void * wantedAddress)
+MMapAllocator::salloc(size_t sz, void * wantedAddress, bool hugePages)
 {
     void * buf(nullptr);
+    bool hugeTlb(false);
     sz = roundUp2PageSize(sz);
     if (sz > 0) {
         const int flags(MAP_ANON | MAP_PRIVATE);
@@ -302,7 +313,8 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
             stackTrace = getStackTrace(1);
             LOG(info, "mmap %ld of size %ld from %s", mmapId, sz, stackTrace.c_str());
         }
-        buf = mmap(wantedAddress, sz, prot, flags | _G_HugeFlags, -1, 0);
+        const int hugeFlags = hugePages ? MAP_HUGETLB : _G_HugeFlags;
+        buf = mmap(wantedAddress, sz, prot, flags | hugeFlags, -1, 0);
         if (buf == MAP_FAILED) {
             if ( ! _G_hasHugePageFailureJustHappened ) {
                 _G_hasHugePageFailureJustHappened = true;
@@ -322,7 +334,11 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
                     throw OOMException(msg);
                 }
             }
+            if (hugePages && (madvise(buf, sz, MADV_HUGEPAGE) != 0)) {
+                LOG(debug, "Failed madvise(%p, %ld, MADV_HUGEPAGE) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+            }
         } else {
+            hugeTlb = (hugeFlags & MAP_HUGETLB) != 0;
             if (_G_hasHugePageFailureJustHappened) {
                 _G_hasHugePageFailureJustHappened = false;
             }
@@ -338,14 +354,48 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
             LOG(info, "%ld mappings of accumulated size %ld", _G_HugeMappings.size(), sum(_G_HugeMappings));
         }
     }
+    return PtrAndSize(buf, sz, hugeTlb);
+}
+
+MemoryAllocator::PtrAndSize
+MMapAllocator::smapFile(const char * fileName, size_t offset, size_t sz)
+{
+    if ((sz == 0) || ((offset & (_G_pageSize - 1)) != 0)) {
+        return PtrAndSize(nullptr, 0);
+    }
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        LOG(warning, "Failed opening '%s' for mapping: '%s'", fileName, FastOS_FileInterface::getLastErrorString().c_str());
+        return PtrAndSize(nullptr, 0);
+    }
+    sz = roundUp2PageSize(sz);
+    size_t mmapId = std::atomic_fetch_add(&_G_mmapCount, 1ul);
+    string stackTrace;
+    if (sz >= _G_MMapLogLimit) {
+        stackTrace = getStackTrace(1);
+        LOG(info, "mmap %ld of size %ld from file '%s' from %s", mmapId, sz, fileName, stackTrace.c_str());
+    }
+    void * buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, offset);
+    if (buf == MAP_FAILED) {
+        LOG(warning, "Failed mapping %ld bytes at offset %ld of '%s': '%s'",
+            sz, offset, fileName, FastOS_FileInterface::getLastErrorString().c_str());
+        close(fd);
+        return PtrAndSize(nullptr, 0);
+    }
+    close(fd);
+    if (sz >= _G_MMapLogLimit) {
+        LockGuard guard(_G_lock);
+        _G_HugeMappings[buf] = MMapInfo(mmapId, sz, stackTrace);
+        LOG(info, "%ld mappings of accumulated size %ld", _G_HugeMappings.size(), sum(_G_HugeMappings));
+    }
     return PtrAndSize(buf, sz);
 }
 
 size_t
-MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize) {
+MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize, bool hugePages) {
     newSize = roundUp2PageSize(newSize);
     if (newSize > current.second) {
-        return extend_inplace(current, newSize);
+        return extend_inplace(current, newSize, hugePages);
     } else if (newSize < current.second) {
         return shrink_inplace(current, newSize);
     } else {
@@ -354,9 +404,12 @@ MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize) {
 }
 
 size_t
-MMapAllocator::extend_inplace(PtrAndSize current, size_t newSize) {
-    PtrAndSize got = MMapAllocator::salloc(newSize - current.second, static_cast<char *>(current.first)+current.second);
-    if ((static_cast<const char *>(current.first) + current.second) == static_cast<const char *>(got.first)) {
+MMapAllocator::extend_inplace(PtrAndSize current, size_t newSize, bool hugePages) {
+    PtrAndSize got = MMapAllocator::salloc(newSize - current.second, static_cast<char *>(current.first)+current.second, hugePages);
+    // Only extend with the same kind of pages, to keep hugePageBytes() exact.
+    if (((static_cast<const char *>(current.first) + current.second) == static_cast<const char *>(got.first)) &&
+        (got.hugeTlb == current.hugeTlb))
+    {
         return current.second + got.second;
     } else {
         MMapAllocator::sfree(got);
@@ -366,7 +419,7 @@ MMapAllocator::extend_inplace(PtrAndSize current, size_t newSize) {
 
 size_t
 MMapAllocator::shrink_inplace(PtrAndSize current, size_t newSize) {
-    PtrAndSize toUnmap(static_cast<char *>(current.first)+newSize, current.second - newSize);
+    PtrAndSize toUnmap(static_cast<char *>(current.first)+newSize, current.second - newSize, current.hugeTlb);
     sfree(toUnmap);
     return newSize;
 }
@@ -397,7 +450,7 @@ size_t
 AutoAllocator::resize_inplace(PtrAndSize current, size_t newSize) const {
     if (isMMapped(current.second) && useMMap(newSize)) {
         newSize = roundUpToHugePages(newSize);
-        return MMapAllocator::sresize_inplace(current, newSize);
+        return MMapAllocator::sresize_inplace(current, newSize, _hugePages);
     } else {
         return 0;
     }
@@ -407,7 +460,7 @@ MMapAllocator::PtrAndSize
 AutoAllocator::alloc(size_t sz) const {
     if (useMMap(sz)) {
         sz = roundUpToHugePages(sz);
-        return MMapAllocator::salloc(sz, nullptr);
+        return MMapAllocator::salloc(sz, nullptr, _hugePages);
     } else {
         if (_alignment == 0) {
             return HeapAllocator::salloc(sz);
@@ -465,12 +518,24 @@ Alloc::allocMMap(size_t sz)
     return Alloc(&MMapAllocator::getDefault(), sz);
 }
 
+Alloc
+Alloc::mapFile(const char * fileName, size_t offset, size_t sz)
+{
+    return Alloc(&MMapAllocator::getDefault(), MMapAllocator::smapFile(fileName, offset, sz));
+}
+
 Alloc
 Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment)
 {
     return Alloc(&AutoAllocator::getAllocator(mmapLimit, alignment), sz);
 }
 
+Alloc
+Alloc::allocHugePages(size_t sz)
+{
+    return Alloc(&AutoAllocator::getHugePages(), sz);
+}
+
 }
 
 }
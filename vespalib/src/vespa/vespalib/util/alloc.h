@@ -10,7 +10,17 @@ class MemoryAllocator {
 public:
     enum {HUGEPAGE_SIZE=0x200000u};
     using UP = std::unique_ptr<MemoryAllocator>;
-    using PtrAndSize = std::pair<void *, size_t>;
+    /*
+     * A memory area. hugeTlb tells if it is backed by explicit huge
+     * pages (MAP_HUGETLB), which is only known when the area is mapped.
+     */
+    struct PtrAndSize {
+        PtrAndSize() : first(nullptr), second(0), hugeTlb(false) { }
+        PtrAndSize(void * ptr, size_t sz, bool hugeTlb_ = false) : first(ptr), second(sz), hugeTlb(hugeTlb_) { }
+        void * first;
+        size_t second;
+        bool   hugeTlb;
+    };
     MemoryAllocator(const MemoryAllocator &) = delete;
     MemoryAllocator & operator = (const MemoryAllocator &) = delete;
     MemoryAllocator() { }
@@ -27,6 +37,12 @@ public:
      * @return true if successful.
      */
     virtual size_t resize_inplace(PtrAndSize current, size_t newSize) const = 0;
+    /*
+     * Number of bytes of the given allocation that are backed by explicit huge
+     * pages (MAP_HUGETLB). Areas only advised to use transparent huge pages
+     * (MADV_HUGEPAGE) are not counted, as the kernel may not honor the advice.
+     */
+    size_t hugePageBytes(PtrAndSize alloc) const { return alloc.hugeTlb ? alloc.second : 0; }
     static size_t roundUpToHugePages(size_t sz) {
         return (sz+(HUGEPAGE_SIZE-1)) & ~(HUGEPAGE_SIZE-1);
     }
@@ -57,6 +73,9 @@ public:
      * @return true if successful.
      */
     bool resize_inplace(size_t newSize);
+    size_t hugePageBytes() const {
+        return (_allocator != nullptr) ? _allocator->hugePageBytes(_alloc) : 0;
+    }
     Alloc(const Alloc &) = delete;
     Alloc & operator = (const Alloc &) = delete;
     Alloc(Alloc && rhs) :
@@ -99,11 +118,30 @@ public:
      * is always used when size is above limit.
      */
     static Alloc alloc(size_t sz=0, size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0);
+    /**
+     * As alloc(), but mmapped allocations are backed by explicit huge pages (MAP_HUGETLB).
+     * If no huge pages are available, ordinary pages are used and the kernel is
+     * advised to back them with transparent huge pages (MADV_HUGEPAGE). Only
+     * the former is reported by hugePageBytes().
+     * Allocations created from the result use the same strategy.
+     */
+    static Alloc allocHugePages(size_t sz=0);
+    /**
+     * Map sz bytes starting at the given offset of a file, private and
+     * copy-on-write. Pages are read from the file on first access and
+     * modifications are never written back. Allocations created from the
+     * result are anonymous mmaps. Offset must be page aligned.
+     * An empty allocation is returned if the file could not be mapped.
+     */
+    static Alloc mapFile(const char * fileName, size_t offset, size_t sz);
 private:
     Alloc(const MemoryAllocator * allocator, size_t sz) : _alloc(allocator->alloc(sz)), _allocator(allocator) { }
+    Alloc(const MemoryAllocator * allocator, PtrAndSize alloc)
+        : _alloc(alloc),
+          _allocator((alloc.first != nullptr) ? allocator : nullptr)
+    { }
     void clear() {
-        _alloc.first = nullptr;
-        _alloc.second = 0;
+        _alloc = PtrAndSize();
         _allocator = nullptr;
     }
     PtrAndSize              _alloc;
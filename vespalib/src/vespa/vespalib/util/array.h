@@ -130,6 +130,7 @@ public:
     size_t size() const                     { return _sz; }
     size_t byteSize() const                 { return _sz * sizeof(T); }
     size_t byteCapacity() const             { return _array.size(); }
+    const Alloc & getAlloc() const          { return _array; }
     size_t capacity() const                 { return _array.size()/sizeof(T); }
     void clear() {
         std::_Destroy(array(0), array(_sz));
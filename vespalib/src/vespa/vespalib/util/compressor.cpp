@@ -26,7 +26,7 @@ compress(ICompressor & compressor, const CompressionConfig & compression, const
 }
 
 CompressionConfig::Type
-docompress(const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest)
+docompress(const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest, const ZStdDictionary * dictionary)
 {
     CompressionConfig::Type type(CompressionConfig::NONE);
     switch (compression.type) {
@@ -38,7 +38,7 @@ docompress(const CompressionConfig & compression, const ConstBufferRef & org, Da
         break;
     case CompressionConfig::ZSTD:
         {
-            ZStdCompressor zstd;
+            ZStdCompressor zstd(dictionary);
             type = compress(zstd, compression, org, dest);
         }
         break;
@@ -50,11 +50,12 @@ docompress(const CompressionConfig & compression, const ConstBufferRef & org, Da
 }
 
 CompressionConfig::Type
-compress(const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
+compress(const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap,
+         const ZStdDictionary * dictionary)
 {
     CompressionConfig::Type type(CompressionConfig::NONE);
     if (org.size() >= compression.minSize) {
-        type = docompress(compression, org, dest);
+        type = docompress(compression, org, dest, dictionary);
     }
     if (type == CompressionConfig::NONE) {
         if (allowSwap) {
@@ -93,7 +94,8 @@ decompress(ICompressor & decompressor, size_t uncompressedLen, const ConstBuffer
 }
 
 void
-decompress(const CompressionConfig::Type & type, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
+decompress(const CompressionConfig::Type & type, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap,
+           const ZStdDictionary * dictionary)
 {
     switch (type) {
     case CompressionConfig::LZ4:
@@ -104,7 +106,7 @@ decompress(const CompressionConfig::Type & type, size_t uncompressedLen, const C
         break;
         case CompressionConfig::ZSTD:
         {
-            ZStdCompressor zstd;
+            ZStdCompressor zstd(dictionary);
             decompress(zstd, uncompressedLen, org, dest, allowSwap);
         }
         break;
@@ -8,6 +8,8 @@ namespace vespalib { class DataBuffer; }
 
 namespace vespalib::compression {
 
+class ZStdDictionary;
+
 class ICompressor
 {
 public:
@@ -25,8 +27,10 @@ public:
  * @param dest is the destination buffer. The compressed data will be appended unless allowSwap is true
  *             and it is not compressable. Then it will be swapped in.
  * @param allowSwap will tell it the data must be appended or if it can be swapped in if it is uncompressable or config is NONE.
+ * @param dictionary is an optional dictionary used when compressing with ZSTD.
  */
-CompressionConfig::Type compress(const CompressionConfig & compression, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
+CompressionConfig::Type compress(const CompressionConfig & compression, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap,
+                                 const ZStdDictionary * dictionary = nullptr);
 
 /**
  * Will try to decompress a buffer according to the config.
@@ -38,8 +42,10 @@ CompressionConfig::Type compress(const CompressionConfig & compression, const ve
  *             appended unless allowSwap is true and compression is NONE.
  *             Then it will be swapped in.
  * @param allowSwap will tell it the data must be appended or if it can be swapped in if compression type is NONE.
+ * @param dictionary is the dictionary needed if the data was compressed with one.
  */
-void decompress(const CompressionConfig::Type & compression, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
+void decompress(const CompressionConfig::Type & compression, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap,
+                const ZStdDictionary * dictionary = nullptr);
 
 size_t computeMaxCompressedsize(CompressionConfig::Type type, size_t uncompressedSize);
 
@@ -4,9 +4,14 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/sync.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <vector>
 #include <cassert>
 
+#ifndef ZSTD_CLEVEL_DEFAULT
+#define ZSTD_CLEVEL_DEFAULT 3
+#endif
+
 using vespalib::alloc::Alloc;
 
 namespace vespalib::compression {
@@ -35,6 +40,59 @@ thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
 }
 
+ZStdDictionary::ZStdDictionary(const ConstBufferRef & raw)
+    : _raw(raw.c_str(), raw.c_str() + raw.size()),
+      _id(ZSTD_getDictID_fromDict(raw.c_str(), raw.size())),
+      _compressionLevel(0),
+      _compressDict(nullptr),
+      _decompressDict(ZSTD_createDDict(_raw.data(), _raw.size()))
+{
+    assert(_decompressDict != nullptr);
+}
+
+ZStdDictionary::ZStdDictionary(const ConstBufferRef & raw, int compressionLevel)
+    : _raw(raw.c_str(), raw.c_str() + raw.size()),
+      _id(ZSTD_getDictID_fromDict(raw.c_str(), raw.size())),
+      _compressionLevel(compressionLevel),
+      _compressDict(ZSTD_createCDict(_raw.data(), _raw.size(),
+                                     (compressionLevel == 0) ? ZSTD_CLEVEL_DEFAULT : compressionLevel)),
+      _decompressDict(ZSTD_createDDict(_raw.data(), _raw.size()))
+{
+    assert(_compressDict != nullptr);
+    assert(_decompressDict != nullptr);
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    ZSTD_freeCDict(_compressDict);
+    ZSTD_freeDDict(_decompressDict);
+}
+
+ZStdDictionary::SP
+ZStdDictionary::train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel)
+{
+    std::vector<char> samplesBuffer;
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(samples.size());
+    for (const ConstBufferRef & sample : samples) {
+        samplesBuffer.insert(samplesBuffer.end(), sample.c_str(), sample.c_str() + sample.size());
+        sampleSizes.push_back(sample.size());
+    }
+    std::vector<char> dict(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(dict.data(), dict.size(), samplesBuffer.data(),
+                                      sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return SP();
+    }
+    return std::make_shared<ZStdDictionary>(ConstBufferRef(dict.data(), sz), compressionLevel);
+}
+
+uint32_t
+ZStdDictionary::getIdFromFrame(const void * frame, size_t frameLen)
+{
+    return ZSTD_getDictID_fromFrame(frame, frameLen);
+}
+
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
 
 bool
@@ -44,7 +102,11 @@ ZStdCompressor::process(const CompressionConfig& config, const void * inputV, si
     if ( ! _tlCompressState) {
         _tlCompressState = std::make_unique<CompressContext>();
     }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    assert((_dictionary == nullptr) || _dictionary->canCompress());
+    size_t sz = (_dictionary != nullptr)
+                ? ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen,
+                                           _dictionary->getCompressDict())
+                : ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -56,7 +118,18 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     if ( ! _tlDecompressState) {
         _tlDecompressState = std::make_unique<DecompressContext>();
     }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    uint32_t dictId = ZStdDictionary::getIdFromFrame(inputV, inputLen);
+    if (dictId != 0) {
+        if ((_dictionary == nullptr) || (_dictionary->getId() != dictId)) {
+            // Compressed with a dictionary we do not have
+            outputLenV = 0;
+            return false;
+        }
+    }
+    size_t sz = (dictId != 0)
+                ? ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen,
+                                             _dictionary->getDecompressDict())
+                : ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
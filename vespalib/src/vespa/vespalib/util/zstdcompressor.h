@@ -2,15 +2,73 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
+/**
+ * A zstd dictionary trained from samples of the data to compress.
+ * Small inputs compressed with a dictionary compress far better than
+ * on their own. Data compressed with a dictionary can only be
+ * decompressed with the same dictionary, identified by its id.
+ */
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    /**
+     * Create a dictionary that can only be used for decompression.
+     * @param raw the serialized dictionary, as produced by train.
+     */
+    explicit ZStdDictionary(const ConstBufferRef & raw);
+    /**
+     * @param raw the serialized dictionary, as produced by train.
+     * @param compressionLevel the level used when compressing with this dictionary,
+     *                         0 selects the zstd default level.
+     */
+    ZStdDictionary(const ConstBufferRef & raw, int compressionLevel);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    /**
+     * Train a dictionary of at most maxSize bytes from the given samples.
+     * @return the dictionary, or an empty pointer if training failed, e.g. due to too little sample data.
+     */
+    static SP train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel);
+    /**
+     * @return id of the dictionary needed to decompress the given zstd frame, 0 if none is needed.
+     */
+    static uint32_t getIdFromFrame(const void * frame, size_t frameLen);
+
+    uint32_t getId() const { return _id; }
+    int getCompressionLevel() const { return _compressionLevel; }
+    bool canCompress() const { return (_compressDict != nullptr); }
+    ConstBufferRef getRaw() const { return ConstBufferRef(&_raw[0], _raw.size()); }
+    const ZSTD_CDict_s * getCompressDict() const { return _compressDict; }
+    const ZSTD_DDict_s * getDecompressDict() const { return _decompressDict; }
+private:
+    std::vector<char> _raw;
+    uint32_t          _id;
+    int               _compressionLevel;
+    ZSTD_CDict_s    * _compressDict;
+    ZSTD_DDict_s    * _decompressDict;
+};
+
 class ZStdCompressor : public ICompressor
 {
 public:
+    ZStdCompressor() : _dictionary(nullptr) { }
+    ZStdCompressor(const ZStdDictionary * dictionary) : _dictionary(dictionary) { }
     bool process(const CompressionConfig& config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    const ZStdDictionary * _dictionary;
 };
 
 }